@@ -0,0 +1,317 @@
+#ifndef ASYNCLOGGER_H
+#define ASYNCLOGGER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <thread>
+#include <type_traits>
+
+/**
+ * @brief Níveis de log (mensagens abaixo do nível configurado são descartadas
+ * antes de qualquer trabalho)
+ */
+enum class LogLevel : uint8_t { Debug = 0, Info, Warn, Error, Off };
+
+/**
+ * @brief Argumento de um registro de log: inteiro, real ou texto estático
+ *
+ * Textos são guardados apenas como ponteiro: use somente literais ou
+ * strings com duração estática (nunca std::string::c_str() temporário).
+ */
+struct LogArg {
+    enum Type : uint8_t { Int, Double, String };
+    Type type;
+    union {
+        int64_t i;
+        double d;
+        const char* s;
+    };
+};
+
+inline LogArg makeLogArg(const char* value) {
+    LogArg arg;
+    arg.type = LogArg::String;
+    arg.s = value;
+    return arg;
+}
+
+inline LogArg makeLogArg(double value) {
+    LogArg arg;
+    arg.type = LogArg::Double;
+    arg.d = value;
+    return arg;
+}
+
+template<typename T>
+typename std::enable_if<std::is_integral<T>::value, LogArg>::type makeLogArg(T value) {
+    LogArg arg;
+    arg.type = LogArg::Int;
+    arg.i = static_cast<int64_t>(value);
+    return arg;
+}
+
+/**
+ * @brief Registro binário de tamanho fixo
+ *
+ * O formato é um literal com "{}" marcando a posição de cada argumento
+ * (inteiros em decimal, reais com 4 casas). A formatação do texto é feita
+ * apenas na thread de saída.
+ */
+struct LogRecord {
+    static const int MAX_ARGS = 10;
+
+    uint64_t timestampNs;
+    const char* format;
+    LogArg args[MAX_ARGS];
+    uint8_t argCount;
+    LogLevel level;
+    uint32_t suppressed;     // Mensagens descartadas pelo limitador desde a última
+};
+
+/**
+ * @brief Fila circular limitada lock-free (múltiplos produtores/consumidores)
+ *
+ * Algoritmo de D. Vyukov: cada célula tem um número de sequência que indica
+ * se está livre para escrita ou pronta para leitura. push/pop nunca
+ * bloqueiam; com a fila cheia push retorna false.
+ */
+template<typename T, size_t Capacity>
+class BoundedQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity precisa ser potência de 2");
+
+public:
+    BoundedQueue() : enqueuePos(0), dequeuePos(0) {
+        for (size_t i = 0; i < Capacity; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool tryPush(const T& value) {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & (Capacity - 1)];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.data = value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Cheia
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& value) {
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & (Capacity - 1)];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    value = cell.data;
+                    cell.sequence.store(pos + Capacity, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Vazia
+            } else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    Cell cells[Capacity];
+    alignas(64) std::atomic<size_t> enqueuePos;
+    alignas(64) std::atomic<size_t> dequeuePos;
+};
+
+/**
+ * @brief Limitador de taxa e amostragem de um ponto de log
+ *
+ * Cada ponto de chamada dos macros LOG_RATE_LIMITED/LOG_SAMPLED tem a sua
+ * instância estática. Com sampleEvery = n, apenas 1 de cada n ocorrências
+ * é considerada; com maxPerSecond > 0, no máximo esse número de mensagens
+ * passa por janela de 1 s e as demais são contadas como suprimidas (o
+ * total aparece na próxima mensagem emitida).
+ */
+class LogSite {
+public:
+    LogSite(uint32_t maxPerSecond, uint32_t sampleEvery);
+
+    /**
+     * @brief Decide se esta ocorrência deve gerar um registro
+     * @param suppressed Recebe quantas mensagens foram suprimidas desde a última emitida
+     */
+    bool admit(uint32_t& suppressed);
+
+private:
+    const uint32_t maxPerSecond;
+    const uint32_t sampleEvery;
+    std::atomic<uint32_t> occurrences;
+    std::atomic<uint64_t> windowStart;
+    std::atomic<uint32_t> inWindow;
+    std::atomic<uint32_t> suppressedCount;
+};
+
+/**
+ * @brief Logger assíncrono para as threads de controle
+ *
+ * As threads de controle apenas copiam um LogRecord para uma fila
+ * lock-free (sem alocação, sem formatação, sem I/O). Uma thread de fundo
+ * esvazia a fila, formata o texto e escreve no stream de saída com um
+ * único flush por lote. Se a fila estiver cheia, o registro é descartado e
+ * contado em getDropped() — a thread de controle nunca espera pelo console.
+ *
+ * Use preferencialmente pelos macros:
+ * @code
+ *   LOG_INFO("Decisão #{} | Saída NN: {}", decisionCount, output);
+ *   LOG_RATE_LIMITED(LogLevel::Warn, 5, "Obstáculo a {} mm", frontMin);
+ *   LOG_SAMPLED(LogLevel::Info, 5, "[SENSORES] R:{} L:{}", right, left);
+ * @endcode
+ */
+class AsyncLogger {
+public:
+    static const size_t QUEUE_CAPACITY = 1024;
+
+    /**
+     * @brief Cria um logger com thread própria escrevendo em out
+     */
+    explicit AsyncLogger(std::ostream& out);
+
+    /**
+     * @brief Esvazia a fila e encerra a thread de saída
+     */
+    ~AsyncLogger();
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    /**
+     * @brief Logger global (console), criado no primeiro uso
+     */
+    static AsyncLogger& instance();
+
+    void setLevel(LogLevel level) { minLevel.store(level, std::memory_order_relaxed); }
+    LogLevel getLevel() const { return minLevel.load(std::memory_order_relaxed); }
+
+    bool isEnabled(LogLevel level) const {
+        return level >= minLevel.load(std::memory_order_relaxed) && level != LogLevel::Off;
+    }
+
+    /**
+     * @brief Enfileira um registro (não bloqueia)
+     * @param level Nível da mensagem
+     * @param suppressed Mensagens suprimidas pelo limitador antes desta
+     * @param format Literal com marcadores "{}"
+     * @return false se a fila estava cheia (registro descartado)
+     */
+    template<typename... Args>
+    bool log(LogLevel level, uint32_t suppressed, const char* format, Args... args) {
+        static_assert(sizeof...(Args) <= LogRecord::MAX_ARGS, "Argumentos demais para LogRecord");
+
+        LogRecord record;
+        record.timestampNs = nowNs();
+        record.format = format;
+        record.level = level;
+        record.suppressed = suppressed;
+        record.argCount = static_cast<uint8_t>(sizeof...(Args));
+        fillArgs(record.args, args...);
+
+        if (!queue.tryPush(record)) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        pushed.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Aguarda até que tudo o que foi enfileirado tenha sido escrito
+     */
+    void flush();
+
+    /**
+     * @brief Registros descartados por fila cheia
+     */
+    uint64_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Formata um registro como texto (usado pela thread de saída)
+     */
+    static void format(std::ostream& out, const LogRecord& record, uint64_t startNs);
+
+    static uint64_t nowNs();
+
+private:
+    std::ostream& output;
+    BoundedQueue<LogRecord, QUEUE_CAPACITY> queue;
+    std::atomic<LogLevel> minLevel;
+    std::atomic<uint64_t> pushed;
+    std::atomic<uint64_t> written;
+    std::atomic<uint64_t> dropped;
+    std::atomic<bool> running;
+    uint64_t startNs;
+    std::thread writer;
+
+    void writerLoop();
+
+    static void fillArgs(LogArg*) {}
+
+    template<typename T, typename... Rest>
+    static void fillArgs(LogArg* out, T first, Rest... rest) {
+        *out = makeLogArg(first);
+        fillArgs(out + 1, rest...);
+    }
+};
+
+#define LOG_AT(level, ...)                                                   \
+    do {                                                                     \
+        AsyncLogger& logger_ = AsyncLogger::instance();                      \
+        if (logger_.isEnabled(level)) logger_.log(level, 0, __VA_ARGS__);    \
+    } while (0)
+
+#define LOG_DEBUG(...) LOG_AT(LogLevel::Debug, __VA_ARGS__)
+#define LOG_INFO(...)  LOG_AT(LogLevel::Info, __VA_ARGS__)
+#define LOG_WARN(...)  LOG_AT(LogLevel::Warn, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT(LogLevel::Error, __VA_ARGS__)
+
+/**
+ * No máximo perSecond mensagens por segundo deste ponto de chamada
+ */
+#define LOG_RATE_LIMITED(level, perSecond, ...)                              \
+    do {                                                                     \
+        static LogSite site_((perSecond), 1);                                \
+        AsyncLogger& logger_ = AsyncLogger::instance();                      \
+        uint32_t suppressed_ = 0;                                            \
+        if (logger_.isEnabled(level) && site_.admit(suppressed_))            \
+            logger_.log(level, suppressed_, __VA_ARGS__);                    \
+    } while (0)
+
+/**
+ * Apenas 1 de cada `every` ocorrências deste ponto de chamada
+ */
+#define LOG_SAMPLED(level, every, ...)                                       \
+    do {                                                                     \
+        static LogSite site_(0, (every));                                    \
+        AsyncLogger& logger_ = AsyncLogger::instance();                      \
+        uint32_t suppressed_ = 0;                                            \
+        if (logger_.isEnabled(level) && site_.admit(suppressed_))            \
+            logger_.log(level, suppressed_, __VA_ARGS__);                    \
+    } while (0)
+
+#endif // ASYNCLOGGER_H
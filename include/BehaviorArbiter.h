@@ -0,0 +1,130 @@
+#ifndef BEHAVIORARBITER_H
+#define BEHAVIORARBITER_H
+
+#include "MotionCommand.h"
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Proposta de um comportamento para o ciclo atual
+ *
+ * active indica se o comportamento quer o controle neste ciclo. Uma
+ * proposta inativa ainda pode trazer um comando (o que o comportamento
+ * faria sozinho), mas é ignorada pelo árbitro. urgency (0..1) pondera a
+ * proposta na fusão.
+ */
+struct Proposal {
+    bool active;
+    MotionCommand command;
+    double urgency;
+
+    Proposal() : active(false), urgency(0.0) {}
+    Proposal(const MotionCommand& cmd, double urg = 1.0)
+        : active(true), command(cmd), urgency(urg) {}
+
+    static Proposal inactive(const MotionCommand& cmd = MotionCommand()) {
+        Proposal proposal(cmd, 0.0);
+        proposal.active = false;
+        return proposal;
+    }
+};
+
+/**
+ * @brief Comportamento reativo: propõe um comando a partir do snapshot
+ *
+ * Não fala com o robô: quem emite o comando é o árbitro (ou a thread que
+ * usa o comportamento isoladamente).
+ */
+class Behavior {
+public:
+    virtual ~Behavior() = default;
+
+    virtual Proposal propose(const SensorSnapshot& snapshot) = 0;
+
+    virtual const char* getName() const = 0;
+};
+
+enum class ArbitrationMode {
+    Subsumption,     // A proposta ativa de maior prioridade vence
+    WeightedFusion   // Velocidades de Move ativas são combinadas por peso * urgência
+};
+
+/**
+ * @brief Árbitro de comportamentos: um único comando por ciclo
+ *
+ * Subsumption: os comportamentos são consultados em ordem de prioridade
+ * (maior primeiro) e a primeira proposta ativa vence; as demais camadas
+ * nem são avaliadas.
+ *
+ * WeightedFusion: todos são consultados. Rotate, Stop e Hold são manobras
+ * discretas e não podem ser médias — se a proposta ativa de maior
+ * prioridade for uma delas, ela vence como na subsunção. Caso contrário,
+ * as velocidades das propostas Move ativas são combinadas com peso
+ * weight * urgency.
+ *
+ * @code
+ *   BehaviorArbiter arbiter(ArbitrationMode::Subsumption);
+ *   arbiter.addBehavior(collisionAvoidance, 10);
+ *   arbiter.addBehavior(wallFollower, 1);
+ *   MotionCommand command = arbiter.arbitrate(snapshot);
+ * @endcode
+ */
+class BehaviorArbiter {
+public:
+    explicit BehaviorArbiter(ArbitrationMode mode = ArbitrationMode::Subsumption);
+
+    /**
+     * @brief Registra um comportamento (o árbitro não assume a posse)
+     * @param priority Maior valor = maior prioridade
+     * @param weight Peso na fusão (ignorado na subsunção)
+     */
+    void addBehavior(Behavior& behavior, int priority, double weight = 1.0);
+
+    /**
+     * @brief Consulta os comportamentos e escolhe o comando do ciclo
+     * @return Hold se nenhum comportamento estiver ativo
+     */
+    MotionCommand arbitrate(const SensorSnapshot& snapshot);
+
+    /**
+     * @brief Comportamento vencedor do último ciclo (nullptr se nenhum)
+     */
+    const Behavior* getLastWinner() const { return lastWinner; }
+
+    ArbitrationMode getMode() const { return mode; }
+    size_t getBehaviorCount() const { return entries.size(); }
+
+    /**
+     * @brief Ciclos em que o comportamento index (em ordem de prioridade) venceu
+     */
+    uint64_t getWins(size_t index) const;
+    const Behavior& getBehavior(size_t index) const { return *entries[index].behavior; }
+
+    uint64_t getCycles() const { return cycles.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Imprime quantas vezes cada comportamento assumiu o controle
+     */
+    void printStatistics(std::ostream& out) const;
+
+private:
+    struct Entry {
+        Behavior* behavior;
+        int priority;
+        double weight;
+        std::unique_ptr<std::atomic<uint64_t>> wins;
+        Proposal proposal;   // Última proposta (reutilizada a cada ciclo)
+    };
+
+    ArbitrationMode mode;
+    std::vector<Entry> entries;   // Ordenado por prioridade decrescente
+    const Behavior* lastWinner;
+    std::atomic<uint64_t> cycles;
+
+    void countWin(Entry& entry);
+};
+
+#endif // BEHAVIORARBITER_H
@@ -0,0 +1,32 @@
+#ifndef BEHAVIORCONTROLLER_H
+#define BEHAVIORCONTROLLER_H
+#include "Aria.h"
+#include "ClassRobo.h"
+#include "BehaviorArbiter.h"
+#include "LatencyTracer.h"
+
+/**
+ * @brief Laço único de controle com arbitragem de comportamentos
+ *
+ * A cada ciclo lê os sensores uma vez (SensorSnapshot), pede ao árbitro o
+ * comando resultante de todos os comportamentos registrados e emite um
+ * único comando ao robô. Substitui várias threads disputando Move/Rotaciona.
+ */
+class BehaviorController : public ArASyncTask
+{
+public:
+    PioneerRobot *robo;
+    BehaviorArbiter &arbiter;
+    ArMutex myMutex;
+    SensorSnapshot snapshot;
+    LatencyTracer latency;
+
+public:
+    BehaviorController(PioneerRobot *_robo, BehaviorArbiter &_arbiter);
+    void *runThread(void *);
+    void runCycle();
+    void lockMutex();
+    void unlockMutex();
+};
+
+#endif // BEHAVIORCONTROLLER_H
@@ -0,0 +1,82 @@
+#ifndef BEHAVIORS_H
+#define BEHAVIORS_H
+
+#include "BehaviorArbiter.h"
+#include "navigation/DwaPlanner.h"
+#include "navigation/GlobalNavigator.h"
+
+/**
+ * @brief Desvio de obstáculos heurístico (ColisionAvoidanceThread)
+ *
+ * Soma ponderada dos sonares de cada lado escolhe o sentido de giro; o
+ * ângulo depende de qual sensor está abaixo do limiar. Fica ativo apenas
+ * com obstáculo dentro dos limiares; sem obstáculo, propõe "seguir em
+ * frente" como proposta inativa, usada quando o comportamento roda sozinho.
+ * Não espera o fim das rotações: a MotionQueue coalesce/preempta.
+ */
+class CollisionAvoidanceBehavior : public Behavior {
+public:
+    CollisionAvoidanceBehavior();
+
+    Proposal propose(const SensorSnapshot& snapshot) override;
+    const char* getName() const override { return "CollisionAvoidance"; }
+};
+
+/**
+ * @brief Seguidor de parede à direita (WallFollowerThread)
+ *
+ * Camada de base: sempre ativo.
+ */
+class WallFollowerBehavior : public Behavior {
+public:
+    WallFollowerBehavior();
+
+    Proposal propose(const SensorSnapshot& snapshot) override;
+    const char* getName() const override { return "WallFollower"; }
+
+    bool isFollowingWall() const { return followingWall; }
+    void setFollowingWall(bool following) { followingWall = following; }
+
+private:
+    bool followingWall;
+};
+
+/**
+ * @brief Planejador local por janela dinâmica (alternativa ao desvio heurístico)
+ *
+ * A cada ciclo converte os ecos do sonar e os pontos do laser do snapshot
+ * em obstáculos, escolhe o par (v, w) pelo DwaPlanner e o emite como Move
+ * com velocidades de roda. Sempre ativo; sem trajetória admissível, dá ré
+ * devagar até recuperar espaço.
+ *
+ * Com um GlobalNavigator e mapa no snapshot, o rumo desejado passa a ser
+ * o do próximo waypoint do plano global; ao chegar ao objetivo, para.
+ */
+class DwaBehavior : public Behavior {
+public:
+    explicit DwaBehavior(const DwaConfig& config = DwaConfig());
+
+    Proposal propose(const SensorSnapshot& snapshot) override;
+    const char* getName() const override { return "DWA"; }
+
+    /**
+     * @brief Direção desejada relativa ao robô (graus; 0 = manter o rumo)
+     */
+    void setGoalBearing(double bearing) { goalBearing = bearing; }
+
+    /**
+     * @brief Segue os waypoints do navegador (nullptr desliga)
+     */
+    void setNavigator(GlobalNavigator* globalNavigator) { navigator = globalNavigator; }
+
+    const DwaPlanner& getPlanner() const { return planner; }
+    const DwaResult& getLastResult() const { return lastResult; }
+
+private:
+    DwaPlanner planner;
+    DwaResult lastResult;
+    double goalBearing;
+    GlobalNavigator* navigator;
+};
+
+#endif // BEHAVIORS_H
@@ -7,13 +7,18 @@
 #include <stdlib.h>
 #include <string.h>
 #include "Aria.h"
+#include "MotionQueue.h"
+#include "RobotInterface.h"
+#include "navigation/OccupancyGrid.h"
+#include "navigation/ParticleFilter.h"
+#include <vector>
 
 #define GirarBase 1
 #define ConexaoSerial 1
 #define ConexaoRadio 2
 #define ConexaoSimulacao 3
 
-class PioneerRobot
+class PioneerRobot : public MotionBackend, public RobotInterface
 {
 public:
   ArRobot robot;
@@ -28,6 +33,12 @@ public:
   ArSerialConnection con1;
 
   int Sensores[8];
+  MotionQueue motion;
+  OccupancyGrid *map;
+  ParticleFilter *localizer;
+  Pose2D lastOdometry;
+  std::vector<ScanPoint> laserPoints;
+  std::vector<ScanPoint> localLaserPoints;
   PioneerRobot(int tipoConexao, const char *info, int *sucesso);
 
   void destroy();
@@ -41,11 +52,19 @@ public:
   float getXPos();
   float getYPos();
   float getAngBase();
+  Pose2D getPose();
 
   void initMov();
   void Rotaciona(double degrees, int Sentido, int velocidade);
   void getAllSonar(int *sensores);
   void Move(double vl, double vr);
+  void getSnapshot(SensorSnapshot &snapshot) override;
+  void execute(const MotionCommand &command, MotionCallback onDone = MotionCallback()) override;
+  void apply(const MotionCommand &command) override;
+  bool isHeadingDone() override;
+  void setMap(OccupancyGrid *grid);
+  void setLocalizer(ParticleFilter *filter);
+  void getLaserPoints(std::vector<ScanPoint> &points, std::vector<ScanPoint> *local = NULL);
   void getLaser();
   void getWriteLaserReadings();
   void RunExit();
@@ -2,6 +2,8 @@
 #define COLISIONAVOIDANCETHREAD_H
 #include "Aria.h"
 #include "ClassRobo.h"
+#include "LatencyTracer.h"
+#include "Behaviors.h"
 
 class ColisionAvoidanceThread : public ArASyncTask
 {
@@ -9,11 +11,14 @@ public:
     PioneerRobot *robo;
     ArCondition myCondition;
     ArMutex myMutex;
-    int sonar[8];
+    SensorSnapshot snapshot;
+    CollisionAvoidanceBehavior behavior;
+    LatencyTracer latency;
 
 public:
     ColisionAvoidanceThread(PioneerRobot *_robo);
     void *runThread(void *);
+    void runCycle();
     void waitOnCondition();
     void lockMutex();
     void unlockMutex();
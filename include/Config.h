@@ -8,6 +8,60 @@
 #define VELOCIDADEROTACAO 50       // 50
 #define VELOCIDADEDESLOCAMENTO 400 // 400
 
+// Frequência dos laços de controle (Hz, prazos absolutos)
+#define FREQUENCIA_DECISAO 10.0   // NeuralCollisionAvoidance
+#define FREQUENCIA_COLISAO 20.0   // ColisionAvoidanceThread
+#define FREQUENCIA_PAREDE 20.0    // WallFollowerThread
+#define FREQUENCIA_SONAR 1.0      // SonarThread (relatório)
+#define FREQUENCIA_LASER 0.5      // LaserThread
+
+// Tempo real para o laço de decisão: 0 = política padrão, 1-99 = SCHED_FIFO
+#define PRIORIDADE_CONTROLE 0
+// Núcleo fixo para o laço de decisão (-1 = sem afinidade)
+#define CPU_CONTROLE -1
+
+// Planejador local (DWA) no lugar do desvio heurístico: 0 = heurístico, 1 = DWA
+#define CONTROLADOR_DWA 0
+#define DWA_VELOCIDADE_MAX 600.0   // mm/s (os reativos ficam em 150-400)
+// Objetivo global para o DWA (mm, referencial da odometria): 0 = apenas desviar
+#define OBJETIVO_ATIVO 0
+#define OBJETIVO_X 5000.0
+#define OBJETIVO_Y 0.0
+
+// Localização de Monte Carlo no main sobre o mapa gravado pelo main_neural:
+// 0 = pose só da odometria
+#define LOCALIZACAO_ATIVA 0
+#define MCL_PARTICULAS 2000
+#define MAPA_ARQUIVO "mapa.grid"
+
+// Frota (main_fleet): frequência de controle de cada robô e threads do pool
+#define FREQUENCIA_FROTA 10.0
+#define FROTA_WORKERS 2
+// Inferência em lote da frota: tamanho máximo do lote (0 = cada robô prediz
+// sozinho) e espera máxima do pedido mais antigo (us)
+#define INFERENCIA_LOTE 0
+#define INFERENCIA_ATRASO_US 200.0
+
+// Aprendizado online no main_neural: as correções das zonas de segurança
+// ajustam uma cópia da rede em segundo plano (0 = desligado). Os pesos
+// aceitos são salvos em APRENDIZADO_ARQUIVO ao encerrar.
+#define APRENDIZADO_ONLINE 0
+#define APRENDIZADO_PERIODO_S 30.0
+#define APRENDIZADO_MIN_AMOSTRAS 20
+#define APRENDIZADO_ARQUIVO "online_weights.json"
+
+// Troca dos pesos sem reiniciar: SIGHUP recarrega o arquivo de pesos; no
+// main_neural, uma mudança na data do arquivo também (verificada a cada
+// RECARGA_PERIODO_S). Grave o arquivo novo com outro nome e renomeie, para
+// a recarga nunca ler um arquivo pela metade. 0 = desligada.
+#define RECARGA_MODELO 1
+#define RECARGA_PERIODO_S 1.0
+
+// Telemetria no formato Prometheus num socket Unix local (0 = desativada).
+// Leitura: curl --unix-socket /tmp/robo_telemetria.sock http://localhost/metrics
+#define TELEMETRIA_ATIVA 1
+#define TELEMETRIA_SOCKET "/tmp/robo_telemetria.sock"
+
 // Logs
 #define LOG false
 #define INFO_WALL_FOLLOWER false
@@ -0,0 +1,59 @@
+#ifndef CONTROLENCODING_H
+#define CONTROLENCODING_H
+
+#include "MotionCommand.h"
+#include <vector>
+
+/**
+ * @brief Faixas da saída da rede de controle (índices de CONTROL_BAND_BOUNDS)
+ */
+enum ControlBand {
+    BandRight = 0,      // 0.50 - 0.56: virar à direita
+    BandLeft,           // 0.56 - 0.62: virar à esquerda
+    BandForward,        // 0.62 - 0.68: seguir em frente
+    BandBackward,       // 0.68 - 0.74: mover para trás
+    BandStop,           // 0.74 - 0.80: parar
+    BandCount
+};
+
+// Limites das faixas: a faixa b vai de [b] (inclusive) a [b + 1] (exclusive);
+// os mesmos de NeuralCollisionAvoidance::ACTION_*
+const double CONTROL_BAND_BOUNDS[BandCount + 1] = {0.50, 0.56, 0.62, 0.68, 0.74, 0.80};
+
+/**
+ * @brief Entrada da rede de controle a partir dos 8 sonares
+ *
+ * Quatro direções (direita, esquerda, frente, trás), cada uma 1 = livre
+ * quando o maior sonar da direção passa de nearThreshold. Não há sonar
+ * traseiro: trás é sempre livre.
+ */
+std::vector<double> encodeSonarInput(const int* sonar, double nearThreshold);
+
+/**
+ * @brief Faixa da saída da rede, ou -1 fora de [0.50, 0.80)
+ */
+int outputBand(double networkOutput);
+
+/**
+ * @brief Faixa correspondente a um comando emitido, ou -1 para Hold
+ */
+int commandBand(const MotionCommand& command);
+
+/**
+ * @brief Faixa a ensinar quando a zona de segurança substituiu a ação da rede
+ *
+ * Só vira amostra o desvio forçado que a própria entrada explica: frente
+ * bloqueada na entrada (input[2] == 0) e o lado do desvio determinado pelos
+ * bits de direita/esquerda (só esquerda livre -> esquerda, só direita livre
+ * -> direita, ambos bloqueados -> trás). A parada de emergência depende da
+ * distância exata, que os 4 bits não carregam, e com os dois lados livres
+ * o lado depende de qual tem mais espaço: nenhum dos dois é rotulado.
+ * @param input Entrada normalizada que a rede recebeu (encodeSonarInput)
+ * @param networkOutput Saída da rede no ciclo
+ * @param command Comando efetivamente emitido
+ * @return Faixa do rótulo, ou -1 se a amostra não deve ser gravada
+ */
+int overrideLabelBand(const std::vector<double>& input, double networkOutput,
+                      const MotionCommand& command);
+
+#endif // CONTROLENCODING_H
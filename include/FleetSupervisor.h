@@ -0,0 +1,169 @@
+#ifndef FLEETSUPERVISOR_H
+#define FLEETSUPERVISOR_H
+
+#include "BehaviorArbiter.h"
+#include "LatencyTracer.h"
+#include "PeriodicScheduler.h"
+#include "RobotInterface.h"
+#include "WorkerPool.h"
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Configuração da frota
+ *
+ * rateHz é a frequência de controle de cada robô. workers é o tamanho do
+ * pool que executa os ciclos (0 = núcleos da máquina); priority e cpu
+ * valem para a thread despachante, como em TaskConfig.
+ */
+struct FleetConfig {
+    double rateHz;
+    int workers;
+    int priority;
+    int cpu;
+
+    FleetConfig(double rate = 10.0, int threads = 0, int prio = 0, int core = -1)
+        : rateHz(rate), workers(threads), priority(prio), cpu(core) {}
+};
+
+/**
+ * @brief Um robô da frota com seu próprio pipeline de comportamentos
+ *
+ * Mesmo ciclo do BehaviorController (snapshot -> árbitro -> comando), mas
+ * sem thread própria: o FleetSupervisor agenda runCycle() no pool. Os
+ * comportamentos guardam estado por robô, então cada membro tem as suas
+ * instâncias; o que pode ser compartilhado são dados imutáveis, como os
+ * pesos da rede (NeuralCollisionAvoidance::shareNetwork).
+ */
+class FleetMember {
+public:
+    FleetMember(const std::string& name, RobotInterface& robot,
+                ArbitrationMode mode = ArbitrationMode::Subsumption);
+
+    FleetMember(const FleetMember&) = delete;
+    FleetMember& operator=(const FleetMember&) = delete;
+
+    /**
+     * @brief Registra um comportamento que pertence a este membro
+     */
+    void addBehavior(std::unique_ptr<Behavior> behavior, int priority, double weight = 1.0);
+
+    /**
+     * @brief Registra um comportamento mantido por quem chama
+     */
+    void addBehavior(Behavior& behavior, int priority, double weight = 1.0);
+
+    /**
+     * @brief Um ciclo de controle (nunca em paralelo consigo mesmo)
+     */
+    void runCycle();
+
+    const std::string& getName() const { return name; }
+    RobotInterface& getRobot() { return robot; }
+    const BehaviorArbiter& getArbiter() const { return arbiter; }
+    const LatencyTracer& getLatency() const { return latency; }
+    uint64_t getCycles() const { return cycles.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Períodos pulados porque o ciclo anterior ainda não terminou
+     */
+    uint64_t getSkipped() const { return skipped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Ciclos interrompidos por exceção (o robô segue sendo despachado)
+     */
+    uint64_t getFailures() const { return failures.load(std::memory_order_relaxed); }
+
+private:
+    friend class FleetSupervisor;
+
+    std::string name;
+    RobotInterface& robot;
+    BehaviorArbiter arbiter;
+    std::vector<std::unique_ptr<Behavior>> owned;
+    SensorSnapshot snapshot;
+    LatencyTracer latency;
+    std::atomic<bool> busy;
+    std::atomic<uint64_t> cycles;
+    std::atomic<uint64_t> skipped;
+    std::atomic<uint64_t> failures;
+};
+
+/**
+ * @brief Supervisor de vários robôs num único processo
+ *
+ * Em vez de uma thread por robô e por comportamento, uma tarefa periódica
+ * (PeriodicScheduler) despacha a cada período um ciclo de cada robô para
+ * um WorkerPool de tamanho fixo: N robôs usam workers + 1 threads. Um robô
+ * cujo ciclo anterior ainda está na fila ou rodando não recebe outro (o
+ * período é contado em getSkipped()), então um robô lento não acumula
+ * trabalho nem atrasa os outros além do que ocupa do pool.
+ *
+ * @code
+ *   FleetSupervisor fleet(FleetConfig(10.0, 2));
+ *   FleetMember& r1 = fleet.addRobot("robo1", pioneer1);
+ *   r1.addBehavior(std::unique_ptr<Behavior>(new CollisionAvoidanceBehavior()), 10);
+ *   fleet.start();
+ *   ...
+ *   fleet.stop();
+ *   fleet.printStatistics(std::cout);
+ * @endcode
+ */
+class FleetSupervisor {
+public:
+    explicit FleetSupervisor(const FleetConfig& config = FleetConfig());
+
+    /**
+     * @brief Para o despacho e aguarda os ciclos em andamento
+     */
+    ~FleetSupervisor();
+
+    FleetSupervisor(const FleetSupervisor&) = delete;
+    FleetSupervisor& operator=(const FleetSupervisor&) = delete;
+
+    /**
+     * @brief Adiciona um robô (somente antes de start)
+     * @throws std::logic_error se a frota já estiver rodando
+     */
+    FleetMember& addRobot(const std::string& name, RobotInterface& robot,
+                          ArbitrationMode mode = ArbitrationMode::Subsumption);
+
+    void start();
+
+    /**
+     * @brief Para o despacho e aguarda os ciclos já enviados ao pool
+     */
+    void stop();
+
+    bool isRunning() const { return scheduler.isRunning(); }
+
+    size_t getRobotCount() const { return members.size(); }
+    FleetMember& getRobot(size_t index) { return *members[index]; }
+    const FleetMember& getRobot(size_t index) const { return *members[index]; }
+
+    /**
+     * @brief Threads usadas pela frota (pool + despachante)
+     */
+    size_t getThreadCount() const { return pool.getThreadCount() + 1; }
+
+    const PeriodicTimer& getDispatchTimer() const { return scheduler.getTimer(0); }
+
+    /**
+     * @brief Imprime ciclos, períodos pulados e latência do ciclo por robô
+     */
+    void printStatistics(std::ostream& out) const;
+
+private:
+    FleetConfig config;
+    std::vector<std::unique_ptr<FleetMember>> members;
+    WorkerPool pool;
+    PeriodicScheduler scheduler;
+
+    void dispatch();
+};
+
+#endif // FLEETSUPERVISOR_H
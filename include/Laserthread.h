@@ -13,6 +13,7 @@ public:
 public:
     LaserThread(PioneerRobot *_robo);
     void *runThread(void *);
+    void runCycle();
     void waitOnCondition();
     void lockMutex();
     void unlockMutex();
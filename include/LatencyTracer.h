@@ -0,0 +1,215 @@
+#ifndef LATENCYTRACER_H
+#define LATENCYTRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+
+/**
+ * @brief Etapas medidas em cada ciclo de um laço de controle
+ *
+ * As quatro primeiras são durações entre tracepoints consecutivos.
+ * SensorToCommand é a latência de ponta a ponta desde o início do ciclo
+ * (leitura dos sonares) até o primeiro comando de motor emitido.
+ * Cycle é a duração total do ciclo (sem o sleep do laço).
+ */
+enum class TraceStage : int {
+    SensorRead = 0,     // Cópia das leituras dos sonares
+    Normalize,          // normalizeSensorData
+    Predict,            // Inferência da rede neural
+    Action,             // Lógica de decisão + emissão do comando
+    SensorToCommand,    // Início do ciclo -> comando de motor
+    Cycle,              // Ciclo completo
+    Count
+};
+
+/**
+ * @brief Histograma de latência log-linear, lock-free, de escritor único
+ *
+ * Buckets com 16 subdivisões por potência de 2 (erro relativo <= 6.25%),
+ * cobrindo de 1 ns a ~36 minutos. Apenas a thread dona grava (load + store
+ * relaxados, sem instruções com lock); qualquer thread pode ler para gerar
+ * relatórios a qualquer momento.
+ */
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 4;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const int MAX_EXPONENT = 41;
+    static const int BUCKETS = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+    LatencyHistogram();
+
+    /**
+     * @brief Registra uma amostra (somente a thread dona)
+     * @param ns Latência em nanossegundos
+     */
+    void record(uint64_t ns) {
+        int index = bucketIndex(ns);
+        counts[index].store(counts[index].load(std::memory_order_relaxed) + 1,
+                            std::memory_order_relaxed);
+        sum.store(sum.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+        if (ns > max.load(std::memory_order_relaxed)) {
+            max.store(ns, std::memory_order_relaxed);
+        }
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    uint64_t getCount() const { return count.load(std::memory_order_acquire); }
+    uint64_t getMax() const { return max.load(std::memory_order_relaxed); }
+    double getMean() const;
+
+    /**
+     * @brief Percentil aproximado (limite superior do bucket)
+     * @param p Percentil entre 0 e 100
+     */
+    uint64_t percentile(double p) const;
+
+    /**
+     * @brief Copia as contagens de outro histograma (pode estar sendo gravado)
+     */
+    void copyFrom(const LatencyHistogram& other);
+
+    static int bucketIndex(uint64_t ns);
+    static uint64_t bucketUpperBound(int index);
+
+private:
+    std::atomic<uint64_t> counts[BUCKETS];
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> sum;
+    std::atomic<uint64_t> max;
+};
+
+/**
+ * @brief Formata uma duração em ns, us ou ms (uma casa decimal)
+ */
+std::string formatLatency(uint64_t ns);
+
+/**
+ * @brief Tracepoints de latência de um laço de controle
+ *
+ * Cada thread de controle possui seu próprio LatencyTracer, com um
+ * histograma por TraceStage. O caminho quente não usa mutex: marcar um
+ * tracepoint é uma leitura do relógio monotônico e algumas operações
+ * atômicas relaxadas. Os tracers se registram numa lista global para que
+ * printAll() possa emitir o relatório de todas as threads (sob demanda,
+ * via requestDump()/SIGUSR1, ou no encerramento).
+ *
+ * Uso típico:
+ * @code
+ *   latency.attachToCurrentThread();
+ *   while (running) {
+ *       latency.beginCycle();
+ *       robo->getAllSonar(sonar);
+ *       latency.tracepoint(TraceStage::SensorRead);
+ *       ...                                   // PioneerRobot::Move chama
+ *       latency.tracepoint(TraceStage::Action); // LatencyTracer::commandIssued()
+ *       latency.endCycle();
+ *   }
+ * @endcode
+ */
+class LatencyTracer {
+public:
+    /**
+     * @brief Cria e registra um tracer
+     * @param name Nome exibido no relatório (ex.: nome da thread)
+     */
+    explicit LatencyTracer(const std::string& name);
+    ~LatencyTracer();
+
+    LatencyTracer(const LatencyTracer&) = delete;
+    LatencyTracer& operator=(const LatencyTracer&) = delete;
+
+    /**
+     * @brief Torna este o tracer da thread atual (usado por commandIssued)
+     */
+    void attachToCurrentThread();
+
+    /**
+     * @brief Marca o início de um ciclo (antes da leitura dos sensores)
+     */
+    void beginCycle() {
+        cycleStart = lastMark = now();
+        commandSeen = false;
+    }
+
+    /**
+     * @brief Registra a duração desde o tracepoint anterior na etapa indicada
+     */
+    void tracepoint(TraceStage stage) {
+        uint64_t t = now();
+        histograms[static_cast<int>(stage)].record(t - lastMark);
+        lastMark = t;
+    }
+
+    /**
+     * @brief Encerra o ciclo, registrando sua duração total
+     *
+     * Se um dump foi solicitado (requestDump), os histogramas de todos os
+     * tracers são copiados aqui, fora da janela medida, e o relatório é
+     * formatado e impresso por uma thread de fundo.
+     */
+    void endCycle();
+
+    /**
+     * @brief Registra a latência sensor -> comando no tracer da thread atual
+     *
+     * Chamado pelos métodos de comando de PioneerRobot. Apenas o primeiro
+     * comando de cada ciclo é contado; sem tracer anexado, não faz nada.
+     */
+    static void commandIssued();
+
+    const LatencyHistogram& getHistogram(TraceStage stage) const {
+        return histograms[static_cast<int>(stage)];
+    }
+
+    const std::string& getName() const { return name; }
+
+    /**
+     * @brief Imprime p50/p99/máx de cada etapa com amostras
+     */
+    void print(std::ostream& out) const;
+
+    /**
+     * @brief Imprime o relatório de todos os tracers registrados
+     */
+    static void printAll(std::ostream& out);
+
+    /**
+     * @brief Solicita um dump no próximo endCycle (async-signal-safe)
+     *
+     * O relatório sai em std::cout, escrito pela thread de fundo.
+     */
+    static void requestDump();
+
+    /**
+     * @brief Visita todos os tracers registrados (com o mutex do registro)
+     */
+    static void forEach(const std::function<void(const LatencyTracer&)>& visit);
+
+    static const char* stageName(TraceStage stage);
+
+    /**
+     * @brief Identificador ASCII da etapa (ex.: "sensor_read"), para exportação
+     */
+    static const char* stageId(TraceStage stage);
+
+private:
+    std::string name;
+    LatencyHistogram histograms[static_cast<int>(TraceStage::Count)];
+
+    // Estado do ciclo corrente (acessado apenas pela thread dona)
+    uint64_t cycleStart;
+    uint64_t lastMark;
+    bool commandSeen;
+
+    static uint64_t now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+};
+
+#endif // LATENCYTRACER_H
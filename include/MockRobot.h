@@ -0,0 +1,103 @@
+#ifndef MOCKROBOT_H
+#define MOCKROBOT_H
+
+#include "RobotInterface.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Segmento de parede do mundo simulado (mm)
+ */
+struct WallSegment {
+    double x0, y0, x1, y1;
+
+    WallSegment(double ax, double ay, double bx, double by) : x0(ax), y0(ay), x1(bx), y1(by) {}
+};
+
+/**
+ * @brief Mundo estático compartilhado pelos MockRobot (somente leitura)
+ *
+ * Os robôs não enxergam uns aos outros: cada um só colide com as paredes.
+ */
+class MockWorld {
+public:
+    void addWall(double x0, double y0, double x1, double y1);
+
+    /**
+     * @brief Quatro paredes de um retângulo
+     */
+    void addRoom(double minX, double minY, double maxX, double maxY);
+
+    /**
+     * @brief Distância até a primeira parede ao longo do raio, ou maxRange
+     * @param angle Direção do raio (graus, referencial do mundo)
+     */
+    double raycast(double x, double y, double angle, double maxRange) const;
+
+    /**
+     * @brief Distância do ponto até a parede mais próxima
+     */
+    double clearance(double x, double y) const;
+
+    const std::vector<WallSegment>& getWalls() const { return walls; }
+
+private:
+    std::vector<WallSegment> walls;
+};
+
+/**
+ * @brief Pioneer simulado sem ARIA para testes e frotas grandes
+ *
+ * Cinemática diferencial integrada em passos fixos de dt a cada
+ * getSnapshot(), não pelo relógio: o resultado depende só da sequência de
+ * comandos, não da carga da máquina. Rotate gira até o alvo de orientação
+ * na velocidade angular máxima (como setDeltaHeading); os sonares são raios
+ * únicos na geometria do P3-DX contra as paredes do MockWorld. Um passo
+ * que encostaria o corpo numa parede é descartado, o robô para e a colisão
+ * é contada.
+ *
+ * Não é thread-safe entre getSnapshot/execute: basta que um único ciclo de
+ * controle por robô rode por vez (FleetSupervisor garante isso).
+ */
+class MockRobot : public RobotInterface, public MotionBackend {
+public:
+    static constexpr double RADIUS = 250.0;           // Raio do corpo (mm)
+    static constexpr double AXLE = 330.0;             // Distância entre rodas (mm)
+    static constexpr double MAX_ROT_VELOCITY = 60.0;  // Graus/s durante Rotate
+    static constexpr double SONAR_RANGE = 5000.0;     // LIMITELEITURA
+
+    /**
+     * @param dt Passo de integração por snapshot (s)
+     */
+    MockRobot(const MockWorld& world, const Pose2D& start, double dt = 0.05);
+
+    void getSnapshot(SensorSnapshot& snapshot) override;
+    void execute(const MotionCommand& command, MotionCallback onDone = MotionCallback()) override;
+
+    void apply(const MotionCommand& command) override;
+    bool isHeadingDone() override;
+
+    Pose2D getPose() const;
+    double getDistanceTravelled() const { return distance; }
+    uint64_t getSteps() const { return steps; }
+    uint64_t getCollisions() const { return collisions.load(std::memory_order_relaxed); }
+    const MotionQueue& getMotionQueue() const { return motion; }
+
+private:
+    const MockWorld& world;
+    MotionQueue motion;
+    double dt;
+    double x, y, theta;   // mm, mm, graus
+    double left, right;   // Velocidade das rodas (mm/s) fora de rotação
+    bool rotating;
+    double headingTarget;
+    double rotationSpeed; // Velocidade linear durante a rotação (mm/s, com sinal)
+    double distance;
+    uint64_t steps;
+    std::atomic<uint64_t> collisions;
+
+    void step();
+};
+
+#endif // MOCKROBOT_H
@@ -0,0 +1,88 @@
+#ifndef MOTIONCOMMAND_H
+#define MOTIONCOMMAND_H
+
+#include "navigation/Pose2D.h"
+#include <cstddef>
+#include <cstdint>
+
+class OccupancyGrid;
+
+/**
+ * @brief Leituras dos sensores de um ciclo, lidas uma única vez
+ *
+ * Todos os comportamentos de um ciclo decidem sobre a mesma cópia, em vez
+ * de cada thread consultar o robô por conta própria.
+ * Índices do sonar: 0=direita, 1-2=diagonal direita, 3-4=frente,
+ * 5-6=diagonal esquerda, 7=esquerda (mm).
+ * laser aponta para os pontos da última varredura (válidos até a próxima
+ * leitura). map aponta para o mapa de ocupação já atualizado com esta
+ * leitura, ou é nulo quando o robô não mantém mapa.
+ */
+struct SensorSnapshot {
+    int sonar[8];
+    bool headingDone;     // Rotação anterior (setDeltaHeading) concluída
+    bool moveDone;        // Deslocamento anterior concluído
+    uint64_t timestampNs;
+    Pose2D pose;          // Odometria no momento da leitura
+    double velocity;      // Velocidade linear atual (mm/s)
+    double rotVelocity;   // Velocidade angular atual (graus/s)
+    const ScanPoint* laser;   // Pontos do laser no mundo (nulo sem laser)
+    size_t laserCount;
+    const OccupancyGrid* map;
+
+    SensorSnapshot()
+        : headingDone(true), moveDone(true), timestampNs(0), velocity(0.0), rotVelocity(0.0),
+          laser(nullptr), laserCount(0), map(nullptr) {
+        for (int i = 0; i < 8; ++i) {
+            sonar[i] = 0;
+        }
+    }
+};
+
+/**
+ * @brief Comando de movimento, independente da ARIA
+ *
+ * Espelha os métodos de PioneerRobot: Move(vl, vr), Rotaciona(graus,
+ * sentido, velocidade) e pararMovimento(). Hold significa "manter o
+ * comando atual" (ex.: aguardando uma rotação terminar) e não gera
+ * nenhuma chamada ao robô.
+ */
+struct MotionCommand {
+    enum Kind : uint8_t { Hold, Move, Rotate, Stop };
+
+    Kind kind;
+    double left;        // Move: velocidade da roda esquerda (mm/s)
+    double right;       // Move: velocidade da roda direita (mm/s)
+    double degrees;     // Rotate: variação de orientação
+    int direction;      // Rotate: sentido (0 = parado, 1 = frente, 2 = ré)
+    int speed;          // Rotate: velocidade linear durante a rotação
+
+    MotionCommand() : kind(Hold), left(0), right(0), degrees(0), direction(0), speed(0) {}
+
+    static MotionCommand hold() { return MotionCommand(); }
+
+    static MotionCommand move(double vl, double vr) {
+        MotionCommand command;
+        command.kind = Move;
+        command.left = vl;
+        command.right = vr;
+        return command;
+    }
+
+    static MotionCommand rotate(double deg, int sentido, int velocidade) {
+        MotionCommand command;
+        command.kind = Rotate;
+        command.degrees = deg;
+        command.direction = sentido;
+        command.speed = velocidade;
+        return command;
+    }
+
+    static MotionCommand stop() {
+        MotionCommand command;
+        command.kind = Stop;
+        return command;
+    }
+};
+
+#endif // MOTIONCOMMAND_H
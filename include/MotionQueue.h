@@ -0,0 +1,120 @@
+#ifndef MOTIONQUEUE_H
+#define MOTIONQUEUE_H
+
+#include "MotionCommand.h"
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Resultado de um comando enviado à MotionQueue
+ */
+enum class MotionStatus {
+    Completed,   // Executado (Move/Stop: aplicado; Rotate: orientação atingida)
+    Preempted,   // Interrompido por uma rotação diferente ou por Stop
+    Superseded   // Substituído por um comando mais novo antes de ser aplicado
+};
+
+typedef std::function<void(MotionStatus)> MotionCallback;
+
+/**
+ * @brief Destino dos comandos (robô real ou simulado, mock nos testes)
+ */
+class MotionBackend {
+public:
+    virtual ~MotionBackend() = default;
+
+    /**
+     * @brief Aplica o comando imediatamente (não bloqueia)
+     */
+    virtual void apply(const MotionCommand& command) = 0;
+
+    /**
+     * @brief A última rotação (setDeltaHeading) terminou?
+     */
+    virtual bool isHeadingDone() = 0;
+};
+
+/**
+ * @brief Fila de comandos de movimento com coalescência e preempção
+ *
+ * Os controladores chamam submit() a cada ciclo, sem esperar o fim de uma
+ * rotação; a fila decide o que chega ao robô:
+ * - Rotate igual ao que está em curso: coalescido (não reinicia o giro)
+ * - Rotate diferente: preempta a rotação em curso (novo alvo de orientação)
+ * - Move durante uma rotação: fica pendente; um Move mais novo substitui o
+ *   pendente. Sem rotação em curso, é aplicado na hora
+ * - Stop: aplicado na hora, descarta a rotação e o Move pendente
+ *
+ * update() deve ser chamado periodicamente (a cada ciclo de controle): ele
+ * detecta o fim da rotação, aplica o Move pendente e dispara os callbacks
+ * de conclusão — no lugar do polling de isHeadingDone() nos controladores.
+ * Callbacks são chamados fora do mutex interno, na thread de submit/update.
+ */
+class MotionQueue {
+public:
+    explicit MotionQueue(MotionBackend& backend);
+
+    MotionQueue(const MotionQueue&) = delete;
+    MotionQueue& operator=(const MotionQueue&) = delete;
+
+    /**
+     * @brief Envia um comando (não bloqueia)
+     * @param onDone Chamado uma única vez com o resultado do comando
+     */
+    void submit(const MotionCommand& command, MotionCallback onDone = MotionCallback());
+
+    /**
+     * @brief Verifica a conclusão da rotação e libera o comando pendente
+     */
+    void update();
+
+    bool isRotating() const;
+    bool hasPending() const;
+
+    uint64_t getSubmitted() const { return submitted; }
+    uint64_t getIssued() const { return issued; }
+    uint64_t getCoalesced() const { return coalesced; }
+    uint64_t getPreempted() const { return preempted; }
+
+    /**
+     * @brief Imprime comandos recebidos, enviados ao robô, coalescidos e preemptados
+     */
+    void printStatistics(std::ostream& out) const;
+
+    /**
+     * @brief Dois Rotate com mesmo ângulo, sentido e velocidade
+     */
+    static bool sameRotation(const MotionCommand& a, const MotionCommand& b);
+
+private:
+    typedef std::vector<std::pair<MotionCallback, MotionStatus>> Notifications;
+
+    struct Slot {
+        bool occupied;
+        MotionCommand command;
+        std::vector<MotionCallback> callbacks;
+
+        Slot() : occupied(false) {}
+    };
+
+    MotionBackend& backend;
+    mutable std::mutex mutex;
+    Slot rotation;         // Rotação em curso
+    Slot pendingMove;      // Move aguardando o fim da rotação
+    Notifications ready;   // Reutilizado entre chamadas (sob o mutex)
+
+    uint64_t submitted;
+    uint64_t issued;
+    uint64_t coalesced;
+    uint64_t preempted;
+
+    void release(Slot& slot, MotionStatus status, Notifications& out);
+    void issue(const MotionCommand& command);
+    void notify(Notifications& pending);
+};
+
+#endif // MOTIONQUEUE_H
@@ -4,6 +4,13 @@
 #include "Aria.h"
 #include "ClassRobo.h"
 #include "neuralnetwork/NeuralNetwork.h"
+#include "neuralnetwork/FixedNetwork.h"
+#include "neuralnetwork/InferenceServer.h"
+#include "neuralnetwork/ModelHandle.h"
+#include "neuralnetwork/OnlineLearner.h"
+#include "LatencyTracer.h"
+#include "Telemetry.h"
+#include "BehaviorArbiter.h"
 #include <memory>
 #include <string>
 
@@ -25,19 +32,53 @@
  * - 0.62 - 0.68: Seguir em FRENTE
  * - 0.68 - 0.74: Mover para TRÁS
  * - 0.74 - 0.80: PARAR
+ * 
+ * Também é um Behavior: pode rodar sozinho (runThread/runCycle) ou compor
+ * com outros comportamentos num BehaviorArbiter (propose).
  */
-class NeuralCollisionAvoidance : public ArASyncTask {
+class NeuralCollisionAvoidance : public ArASyncTask, public Behavior {
+public:
+    typedef FixedNetwork<4, 5, 1> ControlNetwork;
+
 private:
     PioneerRobot* robo;
     std::unique_ptr<NeuralNetwork> network;
     
+    // Cópia 4→5→1 de tamanho fixo usada no laço de controle (sem alocação).
+    // Atualizada a partir de network sempre que os pesos mudam.
+    ControlNetwork controlNetwork;
+    
+    // Pesos somente leitura compartilhados com outras instâncias (frota),
+    // publicados pelo aprendizado online ou recarregados do arquivo; quando
+    // presentes, substituem controlNetwork nas predições. O laço de controle
+    // lê por modelReader sem bloquear; a troca é uma publicação RCU.
+    ModelHandle<ControlNetwork> model;
+    ModelHandle<ControlNetwork>::Reader modelReader;
+    
+    // Servidor de inferência em lote (frota); nulo = predição local
+    InferenceServer<ControlNetwork>* inferenceServer;
+    
+    // Tracepoints do laço de decisão (sensor -> normalização -> predição -> ação)
+    LatencyTracer latency;
+    
+    // Métricas do processo (Telemetry), somadas entre todas as instâncias
+    struct DecisionTelemetry {
+        TelemetryCounter& right;
+        TelemetryCounter& left;
+        TelemetryCounter& forward;
+        TelemetryCounter& backward;
+        TelemetryCounter& stop;
+        TelemetryHistogram& output;
+    };
+    DecisionTelemetry telemetry;
+    
     ArCondition myCondition;
     ArMutex myMutex;
     
     // Dados dos sensores sonar do robô Pioneer
     // O Pioneer possui 8 sensores sonar distribuídos ao redor do chassis
     // Índices: 0=direita, 1-2=diagonal direita, 3-4=frente, 5-6=diagonal esquerda, 7=esquerda
-    int sonar[8];
+    SensorSnapshot snapshot;
     
     // ===== SISTEMA DE 3 ZONAS DE SEGURANÇA =====
     // Este foi o grande diferencial implementado para evitar colisões
@@ -101,6 +142,9 @@ private:
     // 30° era insuficiente para desviar efetivamente
     // 45° permite contornar obstáculos com mais facilidade
     
+    static constexpr double MAP_LOOKAHEAD = 3000.0;
+    // Alcance consultado no mapa de ocupação ao escolher o lado do desvio (mm)
+    
     // ===== ESTATÍSTICAS E MONITORAMENTO =====
     // Para análise de comportamento e apresentação dos resultados
     // Permitem verificar se o robô está tomando decisões balanceadas
@@ -110,6 +154,11 @@ private:
     int forwardDecisions;
     int backwardDecisions;
     int stopDecisions;
+    
+    // Aprendizado online a partir das correções de segurança (nulo = desligado).
+    // Declarado por último: a thread do aprendiz para antes dos demais membros.
+    std::vector<double> overrideTarget;
+    std::unique_ptr<OnlineLearner> learner;
 
 public:
     /**
@@ -143,13 +192,30 @@ public:
      * 2. Normaliza dados (agrupa em 4 direções)
      * 3. Passa pela rede neural (decisão)
      * 4. Executa ação no robô
-     * 5. Loop a cada 100ms
+     * 5. Repete em FREQUENCIA_DECISAO (prazos absolutos, PeriodicTimer)
      * 
      * Roda em thread separada para não bloquear outras operações
      */
-     */
     void* runThread(void*) override;
     
+    /**
+     * @brief Um único ciclo de decisão (sensores -> rede -> ação)
+     * 
+     * Usado por runThread e pelo PeriodicScheduler (main_neural), que
+     * controla a frequência, a prioridade e a afinidade da thread.
+     */
+    void runCycle();
+    
+    /**
+     * @brief Proposta da rede para um snapshot (uso com BehaviorArbiter)
+     * 
+     * Mesma decisão de runCycle, mas sem emitir o comando: quem emite é o
+     * árbitro. As estatísticas contam as propostas feitas.
+     */
+    Proposal propose(const SensorSnapshot& current) override;
+    
+    const char* getName() const override { return "NeuralCollisionAvoidance"; }
+    
     /**
      * @brief Aguarda condição
      */
@@ -173,7 +239,73 @@ public:
     bool saveNetworkWeights(const std::string& filename);
     
     /**
-     * @brief Exibe estatísticas de decisões tomadas
+     * @brief Cópia imutável dos pesos atuais, para compartilhar entre robôs
+     * 
+     * Carregue ou treine uma vez (initializeNetwork) e passe o resultado a
+     * shareNetwork() das instâncias dos outros robôs: predict() é const, então
+     * todos leem os mesmos pesos sem cópia nem mutex.
+     */
+    std::shared_ptr<const ControlNetwork> exportNetwork() const;
+    
+    /**
+     * @brief Usa pesos compartilhados no lugar dos próprios (nullptr volta aos próprios)
+     * 
+     * Pode ser chamado de outra thread com o controle rodando: a troca é
+     * atômica, o ciclo seguinte já usa os novos pesos e o ciclo em andamento
+     * termina com os antigos (liberados depois, ver ModelHandle).
+     */
+    void shareNetwork(std::shared_ptr<const ControlNetwork> weights);
+    
+    /**
+     * @brief Carrega pesos de um arquivo e os publica sem parar o controle
+     * @param weightsFile Arquivo JSON ou binário com a arquitetura 4→5→1
+     * @return false se o arquivo não existir ou for incompatível (os pesos em uso continuam)
+     * 
+     * A leitura e a conversão acontecem na thread de quem chama (nunca no
+     * laço de controle), que só vê a troca de ponteiro no ciclo seguinte.
+     * Com aprendizado online ligado, o aprendiz passa a ajustar a rede
+     * recarregada. Os pesos de network (saveNetworkWeights) não mudam.
+     */
+    bool reloadNetwork(const std::string& weightsFile);
+    
+    /**
+     * @brief Versões de pesos publicadas (shareNetwork, aprendizado online, recarga)
+     */
+    uint64_t getModelVersion() const { return model.getVersion(); }
+    
+    /**
+     * @brief Libera as versões de pesos substituídas que o controle já largou
+     * @return Versões ainda pendentes
+     */
+    std::size_t collectRetiredNetworks() { return model.collect(); }
+    
+    /**
+     * @brief Liga o aprendizado online a partir das correções de segurança
+     * @return false se a rede ainda não foi inicializada
+     * 
+     * Cada vez que uma zona de segurança (parada de emergência, desvio
+     * forçado, frente bloqueada) substitui a ação da rede, a entrada e a
+     * ação executada viram uma amostra rotulada do OnlineLearner. A thread
+     * de fundo ajusta uma cópia da rede e, se a validação melhorar, publica
+     * os novos pesos com shareNetwork, sem parar o controle.
+     */
+    bool enableOnlineLearning(const OnlineLearningConfig& config = OnlineLearningConfig());
+    
+    /**
+     * @brief Aprendiz em uso (nullptr se o aprendizado online estiver desligado)
+     */
+    OnlineLearner* getOnlineLearner() const { return learner.get(); }
+    
+    /**
+     * @brief Envia as predições a um servidor de lote (nullptr volta à predição local)
+     * 
+     * O servidor deve viver mais que esta instância. Cada decisão espera o
+     * resultado do lote, até InferenceConfig::maxDelayUs.
+     */
+    void useInferenceServer(InferenceServer<ControlNetwork>* server);
+    
+    /**
+     * @brief Exibe estatísticas de decisões tomadas e a latência do laço
      */
     void printStatistics() const;
 
@@ -188,8 +320,57 @@ private:
     /**
      * @brief Interpreta a saída da rede e executa a ação correspondente
      * @param networkOutput Saída da rede neural
+     * @return Comando emitido
+     */
+    MotionCommand executeAction(double networkOutput);
+    
+    /**
+     * @brief Escolhe o comando para a saída da rede (zonas de segurança incluídas)
+     * @param actionName Recebe o nome da ação, ou nullptr nas zonas de alerta/perigo
+     */
+    MotionCommand chooseAction(double networkOutput, const SensorSnapshot& current,
+                               const char*& actionName);
+    
+    /**
+     * @brief Espaço livre de cada lado para escolher o sentido do desvio
+     *
+     * Maior leitura dos sonares laterais (5-7 esquerda, 0-2 direita). Com
+     * mapa de ocupação, cada lado fica limitado pela distância livre no mapa
+     * nas mesmas direções: paredes já vistas continuam contando mesmo fora
+     * do cone atual, e o robô para de alternar de lado em becos sem saída.
+     */
+    void sideSpace(const SensorSnapshot& current, int& leftSpace, int& rightSpace) const;
+    
+    /**
+     * @brief Atualiza os contadores por tipo de ação e a distribuição da saída da rede
+     */
+    void recordDecision(double networkOutput, const MotionCommand& command);
+    
+    /**
+     * @brief Envia ao aprendiz a ação executada quando ela não é a da rede
+     *
+     * Só conta o desvio forçado que a entrada normalizada explica (ver
+     * overrideLabelBand). A parada de emergência e o comando padrão para
+     * saídas fora das faixas nunca viram amostra.
+     */
+    void learnFromOverride(const std::vector<double>& input, double networkOutput,
+                           const MotionCommand& command);
+    
+    /**
+     * @brief Saída da rede pelo servidor de lote, se houver, ou localmente
+     */
+    ControlNetwork::Output predictOutput(const ControlNetwork::Input& input) {
+        if (inferenceServer != nullptr) {
+            return inferenceServer->predict(input);
+        }
+        ModelHandle<ControlNetwork>::ReadGuard shared(modelReader);
+        return shared ? shared->predict(input) : controlNetwork.predict(input);
+    }
+    
+    /**
+     * @brief Rede 4→5→1 com sigmoid, ainda sem pesos treinados
      */
-    void executeAction(double networkOutput);
+    static std::unique_ptr<NeuralNetwork> createNetwork();
     
     /**
      * @brief Cria o dataset de treinamento
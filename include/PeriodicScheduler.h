@@ -0,0 +1,207 @@
+#ifndef PERIODICSCHEDULER_H
+#define PERIODICSCHEDULER_H
+
+#include "LatencyTracer.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Temporizador periódico com prazos absolutos
+ *
+ * Cada período começa num instante fixo da grade start + k * período
+ * (clock_nanosleep com TIMER_ABSTIME sobre CLOCK_MONOTONIC), de modo que o
+ * tempo gasto no trabalho não desloca os ciclos seguintes, ao contrário de
+ * um sleep relativo após o trabalho.
+ *
+ * Se o trabalho ultrapassar o prazo (overrun), os períodos perdidos são
+ * pulados e o laço volta à grade no próximo prazo futuro — não há rajada de
+ * ciclos atrasados para "compensar".
+ *
+ * Métricas (escritor único: a thread que chama waitNextPeriod):
+ * - jitter: atraso do despertar em relação ao prazo
+ * - execução: tempo entre o despertar e a chamada seguinte de waitNextPeriod
+ * - overruns e períodos perdidos
+ *
+ * @code
+ *   PeriodicTimer timer(10.0);   // 10 Hz
+ *   timer.start();
+ *   while (running) {
+ *       trabalho();
+ *       timer.waitNextPeriod();
+ *   }
+ * @endcode
+ */
+class PeriodicTimer {
+public:
+    /**
+     * @param rateHz Frequência desejada (> 0)
+     * @throws std::invalid_argument se rateHz <= 0
+     */
+    explicit PeriodicTimer(double rateHz);
+
+    /**
+     * @brief Inicia a grade de prazos a partir de agora
+     */
+    void start();
+
+    /**
+     * @brief Dorme até o próximo prazo da grade
+     * @return false se o ciclo que terminou estourou o período
+     */
+    bool waitNextPeriod();
+
+    uint64_t getPeriodNs() const { return periodNs; }
+    uint64_t getCycles() const { return cycles.load(std::memory_order_relaxed); }
+    uint64_t getOverruns() const { return overruns.load(std::memory_order_relaxed); }
+    uint64_t getMissedPeriods() const { return missedPeriods.load(std::memory_order_relaxed); }
+    const LatencyHistogram& getJitter() const { return jitter; }
+    const LatencyHistogram& getExecution() const { return execution; }
+
+    /**
+     * @brief Frequência efetivamente obtida desde start()
+     */
+    double getAchievedRateHz() const;
+
+    /**
+     * @brief Relógio monotônico em nanossegundos (mesma base dos prazos)
+     */
+    static uint64_t nowNs();
+
+    /**
+     * @brief Dorme até o instante absoluto deadlineNs (base de nowNs)
+     */
+    static void sleepUntil(uint64_t deadlineNs);
+
+private:
+    const uint64_t periodNs;
+    uint64_t nextDeadline;
+    uint64_t lastWake;
+
+    // Publicados para leitura por outras threads (relatórios)
+    std::atomic<uint64_t> startedAt;
+    std::atomic<uint64_t> lastWakeAt;
+    std::atomic<uint64_t> cycles;
+    std::atomic<uint64_t> overruns;
+    std::atomic<uint64_t> missedPeriods;
+    LatencyHistogram jitter;
+    LatencyHistogram execution;
+};
+
+/**
+ * @brief Configuração de uma tarefa periódica
+ *
+ * priority > 0 pede SCHED_FIFO com essa prioridade (1-99) e cpu >= 0 fixa a
+ * thread nesse núcleo. Ambos exigem permissão do sistema (CAP_SYS_NICE ou
+ * limites em /etc/security/limits.conf); se não forem concedidos, a tarefa
+ * roda com a política padrão e o motivo é informado em getRealtimeStatus().
+ */
+struct TaskConfig {
+    double rateHz;
+    int priority;
+    int cpu;
+
+    TaskConfig(double rate = 10.0, int prio = 0, int core = -1)
+        : rateHz(rate), priority(prio), cpu(core) {}
+};
+
+/**
+ * @brief Escalonador de tarefas de controle em taxa fixa
+ *
+ * Cada tarefa registrada roda em sua própria thread, com seu próprio
+ * PeriodicTimer, de modo que uma tarefa lenta (ex.: log, leitura de laser)
+ * não atrasa a frequência de decisão das outras. As métricas de cada tarefa
+ * podem ser lidas a qualquer momento e impressas com printStatistics().
+ *
+ * @code
+ *   PeriodicScheduler scheduler;
+ *   scheduler.addTask("Decisão", TaskConfig(10.0, 50, 1), [&] { controle.runCycle(); });
+ *   scheduler.addTask("Sonar", TaskConfig(1.0), [&] { sonar.runCycle(); });
+ *   scheduler.start();
+ *   ...
+ *   scheduler.stop();
+ *   scheduler.printStatistics(std::cout);
+ * @endcode
+ */
+class PeriodicScheduler {
+public:
+    PeriodicScheduler();
+
+    /**
+     * @brief Para e aguarda todas as tarefas
+     */
+    ~PeriodicScheduler();
+
+    PeriodicScheduler(const PeriodicScheduler&) = delete;
+    PeriodicScheduler& operator=(const PeriodicScheduler&) = delete;
+
+    /**
+     * @brief Registra uma tarefa (somente antes de start)
+     * @return Índice da tarefa
+     * @throws std::logic_error se o escalonador já estiver rodando
+     * @throws std::invalid_argument se a frequência for inválida
+     */
+    size_t addTask(const std::string& name, const TaskConfig& config, std::function<void()> body);
+
+    /**
+     * @brief Cria as threads e inicia todas as tarefas
+     */
+    void start();
+
+    /**
+     * @brief Sinaliza parada e aguarda o fim do ciclo corrente de cada tarefa
+     */
+    void stop();
+
+    bool isRunning() const { return running.load(std::memory_order_acquire); }
+
+    size_t getTaskCount() const { return tasks.size(); }
+    const std::string& getTaskName(size_t index) const { return tasks[index]->name; }
+    const PeriodicTimer& getTimer(size_t index) const { return tasks[index]->timer; }
+
+    /**
+     * @brief "SCHED_FIFO 50, CPU 1", "padrão" ou a falha ao aplicar
+     *
+     * Válido após o primeiro ciclo da tarefa.
+     */
+    std::string getRealtimeStatus(size_t index) const;
+
+    /**
+     * @brief Imprime frequência, overruns, jitter e tempo de execução de cada tarefa
+     */
+    void printStatistics(std::ostream& out) const;
+
+    /**
+     * @brief Aplica prioridade/afinidade à thread atual
+     * @param error Recebe a descrição da falha (se houver)
+     * @return true se tudo o que foi pedido foi aplicado
+     */
+    static bool applyRealtime(int priority, int cpu, std::string* error);
+
+private:
+    struct Task {
+        std::string name;
+        TaskConfig config;
+        std::function<void()> body;
+        PeriodicTimer timer;
+        std::string realtimeStatus;
+        std::atomic<bool> ready;
+        std::thread thread;
+
+        Task(const std::string& taskName, const TaskConfig& taskConfig, std::function<void()> taskBody)
+            : name(taskName), config(taskConfig), body(std::move(taskBody)),
+              timer(taskConfig.rateHz), ready(false) {}
+    };
+
+    std::vector<std::unique_ptr<Task>> tasks;
+    std::atomic<bool> running;
+
+    void runTask(Task& task);
+};
+
+#endif // PERIODICSCHEDULER_H
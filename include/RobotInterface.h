@@ -0,0 +1,30 @@
+#ifndef ROBOTINTERFACE_H
+#define ROBOTINTERFACE_H
+
+#include "MotionCommand.h"
+#include "MotionQueue.h"
+
+/**
+ * @brief O que um laço de controle precisa de um robô
+ *
+ * Uma leitura dos sensores por ciclo (SensorSnapshot) e um destino para o
+ * comando resultante. Implementado por PioneerRobot (robô real ou
+ * MobileSim, via ARIA) e por MockRobot (simulação cinemática, sem ARIA),
+ * para que o mesmo pipeline de comportamentos rode sobre qualquer um.
+ */
+class RobotInterface {
+public:
+    virtual ~RobotInterface() = default;
+
+    /**
+     * @brief Lê todos os sensores de uma vez e avança a fila de movimento
+     */
+    virtual void getSnapshot(SensorSnapshot& snapshot) = 0;
+
+    /**
+     * @brief Envia um comando (não bloqueia)
+     */
+    virtual void execute(const MotionCommand& command, MotionCallback onDone) = 0;
+};
+
+#endif // ROBOTINTERFACE_H
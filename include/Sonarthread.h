@@ -2,6 +2,7 @@
 #define SONARTHREAD_H
 #include "Aria.h"
 #include "ClassRobo.h"
+#include "LatencyTracer.h"
 
 class SonarThread : public ArASyncTask
 {
@@ -10,10 +11,12 @@ public:
     ArCondition myCondition;
     ArMutex myMutex;
     int sonar[8];
+    LatencyTracer latency;
 
 public:
     SonarThread(PioneerRobot *_robo);
     void *runThread(void *);
+    void runCycle();
     void waitOnCondition();
     void lockMutex();
     void unlockMutex();
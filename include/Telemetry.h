@@ -0,0 +1,177 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Contador monotônico (fetch_add relaxado, várias threads)
+ */
+class TelemetryCounter {
+public:
+    TelemetryCounter() : value(0) {}
+
+    void add(uint64_t amount = 1) { value.fetch_add(amount, std::memory_order_relaxed); }
+    uint64_t get() const { return value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> value;
+};
+
+/**
+ * @brief Valor instantâneo (último set vence)
+ */
+class TelemetryGauge {
+public:
+    TelemetryGauge() : value(0.0) {}
+
+    void set(double v) { value.store(v, std::memory_order_relaxed); }
+    double get() const { return value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> value;
+};
+
+/**
+ * @brief Distribuição de valores em buckets lineares entre min e max
+ *
+ * Valores fora do intervalo caem no primeiro ou no último bucket. Cada
+ * observação são dois fetch_add relaxados (bucket e soma em micro-unidades),
+ * sem mutex.
+ */
+class TelemetryHistogram {
+public:
+    TelemetryHistogram(double min, double max, int buckets);
+
+    void observe(double value);
+
+    int getBuckets() const { return static_cast<int>(counts.size()); }
+    double getUpperBound(int bucket) const { return min + width * (bucket + 1); }
+    uint64_t getBucketCount(int bucket) const { return counts[bucket].load(std::memory_order_relaxed); }
+    uint64_t getCount() const;
+    double getSum() const { return sumMicro.load(std::memory_order_relaxed) * 1e-6; }
+
+private:
+    double min;
+    double width;
+    std::vector<std::atomic<uint64_t>> counts;
+    std::atomic<int64_t> sumMicro;
+};
+
+/**
+ * @brief Registro de métricas do processo, exportado no formato texto do Prometheus
+ *
+ * Os laços de controle obtêm a métrica uma vez (counter/gauge/histogram,
+ * com mutex) e depois só a atualizam com operações atômicas relaxadas.
+ * Chamar de novo com o mesmo nome e rótulos devolve a mesma métrica, então
+ * várias instâncias (ex.: um NeuralCollisionAvoidance por robô da frota)
+ * somam no mesmo contador. render() também exporta os histogramas de todos
+ * os LatencyTracer registrados como summaries.
+ *
+ * @code
+ *   TelemetryCounter& decisions = Telemetry::instance().counter(
+ *       "robot_decisions_total", "Decisões por ação", "action=\"forward\"");
+ *   decisions.add();
+ * @endcode
+ */
+class Telemetry {
+public:
+    static Telemetry& instance();
+
+    Telemetry();
+    ~Telemetry();
+
+    Telemetry(const Telemetry&) = delete;
+    Telemetry& operator=(const Telemetry&) = delete;
+
+    /**
+     * @param name Nome Prometheus ([a-zA-Z_:][a-zA-Z0-9_:]*)
+     * @param labels Rótulos já formatados (ex.: action="left"), ou vazio
+     * @throws std::invalid_argument se o nome for inválido ou já usado com outro tipo
+     */
+    TelemetryCounter& counter(const std::string& name, const std::string& help,
+                              const std::string& labels = "");
+    TelemetryGauge& gauge(const std::string& name, const std::string& help,
+                          const std::string& labels = "");
+    TelemetryHistogram& histogram(const std::string& name, const std::string& help,
+                                  double min, double max, int buckets,
+                                  const std::string& labels = "");
+
+    /**
+     * @brief Escreve todas as métricas no formato de exposição texto 0.0.4
+     */
+    void render(std::ostream& out) const;
+
+    /**
+     * @brief Escapa um valor de rótulo (\\, " e quebra de linha)
+     */
+    static std::string escapeLabel(const std::string& value);
+
+private:
+    enum class Type { Counter, Gauge, Histogram };
+
+    struct Metric;
+    struct Family;
+
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<Family>> families;
+
+    Metric& find(const std::string& name, const std::string& help, Type type,
+                 const std::string& labels, double min, double max, int buckets);
+};
+
+/**
+ * @brief Expõe a Telemetry num socket Unix local
+ *
+ * Cada conexão recebe um retrato das métricas e é fechada. Quem envia uma
+ * requisição HTTP (curl --unix-socket) recebe a resposta com cabeçalho;
+ * quem só lê (socat - UNIX-CONNECT:caminho) recebe o texto puro depois de
+ * 50 ms sem requisição. A thread do servidor só toma o mutex do registro
+ * ao renderizar: os laços de controle nunca esperam por ela.
+ */
+class TelemetryServer {
+public:
+    explicit TelemetryServer(const std::string& socketPath, Telemetry& registry = Telemetry::instance());
+
+    /**
+     * @brief Para o servidor e remove o arquivo do socket
+     */
+    ~TelemetryServer();
+
+    TelemetryServer(const TelemetryServer&) = delete;
+    TelemetryServer& operator=(const TelemetryServer&) = delete;
+
+    /**
+     * @brief Cria o socket e inicia a thread
+     *
+     * Um socket antigo no caminho é substituído; outro tipo de arquivo é
+     * mantido e start() falha.
+     * @return false se não foi possível (motivo em getError)
+     */
+    bool start();
+    void stop();
+
+    const std::string& getPath() const { return path; }
+    const std::string& getError() const { return error; }
+    uint64_t getScrapes() const { return scrapes.load(std::memory_order_relaxed); }
+
+private:
+    std::string path;
+    Telemetry& telemetry;
+    std::string error;
+    int listenFd;
+    int wakeFd[2];   // Pipe para acordar o poll no stop()
+    std::thread thread;
+    std::atomic<uint64_t> scrapes;
+
+    void serve();
+    void respond(int client);
+};
+
+#endif // TELEMETRY_H
@@ -2,6 +2,8 @@
 #define WALLFOLLOWERTHREAD_H
 #include "Aria.h"
 #include "ClassRobo.h"
+#include "LatencyTracer.h"
+#include "Behaviors.h"
 
 class WallFollowerThread : public ArASyncTask
 {
@@ -9,12 +11,14 @@ public:
     PioneerRobot *robo;
     ArCondition myCondition;
     ArMutex myMutex;
-    int sonar[8];
-    int parede_direita = 0;
+    SensorSnapshot snapshot;
+    WallFollowerBehavior behavior;
+    LatencyTracer latency;
 
 public:
     WallFollowerThread(PioneerRobot *_robo);
     void *runThread(void *);
+    void runCycle();
     void waitOnCondition();
     void lockMutex();
     void unlockMutex();
@@ -0,0 +1,73 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Pool fixo de threads com fila FIFO de tarefas
+ *
+ * As threads são criadas no construtor e encerradas no destrutor (depois
+ * de esvaziar a fila). Tarefas não devem lançar exceções: uma exceção que
+ * escape é descartada e contada em getFailed().
+ *
+ * @code
+ *   WorkerPool pool(2);
+ *   pool.submit([&] { robo1.runCycle(); });
+ *   pool.submit([&] { robo2.runCycle(); });
+ *   pool.waitIdle();
+ * @endcode
+ */
+class WorkerPool {
+public:
+    /**
+     * @param threads Número de threads (0 = núcleos da máquina)
+     */
+    explicit WorkerPool(int threads = 0);
+
+    /**
+     * @brief Executa as tarefas pendentes e encerra as threads
+     */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * @brief Enfileira uma tarefa
+     * @return false se o pool já estiver encerrando
+     */
+    bool submit(std::function<void()> task);
+
+    /**
+     * @brief Bloqueia até a fila esvaziar e nenhuma tarefa estar rodando
+     */
+    void waitIdle();
+
+    size_t getThreadCount() const { return threads.size(); }
+    size_t getQueued() const;
+    uint64_t getExecuted() const { return executed.load(std::memory_order_relaxed); }
+    uint64_t getFailed() const { return failed.load(std::memory_order_relaxed); }
+
+private:
+    std::vector<std::thread> threads;
+    std::deque<std::function<void()>> queue;
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    size_t active;
+    bool stopping;
+    std::atomic<uint64_t> executed;
+    std::atomic<uint64_t> failed;
+
+    void workerLoop();
+};
+
+#endif // WORKERPOOL_H
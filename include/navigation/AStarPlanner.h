@@ -0,0 +1,68 @@
+#ifndef ASTARPLANNER_H
+#define ASTARPLANNER_H
+
+#include "PlanningMap.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Busca A* 8-conexa sobre um PlanningMap, com Jump Point Search
+ *
+ * Heurística octil (admissível e consistente para custos 1 e raiz de 2),
+ * fila de prioridade em heap binário com remoção preguiçosa e conjunto
+ * fechado como bitmap (1 bit por célula). Com jumpPoints (padrão) os
+ * sucessores são podados por JPS (Harabor & Grastien 2011, variante sem
+ * cortar quinas): em áreas abertas só os pontos de salto entram no heap,
+ * e o caminho continua ótimo. Os vetores são dimensionados no primeiro
+ * plan() de cada tamanho de mapa e reaproveitados: ao fim da busca só as
+ * células tocadas são restauradas.
+ *
+ * Para um mapa de 4000x4000 a memória é ~130 MB (g e pai, bitmap).
+ */
+class AStarPlanner {
+public:
+    explicit AStarPlanner(bool jumpPoints = true);
+
+    /**
+     * @brief Caminho de start a goal (inclusive), em células do mapa
+     * @return false se goal estiver bloqueado ou inalcançável
+     */
+    bool plan(const PlanningMap& map, const GridCell& start, const GridCell& goal,
+              std::vector<GridCell>& path);
+
+    size_t getExpanded() const { return expanded; }
+    float getPathCost() const { return pathCost; }
+
+    /**
+     * @brief Distância octil entre duas células
+     */
+    static float octile(int dx, int dy);
+
+private:
+    struct HeapNode {
+        float f;
+        float g;
+        uint32_t index;
+    };
+
+    bool jumpPoints;
+    std::vector<float> g;
+    std::vector<uint32_t> parent;     // Célula anterior (ou ponto de salto anterior)
+    std::vector<uint64_t> closed;     // Bitmap do conjunto fechado
+    std::vector<HeapNode> heap;
+    std::vector<uint32_t> touched;    // Células com g/pai/fechado alterados
+    size_t capacity;
+    size_t expanded;
+    float pathCost;
+
+    void prepare(size_t cells);
+    void reset();
+    void relax(uint32_t from, float fromG, int nx, int ny, int width, const GridCell& goal);
+    bool jump(const PlanningMap& map, int x, int y, int dx, int dy, const GridCell& goal,
+              int& jx, int& jy) const;
+    bool jumpStraight(const PlanningMap& map, int x, int y, int dx, int dy, const GridCell& goal,
+                      int& jx, int& jy) const;
+};
+
+#endif // ASTARPLANNER_H
@@ -0,0 +1,91 @@
+#ifndef DSTARLITE_H
+#define DSTARLITE_H
+
+#include "PlanningMap.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Replanejamento incremental (D* Lite, Koenig & Likhachev 2002)
+ *
+ * Busca do objetivo para o robô: quando o robô anda (moveStart) ou células
+ * mudam (updateCell), só os estados afetados são reexpandidos, em vez de
+ * refazer a busca inteira. Usa a versão otimizada com o acumulador km e
+ * heap binário com remoção preguiçosa (cada entrada guarda a chave com que
+ * foi inserida; entradas desatualizadas são descartadas ao sair).
+ *
+ * O mapa é mantido por referência e alterado apenas por updateCell. Não é
+ * thread-safe.
+ */
+class DStarLite {
+public:
+    explicit DStarLite(PlanningMap& map);
+
+    /**
+     * @brief Reinicia a busca para um novo par robô/objetivo
+     */
+    void initialize(const GridCell& start, const GridCell& goal);
+
+    /**
+     * @brief Atualiza a posição do robô (após andar pelo caminho)
+     */
+    void moveStart(const GridCell& start);
+
+    /**
+     * @brief Marca/desmarca um obstáculo e reabre os estados vizinhos
+     * @return true se a célula mudou
+     */
+    bool updateCell(int x, int y, bool blocked);
+
+    /**
+     * @brief Propaga as mudanças pendentes e extrai o caminho robô -> objetivo
+     * @return false se não houver caminho
+     */
+    bool computePath(std::vector<GridCell>& path);
+
+    size_t getExpanded() const { return expanded; }
+    const GridCell& getStart() const { return start; }
+    const GridCell& getGoal() const { return goal; }
+
+private:
+    struct Key {
+        float k1;
+        float k2;
+
+        bool operator<(const Key& other) const {
+            return k1 < other.k1 || (k1 == other.k1 && k2 < other.k2);
+        }
+        bool operator==(const Key& other) const { return k1 == other.k1 && k2 == other.k2; }
+    };
+
+    struct HeapNode {
+        Key key;
+        uint32_t index;
+    };
+
+    PlanningMap& map;
+    int width;
+    GridCell start;
+    GridCell goal;
+    GridCell lastStart;
+    float km;
+
+    std::vector<float> g;
+    std::vector<float> rhs;
+    std::vector<Key> queuedKey;       // Chave atual de cada estado na fila
+    std::vector<uint8_t> inQueue;
+    std::vector<HeapNode> heap;
+    size_t expanded;
+
+    uint32_t indexOf(int x, int y) const { return static_cast<uint32_t>(y) * width + x; }
+    float heuristic(uint32_t index) const;
+    Key calculateKey(uint32_t index) const;
+    float edgeCost(int x, int y, int dir) const;
+    void push(uint32_t index, const Key& key);
+    bool topKey(Key& key);
+    void updateVertex(uint32_t index);
+    void computeShortestPath();
+};
+
+#endif // DSTARLITE_H
@@ -0,0 +1,144 @@
+#ifndef DWAPLANNER_H
+#define DWAPLANNER_H
+
+#include "Pose2D.h"
+#include "OccupancyGrid.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Parâmetros do planejador local (Dynamic Window Approach)
+ *
+ * Velocidades em mm/s e graus/s; tempos em segundos; distâncias em mm.
+ */
+struct DwaConfig {
+    double maxVelocity;        // Limite de velocidade linear (sem ré)
+    double maxRotVelocity;     // Limite de velocidade angular
+    double acceleration;       // Aceleração/frenagem linear
+    double rotAcceleration;    // Aceleração angular
+    double windowTime;         // Janela dinâmica: velocidades alcançáveis neste tempo
+    double horizon;            // Duração de cada trajetória simulada
+    double simStep;            // Passo da simulação
+    int velocitySamples;       // Amostras de v na janela
+    int rotVelocitySamples;    // Amostras de w na janela
+    double robotRadius;        // Raio do círculo que envolve o robô
+    double safetyMargin;       // Folga somada ao raio na verificação de colisão
+    double maxClearance;       // Folga a partir da qual não há ganho na pontuação
+    double obstacleRange;      // Pontos mais distantes que isto são ignorados
+    double axleTrack;          // Distância entre as rodas (conversão para setVel2)
+    double headingWeight;      // Pesos da função objetivo
+    double clearanceWeight;
+    double velocityWeight;
+    size_t maxObstacles;       // Capacidade reservada para os pontos de obstáculo
+
+    DwaConfig();
+};
+
+/**
+ * @brief Melhor par (v, w) de um ciclo
+ *
+ * valid = false quando nenhuma trajetória da janela é admissível (o robô
+ * não consegue frear antes de colidir em nenhuma delas).
+ */
+struct DwaResult {
+    bool valid;
+    double velocity;       // mm/s
+    double rotVelocity;    // graus/s (+ = anti-horário, esquerda)
+    double clearance;      // Menor folga até os obstáculos na trajetória escolhida
+    double score;
+    int admissible;        // Trajetórias admissíveis neste ciclo
+
+    DwaResult() : valid(false), velocity(0.0), rotVelocity(0.0), clearance(0.0), score(0.0), admissible(0) {}
+};
+
+/**
+ * @brief Planejador local por janela dinâmica
+ *
+ * A cada ciclo amostra pares (v, w) alcançáveis a partir da velocidade
+ * atual, simula o arco de cada par por horizon segundos e pontua as
+ * trajetórias admissíveis por rumo, folga (no arco e em linha reta a
+ * partir do fim dele) e velocidade. Ao
+ * contrário dos controladores reativos, freia ou curva antes de o
+ * obstáculo entrar nos limiares, o que permite velocidades maiores.
+ *
+ * Os candidatos ficam num buffer SoA alocado no construtor, e os
+ * obstáculos em vetores float x/y preenchidos até múltiplo de 4. A
+ * distância mínima de cada ponto simulado a todos os obstáculos usa SSE
+ * (4 obstáculos por instrução), com versão escalar como alternativa.
+ * Nenhuma alocação ocorre em plan() enquanto o número de obstáculos não
+ * passar de maxObstacles.
+ *
+ * Obstáculos e trajetórias ficam no referencial do robô (x para a frente,
+ * y para a esquerda). Não é thread-safe.
+ */
+class DwaPlanner {
+public:
+    explicit DwaPlanner(const DwaConfig& config = DwaConfig());
+
+    void clearObstacles();
+
+    /**
+     * @brief Adiciona um ponto de obstáculo no referencial do robô
+     */
+    void addObstacle(double x, double y);
+
+    /**
+     * @brief Adiciona o eco de cada sonar (leituras sem retorno são ignoradas)
+     * @param maxRange Leituras a partir deste valor não têm retorno (LIMITELEITURA)
+     */
+    void addSonar(const int* sonar, int count, double maxRange,
+                  const SonarGeometry* geometry = pioneerSonarGeometry());
+
+    /**
+     * @brief Adiciona pontos do laser (mundo) convertidos para o robô
+     */
+    void addScan(const Pose2D& pose, const ScanPoint* points, size_t count);
+
+    /**
+     * @brief Escolhe o melhor par (v, w) para o ciclo
+     * @param velocity Velocidade linear atual (mm/s)
+     * @param rotVelocity Velocidade angular atual (graus/s)
+     * @param goalBearing Direção desejada relativa ao robô (graus; 0 = em frente)
+     */
+    DwaResult plan(double velocity, double rotVelocity, double goalBearing = 0.0);
+
+    /**
+     * @brief Converte (v, w) em velocidades das rodas (setVel2)
+     */
+    void toWheelSpeeds(double velocity, double rotVelocity, double& left, double& right) const;
+
+    size_t getCandidateCapacity() const { return candVelocity.size(); }
+    size_t getObstacleCount() const { return obstacleCount; }
+    uint64_t getEvaluated() const { return evaluated; }
+    const DwaConfig& getConfig() const { return config; }
+
+private:
+    DwaConfig config;
+
+    // Obstáculos (SoA, preenchidos com pontos distantes até múltiplo de 4)
+    std::vector<float> obstacleX;
+    std::vector<float> obstacleY;
+    size_t obstacleCount;
+
+    // Candidatos do ciclo (SoA, tamanho fixo)
+    std::vector<double> candVelocity;
+    std::vector<double> candRotVelocity;
+    std::vector<double> candClearance;
+    std::vector<double> candScoreClearance;
+    std::vector<double> candHeading;
+    std::vector<uint8_t> candAdmissible;
+
+    uint64_t evaluated;
+
+    void padObstacles();
+    /**
+     * @brief Simula o arco (v, w)
+     * @param gap Recebe a menor folga entre o robô e os obstáculos no arco
+     * @param ahead Recebe a distância livre em linha reta a partir do fim do arco
+     * @return Distância percorrida antes da colisão (infinito se não colide)
+     */
+    double pathClearance(double velocity, double rotVelocity, double& gap, double& ahead) const;
+};
+
+#endif // DWAPLANNER_H
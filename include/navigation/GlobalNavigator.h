@@ -0,0 +1,86 @@
+#ifndef GLOBALNAVIGATOR_H
+#define GLOBALNAVIGATOR_H
+
+#include "DStarLite.h"
+#include "OccupancyGrid.h"
+#include "PlanningMap.h"
+#include "Pose2D.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Parâmetros do navegador global (distâncias em mm)
+ */
+struct NavigatorConfig {
+    double margin;             // Folga da janela de planejamento em volta de robô e objetivo
+    double inflateRadius;      // Dilatação dos obstáculos (raio do robô + folga)
+    double waypointTolerance;  // Distância para considerar um waypoint alcançado
+    double goalTolerance;      // Distância para considerar o objetivo alcançado
+    int replanCycles;          // Ciclos de update() entre releituras do mapa
+    bool unknownBlocked;       // Células desconhecidas bloqueiam o caminho
+
+    NavigatorConfig();
+};
+
+/**
+ * @brief Planejamento global sobre o mapa de ocupação, com replanejamento
+ *
+ * Recorta do OccupancyGrid uma janela que contém robô e objetivo,
+ * planeja com D* Lite e reduz o caminho a waypoints em linha de visada.
+ * A cada replanCycles chamadas relê a janela; só as células que mudaram
+ * são passadas ao D* Lite, que corrige o caminho de forma incremental.
+ * Se o robô sair da janela, a janela é refeita e o plano recomeça.
+ *
+ * update() devolve o rumo relativo ao próximo waypoint, para o
+ * planejador local (DwaBehavior) seguir.
+ */
+class GlobalNavigator {
+public:
+    explicit GlobalNavigator(const NavigatorConfig& config = NavigatorConfig());
+
+    void setGoal(double x, double y);
+    void clearGoal();
+
+    bool hasGoal() const { return goalSet; }
+    bool isGoalReached() const { return goalReached; }
+
+    /**
+     * @brief Avança o plano e calcula o rumo para o próximo waypoint
+     * @param bearing Recebe o rumo relativo à orientação do robô (graus)
+     * @return false sem objetivo, com objetivo alcançado ou sem caminho
+     */
+    bool update(const Pose2D& pose, const OccupancyGrid& map, double& bearing);
+
+    /**
+     * @brief Waypoints restantes no mundo (theta não usado)
+     */
+    const std::vector<Pose2D>& getWaypoints() const { return waypoints; }
+
+    uint64_t getReplans() const { return replans; }
+    uint64_t getChangedCells() const { return changedCells; }
+    size_t getLastExpanded() const { return dstar ? dstar->getExpanded() : 0; }
+
+private:
+    NavigatorConfig config;
+    double goalX;
+    double goalY;
+    bool goalSet;
+    bool goalReached;
+    bool pathFound;
+
+    std::unique_ptr<PlanningMap> window;
+    std::unique_ptr<DStarLite> dstar;
+    std::vector<GridCell> path;
+    std::vector<Pose2D> waypoints;
+    size_t nextWaypoint;
+    int cyclesSinceReplan;
+    uint64_t replans;
+    uint64_t changedCells;
+
+    void buildWindow(const Pose2D& pose, const OccupancyGrid& map);
+    void refreshWindow(const OccupancyGrid& map);
+    void replan();
+};
+
+#endif // GLOBALNAVIGATOR_H
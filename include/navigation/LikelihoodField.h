@@ -0,0 +1,71 @@
+#ifndef LIKELIHOODFIELD_H
+#define LIKELIHOODFIELD_H
+
+#include "OccupancyGrid.h"
+#include <cmath>
+#include <vector>
+
+/**
+ * @brief Modelo de campo de verossimilhança do laser (Thrun et al., cap. 6.4)
+ *
+ * Pré-calcula, para cada célula de uma janela do mapa conhecido, o
+ * log da probabilidade de um feixe terminar ali:
+ *   log(zHit * exp(-d² / 2 sigma²) + zRandom)
+ * onde d é a distância até a célula ocupada mais próxima (transformada de
+ * distância euclidiana exata, Felzenszwalb & Huttenlocher). Assim o peso
+ * de um feixe é uma única leitura de memória, sem traçar raios.
+ * Imutável depois de construído: pode ser lido por várias threads.
+ */
+class LikelihoodField {
+public:
+    /**
+     * @param margin Folga em volta das células observadas (mm)
+     * @param sigma Desvio padrão do ruído do laser (mm)
+     * @param zHit, zRandom Pesos da gaussiana e do ruído uniforme
+     * @throws std::invalid_argument se o mapa estiver vazio
+     */
+    LikelihoodField(const OccupancyGrid& map, double margin = 1000.0, double sigma = 100.0,
+                    double zHit = 0.9, double zRandom = 0.1);
+
+    /**
+     * @brief log p do ponto (mm); fora da janela vale o piso (só ruído)
+     */
+    float logLikelihood(double x, double y) const {
+        int cx = static_cast<int>(std::floor(x * inverseResolution)) - originX;
+        int cy = static_cast<int>(std::floor(y * inverseResolution)) - originY;
+        if (static_cast<unsigned>(cx) >= static_cast<unsigned>(width) ||
+            static_cast<unsigned>(cy) >= static_cast<unsigned>(height)) {
+            return floorValue;
+        }
+        return field[static_cast<size_t>(cy) * width + cx];
+    }
+
+    /**
+     * @brief Distância (mm) da célula até o obstáculo mais próximo
+     */
+    double obstacleDistance(double x, double y) const;
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    double getResolution() const { return resolution; }
+    float getFloor() const { return floorValue; }
+
+    // Extremos da janela no mundo (mm)
+    double getMinX() const { return originX * resolution; }
+    double getMinY() const { return originY * resolution; }
+    double getMaxX() const { return (originX + width) * resolution; }
+    double getMaxY() const { return (originY + height) * resolution; }
+
+private:
+    int originX;
+    int originY;
+    int width;
+    int height;
+    double resolution;
+    double inverseResolution;
+    float floorValue;
+    std::vector<float> field;         // log p por célula, linha a linha
+    std::vector<float> distance;      // Distância ao obstáculo (células)
+};
+
+#endif // LIKELIHOODFIELD_H
@@ -0,0 +1,190 @@
+#ifndef OCCUPANCYGRID_H
+#define OCCUPANCYGRID_H
+
+#include "Pose2D.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Posição e orientação de um sonar no referencial do robô
+ *
+ * x para a frente, y para a esquerda (mm), angle em graus.
+ */
+struct SonarGeometry {
+    double x;
+    double y;
+    double angle;
+};
+
+/**
+ * @brief Os 8 sonares frontais do Pioneer 3-DX (p3dx.p da ARIA)
+ */
+const SonarGeometry* pioneerSonarGeometry();
+
+/**
+ * @brief Parâmetros do mapa de ocupação
+ *
+ * Log-odds quantizado em int8: valor = log(p / (1 - p)) * LOGODDS_SCALE.
+ * 0 = desconhecido (p = 0.5).
+ */
+struct GridConfig {
+    double resolution;       // Lado da célula (mm)
+    int hitDelta;            // Incremento da célula de retorno (p ~ 0.70)
+    int missDelta;           // Decremento das células atravessadas (p ~ 0.40)
+    int clampMin;            // Saturação: o mapa continua respondendo a mudanças
+    int clampMax;
+    int occupiedThreshold;   // log-odds >= limiar: ocupada
+    int freeThreshold;       // log-odds <= limiar: livre
+
+    double sonarHalfAngle;   // Meia abertura do cone do sonar (graus)
+    int sonarRays;           // Raios traçados por cone
+    double sonarFreeRange;   // Alcance confiável: leituras maiores não marcam retorno
+
+    GridConfig();
+};
+
+/**
+ * @brief Mapa de ocupação incremental em log-odds, esparso por blocos
+ *
+ * O plano é dividido em blocos de TILE_SIZE x TILE_SIZE células, alocados
+ * só quando um raio passa por eles (o ambiente não precisa ter tamanho
+ * conhecido e a memória cresce com a área explorada). Cada bloco é um
+ * vetor contíguo de int8, linha a linha.
+ *
+ * Atualização por varredura: os raios (Bresenham) de todos os sensores
+ * de uma leitura marcam um bloco de deltas temporário — cada célula
+ * recebe no máximo uma atualização por varredura, e retorno prevalece
+ * sobre livre onde os cones se sobrepõem. No fim, os deltas são somados
+ * aos blocos com adição saturada SSE2 (16 células por instrução) e
+ * limitados a [clampMin, clampMax].
+ *
+ * Não é thread-safe: integração e consultas devem ocorrer na mesma
+ * thread (o laço de controle, via PioneerRobot::getSnapshot).
+ */
+class OccupancyGrid {
+public:
+    static const int TILE_BITS = 5;
+    static const int TILE_SIZE = 1 << TILE_BITS;   // 32 células por lado
+    static const int TILE_CELLS = TILE_SIZE * TILE_SIZE;
+    static constexpr double LOGODDS_SCALE = 16.0;
+
+    enum CellState { Unknown, Free, Occupied };
+
+    explicit OccupancyGrid(const GridConfig& config = GridConfig());
+
+    OccupancyGrid(const OccupancyGrid&) = delete;
+    OccupancyGrid& operator=(const OccupancyGrid&) = delete;
+
+    /**
+     * @brief Integra uma leitura dos 8 sonares (cones)
+     * @param pose Pose do robô no momento da leitura
+     * @param sonar Distâncias em mm, índices como em getAllSonar
+     * @param geometry Posição de cada sonar no robô (padrão: Pioneer 3-DX)
+     */
+    void integrateSonar(const Pose2D& pose, const int* sonar, int count = 8,
+                        const SonarGeometry* geometry = pioneerSonarGeometry());
+
+    /**
+     * @brief Integra uma varredura do laser
+     * @param origin Posição do laser no mundo (theta ignorado)
+     * @param points Pontos finais de cada feixe, no mundo
+     */
+    void integrateScan(const Pose2D& origin, const ScanPoint* points, size_t count);
+
+    /**
+     * @brief Integra um único raio (livre até o fim; ocupado no fim se hit)
+     */
+    void integrateRay(double x0, double y0, double x1, double y1, bool hit);
+
+    int8_t getLogOdds(double x, double y) const;
+    double getProbability(double x, double y) const;
+    CellState getState(double x, double y) const;
+    bool isFree(double x, double y) const { return getState(x, y) == Free; }
+
+    /**
+     * @brief Distância livre a partir da pose, numa direção relativa
+     * @param bearing Ângulo relativo à orientação do robô (graus, + = esquerda)
+     * @param maxRange Distância máxima consultada (mm)
+     * @return Distância até a primeira célula ocupada, ou maxRange. Células
+     *         desconhecidas são tratadas como livres.
+     */
+    double freeDistance(const Pose2D& pose, double bearing, double maxRange) const;
+
+    /**
+     * @brief Maior distância livre num setor [fromBearing, toBearing]
+     * @param rays Direções consultadas no setor (>= 2)
+     */
+    double sectorClearance(const Pose2D& pose, double fromBearing, double toBearing,
+                           double maxRange, int rays = 5) const;
+
+    /**
+     * @brief Índice da célula que contém a coordenada (mm)
+     */
+    int worldToCell(double coordinate) const { return toCell(coordinate); }
+
+    /**
+     * @brief Copia uma região retangular de células (log-odds) para out
+     * @param out width * height valores, linha a linha; blocos ausentes viram 0
+     */
+    void exportRegion(int cx0, int cy0, int width, int height, int8_t* out) const;
+
+    /**
+     * @brief Células extremas já observadas (inclusive, alinhadas aos blocos)
+     * @return false se o mapa estiver vazio
+     */
+    bool getBounds(int& cx0, int& cy0, int& cx1, int& cy1) const;
+
+    /**
+     * @brief Grava os blocos em arquivo binário (mapa para localização)
+     */
+    bool save(const std::string& filename) const;
+
+    /**
+     * @brief Substitui o conteúdo pelos blocos gravados por save()
+     * @return false se o arquivo não abrir, for inválido ou tiver outra resolução
+     */
+    bool load(const std::string& filename);
+
+    const GridConfig& getConfig() const { return config; }
+    size_t getTileCount() const { return tiles.size(); }
+    size_t getMemoryBytes() const { return tiles.size() * sizeof(Tile); }
+    uint64_t getScans() const { return scans; }
+    double getResolution() const { return config.resolution; }
+
+    void clear();
+
+private:
+    struct Tile {
+        alignas(16) int8_t cells[TILE_CELLS];
+    };
+
+    typedef std::unordered_map<uint64_t, std::unique_ptr<Tile>> TileMap;
+
+    GridConfig config;
+    TileMap tiles;
+    uint64_t scans;
+
+    // Varredura em andamento: blocos de deltas reutilizados entre leituras
+    std::vector<std::unique_ptr<Tile>> deltaPool;
+    std::unordered_map<uint64_t, size_t> deltaIndex;
+    uint64_t lastDeltaKey;
+    Tile* lastDelta;
+
+    int toCell(double coordinate) const;
+    static int tileOf(int cell);
+    static uint64_t tileKey(int tx, int ty);
+    const Tile* findTile(int cx, int cy) const;
+    int8_t cellValue(int cx, int cy) const;
+
+    void beginScan();
+    void mark(int cx, int cy, int8_t delta);
+    void traceRay(int cx0, int cy0, int cx1, int cy1, bool hit);
+    void traceRay(double x0, double y0, double x1, double y1, bool hit);
+    void commitScan();
+};
+
+#endif // OCCUPANCYGRID_H
@@ -0,0 +1,134 @@
+#ifndef PARTICLEFILTER_H
+#define PARTICLEFILTER_H
+
+#include "LikelihoodField.h"
+#include "Pose2D.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Parâmetros da localização de Monte Carlo
+ */
+struct MclConfig {
+    size_t particles;          // Número de partículas
+    int threads;               // Threads do cálculo de pesos (0 = núcleos da máquina)
+    int beams;                 // Feixes do laser usados por atualização (subamostragem)
+    double alphaRotRot;        // Ruído da odometria (modelo de Thrun, cap. 5.4):
+    double alphaRotTrans;      //   rotação por rotação, rotação por translação,
+    double alphaTransTrans;    //   translação por translação,
+    double alphaTransRot;      //   translação por rotação (mm/rad)
+    double resampleThreshold;  // Reamostra quando ESS < fração * N
+    uint32_t seed;
+
+    MclConfig();
+};
+
+/**
+ * @brief Localização de Monte Carlo (filtro de partículas) sobre um mapa conhecido
+ *
+ * As partículas ficam em estrutura de vetores (x, y, theta e peso em
+ * vetores separados), e cada atualização percorre a memória em sequência.
+ * A predição amostra o modelo de odometria; a correção pontua cada
+ * partícula pelo LikelihoodField, com um laço feixe a feixe que só faz
+ * leituras na tabela. Predição e pesos são divididos em blocos contíguos
+ * entre threads de um pool fixo (criado no construtor, cada uma com seu
+ * gerador aleatório). A reamostragem é de baixa variância (um único
+ * sorteio, O(N)) e só acontece quando o número efetivo de partículas cai.
+ *
+ * predict/update/estimate devem ser chamados de uma única thread.
+ */
+class ParticleFilter {
+public:
+    explicit ParticleFilter(const LikelihoodField& field, const MclConfig& config = MclConfig());
+    ~ParticleFilter();
+
+    ParticleFilter(const ParticleFilter&) = delete;
+    ParticleFilter& operator=(const ParticleFilter&) = delete;
+
+    /**
+     * @brief Espalha as partículas numa gaussiana em volta da pose
+     * @param sigmaXY Desvio em x e y (mm)
+     * @param sigmaTheta Desvio da orientação (graus)
+     */
+    void initialize(const Pose2D& pose, double sigmaXY, double sigmaTheta);
+
+    /**
+     * @brief Aplica o deslocamento medido pela odometria entre duas leituras
+     */
+    void predict(const Pose2D& odometryBefore, const Pose2D& odometryAfter);
+
+    /**
+     * @brief Pondera as partículas por uma varredura do laser
+     * @param points Pontos finais dos feixes no referencial do robô (mm,
+     *        x para a frente); feixes sem retorno (hit = false) são ignorados
+     */
+    void update(const ScanPoint* points, size_t count);
+
+    /**
+     * @brief Média ponderada das partículas (orientação por média circular)
+     */
+    Pose2D estimate() const;
+
+    /**
+     * @brief Número efetivo de partículas, 1 / soma(w²)
+     */
+    double getEffectiveSampleSize() const;
+
+    size_t size() const { return x.size(); }
+    int getThreads() const { return static_cast<int>(workers.size()) + 1; }
+    uint64_t getUpdates() const { return updates; }
+    uint64_t getResamples() const { return resamples; }
+
+    // Acesso às partículas (testes e visualização)
+    const std::vector<float>& getX() const { return x; }
+    const std::vector<float>& getY() const { return y; }
+    const std::vector<float>& getTheta() const { return theta; }
+    const std::vector<float>& getWeights() const { return weight; }
+
+private:
+    const LikelihoodField& field;
+    MclConfig config;
+
+    // Partículas (theta em radianos)
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> theta;
+    std::vector<float> weight;
+    std::vector<float> logWeight;
+    std::vector<float> nextX;          // Destino da reamostragem
+    std::vector<float> nextY;
+    std::vector<float> nextTheta;
+
+    // Feixes subamostrados da varredura atual
+    std::vector<float> beamX;
+    std::vector<float> beamY;
+
+    std::mt19937 rng;                  // Thread chamadora (inicialização e reamostragem)
+    std::vector<std::mt19937> workerRng;
+    uint64_t updates;
+    uint64_t resamples;
+
+    // Pool: cada thread processa o bloco com seu índice
+    std::vector<std::thread> workers;
+    std::mutex poolMutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::function<void(size_t, size_t, int)> job;
+    uint64_t generation;
+    int pending;
+    bool stopping;
+
+    void parallelFor(const std::function<void(size_t, size_t, int)>& work);
+    void workerLoop(int index);
+    void runBlock(int index);
+    void normalize();
+    void resample();
+};
+
+#endif // PARTICLEFILTER_H
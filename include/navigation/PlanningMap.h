@@ -0,0 +1,121 @@
+#ifndef PLANNINGMAP_H
+#define PLANNINGMAP_H
+
+#include "OccupancyGrid.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Célula de um PlanningMap (índices locais, a partir de 0)
+ */
+struct GridCell {
+    int x;
+    int y;
+
+    GridCell() : x(0), y(0) {}
+    GridCell(int cx, int cy) : x(cx), y(cy) {}
+
+    bool operator==(const GridCell& other) const { return x == other.x && y == other.y; }
+    bool operator!=(const GridCell& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Janela retangular e densa do mapa, usada pelos planejadores globais
+ *
+ * Só guarda se cada célula está bloqueada: um bit por célula, em ordem de
+ * linhas e também transposto (em ordem de colunas), para que as varreduras
+ * retas do JPS leiam 64 células de uma vez nos dois eixos. Um mapa de
+ * 4000x4000 ocupa 4 MB. As células da janela correspondem às células
+ * [originX, originX + width) x [originY, originY + height) do
+ * OccupancyGrid de mesma resolução. Fora da janela tudo é bloqueado.
+ */
+class PlanningMap {
+public:
+    /**
+     * @throws std::invalid_argument se width/height não forem positivos
+     */
+    PlanningMap(int width, int height, int originX = 0, int originY = 0, double resolution = 50.0);
+
+    /**
+     * @brief Recorta uma janela do mapa de ocupação
+     * @param cx0, cy0 Primeira célula da janela no OccupancyGrid
+     * @param inflateRadius Obstáculos dilatados por este raio (mm), para
+     *        que o caminho do centro do robô mantenha distância das paredes
+     * @param unknownBlocked Trata células desconhecidas como bloqueadas
+     */
+    static PlanningMap fromOccupancy(const OccupancyGrid& grid, int cx0, int cy0, int width, int height,
+                                     double inflateRadius, bool unknownBlocked = false);
+
+    bool isBlocked(int x, int y) const {
+        if (x < 0 || y < 0 || x >= width || y >= height) {
+            return true;
+        }
+        size_t index = static_cast<size_t>(y) * width + x;
+        return (bits[index >> 6] >> (index & 63)) & 1;
+    }
+
+    void setBlocked(int x, int y, bool blocked);
+
+    /**
+     * @brief 64 células da linha y a partir de x (bit i = célula x + i)
+     *
+     * Células fora do mapa vêm como bloqueadas.
+     */
+    uint64_t rowWord(int x, int y) const;
+
+    /**
+     * @brief 64 células da coluna x a partir de y (bit i = célula y + i)
+     */
+    uint64_t columnWord(int x, int y) const;
+
+    // Vizinhança 8-conexa: 0-3 ortogonais (custo 1), 4-7 diagonais (custo raiz de 2)
+    static const int DIRECTIONS = 8;
+    static const int DX[DIRECTIONS];
+    static const int DY[DIRECTIONS];
+    static const float COST[DIRECTIONS];
+
+    /**
+     * @brief Passo de (x, y) na direção dir é permitido?
+     *
+     * O destino precisa estar livre; na diagonal, as duas células
+     * ortogonais também (o robô não corta quinas).
+     */
+    bool canMove(int x, int y, int dir) const {
+        int nx = x + DX[dir];
+        int ny = y + DY[dir];
+        if (isBlocked(nx, ny)) {
+            return false;
+        }
+        return dir < 4 || (!isBlocked(nx, y) && !isBlocked(x, ny));
+    }
+
+    /**
+     * @brief Dilata as células bloqueadas por um disco de radiusCells
+     */
+    void inflate(int radiusCells);
+
+    /**
+     * @brief Segmento livre entre duas células (Bresenham)?
+     */
+    bool lineOfSight(const GridCell& a, const GridCell& b) const;
+
+    GridCell worldToCell(double x, double y) const;
+    void cellToWorld(const GridCell& cell, double& x, double& y) const;
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getOriginX() const { return originX; }
+    int getOriginY() const { return originY; }
+    double getResolution() const { return resolution; }
+
+private:
+    int width;
+    int height;
+    int originX;
+    int originY;
+    double resolution;
+    std::vector<uint64_t> bits;       // Ordem de linhas (y * width + x)
+    std::vector<uint64_t> columns;    // Transposto (x * height + y)
+};
+
+#endif // PLANNINGMAP_H
@@ -0,0 +1,34 @@
+#ifndef POSE2D_H
+#define POSE2D_H
+
+/**
+ * @brief Pose do robô no referencial do mundo (odometria da ARIA)
+ *
+ * x/y em mm, theta em graus (anti-horário, 0 = eixo x). PioneerRobot
+ * monta a pose a partir de getXPos/getYPos (cm) e getAngBase.
+ */
+struct Pose2D {
+    double x;
+    double y;
+    double theta;
+
+    Pose2D() : x(0.0), y(0.0), theta(0.0) {}
+    Pose2D(double px, double py, double pth) : x(px), y(py), theta(pth) {}
+};
+
+/**
+ * @brief Ponto lido pelo laser, já em coordenadas do mundo (mm)
+ *
+ * hit = false quando o feixe não teve retorno (alcance máximo): a célula
+ * final não é marcada como ocupada, só o caminho como livre.
+ */
+struct ScanPoint {
+    double x;
+    double y;
+    bool hit;
+
+    ScanPoint() : x(0.0), y(0.0), hit(false) {}
+    ScanPoint(double px, double py, bool h) : x(px), y(py), hit(h) {}
+};
+
+#endif // POSE2D_H
@@ -2,6 +2,7 @@
 #define ACTIVATIONFUNCTION_H
 
 #include <cmath>
+#include <memory>
 #include <string>
 
 /**
@@ -135,4 +136,20 @@ public:
     }
 };
 
+/**
+ * @brief Cria uma função de ativação a partir do nome retornado por getName()
+ * @param name Nome da função ("Sigmoid", "Tanh", "ReLU" ou "Linear")
+ * @return Função de ativação correspondente, ou nullptr se o nome for desconhecido
+ * 
+ * Usada ao carregar modelos salvos, onde a ativação de cada camada
+ * é armazenada apenas pelo nome.
+ */
+inline std::shared_ptr<ActivationFunction> createActivation(const std::string& name) {
+    if (name == "Sigmoid") return std::make_shared<SigmoidActivation>();
+    if (name == "Tanh") return std::make_shared<TanhActivation>();
+    if (name == "ReLU") return std::make_shared<ReLUActivation>();
+    if (name == "Linear") return std::make_shared<LinearActivation>();
+    return nullptr;
+}
+
 #endif // ACTIVATIONFUNCTION_H
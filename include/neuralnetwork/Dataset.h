@@ -0,0 +1,516 @@
+#ifndef DATASET_H
+#define DATASET_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <algorithm>
+#include "Random.h"
+
+/**
+ * @brief Interface para conjuntos de dados de treinamento/validação
+ *
+ * Abstrai a origem das amostras (memória, CSV ou arquivo binário) para
+ * que NeuralNetwork::trainBatch possa treinar com datasets maiores que a
+ * memória disponível. As amostras são lidas uma a uma por índice; fontes
+ * em disco mantêm em cache apenas o bloco de amostras atual.
+ *
+ * getBlockSize() indica o tamanho do bloco de leitura: o embaralhamento do
+ * treinamento troca a ordem dos blocos e das amostras dentro de cada bloco,
+ * de modo que a leitura do disco continua sequencial dentro de um bloco.
+ */
+class Dataset {
+public:
+    virtual ~Dataset() = default;
+
+    /**
+     * @brief Retorna o número de amostras
+     */
+    virtual size_t size() const = 0;
+
+    /**
+     * @brief Retorna o número de valores de entrada por amostra
+     */
+    virtual int getInputSize() const = 0;
+
+    /**
+     * @brief Retorna o número de valores de saída esperada por amostra
+     */
+    virtual int getOutputSize() const = 0;
+
+    /**
+     * @brief Lê uma amostra
+     * @param index Índice da amostra [0, size())
+     * @param input Recebe o vetor de entrada (redimensionado se necessário)
+     * @param target Recebe o vetor de saída esperada (redimensionado se necessário)
+     */
+    virtual void getSample(size_t index, std::vector<double>& input,
+                           std::vector<double>& target) const = 0;
+
+    /**
+     * @brief Tamanho do bloco de leitura usado no embaralhamento
+     * @return Número de amostras por bloco (size() = embaralhamento completo)
+     */
+    virtual size_t getBlockSize() const { return size(); }
+
+    /**
+     * @brief Lê um lote de amostras para buffers contíguos
+     * @param indices Índices das amostras [0, size())
+     * @param count Número de amostras
+     * @param inputs Destino [count][getInputSize()]
+     * @param targets Destino [count][getOutputSize()]
+     * @throws std::invalid_argument se uma amostra tiver outro tamanho
+     *
+     * Usado por NeuralNetwork::trainBatch e evaluate. A implementação
+     * padrão chama getSample() por amostra; datasets em memória copiam
+     * direto das suas linhas.
+     */
+    virtual void readBatch(const size_t* indices, size_t count,
+                           double* inputs, double* targets) const;
+
+    /**
+     * @brief Indica se várias threads podem ler ao mesmo tempo
+     *
+     * Leituras são const, mas fontes em disco guardam o bloco atual num
+     * cache interno: essas retornam false e precisam de SynchronizedDataset
+     * (ou de uma thread só) para leituras em paralelo.
+     */
+    virtual bool concurrentReads() const { return false; }
+};
+
+/**
+ * @brief Dataset em memória sobre vetores já existentes (sem cópia)
+ *
+ * Adaptador usado pelas sobrecargas de trainBatch/validate que recebem
+ * std::vector<std::vector<double>>. Os vetores precisam continuar vivos
+ * enquanto o dataset for usado.
+ */
+class MemoryDataset : public Dataset {
+private:
+    const std::vector<std::vector<double>>& inputs;
+    const std::vector<std::vector<double>>& targets;
+
+public:
+    MemoryDataset(const std::vector<std::vector<double>>& inputs,
+                  const std::vector<std::vector<double>>& targets);
+
+    size_t size() const override { return inputs.size(); }
+    int getInputSize() const override;
+    int getOutputSize() const override;
+    void getSample(size_t index, std::vector<double>& input,
+                   std::vector<double>& target) const override;
+    void readBatch(const size_t* indices, size_t count,
+                   double* batchInputs, double* batchTargets) const override;
+    bool concurrentReads() const override { return true; }
+};
+
+/**
+ * @brief Dataset lido de arquivo CSV em blocos
+ *
+ * Cada linha contém inputSize valores de entrada seguidos de outputSize
+ * valores esperados, separados por vírgula, ponto e vírgula ou espaço.
+ * Uma linha de cabeçalho não numérica e linhas vazias são ignoradas.
+ *
+ * Ao abrir, o arquivo é percorrido uma vez para indexar o início de cada
+ * bloco (memória proporcional a size()/blockSize). Durante o treinamento
+ * apenas o bloco atual fica em memória.
+ */
+class CsvDataset : public Dataset {
+private:
+    std::string filename;
+    mutable std::ifstream file;
+    int inputSize;
+    int outputSize;
+    size_t blockSize;
+    size_t numSamples;
+
+    std::vector<uint64_t> blockOffsets;  // Posição no arquivo do início de cada bloco
+    std::vector<uint64_t> blockLines;    // Número (a partir de 1) da primeira linha de cada bloco
+    mutable std::vector<double> blockValues;     // Valores do bloco em cache (linha a linha)
+    mutable size_t cachedBlock;
+
+public:
+    /**
+     * @brief Abre e indexa o arquivo CSV
+     * @param filename Caminho do arquivo
+     * @param inputSize Número de colunas de entrada
+     * @param outputSize Número de colunas de saída esperada
+     * @param blockSize Amostras por bloco de leitura
+     * @throws std::runtime_error se o arquivo não puder ser aberto ou tiver linhas inválidas
+     */
+    CsvDataset(const std::string& filename, int inputSize, int outputSize,
+               size_t blockSize = 4096);
+
+    size_t size() const override { return numSamples; }
+    int getInputSize() const override { return inputSize; }
+    int getOutputSize() const override { return outputSize; }
+    size_t getBlockSize() const override { return blockSize; }
+    void getSample(size_t index, std::vector<double>& input,
+                   std::vector<double>& target) const override;
+
+private:
+    void buildIndex();
+    void loadBlock(size_t block) const;
+};
+
+/**
+ * @brief Dataset em formato binário colunar (float32)
+ *
+ * Formato do arquivo (little-endian nativo):
+ * - cabeçalho: "NNDS" versão:u32 numSamples:u64 inputSize:u32 outputSize:u32
+ * - em seguida uma coluna por valor (entradas e depois saídas), cada uma
+ *   com numSamples valores float32 contíguos
+ *
+ * Em sistemas POSIX o arquivo é mapeado em memória (mmap) e o sistema
+ * operacional carrega apenas as páginas acessadas. Sem mmap, cada bloco é
+ * lido coluna a coluna para um cache em memória.
+ */
+class BinaryDataset : public Dataset {
+private:
+    std::string filename;
+    size_t numSamples;
+    int inputSize;
+    int outputSize;
+    size_t blockSize;
+
+    // Arquivo mapeado (nullptr quando mmap não está disponível)
+    const unsigned char* mapped;
+    size_t mappedLength;
+
+    // Leitura em blocos (sem mmap; fechado quando o mapeamento funciona)
+    mutable std::ifstream file;
+    mutable std::vector<float> blockValues;      // [coluna][amostra do bloco]
+    mutable size_t cachedBlock;
+
+public:
+    /**
+     * @brief Abre o arquivo binário
+     * @param filename Caminho do arquivo
+     * @param blockSize Amostras por bloco de leitura
+     * @throws std::runtime_error se o arquivo não puder ser aberto ou for inválido
+     */
+    explicit BinaryDataset(const std::string& filename, size_t blockSize = 4096);
+    ~BinaryDataset() override;
+
+    BinaryDataset(const BinaryDataset&) = delete;
+    BinaryDataset& operator=(const BinaryDataset&) = delete;
+
+    size_t size() const override { return numSamples; }
+    int getInputSize() const override { return inputSize; }
+    int getOutputSize() const override { return outputSize; }
+    size_t getBlockSize() const override { return blockSize; }
+    void getSample(size_t index, std::vector<double>& input,
+                   std::vector<double>& target) const override;
+
+    /**
+     * @brief Grava qualquer dataset no formato binário colunar
+     * @param filename Arquivo de destino
+     * @param source Dataset de origem (lido sequencialmente, uma única vez)
+     * @return true se gravou com sucesso
+     */
+    static bool write(const std::string& filename, const Dataset& source);
+
+    /**
+     * @brief Leituras paralelas só com o arquivo mapeado (sem cache de bloco)
+     */
+    bool concurrentReads() const override { return mapped != nullptr; }
+
+private:
+    void loadBlock(size_t block) const;
+};
+
+/**
+ * @brief Dataset compacto em memória: matriz contígua de features alinhada
+ *
+ * Armazena todas as entradas em uma única matriz [amostra][feature] com
+ * início alinhado em 64 bytes (linha de cache), linhas com comprimento
+ * múltiplo de 16 bytes (largura SSE) e as saídas esperadas em um array
+ * paralelo [amostra][saída]. Comparado a vector<vector<double>>
+ * não há uma alocação por amostra, e com T = float a memória cai pela metade.
+ *
+ * Como implementa Dataset, é aceito por NeuralNetwork::trainBatch e
+ * NeuralNetwork::validate. Os dois leem as amostras em lotes por
+ * readBatch(), que copia direto das linhas contíguas (um memcpy por linha
+ * quando T = double, conversão para double quando T = float), sem passar
+ * por vetores por amostra. gatherBatch() monta mini-batches no próprio
+ * tipo T, com as linhas alinhadas.
+ *
+ * @tparam T float ou double
+ */
+template <typename T>
+class MatrixDataset : public Dataset {
+public:
+    static constexpr size_t ALIGNMENT = 64;      // Alinhamento do início da matriz
+    static constexpr size_t ROW_ALIGNMENT = 16;  // Granularidade do comprimento das linhas
+
+    /**
+     * @brief Cria um dataset vazio
+     * @param inputSize Número de features por amostra
+     * @param outputSize Número de saídas esperadas por amostra
+     * @param capacity Número de amostras para reservar
+     */
+    MatrixDataset(int inputSize, int outputSize, size_t capacity = 0)
+        : inputSize(inputSize),
+          outputSize(outputSize),
+          stride(alignedStride(inputSize)),
+          numSamples(0),
+          capacity(0),
+          features(nullptr, &freeAligned),
+          targets(nullptr, &freeAligned) {
+        if (inputSize <= 0 || outputSize <= 0) {
+            throw std::invalid_argument("Dataset sizes must be positive");
+        }
+        reserve(capacity);
+    }
+
+    /**
+     * @brief Cria o dataset a partir dos vetores usados até agora
+     */
+    static MatrixDataset fromVectors(const std::vector<std::vector<double>>& inputs,
+                                     const std::vector<std::vector<double>>& targets) {
+        MemoryDataset view(inputs, targets);
+        return load(view);
+    }
+
+    /**
+     * @brief Carrega para memória qualquer dataset (ex.: BinaryDataset que cabe na RAM)
+     */
+    static MatrixDataset load(const Dataset& source) {
+        MatrixDataset result(source.getInputSize(), source.getOutputSize(), source.size());
+        std::vector<double> input, target;
+        for (size_t i = 0; i < source.size(); ++i) {
+            source.getSample(i, input, target);
+            result.append(input.data(), target.data());
+        }
+        return result;
+    }
+
+    MatrixDataset(MatrixDataset&&) = default;
+    MatrixDataset& operator=(MatrixDataset&&) = default;
+
+    /**
+     * @brief Adiciona uma amostra ao final
+     * @param input inputSize valores de entrada
+     * @param target outputSize valores esperados
+     */
+    void append(const double* input, const double* target) {
+        if (numSamples == capacity) {
+            reserve(std::max<size_t>(64, capacity * 2));
+        }
+        T* row = features.get() + numSamples * stride;
+        for (int i = 0; i < inputSize; ++i) row[i] = static_cast<T>(input[i]);
+        T* out = targets.get() + numSamples * outputSize;
+        for (int i = 0; i < outputSize; ++i) out[i] = static_cast<T>(target[i]);
+        ++numSamples;
+    }
+
+    /**
+     * @brief Garante espaço para pelo menos newCapacity amostras
+     */
+    void reserve(size_t newCapacity) {
+        if (newCapacity <= capacity) return;
+        void* memory = allocateAligned(newCapacity * stride * sizeof(T));
+        T* grown = static_cast<T*>(memory);
+        std::memset(grown, 0, newCapacity * stride * sizeof(T));
+        if (numSamples > 0) {
+            std::memcpy(grown, features.get(), numSamples * stride * sizeof(T));
+        }
+        features.reset(grown);
+        T* grownTargets = static_cast<T*>(allocateAligned(newCapacity * outputSize * sizeof(T)));
+        if (numSamples > 0) {
+            std::memcpy(grownTargets, targets.get(), numSamples * outputSize * sizeof(T));
+        }
+        targets.reset(grownTargets);
+        capacity = newCapacity;
+    }
+
+    size_t size() const override { return numSamples; }
+    int getInputSize() const override { return inputSize; }
+    int getOutputSize() const override { return outputSize; }
+
+    void getSample(size_t index, std::vector<double>& input,
+                   std::vector<double>& target) const override {
+        const T* row = getRow(index);
+        input.assign(row, row + inputSize);
+        const T* out = getTarget(index);
+        target.assign(out, out + outputSize);
+    }
+
+    bool concurrentReads() const override { return true; }
+
+    void readBatch(const size_t* indices, size_t count,
+                   double* batchInputs, double* batchTargets) const override {
+        // std::copy de double para double é um memmove por linha
+        for (size_t b = 0; b < count; ++b) {
+            const T* row = getRow(indices[b]);
+            std::copy(row, row + inputSize, batchInputs + b * inputSize);
+            const T* out = getTarget(indices[b]);
+            std::copy(out, out + outputSize, batchTargets + b * outputSize);
+        }
+    }
+
+    /**
+     * @brief Ponteiro para as features da amostra (alinhado em 16 bytes)
+     */
+    const T* getRow(size_t index) const { return features.get() + index * stride; }
+
+    /**
+     * @brief Ponteiro para as saídas esperadas da amostra
+     */
+    const T* getTarget(size_t index) const { return targets.get() + index * outputSize; }
+
+    /**
+     * @brief Distância, em elementos, entre linhas consecutivas da matriz
+     */
+    size_t getStride() const { return stride; }
+
+    /**
+     * @brief Copia um mini-batch para buffers contíguos
+     * @param indices Índices das amostras
+     * @param count Número de amostras
+     * @param batchFeatures Destino [count][getStride()]
+     * @param batchTargets Destino [count][outputSize]
+     */
+    void gatherBatch(const size_t* indices, size_t count,
+                     T* batchFeatures, T* batchTargets) const {
+        for (size_t b = 0; b < count; ++b) {
+            std::memcpy(batchFeatures + b * stride, getRow(indices[b]), stride * sizeof(T));
+            std::memcpy(batchTargets + b * outputSize, getTarget(indices[b]),
+                        outputSize * sizeof(T));
+        }
+    }
+
+private:
+    int inputSize;
+    int outputSize;
+    size_t stride;
+    size_t numSamples;
+    size_t capacity;
+    std::unique_ptr<T, void (*)(T*)> features;  // [capacity][stride]
+    std::unique_ptr<T, void (*)(T*)> targets;   // [capacity][outputSize], alinhado como features
+
+    static size_t alignedStride(int inputSize) {
+        size_t perLine = ROW_ALIGNMENT / sizeof(T);
+        return (static_cast<size_t>(inputSize) + perLine - 1) / perLine * perLine;
+    }
+
+    static void* allocateAligned(size_t bytes) {
+        void* memory = nullptr;
+#ifdef _WIN32
+        memory = _aligned_malloc(bytes, ALIGNMENT);
+#else
+        if (posix_memalign(&memory, ALIGNMENT, bytes) != 0) memory = nullptr;
+#endif
+        if (!memory) throw std::bad_alloc();
+        return memory;
+    }
+
+    static void freeAligned(T* memory) {
+#ifdef _WIN32
+        _aligned_free(memory);
+#else
+        std::free(memory);
+#endif
+    }
+};
+
+typedef MatrixDataset<float> FloatDataset;
+typedef MatrixDataset<double> DoubleDataset;
+
+/**
+ * @brief Leituras serializadas de um dataset compartilhado entre threads
+ *
+ * Para datasets sem concurrentReads() (CSV e binário sem mmap, com bloco
+ * em cache): cada getSample/readBatch segura um mutex, então várias
+ * threads podem treinar sobre o mesmo arquivo. Com os lotes de readBatch o
+ * mutex é tomado uma vez a cada lote, não por amostra. O dataset original
+ * precisa continuar vivo e não pode ser lido por fora enquanto isso.
+ */
+class SynchronizedDataset : public Dataset {
+private:
+    const Dataset& source;
+    mutable std::mutex mutex;
+
+public:
+    explicit SynchronizedDataset(const Dataset& source) : source(source) {}
+
+    size_t size() const override { return source.size(); }
+    int getInputSize() const override { return source.getInputSize(); }
+    int getOutputSize() const override { return source.getOutputSize(); }
+    size_t getBlockSize() const override { return source.getBlockSize(); }
+    bool concurrentReads() const override { return true; }
+
+    void getSample(size_t index, std::vector<double>& input,
+                   std::vector<double>& target) const override {
+        std::lock_guard<std::mutex> lock(mutex);
+        source.getSample(index, input, target);
+    }
+
+    void readBatch(const size_t* indices, size_t count,
+                   double* inputs, double* targets) const override {
+        std::lock_guard<std::mutex> lock(mutex);
+        source.readBatch(indices, count, inputs, targets);
+    }
+};
+
+/**
+ * @brief Embaralhamento por blocos de índices
+ *
+ * Gera uma permutação dos índices [0, size) sem materializar um vetor com
+ * todos eles: a ordem dos blocos é embaralhada e, dentro de cada bloco, a
+ * ordem das amostras. Assim o acesso ao disco continua sequencial por bloco.
+ *
+ * A permutação da época e depende só de (seed, e): cada época e cada bloco
+ * têm o seu fluxo de CounterRng, e a ordem dos blocos parte sempre da
+ * identidade. Um treinamento retomado na época e embaralha como o original.
+ *
+ * Uso:
+ *   BlockShuffler shuffler(data.size(), data.getBlockSize(), seed);
+ *   shuffler.shuffle();
+ *   for (size_t k = 0; k < data.size(); ++k) { size_t idx = shuffler.at(k); ... }
+ */
+class BlockShuffler {
+private:
+    size_t total;
+    size_t blockSize;
+    std::vector<size_t> blockOrder;
+    std::vector<size_t> withinBlock;
+    size_t currentBlock;
+    uint64_t seed;
+    uint64_t epoch;
+    CounterRng epochRng;
+
+public:
+    /**
+     * @param seed Semente do embaralhamento (mesma semente = mesma sequência de épocas)
+     */
+    BlockShuffler(size_t total, size_t blockSize, uint64_t seed = CounterRng::entropySeed());
+
+    /**
+     * @brief Sorteia a ordem da próxima época (chamar a cada época)
+     */
+    void shuffle();
+
+    /**
+     * @brief Sorteia a ordem de uma época específica; shuffle() continua dela
+     */
+    void shuffle(uint64_t epochIndex);
+
+    /**
+     * @brief Índice da k-ésima amostra da época (k deve ser crescente)
+     */
+    size_t at(size_t k);
+
+private:
+    void shuffleBlock(size_t block);
+};
+
+#endif // DATASET_H
@@ -0,0 +1,75 @@
+#ifndef EVALUATION_H
+#define EVALUATION_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Faixas da saída da rede que codificam as ações do robô
+ *
+ * Os valores padrão são os de NeuralCollisionAvoidance::ACTION_*: a saída
+ * em [bounds[k], bounds[k + 1]) escolhe a ação names[k]. Fora de todas as
+ * faixas, nenhuma ação.
+ */
+struct ActionBands {
+    std::vector<double> bounds = {0.50, 0.56, 0.62, 0.68, 0.74, 0.80};
+    std::vector<std::string> names = {"DIREITA", "ESQUERDA", "FRENTE", "TRÁS", "PARAR"};
+
+    /**
+     * @brief Índice da faixa de um valor (-1 = fora de todas)
+     */
+    int classify(double output) const;
+
+    std::size_t size() const { return names.size(); }
+};
+
+/**
+ * @brief Parâmetros de NeuralNetwork::evaluate
+ */
+struct EvaluationConfig {
+    ActionBands bands;
+    int outputIndex = 0;                 // Saída comparada com as faixas
+    std::size_t batchSize = 512;         // Amostras por lote (unidade de trabalho das threads)
+    int threads = 0;                     // 0 = núcleos disponíveis
+    std::size_t parallelThreshold = 16384;  // Abaixo disso, uma thread só
+};
+
+/**
+ * @brief Métricas agregadas de uma avaliação
+ *
+ * confusion[esperada][predita] conta as amostras por faixa; o índice
+ * bands.size() é "fora das faixas". accuracy() considera só as amostras
+ * cuja saída esperada cai numa faixa.
+ */
+struct EvaluationResult {
+    std::size_t samples = 0;
+    double loss = 0.0;          // Mesmo erro de NeuralNetwork::validate: média de 0.5 * Σ(alvo - saída)²
+    double mse = 0.0;           // Média de (alvo - saída)² sobre amostras e saídas
+    double maxAbsError = 0.0;   // Maior |alvo - saída|
+    std::vector<std::string> labels;                   // Nomes das faixas + "fora"
+    std::vector<std::vector<std::size_t>> confusion;   // [esperada][predita]
+    std::size_t labeled = 0;    // Amostras com saída esperada dentro de uma faixa
+    std::size_t correct = 0;    // Dessas, com a mesma faixa na predição
+    int threads = 1;
+    double seconds = 0.0;
+
+    double accuracy() const { return labeled > 0 ? static_cast<double>(correct) / labeled : 0.0; }
+
+    /**
+     * @brief Fração das amostras da faixa esperada k preditas como k
+     */
+    double recall(std::size_t band) const;
+
+    /**
+     * @brief Fração das predições na faixa k que esperavam k
+     */
+    double precision(std::size_t band) const;
+};
+
+/**
+ * @brief Exibe as métricas e a matriz de confusão
+ */
+void printEvaluationReport(const EvaluationResult& result);
+
+#endif // EVALUATION_H
@@ -0,0 +1,304 @@
+#ifndef FIXEDNETWORK_H
+#define FIXEDNETWORK_H
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include "NeuralNetwork.h"
+
+/**
+ * @brief Funções de ativação suportadas pela rede de tamanho fixo
+ */
+enum class FixedActivation { Sigmoid, Tanh, ReLU, Linear };
+
+/**
+ * @brief Converte o nome de uma ActivationFunction para FixedActivation
+ * @throws std::invalid_argument se o nome não for reconhecido
+ */
+inline FixedActivation fixedActivationFromName(const std::string& name) {
+    if (name == "Sigmoid") return FixedActivation::Sigmoid;
+    if (name == "Tanh") return FixedActivation::Tanh;
+    if (name == "ReLU") return FixedActivation::ReLU;
+    if (name == "Linear") return FixedActivation::Linear;
+    throw std::invalid_argument("Ativação não suportada na rede fixa: " + name);
+}
+
+/**
+ * @brief Aplica a ativação (mesmas fórmulas de ActivationFunction.h)
+ */
+inline double fixedActivate(FixedActivation activation, double x) {
+    switch (activation) {
+        case FixedActivation::Sigmoid: return 1.0 / (1.0 + std::exp(-x));
+        case FixedActivation::Tanh: return std::tanh(x);
+        case FixedActivation::ReLU: return x > 0.0 ? x : 0.0;
+        case FixedActivation::Linear: return x;
+    }
+    return x;
+}
+
+/**
+ * @brief Camada densa com dimensões conhecidas em tempo de compilação
+ *
+ * Pesos armazenados por neurônio ([neurônio][entrada]) para que cada soma
+ * ponderada percorra memória contígua. Os laços têm limites constantes e
+ * são desenrolados pelo compilador.
+ */
+template<std::size_t Inputs, std::size_t Outputs>
+struct FixedLayer {
+    std::array<std::array<double, Inputs>, Outputs> weights;
+    std::array<double, Outputs> bias;
+    FixedActivation activation;
+
+    FixedLayer() : activation(FixedActivation::Sigmoid) {
+        for (auto& row : weights) row.fill(0.0);
+        bias.fill(0.0);
+    }
+
+    /**
+     * @brief Copia pesos e bias de uma Layer dinâmica com o mesmo formato
+     * @throws std::invalid_argument se as dimensões não coincidirem
+     */
+    void load(const Layer& layer) {
+        if (layer.getInputSize() != static_cast<int>(Inputs) ||
+            layer.getOutputSize() != static_cast<int>(Outputs)) {
+            throw std::invalid_argument(
+                "Layer shape mismatch. Expected " + std::to_string(Inputs) + "x" +
+                std::to_string(Outputs) + " but got " +
+                std::to_string(layer.getInputSize()) + "x" + std::to_string(layer.getOutputSize())
+            );
+        }
+
+        const auto& source = layer.getWeights();
+        for (std::size_t i = 0; i < Inputs; ++i) {
+            for (std::size_t j = 0; j < Outputs; ++j) {
+                weights[j][i] = source[i][j];
+            }
+        }
+        for (std::size_t j = 0; j < Outputs; ++j) {
+            bias[j] = layer.getBias()[j];
+        }
+        activation = fixedActivationFromName(layer.getActivationName());
+    }
+
+    void forward(const std::array<double, Inputs>& input,
+                 std::array<double, Outputs>& output) const {
+        for (std::size_t j = 0; j < Outputs; ++j) {
+            // Mesma ordem de soma de Layer::forward: bias + sum(input[i] * w[i][j])
+            double sum = bias[j];
+            for (std::size_t i = 0; i < Inputs; ++i) {
+                sum += input[i] * weights[j][i];
+            }
+            output[j] = fixedActivate(activation, sum);
+        }
+    }
+
+    /**
+     * @brief forward de count linhas ([linha][entrada] -> [linha][saída])
+     *
+     * Neurônio no laço de fora: os pesos de cada neurônio são lidos uma vez
+     * por lote, não uma vez por linha. Quatro linhas por vez, com somas
+     * independentes, para não esperar cada adição terminar. Cada linha
+     * mantém a ordem de soma de forward(), então o resultado é idêntico.
+     */
+    void forwardBatch(const double* input, double* output, std::size_t count) const {
+        for (std::size_t j = 0; j < Outputs; ++j) {
+            const std::array<double, Inputs>& w = weights[j];
+            std::size_t r = 0;
+            for (; r + 4 <= count; r += 4) {
+                const double* row0 = input + r * Inputs;
+                const double* row1 = row0 + Inputs;
+                const double* row2 = row1 + Inputs;
+                const double* row3 = row2 + Inputs;
+                double sum0 = bias[j], sum1 = bias[j], sum2 = bias[j], sum3 = bias[j];
+                for (std::size_t i = 0; i < Inputs; ++i) {
+                    sum0 += row0[i] * w[i];
+                    sum1 += row1[i] * w[i];
+                    sum2 += row2[i] * w[i];
+                    sum3 += row3[i] * w[i];
+                }
+                output[r * Outputs + j] = fixedActivate(activation, sum0);
+                output[(r + 1) * Outputs + j] = fixedActivate(activation, sum1);
+                output[(r + 2) * Outputs + j] = fixedActivate(activation, sum2);
+                output[(r + 3) * Outputs + j] = fixedActivate(activation, sum3);
+            }
+            for (; r < count; ++r) {
+                const double* row = input + r * Inputs;
+                double sum = bias[j];
+                for (std::size_t i = 0; i < Inputs; ++i) {
+                    sum += row[i] * w[i];
+                }
+                output[r * Outputs + j] = fixedActivate(activation, sum);
+            }
+        }
+    }
+};
+
+namespace fixednetwork_detail {
+
+// Linhas por bloco no forward em lote (ativações intermediárias na pilha)
+const std::size_t BATCH_BLOCK = 32;
+
+template<std::size_t First, std::size_t... Rest>
+struct FirstOf {
+    static constexpr std::size_t value = First;
+};
+
+/**
+ * Encadeamento recursivo das camadas: LayerChain<4, 5, 1> contém
+ * FixedLayer<4, 5> seguida de LayerChain<5, 1>.
+ */
+template<std::size_t... Sizes>
+struct LayerChain;
+
+template<std::size_t Inputs, std::size_t Outputs>
+struct LayerChain<Inputs, Outputs> {
+    static constexpr std::size_t OUTPUTS = Outputs;
+
+    FixedLayer<Inputs, Outputs> layer;
+
+    void load(const std::vector<std::shared_ptr<Layer>>& layers, std::size_t index) {
+        layer.load(*layers[index]);
+    }
+
+    void forward(const std::array<double, Inputs>& input,
+                 std::array<double, Outputs>& output) const {
+        layer.forward(input, output);
+    }
+
+    void forwardBatch(const double* input, double* output, std::size_t count) const {
+        layer.forwardBatch(input, output, count);
+    }
+};
+
+template<std::size_t Inputs, std::size_t Hidden, std::size_t... Rest>
+struct LayerChain<Inputs, Hidden, Rest...> {
+    typedef LayerChain<Hidden, Rest...> Next;
+    static constexpr std::size_t OUTPUTS = Next::OUTPUTS;
+
+    FixedLayer<Inputs, Hidden> layer;
+    Next next;
+
+    void load(const std::vector<std::shared_ptr<Layer>>& layers, std::size_t index) {
+        layer.load(*layers[index]);
+        next.load(layers, index + 1);
+    }
+
+    void forward(const std::array<double, Inputs>& input,
+                 std::array<double, OUTPUTS>& output) const {
+        std::array<double, Hidden> hidden;
+        layer.forward(input, hidden);
+        next.forward(hidden, output);
+    }
+
+    void forwardBatch(const double* input, double* output, std::size_t count) const {
+        std::array<double, BATCH_BLOCK * Hidden> hidden;
+        for (std::size_t begin = 0; begin < count; begin += BATCH_BLOCK) {
+            std::size_t rows = count - begin < BATCH_BLOCK ? count - begin : BATCH_BLOCK;
+            layer.forwardBatch(input + begin * Inputs, hidden.data(), rows);
+            next.forwardBatch(hidden.data(), output + begin * OUTPUTS, rows);
+        }
+    }
+};
+
+} // namespace fixednetwork_detail
+
+/**
+ * @brief Rede feedforward com arquitetura fixada em tempo de compilação
+ *
+ * FixedNetwork<4, 5, 1> corresponde à rede de produção (4 entradas,
+ * 5 neurônios ocultos, 1 saída). Toda a memória fica em std::array dentro
+ * do próprio objeto: a predição não aloca, é const (pode ser chamada de
+ * várias threads) e produz exatamente os mesmos valores de
+ * NeuralNetwork::predict para os mesmos pesos.
+ *
+ * Exemplo:
+ * @code
+ *   FixedNetwork<4, 5, 1> fixed(network);   // network já treinada/carregada
+ *   FixedNetwork<4, 5, 1>::Input in = {{1, 0, 1, 0}};
+ *   double action = fixed.predict(in)[0];
+ * @endcode
+ */
+template<std::size_t... Sizes>
+class FixedNetwork {
+    static_assert(sizeof...(Sizes) >= 2, "FixedNetwork precisa de ao menos entrada e saída");
+
+    typedef fixednetwork_detail::LayerChain<Sizes...> Chain;
+
+public:
+    static constexpr std::size_t INPUTS = fixednetwork_detail::FirstOf<Sizes...>::value;
+    static constexpr std::size_t OUTPUTS = Chain::OUTPUTS;
+    static constexpr std::size_t LAYERS = sizeof...(Sizes) - 1;
+
+    typedef std::array<double, INPUTS> Input;
+    typedef std::array<double, OUTPUTS> Output;
+
+    /**
+     * @brief Rede com pesos zerados (use load() antes de predizer)
+     */
+    FixedNetwork() {}
+
+    /**
+     * @brief Copia os pesos de uma NeuralNetwork com a mesma arquitetura
+     * @throws std::invalid_argument se a arquitetura for diferente
+     */
+    explicit FixedNetwork(const NeuralNetwork& network) {
+        load(network);
+    }
+
+    /**
+     * @brief Recarrega os pesos (ex.: após novo treinamento)
+     * @throws std::invalid_argument se a arquitetura for diferente
+     */
+    void load(const NeuralNetwork& network) {
+        if (network.getLayers().size() != LAYERS) {
+            throw std::invalid_argument(
+                "Network depth mismatch. Expected " + std::to_string(LAYERS) +
+                " layers but got " + std::to_string(network.getLayers().size())
+            );
+        }
+        chain.load(network.getLayers(), 0);
+    }
+
+    /**
+     * @brief Forward propagation sem alocação
+     * @param input Entradas normalizadas
+     * @return Saída da rede
+     */
+    Output predict(const Input& input) const {
+        Output output;
+        chain.forward(input, output);
+        return output;
+    }
+
+    /**
+     * @brief Predição de um lote (mesmos valores de predict linha a linha)
+     *
+     * Cada camada percorre o lote inteiro com os pesos de um neurônio antes
+     * de passar ao próximo, amortizando a leitura dos pesos entre as linhas.
+     */
+    void predictBatch(const Input* inputs, Output* outputs, std::size_t count) const {
+        static_assert(sizeof(Input) == INPUTS * sizeof(double) &&
+                      sizeof(Output) == OUTPUTS * sizeof(double),
+                      "std::array com preenchimento");
+        if (count == 0) {
+            return;
+        }
+        chain.forwardBatch(inputs[0].data(), outputs[0].data(), count);
+    }
+
+private:
+    Chain chain;
+};
+
+template<std::size_t... Sizes>
+constexpr std::size_t FixedNetwork<Sizes...>::INPUTS;
+
+template<std::size_t... Sizes>
+constexpr std::size_t FixedNetwork<Sizes...>::OUTPUTS;
+
+template<std::size_t... Sizes>
+constexpr std::size_t FixedNetwork<Sizes...>::LAYERS;
+
+#endif // FIXEDNETWORK_H
@@ -0,0 +1,204 @@
+#ifndef HYPERPARAMETERSEARCH_H
+#define HYPERPARAMETERSEARCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Dataset.h"
+#include "NeuralNetwork.h"
+
+/**
+ * @brief Valores candidatos de cada hiperparâmetro
+ *
+ * Todas as camadas ocultas de uma configuração têm o mesmo tamanho e a
+ * mesma ativação; a camada de saída é sempre Sigmoid (codificação das
+ * ações em [0, 1]). Ativações pelo nome de createActivation().
+ */
+struct SearchSpace {
+    std::vector<int> hiddenSizes = {3, 4, 5, 6, 7, 8};
+    std::vector<int> depths = {1, 2};
+    std::vector<std::string> activations = {"Sigmoid", "Tanh", "ReLU"};
+    std::vector<double> learningRates = {0.05, 0.1, 0.3, 0.5};
+    std::vector<double> momenta = {0.0, 0.5, 0.9};
+    std::vector<double> initRanges = {0.1, 0.5, 1.0};
+
+    /**
+     * @brief Número de combinações (tamanho da busca em grade)
+     */
+    std::size_t gridSize() const;
+};
+
+/**
+ * @brief Uma combinação de hiperparâmetros
+ */
+struct TrialConfig {
+    int hiddenSize = 5;
+    int depth = 1;
+    std::string activation = "Sigmoid";
+    double learningRate = 0.3;
+    double momentum = 0.9;
+    double initRange = 0.5;
+
+    /**
+     * @brief Arquitetura no formato "4-5-1"
+     */
+    std::string architecture(int inputSize, int outputSize) const;
+
+    /**
+     * @brief Cria a rede desta configuração, com pesos aleatórios
+     * @throws std::invalid_argument se a ativação for desconhecida
+     */
+    std::unique_ptr<NeuralNetwork> build(int inputSize, int outputSize) const;
+
+    /**
+     * @brief Cria a rede com semente fixa (a mesma semente dá os mesmos pesos)
+     * @throws std::invalid_argument se a ativação for desconhecida
+     */
+    std::unique_ptr<NeuralNetwork> build(int inputSize, int outputSize, uint64_t seed) const;
+};
+
+enum class SearchStrategy {
+    Grid,               // Todas as combinações
+    Random,             // trials combinações sorteadas (sem repetição)
+    SuccessiveHalving   // trials sorteadas; a cada rodada só 1/eta continua
+};
+
+/**
+ * @brief Orçamento e paralelismo da busca
+ */
+struct SearchConfig {
+    SearchStrategy strategy = SearchStrategy::SuccessiveHalving;
+    int trials = 54;                // Random e SuccessiveHalving (Grid usa todas)
+    int maxEpochs = 20000;          // Orçamento de uma configuração que vai até o fim
+    double errorThreshold = 0.0;    // Convergência no treino (0 = usa todo o orçamento)
+    int threads = 0;                // Trials em paralelo (0 = núcleos disponíveis)
+    uint64_t seed = 42;             // Sorteio das configurações e pesos iniciais dos trials
+
+    // SuccessiveHalving: orçamentos minEpochs, minEpochs*eta, ... até maxEpochs
+    int minEpochs = 500;
+    int eta = 3;
+
+    // Grid/Random: a cada evaluationInterval épocas, um trial cujo erro de
+    // validação esteja acima da mediana dos outros no mesmo ponto é interrompido
+    int evaluationInterval = 1000;
+    bool medianStopping = true;
+    int minTrialsForMedian = 4;     // Pontos de comparação necessários antes de interromper
+};
+
+/**
+ * @brief Resultado de uma configuração
+ */
+struct TrialResult {
+    int id = 0;
+    TrialConfig config;
+    uint64_t seed = 0;              // Semente da rede (build(in, out, seed) a recria)
+    double validationError = 0.0;   // MSE no conjunto de validação (infinito se falhou)
+    double trainingError = 0.0;     // MSE no conjunto de treinamento
+    int epochs = 0;                 // Épocas realmente treinadas
+    bool stopped = false;           // Interrompido por perder para os demais
+    double seconds = 0.0;
+    std::string error;              // Mensagem da exceção, se falhou
+};
+
+/**
+ * @brief Resultado da busca, do melhor para o pior
+ */
+struct SearchReport {
+    std::vector<TrialResult> results;
+    SearchStrategy strategy = SearchStrategy::Grid;
+    int inputSize = 0;
+    int outputSize = 0;
+    long long epochsTrained = 0;    // Soma das épocas de todos os trials
+    long long epochsBudget = 0;     // Sem interrupção: trials x maxEpochs
+    int threads = 0;
+    double seconds = 0.0;
+
+    const TrialResult& best() const { return results.front(); }
+};
+
+/**
+ * @brief Busca de hiperparâmetros para as redes do projeto
+ *
+ * Cada trial cria e treina a sua própria rede (trainBatch sem saída no
+ * console) e mede o erro no conjunto de validação. Os trials rodam em
+ * paralelo em threads sobre os mesmos datasets, lidos sem cópia: os que não
+ * aceitam leituras simultâneas (CSV, binário sem mmap) são lidos através
+ * de um SynchronizedDataset.
+ *
+ * Na busca em grade e na aleatória, os trials treinam em trechos de
+ * evaluationInterval épocas e o que estiver pior que a mediana dos outros
+ * no mesmo ponto é interrompido (parada pela mediana). No successive
+ * halving, todos treinam minEpochs, só o melhor 1/eta continua até
+ * minEpochs*eta, e assim por diante até maxEpochs.
+ *
+ * A busca é reprodutível: cada trial tem a semente derivada de
+ * (config.seed, id), treina numa única thread e a parada pela mediana
+ * compara cada trial só com os de id menor. Com a mesma semente, o
+ * relatório (erros, épocas, interrupções) é idêntico com 1 ou N threads.
+ *
+ * @code
+ *   SearchConfig config;
+ *   config.strategy = SearchStrategy::SuccessiveHalving;
+ *   CsvDataset training("sensores.csv", 4, 1);
+ *   SearchReport report = HyperparameterSearch(SearchSpace(), config).run(training, validation);
+ *   printSearchReport(report);
+ *   std::unique_ptr<NeuralNetwork> network = report.best().config.build(4, 1);
+ * @endcode
+ */
+class HyperparameterSearch {
+public:
+    /**
+     * @throws std::invalid_argument se o espaço tiver lista vazia ou ativação desconhecida,
+     *         ou se o orçamento for inválido
+     */
+    HyperparameterSearch(const SearchSpace& space, const SearchConfig& config = SearchConfig());
+
+    /**
+     * @brief Configurações que serão avaliadas (grade completa ou sorteio)
+     */
+    std::vector<TrialConfig> candidates() const;
+
+    /**
+     * @brief Executa a busca
+     * @param training Conjunto de treino de cada trial
+     * @param validation Conjunto que ordena os trials (pode ser o mesmo objeto)
+     * @throws std::invalid_argument se um dos conjuntos estiver vazio ou os
+     *         tamanhos de entrada/saída forem diferentes
+     */
+    SearchReport run(const Dataset& training, const Dataset& validation);
+
+    /**
+     * @brief Executa a busca sobre vetores em memória
+     * @throws std::invalid_argument se um dos conjuntos estiver vazio ou incompleto
+     */
+    SearchReport run(const std::vector<std::vector<double>>& trainInputs,
+                     const std::vector<std::vector<double>>& trainTargets,
+                     const std::vector<std::vector<double>>& validationInputs,
+                     const std::vector<std::vector<double>>& validationTargets);
+
+    const SearchSpace& getSpace() const { return space; }
+    const SearchConfig& getConfig() const { return config; }
+
+private:
+    SearchSpace space;
+    SearchConfig config;
+
+    TrialConfig configAt(std::size_t index) const;
+    uint64_t trialSeed(std::size_t index) const;
+    int threadCount(std::size_t trials) const;
+};
+
+/**
+ * @brief Nome da estratégia ("grade", "aleatória", "successive halving")
+ */
+const char* searchStrategyName(SearchStrategy strategy);
+
+/**
+ * @brief Exibe as melhores configurações em formato de tabela
+ * @param rows Linhas da tabela (0 = todas)
+ */
+void printSearchReport(const SearchReport& report, std::size_t rows = 10);
+
+#endif // HYPERPARAMETERSEARCH_H
@@ -0,0 +1,232 @@
+#ifndef INFERENCESERVER_H
+#define INFERENCESERVER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "ModelHandle.h"
+
+/**
+ * @brief Limites de formação dos lotes
+ *
+ * Um lote é avaliado assim que tiver maxBatch pedidos ou quando o pedido
+ * mais antigo completar maxDelayUs de espera, o que vier primeiro.
+ */
+struct InferenceConfig {
+    std::size_t maxBatch;
+    double maxDelayUs;
+
+    InferenceConfig(std::size_t batch = 32, double delayUs = 200.0)
+        : maxBatch(batch), maxDelayUs(delayUs) {}
+};
+
+/**
+ * @brief Servidor de inferência em lote para vários robôs
+ *
+ * Os pipelines de controle de cada robô chamam submit() de suas próprias
+ * threads e recebem um std::future; uma thread do servidor junta os
+ * pedidos que chegam dentro da janela e os avalia de uma vez com
+ * Network::predictBatch (os pesos de cada neurônio são lidos uma vez por
+ * lote). Os pesos são somente leitura e compartilhados
+ * (std::shared_ptr<const Network>), como em
+ * NeuralCollisionAvoidance::shareNetwork, e podem ser trocados com
+ * publish() sem parar o servidor.
+ *
+ * Só há o que agrupar quando vários pipelines pedem ao mesmo tempo: um
+ * único chamador que espera cada resultado paga até maxDelayUs por
+ * decisão. No FleetSupervisor, o lote é limitado ao número de workers.
+ *
+ * Network precisa de Input, Output e predictBatch (ex.: FixedNetwork).
+ *
+ * @code
+ *   InferenceServer<FixedNetwork<4, 5, 1>> server(weights, InferenceConfig(16, 200.0));
+ *   std::future<FixedNetwork<4, 5, 1>::Output> result = server.submit(input);
+ *   double action = result.get()[0];
+ * @endcode
+ */
+template<class Network>
+class InferenceServer {
+public:
+    typedef typename Network::Input Input;
+    typedef typename Network::Output Output;
+
+    /**
+     * @throws std::invalid_argument se a rede for nula ou maxBatch for zero
+     */
+    explicit InferenceServer(std::shared_ptr<const Network> weights,
+                             const InferenceConfig& inferenceConfig = InferenceConfig())
+        : model(weights), reader(model), config(inferenceConfig), stopping(false),
+          requests(0), batches(0), fullBatches(0), largestBatch(0) {
+        if (!weights) {
+            throw std::invalid_argument("InferenceServer: rede nula");
+        }
+        if (config.maxBatch == 0) {
+            throw std::invalid_argument("InferenceServer: maxBatch deve ser positivo");
+        }
+        pending.reserve(config.maxBatch);
+        batch.reserve(config.maxBatch);
+        inputs.resize(config.maxBatch);
+        outputs.resize(config.maxBatch);
+        worker = std::thread(&InferenceServer::serve, this);
+    }
+
+    /**
+     * @brief Avalia os pedidos pendentes e encerra a thread
+     */
+    ~InferenceServer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+
+    InferenceServer(const InferenceServer&) = delete;
+    InferenceServer& operator=(const InferenceServer&) = delete;
+
+    /**
+     * @brief Enfileira uma entrada (não bloqueia)
+     * @throws std::logic_error se o servidor estiver encerrando
+     */
+    std::future<Output> submit(const Input& input) {
+        Request request;
+        request.input = input;
+        request.arrival = std::chrono::steady_clock::now();
+        std::future<Output> result = request.promise.get_future();
+        bool notify;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping) {
+                throw std::logic_error("InferenceServer: servidor encerrando");
+            }
+            pending.push_back(std::move(request));
+            // Só o primeiro pedido (início do prazo) e o lote cheio acordam o servidor
+            notify = pending.size() == 1 || pending.size() == config.maxBatch;
+        }
+        if (notify) {
+            wake.notify_one();
+        }
+        return result;
+    }
+
+    /**
+     * @brief Atalho bloqueante: submit(input).get()
+     */
+    Output predict(const Input& input) {
+        return submit(input).get();
+    }
+
+    /**
+     * @brief Troca os pesos (qualquer thread): o próximo lote já usa os novos
+     * @throws std::invalid_argument se a rede for nula
+     */
+    void publish(std::shared_ptr<const Network> weights) {
+        if (!weights) {
+            throw std::invalid_argument("InferenceServer: rede nula");
+        }
+        model.publish(std::move(weights));
+    }
+
+    const InferenceConfig& getConfig() const { return config; }
+    uint64_t getRequests() const { return requests.load(std::memory_order_relaxed); }
+    uint64_t getBatches() const { return batches.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Lotes avaliados por terem atingido maxBatch (os demais, pelo prazo)
+     */
+    uint64_t getFullBatches() const { return fullBatches.load(std::memory_order_relaxed); }
+    uint64_t getLargestBatch() const { return largestBatch.load(std::memory_order_relaxed); }
+
+    double getMeanBatch() const {
+        uint64_t count = getBatches();
+        return count > 0 ? static_cast<double>(getRequests()) / count : 0.0;
+    }
+
+private:
+    struct Request {
+        Input input;
+        std::promise<Output> promise;
+        std::chrono::steady_clock::time_point arrival;
+    };
+
+    ModelHandle<Network> model;
+    typename ModelHandle<Network>::Reader reader;   // Só a thread do servidor
+    InferenceConfig config;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::vector<Request> pending;   // Em ordem de chegada
+    bool stopping;
+    std::thread worker;
+
+    // Usados só pela thread do servidor (reaproveitados entre lotes)
+    std::vector<Request> batch;
+    std::vector<Input> inputs;
+    std::vector<Output> outputs;
+
+    std::atomic<uint64_t> requests;
+    std::atomic<uint64_t> batches;
+    std::atomic<uint64_t> fullBatches;
+    std::atomic<uint64_t> largestBatch;
+
+    void serve() {
+        const std::chrono::nanoseconds delay(static_cast<int64_t>(config.maxDelayUs * 1000.0));
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this] { return stopping || !pending.empty(); });
+                if (pending.empty()) {
+                    return;
+                }
+                // Espera encher o lote até o prazo do pedido mais antigo
+                const std::chrono::steady_clock::time_point deadline = pending.front().arrival + delay;
+                wake.wait_until(lock, deadline, [this] {
+                    return stopping || pending.size() >= config.maxBatch;
+                });
+                const std::size_t count = pending.size() < config.maxBatch ? pending.size() : config.maxBatch;
+                for (std::size_t i = 0; i < count; ++i) {
+                    batch.push_back(std::move(pending[i]));
+                }
+                // Os que sobram mantêm a hora de chegada: prazo vencido, próximo lote já
+                pending.erase(pending.begin(), pending.begin() + count);
+            }
+            evaluate();
+        }
+    }
+
+    void evaluate() {
+        const std::size_t count = batch.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            inputs[i] = batch[i].input;
+        }
+        {
+            typename ModelHandle<Network>::ReadGuard network(reader);
+            network->predictBatch(inputs.data(), outputs.data(), count);
+        }
+
+        // Contadores antes dos resultados: quem recebeu a resposta já vê o lote
+        requests.fetch_add(count, std::memory_order_relaxed);
+        batches.fetch_add(1, std::memory_order_relaxed);
+        if (count == config.maxBatch) {
+            fullBatches.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (count > largestBatch.load(std::memory_order_relaxed)) {
+            largestBatch.store(count, std::memory_order_relaxed);
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            batch[i].promise.set_value(outputs[i]);
+        }
+        batch.clear();
+    }
+};
+
+#endif // INFERENCESERVER_H
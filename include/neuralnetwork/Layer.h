@@ -3,9 +3,38 @@
 
 #include <vector>
 #include <memory>
-#include <random>
+#include <cstdint>
 #include "ActivationFunction.h"
 
+class CounterRng;
+
+/**
+ * @brief Inicialização dos pesos de uma camada
+ */
+enum class WeightInit {
+    Uniform,    // U(-weightInitRange, +weightInitRange), bias com 1/10 da amplitude
+    Xavier,     // U(±√(6 / (entradas + neurônios))), bias zero: Sigmoid, Tanh
+    He          // U(±√(6 / entradas)), bias zero: ReLU
+};
+
+/**
+ * @brief Inicialização e regularização de uma camada
+ * 
+ * dropout: no treino, cada saída da camada é desligada com essa
+ * probabilidade e as demais são multiplicadas por 1 / (1 - dropout)
+ * (inverted dropout). Na predição não há máscara nem escala: predict()
+ * e forwardBatch() fazem as mesmas contas de uma camada sem dropout.
+ * 
+ * weightDecay: regularização L2; a atualização usa gradiente + λ·peso
+ * (os bias não decaem).
+ */
+struct LayerConfig {
+    WeightInit init = WeightInit::Uniform;
+    double weightInitRange = 0.5;   // Só para WeightInit::Uniform
+    double dropout = 0.0;           // Fração das saídas desligadas no treino [0, 1)
+    double weightDecay = 0.0;       // λ da regularização L2 (>= 0)
+};
+
 /**
  * @brief Representa uma camada (layer) na rede neural
  * 
@@ -34,14 +63,24 @@ private:
     // Função de ativação desta camada
     std::shared_ptr<ActivationFunction> activationFunction;
     
+    WeightInit init;                     // Inicialização usada (gravada com o modelo)
+    
     // Valores intermediários (guardados para backpropagation)
     std::vector<double> inputs;          // Entradas recebidas
     std::vector<double> weightedSums;    // Somas ponderadas (antes da ativação)
     std::vector<double> activations;     // Saídas após ativação
     
+    // Dropout: máscara da última amostra de treino (0 ou 1 / (1 - dropout))
+    double dropout;
+    std::vector<double> dropoutMask;
+    bool masked;                         // A última forward aplicou a máscara
+    
+    double weightDecay;                  // λ da regularização L2
+    
     // Gradientes (para backpropagation)
     std::vector<std::vector<double>> weightGradients;
     std::vector<double> biasGradients;
+    double gradientNormSquared;          // ||gradiente||² do último backward
     
     // Momentum (para otimização)
     std::vector<std::vector<double>> weightVelocity;
@@ -59,6 +98,28 @@ public:
           std::shared_ptr<ActivationFunction> activationFunc,
           double weightInitRange = 0.5);
     
+    /**
+     * @brief Construtor com pesos iniciais reprodutíveis
+     * @param seed Semente da rede
+     * @param stream Fluxo desta camada (índice da camada na rede)
+     * 
+     * Os pesos dependem só de (seed, stream, dimensões, weightInitRange).
+     */
+    Layer(int inputSize, int neurons,
+          std::shared_ptr<ActivationFunction> activationFunc,
+          double weightInitRange, uint64_t seed, uint64_t stream);
+    
+    /**
+     * @brief Construtor com inicialização e regularização configuráveis
+     * @param config Inicialização, dropout e weight decay (ver LayerConfig)
+     * @param seed Semente da rede
+     * @param stream Fluxo desta camada (índice da camada na rede)
+     * @throws std::invalid_argument se dropout estiver fora de [0, 1) ou weightDecay < 0
+     */
+    Layer(int inputSize, int neurons,
+          std::shared_ptr<ActivationFunction> activationFunc,
+          const LayerConfig& config, uint64_t seed, uint64_t stream);
+    
     /**
      * @brief Forward propagation - calcula as saídas da camada
      * @param input Vetor de entradas
@@ -66,6 +127,26 @@ public:
      */
     std::vector<double> forward(const std::vector<double>& input);
     
+    /**
+     * @brief Forward de treino: aplica o dropout da camada, se houver
+     * @param input Vetor de entradas
+     * @param rng Fluxo da máscara desta amostra nesta camada
+     * @return Ativações com a máscara aplicada (usada pelo próximo backward)
+     * 
+     * Sem dropout, igual a forward() e não consome números de rng.
+     */
+    std::vector<double> forwardTraining(const std::vector<double>& input, CounterRng& rng);
+    
+    /**
+     * @brief Forward de um lote, sem guardar estado (pode rodar em paralelo)
+     * @param input Entradas em linhas contíguas [rows][inputSize]
+     * @param rows Número de amostras
+     * @param output Recebe as ativações [rows][neurons] (redimensionado)
+     * 
+     * Mesmas operações, na mesma ordem, de forward(): resultado idêntico.
+     */
+    void forwardBatch(const double* input, size_t rows, std::vector<double>& output) const;
+    
     /**
      * @brief Backward propagation - calcula gradientes
      * @param outputGradients Gradientes vindos da camada seguinte
@@ -77,6 +158,8 @@ public:
      * @brief Atualiza os pesos e bias usando os gradientes calculados
      * @param learningRate Taxa de aprendizado
      * @param momentum Fator de momentum para suavizar atualizações
+     * 
+     * Com weightDecay, o gradiente de cada peso recebe + weightDecay * peso.
      */
     void updateWeights(double learningRate, double momentum);
     
@@ -92,6 +175,35 @@ public:
      */
     int getInputSize() const { return inputSize; }
     
+    /**
+     * @brief Quadrado da norma L2 do gradiente (pesos e bias) do último backward
+     */
+    double getGradientNormSquared() const { return gradientNormSquared; }
+    
+    /**
+     * @brief Fração das saídas desligadas no treino (0 = sem dropout)
+     */
+    double getDropout() const { return dropout; }
+    
+    /**
+     * @brief Coeficiente da regularização L2 (0 = sem weight decay)
+     */
+    double getWeightDecay() const { return weightDecay; }
+    
+    /**
+     * @brief Inicialização com que os pesos da camada foram criados
+     */
+    WeightInit getInit() const { return init; }
+    
+    /**
+     * @brief Troca inicialização, dropout e weight decay sem mexer nos pesos
+     * 
+     * Usado ao carregar um modelo salvo: a configuração gravada vale para a
+     * continuação do treino. weightInitRange é ignorado.
+     * @throws std::invalid_argument se dropout estiver fora de [0, 1) ou weightDecay < 0
+     */
+    void setConfig(const LayerConfig& config);
+    
     /**
      * @brief Retorna as últimas ativações calculadas
      * @return Vetor de ativações
@@ -110,6 +222,29 @@ public:
      */
     void setBias(const std::vector<double>& newBias);
     
+    /**
+     * @brief Define o momentum acumulado (usado ao retomar um treinamento)
+     * @param newWeightVelocity Matriz [inputSize][neurons]
+     * @param newBiasVelocity Vetor [neurons]
+     */
+    void setVelocity(const std::vector<std::vector<double>>& newWeightVelocity,
+                     const std::vector<double>& newBiasVelocity);
+    
+    /**
+     * @brief Zera o momentum (pesos carregados sem estado de treinamento)
+     */
+    void resetVelocity();
+    
+    /**
+     * @brief Obtém o momentum acumulado dos pesos
+     */
+    const std::vector<std::vector<double>>& getWeightVelocity() const { return weightVelocity; }
+    
+    /**
+     * @brief Obtém o momentum acumulado dos bias
+     */
+    const std::vector<double>& getBiasVelocity() const { return biasVelocity; }
+    
     /**
      * @brief Obtém os pesos atuais da camada
      * @return Matriz de pesos
@@ -133,9 +268,11 @@ public:
 private:
     /**
      * @brief Inicializa os pesos aleatoriamente
-     * @param range Amplitude da inicialização
+     * @param config Tipo de inicialização (e amplitude, se uniforme)
+     * @param seed Semente da rede
+     * @param stream Fluxo desta camada
      */
-    void initializeWeights(double range);
+    void initializeWeights(const LayerConfig& config, uint64_t seed, uint64_t stream);
 };
 
 #endif // LAYER_H
@@ -0,0 +1,251 @@
+#ifndef MODELHANDLE_H
+#define MODELHANDLE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Modelo publicado por ponteiro atômico, no estilo RCU
+ *
+ * Quem carrega um modelo novo o constrói fora do laço de controle e chama
+ * publish(): uma troca atômica de ponteiro. O laço de controle lê com um
+ * ReadGuard (duas escritas atômicas e uma leitura, sem mutex, sem contagem
+ * de referências, sem alocação) e passa a ver o modelo novo no ciclo
+ * seguinte.
+ *
+ * Versões antigas são liberadas por época: cada Reader anuncia a época
+ * global ao entrar na leitura e zera o anúncio ao sair. Uma versão
+ * substituída na época E só é destruída quando nenhum leitor ativo anunciou
+ * época anterior a E, ou seja, quando ninguém pode mais estar usando o
+ * ponteiro antigo. A liberação acontece em publish() e collect(), sempre do
+ * lado de quem publica; o leitor nunca espera nem libera memória.
+ *
+ * Cada thread leitora usa o seu Reader (um slot fixo, reservado na
+ * construção); leituras não podem ser aninhadas no mesmo Reader, e nenhum
+ * Reader pode sobreviver ao handle.
+ *
+ * @code
+ *   ModelHandle<FixedNetwork<4, 5, 1>> model(initialWeights);
+ *   ModelHandle<FixedNetwork<4, 5, 1>>::Reader reader(model);   // Thread de controle
+ *   {
+ *       ModelHandle<FixedNetwork<4, 5, 1>>::ReadGuard current(reader);
+ *       output = current->predict(input);
+ *   }
+ *   model.publish(std::make_shared<const FixedNetwork<4, 5, 1>>(reloaded));   // Outra thread
+ * @endcode
+ */
+template<class T>
+class ModelHandle {
+private:
+    static const std::size_t CACHE_LINE = 64;
+
+    // Um slot por linha de cache: leitores vizinhos não disputam a mesma linha
+    struct alignas(CACHE_LINE) Slot {
+        std::atomic<bool> used;
+        std::atomic<uint64_t> epoch;   // 0 = fora de leitura
+
+        Slot() : used(false), epoch(0) {}
+    };
+    static_assert(sizeof(Slot) % CACHE_LINE == 0, "Slot precisa ocupar linhas de cache inteiras");
+
+public:
+    /**
+     * @brief Slot de leitura de uma thread
+     */
+    class Reader {
+    public:
+        /**
+         * @throws std::length_error se todos os slots estiverem em uso
+         */
+        explicit Reader(ModelHandle& model) : handle(model), slot(nullptr) {
+            for (std::size_t i = 0; i < handle.slotCount; ++i) {
+                bool expected = false;
+                if (handle.slots[i].used.compare_exchange_strong(expected, true)) {
+                    slot = &handle.slots[i];
+                    return;
+                }
+            }
+            throw std::length_error("ModelHandle: todos os slots de leitura estão em uso");
+        }
+
+        ~Reader() {
+            slot->epoch.store(0, std::memory_order_release);
+            slot->used.store(false, std::memory_order_release);
+        }
+
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        /**
+         * @brief Entra na leitura e devolve o modelo atual (pode ser nulo)
+         *
+         * O ponteiro vale até exit(). Prefira ReadGuard.
+         */
+        const T* enter() {
+            slot->epoch.store(handle.epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+            return handle.current.load(std::memory_order_seq_cst);
+        }
+
+        void exit() {
+            slot->epoch.store(0, std::memory_order_release);
+        }
+
+    private:
+        ModelHandle& handle;
+        Slot* slot;
+    };
+
+    /**
+     * @brief Leitura com escopo: o modelo não é liberado enquanto o guard existir
+     */
+    class ReadGuard {
+    public:
+        explicit ReadGuard(Reader& r) : reader(r), model(r.enter()) {}
+        ~ReadGuard() { reader.exit(); }
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        const T* get() const { return model; }
+        const T* operator->() const { return model; }
+        const T& operator*() const { return *model; }
+        explicit operator bool() const { return model != nullptr; }
+
+    private:
+        Reader& reader;
+        const T* model;
+    };
+
+    /**
+     * @param initial Modelo inicial (nulo = nenhum até o primeiro publish)
+     * @param maxReaders Número máximo de Readers simultâneos
+     * @throws std::invalid_argument se maxReaders for zero
+     */
+    explicit ModelHandle(std::shared_ptr<const T> initial = std::shared_ptr<const T>(),
+                         std::size_t maxReaders = 16)
+        : slotStorage(new unsigned char[(std::max<std::size_t>(maxReaders, 1) + 1) * sizeof(Slot)]),
+          slots(createSlots(slotStorage.get(), std::max<std::size_t>(maxReaders, 1))), slotCount(maxReaders),
+          current(initial.get()), epoch(1), published(std::move(initial)),
+          version(published ? 1 : 0), reclaimed(0) {
+        if (maxReaders == 0) {
+            throw std::invalid_argument("ModelHandle: maxReaders deve ser positivo");
+        }
+    }
+
+    ModelHandle(const ModelHandle&) = delete;
+    ModelHandle& operator=(const ModelHandle&) = delete;
+
+    /**
+     * @brief Publica um novo modelo (qualquer thread; não bloqueia os leitores)
+     *
+     * Publicações concorrentes são serializadas entre si por um mutex que os
+     * leitores nunca tomam.
+     */
+    void publish(std::shared_ptr<const T> model) {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        current.store(model.get(), std::memory_order_seq_cst);
+        // Leitores que ainda podem ter o ponteiro antigo anunciaram época < retireEpoch
+        const uint64_t retireEpoch = epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+        if (published) {
+            retired.push_back(Retired{std::move(published), retireEpoch});
+        }
+        published = std::move(model);
+        version.fetch_add(1, std::memory_order_relaxed);
+        reclaim();
+    }
+
+    /**
+     * @brief Libera as versões antigas que nenhum leitor pode mais estar usando
+     * @return Versões antigas ainda pendentes
+     */
+    std::size_t collect() {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        reclaim();
+        return retired.size();
+    }
+
+    /**
+     * @brief Modelo atual com posse (lado de quem publica; toma o mutex)
+     */
+    std::shared_ptr<const T> get() const {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        return published;
+    }
+
+    /**
+     * @brief Número de modelos publicados (incluindo o inicial)
+     */
+    uint64_t getVersion() const { return version.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Versões antigas já destruídas
+     */
+    uint64_t getReclaimed() const { return reclaimed.load(std::memory_order_relaxed); }
+
+    std::size_t getPending() const {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        return retired.size();
+    }
+
+private:
+    struct Retired {
+        std::shared_ptr<const T> model;
+        uint64_t epoch;
+    };
+
+    // O new do C++14 ignora alignas(64): slots construídos numa área alinhada à mão
+    std::unique_ptr<unsigned char[]> slotStorage;
+    Slot* slots;
+    std::size_t slotCount;
+    std::atomic<const T*> current;
+    std::atomic<uint64_t> epoch;
+
+    // Lado de quem publica (protegido por writerMutex)
+    mutable std::mutex writerMutex;
+    std::shared_ptr<const T> published;
+    std::vector<Retired> retired;
+
+    std::atomic<uint64_t> version;
+    std::atomic<uint64_t> reclaimed;
+
+    static Slot* createSlots(unsigned char* storage, std::size_t count) {
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(storage);
+        address = (address + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+        Slot* first = reinterpret_cast<Slot*>(address);
+        for (std::size_t i = 0; i < count; ++i) {
+            new (first + i) Slot();   // Slot é trivialmente destrutível
+        }
+        return first;
+    }
+
+    void reclaim() {
+        uint64_t oldest = std::numeric_limits<uint64_t>::max();
+        for (std::size_t i = 0; i < slotCount; ++i) {
+            uint64_t announced = slots[i].epoch.load(std::memory_order_seq_cst);
+            if (announced != 0 && announced < oldest) {
+                oldest = announced;
+            }
+        }
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < retired.size(); ++i) {
+            if (retired[i].epoch <= oldest) {
+                retired[i].model.reset();
+                reclaimed.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                retired[kept++] = std::move(retired[i]);
+            }
+        }
+        retired.resize(kept);
+    }
+};
+
+#endif // MODELHANDLE_H
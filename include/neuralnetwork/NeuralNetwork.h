@@ -1,11 +1,60 @@
 #ifndef NEURALNETWORK_H
 #define NEURALNETWORK_H
 
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <string>
+#include <utility>
+#include <iosfwd>
 #include "Layer.h"
 #include "ActivationFunction.h"
+#include "Dataset.h"
+#include "TrainingObserver.h"
+#include "Evaluation.h"
+
+/**
+ * @brief Configuração de validação periódica, early stopping e checkpoints
+ * 
+ * Usada pela sobrecarga de NeuralNetwork::trainBatch que consulta um
+ * conjunto de validação durante o treinamento. A cada validationInterval
+ * épocas o erro de validação é medido; se melhorar, os pesos são guardados
+ * como melhor modelo (e gravados em checkpointFile, se definido). Após
+ * patience validações seguidas sem melhora o treinamento é interrompido.
+ * 
+ * stateFile guarda, a cada checkpointInterval épocas e na última, o estado
+ * para retomar: pesos e momentum atuais, épocas concluídas, melhor erro de
+ * validação (e a época dele) e o contador de paciência. Com resume, o
+ * treinamento continua desse estado (ou, se não houver stateFile, do melhor
+ * modelo) e segue como se não tivesse sido interrompido; os pesos a
+ * restaurar ao final vêm de checkpointFile. Sem checkpointFile, só um
+ * melhor modelo encontrado depois da retomada é restaurado.
+ * 
+ * O formato dos arquivos segue a extensão: ".bin" grava o formato binário,
+ * qualquer outra extensão grava JSON.
+ * 
+ * observers recebem as métricas de cada época (erro, validação, norma do
+ * gradiente, tempo); com verbose, a saída no console é um observador a mais.
+ */
+struct EarlyStoppingConfig {
+    // Conjunto de validação (nullptr = sem validação, apenas errorThreshold)
+    const std::vector<std::vector<double>>* validationInputs = nullptr;
+    const std::vector<std::vector<double>>* validationTargets = nullptr;
+    const Dataset* validationDataset = nullptr;  // Alternativa aos vetores (ex.: CsvDataset)
+    
+    int validationInterval = 100;   // Épocas entre validações
+    int patience = 20;              // Validações sem melhora antes de parar (0 = nunca para)
+    double minDelta = 1e-6;         // Melhora mínima para considerar progresso
+    
+    bool restoreBestWeights = true; // Ao final, volta aos pesos com menor erro de validação
+    
+    std::string checkpointFile;     // Arquivo do melhor modelo (vazio = sem checkpoint)
+    std::string stateFile;          // Estado para retomar o treino (vazio = não grava)
+    int checkpointInterval = 100;   // Épocas entre gravações de stateFile (0 = só a última)
+    bool resume = false;            // Retoma de stateFile (ou checkpointFile), se existir
+    
+    std::vector<TrainingObserver*> observers;  // Não pertencem à configuração
+};
 
 /**
  * @brief Classe principal da rede neural feedforward
@@ -17,6 +66,7 @@
  * - Rede feedforward totalmente conectada
  * - Número arbitrário de camadas ocultas
  * - Funções de ativação configuráveis por camada
+ * - Inicialização Xavier/He, dropout e weight decay por camada (LayerConfig)
  * - Treinamento por backpropagation com momentum
  * 
  * Exemplo de uso para collision avoidance:
@@ -37,6 +87,16 @@ private:
     // Métricas de treinamento
     double lastError;
     int trainingIterations;
+    double lastGradientNormSquared;  // ||gradiente||² do último train()
+    int completedEpochs;          // Épocas concluídas (gravado nos checkpoints)
+    double bestValidationError;   // Melhor erro de validação já observado
+    int bestValidationEpoch;      // Época do melhor erro de validação
+    int stalledValidations;       // Validações seguidas sem melhora (paciência)
+    
+    // Reprodutibilidade: camada l usa o fluxo (seed, l); o embaralhamento, um fluxo próprio
+    uint64_t seed;
+    uint64_t shuffledEpochs;      // Épocas já embaralhadas (a próxima usa o índice seguinte)
+    uint64_t trainedSamples;      // Amostras já treinadas (índice das máscaras de dropout)
 
 public:
     /**
@@ -50,6 +110,21 @@ public:
                   double learningRate = 0.3, 
                   double momentum = 0.9);
     
+    /**
+     * @brief Fixa a semente dos pesos iniciais e do embaralhamento
+     * @param networkSeed Semente (mesma semente e mesmas chamadas = mesmos pesos, bit a bit)
+     * @throws std::logic_error se alguma camada já foi criada
+     * 
+     * Sem esta chamada, a semente é sorteada na construção (getSeed() a
+     * informa, para repetir o treinamento depois).
+     */
+    void setSeed(uint64_t networkSeed);
+    
+    /**
+     * @brief Obtém a semente da rede
+     */
+    uint64_t getSeed() const { return seed; }
+    
     /**
      * @brief Adiciona uma camada oculta à rede
      * @param neurons Número de neurônios na camada
@@ -62,6 +137,20 @@ public:
                        std::shared_ptr<ActivationFunction> activationFunc,
                        double weightInitRange = 0.5);
     
+    /**
+     * @brief Adiciona uma camada oculta com inicialização e regularização próprias
+     * @param neurons Número de neurônios na camada
+     * @param activationFunc Função de ativação
+     * @param config Inicialização (uniforme, Xavier, He), dropout e weight decay
+     * @throws std::invalid_argument se dropout estiver fora de [0, 1) ou weightDecay < 0
+     * 
+     * As máscaras de dropout vêm de um fluxo da semente da rede, indexado
+     * pela amostra treinada: com setSeed, o treino continua reprodutível.
+     */
+    void addHiddenLayer(int neurons,
+                       std::shared_ptr<ActivationFunction> activationFunc,
+                       const LayerConfig& config);
+    
     /**
      * @brief Finaliza a construção da rede, adicionando a camada de saída
      * @param activationFunc Função de ativação da camada de saída
@@ -70,6 +159,15 @@ public:
     void finalize(std::shared_ptr<ActivationFunction> activationFunc,
                  double weightInitRange = 0.5);
     
+    /**
+     * @brief Finaliza a rede com inicialização e weight decay próprios na saída
+     * @param activationFunc Função de ativação da camada de saída
+     * @param config Inicialização e weight decay (ver LayerConfig)
+     * @throws std::invalid_argument se config.dropout != 0 (a saída não usa dropout)
+     */
+    void finalize(std::shared_ptr<ActivationFunction> activationFunc,
+                 const LayerConfig& config);
+    
     /**
      * @brief Realiza predição (forward propagation) com entrada fornecida
      * @param input Vetor de entrada
@@ -81,7 +179,7 @@ public:
      * @brief Treina a rede com um único exemplo
      * @param input Vetor de entrada
      * @param target Vetor de saída esperada
-     * @return Erro quadrático médio para este exemplo
+     * @return Erro quadrático médio para este exemplo (com o dropout aplicado)
      */
     double train(const std::vector<double>& input, 
                 const std::vector<double>& target);
@@ -101,6 +199,41 @@ public:
                   double errorThreshold = 0.001,
                   bool verbose = true);
     
+    /**
+     * @brief Treina a rede com validação periódica e early stopping
+     * @param inputs Conjunto de vetores de entrada
+     * @param targets Conjunto de vetores de saída esperada
+     * @param epochs Número máximo de épocas (contando épocas já retomadas)
+     * @param errorThreshold Limiar de erro de treinamento para parada antecipada
+     * @param verbose Se true, exibe progresso do treinamento
+     * @param config Validação, paciência e checkpoint (ver EarlyStoppingConfig)
+     * @return Número de épocas executadas
+     */
+    int trainBatch(const std::vector<std::vector<double>>& inputs,
+                  const std::vector<std::vector<double>>& targets,
+                  int epochs,
+                  double errorThreshold,
+                  bool verbose,
+                  const EarlyStoppingConfig& config);
+    
+    /**
+     * @brief Treina a rede com um dataset possivelmente maior que a memória
+     * @param data Dataset de treinamento (memória, CSV ou binário)
+     * @param epochs Número máximo de épocas
+     * @param errorThreshold Limiar de erro de treinamento para parada antecipada
+     * @param verbose Se true, exibe progresso do treinamento
+     * @param config Validação, paciência e checkpoint (ver EarlyStoppingConfig)
+     * @return Número de épocas executadas
+     * 
+     * As amostras são embaralhadas por blocos (Dataset::getBlockSize()),
+     * mantendo a leitura sequencial dentro de cada bloco.
+     */
+    int trainBatch(const Dataset& data,
+                  int epochs,
+                  double errorThreshold = 0.001,
+                  bool verbose = true,
+                  const EarlyStoppingConfig& config = EarlyStoppingConfig());
+    
     /**
      * @brief Valida a rede com conjunto de dados de validação
      * @param inputs Conjunto de vetores de entrada
@@ -113,16 +246,47 @@ public:
                    bool verbose = true);
     
     /**
-     * @brief Salva os pesos da rede em arquivo JSON
+     * @brief Valida a rede com um dataset (memória, CSV ou binário)
+     * @param data Dataset de validação
+     * @param verbose Se true, exibe resultados detalhados
+     * @return Erro médio no conjunto de validação
+     * 
+     * Sem verbose, usa evaluate() (lotes, sem formatação).
+     */
+    double validate(const Dataset& data, bool verbose = true);
+    
+    /**
+     * @brief Avalia a rede em lotes, em paralelo para conjuntos grandes
+     * @param data Dataset avaliado (lido por uma thread de cada vez)
+     * @param config Faixas das ações, tamanho do lote e threads
+     * @return Erro, MSE, matriz de confusão e acurácia; nada é impresso
+     * @throws std::invalid_argument se as dimensões do dataset não baterem com a rede
+     * 
+     * Não altera a rede (pode rodar junto com outras leituras). Os lotes
+     * são reduzidos na ordem do dataset: o resultado é o mesmo com
+     * qualquer número de threads. printEvaluationReport() formata.
+     */
+    EvaluationResult evaluate(const Dataset& data, const EvaluationConfig& config = EvaluationConfig()) const;
+    
+    EvaluationResult evaluate(const std::vector<std::vector<double>>& inputs,
+                              const std::vector<std::vector<double>>& targets,
+                              const EvaluationConfig& config = EvaluationConfig()) const;
+    
+    /**
+     * @brief Salva os pesos da rede em arquivo JSON (ou binário, se ".bin")
      * @param filename Nome do arquivo
      * @return true se salvou com sucesso
      */
     bool saveWeights(const std::string& filename) const;
     
     /**
-     * @brief Carrega os pesos da rede de arquivo JSON
+     * @brief Carrega os pesos da rede de arquivo JSON (ou binário, se ".bin")
      * @param filename Nome do arquivo
      * @return true se carregou com sucesso
+     * 
+     * Se a rede já possui camadas, as dimensões do arquivo precisam ser
+     * iguais às da rede. Se a rede ainda não tem camadas, elas são criadas
+     * a partir do arquivo (tamanhos e funções de ativação).
      */
     bool loadWeights(const std::string& filename);
     
@@ -150,13 +314,102 @@ public:
      */
     int getTrainingIterations() const { return trainingIterations; }
     
+    /**
+     * @brief Obtém o número de épocas concluídas (inclui épocas retomadas de checkpoint)
+     * @return Número de épocas
+     */
+    int getCompletedEpochs() const { return completedEpochs; }
+    
+    /**
+     * @brief Obtém o melhor erro de validação observado durante o treinamento
+     * @return Melhor erro de validação (infinito se nunca validou)
+     */
+    double getBestValidationError() const { return bestValidationError; }
+    
+    /**
+     * @brief Obtém a época do melhor erro de validação (0 se nunca validou)
+     */
+    int getBestValidationEpoch() const { return bestValidationEpoch; }
+    
+    /**
+     * @brief Obtém as camadas da rede (entrada → saída)
+     * @return Vetor de camadas
+     */
+    const std::vector<std::shared_ptr<Layer>>& getLayers() const { return layers; }
+    
+    /**
+     * @brief Obtém o número de entradas da rede
+     */
+    int getInputSize() const { return inputSize; }
+    
+    /**
+     * @brief Obtém o número de saídas da rede
+     */
+    int getOutputSize() const { return outputSize; }
+    
     /**
      * @brief Obtém informações sobre a arquitetura da rede
      * @return String descrevendo a arquitetura
      */
     std::string getArchitectureInfo() const;
+    
+    /**
+     * @brief Cópia independente da rede (camadas, pesos e estado de treinamento)
+     * 
+     * A cópia implícita compartilha as camadas (std::shared_ptr); clone() as
+     * duplica, para treinar uma cópia sem alterar a original. As funções de
+     * ativação, sem estado, continuam compartilhadas.
+     */
+    std::unique_ptr<NeuralNetwork> clone() const;
 
 private:
+    // Pesos e bias de todas as camadas (snapshot do melhor modelo)
+    typedef std::vector<std::pair<std::vector<std::vector<double>>,
+                                  std::vector<double>>> ParameterSnapshot;
+    
+    /**
+     * @brief Copia os pesos e bias atuais de todas as camadas
+     * @return Snapshot dos parâmetros
+     */
+    ParameterSnapshot captureParameters() const;
+    
+    /**
+     * @brief Restaura pesos e bias a partir de um snapshot
+     * @param snapshot Parâmetros capturados por captureParameters()
+     */
+    void restoreParameters(const ParameterSnapshot& snapshot);
+    
+    /**
+     * @brief Restaura o momentum das camadas (vazio = zera)
+     * @param velocities Momentum dos pesos e bias por camada, gravado no estado
+     */
+    void restoreVelocities(const ParameterSnapshot& velocities);
+    
+    /**
+     * @brief Grava o modelo sem mensagens no console (usado por checkpoints)
+     * @param filename Nome do arquivo (".bin" = binário, demais = JSON)
+     * @param withVelocity Inclui o momentum das camadas (estado para retomar)
+     * @return true se gravou com sucesso
+     */
+    bool writeModelFile(const std::string& filename, bool withVelocity = false) const;
+    
+    bool writeJson(std::ostream& out, bool withVelocity) const;
+    bool writeBinary(std::ostream& out, bool withVelocity) const;
+    bool readJson(std::istream& in);
+    bool readBinary(std::istream& in);
+    
+    /**
+     * @brief Ajusta as camadas da rede para o formato lido de um arquivo
+     * @param sizes Pares (inputSize, neurons) de cada camada
+     * @param activations Nome da ativação de cada camada
+     * @param configs Inicialização, dropout e weight decay de cada camada
+     *                (vazio: arquivo antigo, mantém a configuração atual)
+     * @return true se a rede é compatível (ou foi criada) com esse formato
+     */
+    bool prepareLayers(const std::vector<std::pair<int, int>>& sizes,
+                       const std::vector<std::string>& activations,
+                       const std::vector<LayerConfig>& configs);
+    
     /**
      * @brief Calcula o erro quadrático médio
      * @param output Saída da rede
@@ -0,0 +1,158 @@
+#ifndef ONLINELEARNER_H
+#define ONLINELEARNER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "NeuralNetwork.h"
+
+/**
+ * @brief Parâmetros do aprendizado online
+ */
+struct OnlineLearningConfig {
+    std::size_t capacity = 2000;     // Amostras guardadas (as mais antigas saem)
+    std::size_t minNewSamples = 20;  // Amostras novas antes de uma rodada
+    double intervalSeconds = 30.0;   // Período entre rodadas da thread
+    int epochs = 3000;               // Épocas por rodada (rede 4-5-1: < 1 s)
+    double learningRate = 0.1;       // Menor que a do treinamento inicial: ajuste fino
+    int holdoutEvery = 5;            // Uma a cada holdoutEvery amostras vai para a validação
+    double minImprovement = 1e-5;    // Melhora mínima do erro de validação para publicar
+    double maxForgetting = 5e-4;     // Aumento máximo do erro (MSE) no conjunto de base
+    bool idlePriority = true;        // Thread em SCHED_IDLE (só usa CPU ociosa)
+};
+
+/**
+ * @brief Ajuste fino contínuo de uma rede a partir de amostras rotuladas em operação
+ *
+ * O laço de controle chama record() com a entrada da rede e a saída que
+ * deveria ter sido produzida (ex.: a ação imposta por uma regra de
+ * segurança). record() só copia a amostra para um buffer circular
+ * pré-alocado, com try_lock: se a thread de treinamento estiver copiando o
+ * buffer naquele instante, a amostra é descartada e contada, e o controle
+ * nunca espera.
+ *
+ * A cada intervalSeconds, havendo minNewSamples amostras novas, a thread de
+ * fundo (prioridade SCHED_IDLE) treina uma cópia da rede atual (clone) com
+ * as amostras guardadas mais o conjunto de base (replay, para a rede não
+ * esquecer o comportamento original). Exemplos de base com a mesma entrada
+ * de uma amostra são substituídos por ela. A cópia só substitui a atual se
+ * o erro de validação (amostras separadas + base) cair e o erro na base
+ * não subir mais que maxForgetting; nesse caso publish() recebe a nova
+ * rede, e quem a usa troca os pesos de forma atômica (ex.:
+ * NeuralCollisionAvoidance::shareNetwork).
+ *
+ * @code
+ *   OnlineLearner learner(network, baseInputs, baseTargets,
+ *       [&](const NeuralNetwork& improved) { controller.shareNetwork(...); });
+ *   learner.start();
+ *   learner.record(input, {0.77});   // No laço de controle
+ * @endcode
+ */
+class OnlineLearner {
+public:
+    typedef std::function<void(const NeuralNetwork&)> Publisher;
+
+    /**
+     * @param initial Rede em uso (copiada; a original não é alterada)
+     * @param baseInputs Conjunto de base, treinado e validado em toda rodada
+     * @param publisher Chamado na thread de treinamento a cada rede aceita
+     * @throws std::invalid_argument se capacity ou holdoutEvery forem inválidos
+     */
+    OnlineLearner(const NeuralNetwork& initial,
+                  const std::vector<std::vector<double>>& baseInputs,
+                  const std::vector<std::vector<double>>& baseTargets,
+                  Publisher publisher,
+                  const OnlineLearningConfig& learningConfig = OnlineLearningConfig());
+
+    /**
+     * @brief Encerra a thread (a rodada em andamento termina antes)
+     */
+    ~OnlineLearner();
+
+    OnlineLearner(const OnlineLearner&) = delete;
+    OnlineLearner& operator=(const OnlineLearner&) = delete;
+
+    /**
+     * @brief Guarda uma amostra rotulada (não bloqueia, não aloca)
+     * @return false se a amostra foi descartada (buffer ocupado ou tamanho errado)
+     */
+    bool record(const std::vector<double>& input, const std::vector<double>& target);
+
+    void start();
+    void stop();
+
+    /**
+     * @brief Executa uma rodada de treinamento na thread atual
+     * @return true se a nova rede foi aceita e publicada
+     *
+     * Usado pela thread de fundo; útil também em testes e para forçar uma
+     * rodada depois de stop(). Não deve rodar junto com a thread.
+     */
+    bool trainRound();
+
+    /**
+     * @brief Passa a ajustar outra rede (ex.: pesos recarregados do arquivo)
+     *
+     * Pode ser chamado de qualquer thread. Uma rodada em andamento, treinada
+     * sobre a rede anterior, é descartada em vez de publicada. As amostras
+     * guardadas continuam valendo para a nova rede.
+     */
+    void rebase(const NeuralNetwork& network);
+
+    /**
+     * @brief Salva os pesos da rede aceita mais recente
+     */
+    bool saveWeights(const std::string& filename) const;
+
+    uint64_t getRecorded() const { return recorded.load(std::memory_order_relaxed); }
+    uint64_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+    uint64_t getRounds() const { return rounds.load(std::memory_order_relaxed); }
+    uint64_t getAccepted() const { return accepted.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Erro de validação da rede aceita, medido na última rodada
+     */
+    double getValidationError() const { return validationError.load(std::memory_order_relaxed); }
+
+    const OnlineLearningConfig& getConfig() const { return config; }
+
+private:
+    OnlineLearningConfig config;
+    Publisher publish;
+    std::vector<std::vector<double>> replayInputs;
+    std::vector<std::vector<double>> replayTargets;
+
+    // Rede aceita (trocada pela thread de treinamento ou por rebase)
+    std::unique_ptr<NeuralNetwork> current;
+    uint64_t generation;     // Incrementado por rebase
+    mutable std::mutex currentMutex;
+
+    // Buffer circular de amostras (slots pré-alocados)
+    std::mutex samplesMutex;
+    std::vector<std::vector<double>> sampleInputs;
+    std::vector<std::vector<double>> sampleTargets;
+    uint64_t written;        // Amostras já gravadas (posição = written % capacity)
+    uint64_t trainedUpTo;    // Valor de written na última rodada
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    bool stopping;
+    std::thread worker;
+
+    std::atomic<uint64_t> recorded;
+    std::atomic<uint64_t> dropped;
+    std::atomic<uint64_t> rounds;
+    std::atomic<uint64_t> accepted;
+    std::atomic<double> validationError;
+
+    void run();
+};
+
+#endif // ONLINELEARNER_H
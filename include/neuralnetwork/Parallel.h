@@ -0,0 +1,35 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Executa fn(0..count-1) em threads que pegam o próximo índice livre
+ *
+ * A thread que chama também trabalha; threads <= 1 roda tudo nela. Os
+ * índices são entregues em ordem crescente. Quem precisa de resultado
+ * independente do número de threads grava por índice e reduz depois, na
+ * ordem dos índices.
+ */
+template<class Fn>
+void parallelFor(std::size_t count, int threads, Fn fn) {
+    std::atomic<std::size_t> next(0);
+    auto worker = [&] {
+        for (std::size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            fn(i);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::size_t t = 0; t < pool.size(); ++t) {
+        pool[t].join();
+    }
+}
+
+#endif // PARALLEL_H
@@ -0,0 +1,142 @@
+#ifndef QUANTIZEDNETWORK_H
+#define QUANTIZEDNETWORK_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "NeuralNetwork.h"
+#include "Dataset.h"
+
+/**
+ * @brief Cópia somente-inferência de uma NeuralNetwork em float32 e int8
+ *
+ * Construída a partir de uma rede treinada (que continua sendo a referência
+ * em double). Oferece dois caminhos de predição:
+ *
+ * - float32: pesos convertidos para float, armazenados por neurônio
+ *   [neurônio][entrada] para que cada produto escalar seja contíguo.
+ * - int8: quantização pós-treinamento simétrica por camada. Os pesos usam
+ *   escala maxabs(W)/127; as entradas de cada camada usam uma escala
+ *   calibrada com um dataset (maxabs das ativações observadas)/127. O
+ *   produto escalar é feito em inteiros (SSE2/AVX2 quando disponíveis) e
+ *   reescalado para float antes do bias e da função de ativação.
+ *
+ * Como NeuralNetwork::predict, os métodos de predição reutilizam buffers
+ * internos e não devem ser chamados concorrentemente na mesma instância.
+ */
+class QuantizedNetwork {
+public:
+    /**
+     * @brief Converte uma rede treinada
+     * @param network Rede de referência (precisa estar finalizada)
+     * @throws std::runtime_error se a rede não tiver camadas ou usar ativação desconhecida
+     */
+    explicit QuantizedNetwork(const NeuralNetwork& network);
+
+    /**
+     * @brief Calibra as escalas int8 das ativações de cada camada
+     * @param data Amostras representativas (ex.: conjunto de treinamento)
+     */
+    void calibrate(const Dataset& data);
+
+    /**
+     * @brief Indica se calibrate() já foi chamado (necessário para predictInt8)
+     */
+    bool isCalibrated() const { return calibrated; }
+
+    /**
+     * @brief Predição em float32
+     * @param input Vetor de entrada
+     * @return Saída da rede
+     */
+    std::vector<double> predictFloat(const std::vector<double>& input);
+
+    /**
+     * @brief Predição quantizada em int8
+     * @param input Vetor de entrada
+     * @return Saída da rede
+     * @throws std::runtime_error se a rede não foi calibrada
+     */
+    std::vector<double> predictInt8(const std::vector<double>& input);
+
+    /**
+     * @brief Memória ocupada pelos pesos em cada formato (bytes)
+     */
+    size_t getFloatWeightBytes() const;
+    size_t getInt8WeightBytes() const;
+
+private:
+    enum class Activation { Sigmoid, Tanh, ReLU, Linear };
+
+    struct QuantLayer {
+        int inputSize;
+        int neurons;
+        int paddedInputs;                 // inputSize arredondado para múltiplo de 16
+        Activation activation;
+
+        std::vector<float> weights;       // [neurons][paddedInputs]
+        std::vector<float> bias;          // [neurons]
+
+        std::vector<int8_t> qweights;     // [neurons][paddedInputs]
+        float weightScale;                // valor real = qweight * weightScale
+        float inputScale;                 // valor real = qinput * inputScale
+    };
+
+    std::vector<QuantLayer> layers;
+    int inputSize;
+    int outputSize;
+    bool calibrated;
+
+    // Buffers reutilizados entre predições
+    std::vector<float> bufferA;
+    std::vector<float> bufferB;
+    std::vector<int8_t> quantizedInput;
+
+    static Activation activationFromName(const std::string& name);
+    static float activate(Activation activation, float x);
+
+    // Camada em float, somando a partir do bias como Layer::forward
+    static void forwardFloat(const QuantLayer& layer, const float* in, float* out);
+};
+
+/**
+ * @brief Comparação de precisão e velocidade entre double, float32 e int8
+ */
+struct QuantizationReport {
+    size_t samples = 0;
+
+    double mseDouble = 0.0;      // Erro quadrático médio vs. alvos (mesma métrica de validate)
+    double mseFloat = 0.0;
+    double mseInt8 = 0.0;
+
+    double maxDiffFloat = 0.0;   // Maior |saída - saída double|
+    double maxDiffInt8 = 0.0;
+
+    double nsDouble = 0.0;       // Tempo médio por inferência (ns)
+    double nsFloat = 0.0;
+    double nsInt8 = 0.0;
+
+    size_t bytesDouble = 0;      // Memória dos pesos
+    size_t bytesFloat = 0;
+    size_t bytesInt8 = 0;
+};
+
+/**
+ * @brief Mede precisão e velocidade dos modos quantizados contra a referência
+ * @param reference Rede em double
+ * @param quantized Cópia quantizada (calibrada)
+ * @param data Conjunto de avaliação (ex.: validação)
+ * @param repetitions Passadas pelo dataset na medição de tempo
+ * @return Relatório com erro e ns/inferência de cada modo
+ */
+QuantizationReport compareQuantization(NeuralNetwork& reference,
+                                       QuantizedNetwork& quantized,
+                                       const Dataset& data,
+                                       int repetitions = 1000);
+
+/**
+ * @brief Exibe o relatório em formato de tabela
+ */
+void printQuantizationReport(const QuantizationReport& report);
+
+#endif // QUANTIZEDNETWORK_H
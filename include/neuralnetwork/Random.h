@@ -0,0 +1,103 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+
+/**
+ * @brief Gerador de números aleatórios baseado em contador
+ *
+ * O n-ésimo número de um fluxo é uma função pura de (seed, stream, n): um
+ * hash SplitMix64 da chave do fluxo somada ao contador. Não há estado
+ * compartilhado, então o resultado não depende de quantas threads existem
+ * nem da ordem em que os fluxos são consumidos; cada camada, cada época
+ * do embaralhamento e cada trial da busca usa o seu fluxo.
+ *
+ * Ao contrário de std::uniform_real_distribution e std::random_shuffle, a
+ * conversão para double e o embaralhamento estão definidos aqui, e dão os
+ * mesmos valores em qualquer biblioteca padrão.
+ *
+ * @code
+ *   CounterRng rng(seed, layerIndex);
+ *   double w = rng.uniform(-range, range);
+ *   CounterRng epochRng = CounterRng(seed, epoch).split(block);
+ * @endcode
+ */
+class CounterRng {
+public:
+    CounterRng(uint64_t seed, uint64_t stream)
+        : key(mix(mix(seed) ^ (stream * 0xD1B54A32D192ED03ULL + 0x8BB84B93962EACC9ULL))),
+          counter(0) {}
+
+    /**
+     * @brief Próximo número de 64 bits do fluxo
+     */
+    uint64_t next() { return at(counter++); }
+
+    /**
+     * @brief n-ésimo número do fluxo, sem avançar o contador
+     */
+    uint64_t at(uint64_t n) const { return mix(key + (n + 1) * 0x9E3779B97F4A7C15ULL); }
+
+    /**
+     * @brief Número em [0, 1) com 53 bits de precisão
+     */
+    double uniform() { return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0); }
+
+    /**
+     * @brief Número em [low, high)
+     */
+    double uniform(double low, double high) { return low + (high - low) * uniform(); }
+
+    /**
+     * @brief Inteiro uniforme em [0, bound) sem viés (bound > 0)
+     */
+    uint64_t below(uint64_t bound) {
+        // Descarta o início do intervalo que sobraria na divisão por bound
+        const uint64_t threshold = (0 - bound) % bound;
+        uint64_t value;
+        do {
+            value = next();
+        } while (value < threshold);
+        return value % bound;
+    }
+
+    /**
+     * @brief Fluxo derivado, independente deste e dos demais derivados
+     */
+    CounterRng split(uint64_t stream) const { return CounterRng(key, stream); }
+
+    /**
+     * @brief Semente não determinística, para quem não escolheu uma
+     */
+    static uint64_t entropySeed() {
+        std::random_device device;
+        return (static_cast<uint64_t>(device()) << 32) ^ device();
+    }
+
+    static uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+private:
+    uint64_t key;
+    uint64_t counter;
+};
+
+/**
+ * @brief Fisher-Yates com CounterRng (substitui std::random_shuffle)
+ */
+template<class Iterator>
+void shuffleRange(Iterator first, Iterator last, CounterRng& rng) {
+    const std::size_t count = static_cast<std::size_t>(last - first);
+    for (std::size_t i = count; i > 1; --i) {
+        std::size_t j = static_cast<std::size_t>(rng.below(i));
+        std::swap(first[i - 1], first[j]);
+    }
+}
+
+#endif // RANDOM_H
@@ -0,0 +1,184 @@
+#ifndef TRAININGOBSERVER_H
+#define TRAININGOBSERVER_H
+
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Dados do início de um trainBatch
+ */
+struct TrainingStart {
+    std::size_t samples = 0;            // Padrões de treinamento por época
+    int startEpoch = 1;                 // > 1 quando retomado de checkpoint
+    int maxEpochs = 0;
+    double errorThreshold = 0.0;
+    std::size_t validationSamples = 0;  // 0 = sem validação
+    int validationInterval = 0;
+    int patience = 0;
+    std::string architecture;           // NeuralNetwork::getArchitectureInfo()
+};
+
+/**
+ * @brief Métricas de uma época
+ *
+ * gradientNorm é a raiz da média, nas amostras da época, do quadrado da
+ * norma L2 do gradiente de todos os pesos e bias (antes do momentum).
+ */
+struct EpochStats {
+    int epoch = 0;
+    double trainingError = 0.0;         // MSE médio da época
+    double validationError = std::numeric_limits<double>::quiet_NaN();  // NaN fora das épocas de validação
+    double gradientNorm = 0.0;
+    double learningRate = 0.0;
+    std::size_t samples = 0;
+    double trainSeconds = 0.0;          // Forward, backward e atualização dos pesos
+    double validationSeconds = 0.0;     // Validação e gravação do checkpoint
+    double elapsedSeconds = 0.0;        // Desde o início do trainBatch
+
+    bool validated() const { return !std::isnan(validationError); }
+    double samplesPerSecond() const { return trainSeconds > 0.0 ? samples / trainSeconds : 0.0; }
+};
+
+enum class StopReason {
+    MaxEpochs,      // Todas as épocas pedidas
+    Converged,      // Erro de treino abaixo de errorThreshold
+    EarlyStopped    // patience validações sem melhora
+};
+
+/**
+ * @brief Resumo do fim de um trainBatch
+ */
+struct TrainingEnd {
+    int lastEpoch = 0;                  // Última época concluída
+    int epochsTrained = 0;              // Épocas desta chamada (sem as retomadas)
+    StopReason reason = StopReason::MaxEpochs;
+    double finalError = 0.0;            // Erro de treino da última época
+    double bestValidationError = std::numeric_limits<double>::infinity();
+    int stalledValidations = 0;         // Validações sem melhora ao parar
+    bool restoredBest = false;          // Pesos voltaram ao melhor modelo de validação
+    std::size_t samples = 0;
+    double seconds = 0.0;               // Tempo total do trainBatch
+    double trainSeconds = 0.0;          // Soma de EpochStats::trainSeconds
+    double validationSeconds = 0.0;     // Soma de EpochStats::validationSeconds
+};
+
+/**
+ * @brief Recebe o progresso do treinamento (NeuralNetwork::trainBatch)
+ *
+ * Registrado em EarlyStoppingConfig::observers. Os métodos são chamados na
+ * thread do treinamento, uma vez por época, entre uma época e a seguinte:
+ * o que o observador gastar entra no tempo total, mas não em trainSeconds.
+ */
+class TrainingObserver {
+public:
+    virtual ~TrainingObserver() {}
+
+    virtual void onTrainingBegin(const TrainingStart& start) { (void)start; }
+    virtual void onEpochEnd(const EpochStats& stats) = 0;
+    virtual void onTrainingEnd(const TrainingEnd& end) { (void)end; }
+};
+
+/**
+ * @brief Saída no console do trainBatch com verbose = true
+ *
+ * Imprime o cabeçalho, o erro a cada `interval` épocas (e na primeira) e,
+ * ao final, o motivo da parada e onde o tempo foi gasto.
+ */
+class ConsoleTrainingObserver : public TrainingObserver {
+public:
+    explicit ConsoleTrainingObserver(int interval = 1000);
+
+    void onTrainingBegin(const TrainingStart& start) override;
+    void onEpochEnd(const EpochStats& stats) override;
+    void onTrainingEnd(const TrainingEnd& end) override;
+
+private:
+    int interval;
+};
+
+/**
+ * @brief Guarda as métricas de todas as épocas em memória
+ *
+ * Acumula entre chamadas seguidas de trainBatch; getEnd() é o fim da última.
+ */
+class TrainingHistory : public TrainingObserver {
+public:
+    void onTrainingBegin(const TrainingStart& start) override;
+    void onEpochEnd(const EpochStats& stats) override;
+    void onTrainingEnd(const TrainingEnd& end) override;
+
+    const std::vector<EpochStats>& getEpochs() const { return epochs; }
+    const TrainingEnd& getEnd() const { return end; }
+    bool isFinished() const { return finished; }
+
+private:
+    std::vector<EpochStats> epochs;
+    TrainingEnd end;
+    bool finished = false;
+};
+
+/**
+ * @brief Grava uma linha CSV por época
+ *
+ * Colunas: epoch, training_error, validation_error (vazio fora das épocas
+ * de validação), gradient_norm, learning_rate, samples, samples_per_second,
+ * train_seconds, validation_seconds, elapsed_seconds.
+ */
+class CsvTrainingLog : public TrainingObserver {
+public:
+    /**
+     * @throws std::runtime_error se o arquivo não puder ser criado
+     */
+    explicit CsvTrainingLog(const std::string& filename);
+
+    void onEpochEnd(const EpochStats& stats) override;
+    void onTrainingEnd(const TrainingEnd& end) override;
+
+private:
+    std::ofstream out;
+};
+
+/**
+ * @brief Grava um registro binário de tamanho fixo por época
+ *
+ * Formato (little-endian nativo): magic "NNTL", versão:u32 e, por época,
+ * epoch:i64 samples:u64 e os campos double de EpochStats na ordem da
+ * declaração. Menor e mais rápido de gravar que o CSV em treinos longos;
+ * read() devolve as épocas para comparar execuções.
+ */
+class BinaryTrainingLog : public TrainingObserver {
+public:
+    /**
+     * @throws std::runtime_error se o arquivo não puder ser criado
+     */
+    explicit BinaryTrainingLog(const std::string& filename);
+
+    void onEpochEnd(const EpochStats& stats) override;
+    void onTrainingEnd(const TrainingEnd& end) override;
+
+    /**
+     * @throws std::runtime_error se o arquivo não existir ou não for um log binário
+     */
+    static std::vector<EpochStats> read(const std::string& filename);
+
+private:
+    std::ofstream out;
+};
+
+/**
+ * @brief Abre um log de treinamento pelo nome (".bin" = binário, demais = CSV)
+ * @throws std::runtime_error se o arquivo não puder ser criado
+ */
+std::unique_ptr<TrainingObserver> openTrainingLog(const std::string& filename);
+
+/**
+ * @brief Nome do motivo da parada ("máximo de épocas", "convergência", "early stopping")
+ */
+const char* stopReasonName(StopReason reason);
+
+#endif // TRAININGOBSERVER_H
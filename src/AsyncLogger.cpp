@@ -0,0 +1,171 @@
+#include "AsyncLogger.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+// ===== LogSite =====
+
+LogSite::LogSite(uint32_t perSecond, uint32_t every)
+    : maxPerSecond(perSecond),
+      sampleEvery(every > 0 ? every : 1),
+      occurrences(0),
+      windowStart(0),
+      inWindow(0),
+      suppressedCount(0) {
+}
+
+bool LogSite::admit(uint32_t& suppressed) {
+    // Amostragem: descartes intencionais, não contam como suprimidos
+    if (sampleEvery > 1 &&
+        occurrences.fetch_add(1, std::memory_order_relaxed) % sampleEvery != sampleEvery - 1) {
+        return false;
+    }
+
+    if (maxPerSecond > 0) {
+        uint64_t now = AsyncLogger::nowNs();
+        uint64_t start = windowStart.load(std::memory_order_relaxed);
+        if (now - start >= 1000000000ULL &&
+            windowStart.compare_exchange_strong(start, now, std::memory_order_relaxed)) {
+            inWindow.store(0, std::memory_order_relaxed);
+        }
+        if (inWindow.fetch_add(1, std::memory_order_relaxed) >= maxPerSecond) {
+            suppressedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    suppressed = suppressedCount.exchange(0, std::memory_order_relaxed);
+    return true;
+}
+
+// ===== AsyncLogger =====
+
+AsyncLogger::AsyncLogger(std::ostream& out)
+    : output(out),
+      minLevel(LogLevel::Info),
+      pushed(0),
+      written(0),
+      dropped(0),
+      running(true),
+      startNs(nowNs()) {
+    writer = std::thread(&AsyncLogger::writerLoop, this);
+}
+
+AsyncLogger::~AsyncLogger() {
+    running.store(false, std::memory_order_release);
+    if (writer.joinable()) {
+        writer.join();
+    }
+}
+
+namespace {
+
+void flushGlobalLogger() {
+    AsyncLogger::instance().flush();
+}
+
+} // namespace
+
+AsyncLogger& AsyncLogger::instance() {
+    // Nunca destruído: threads de controle ainda podem registrar durante o
+    // exit(). No encerramento apenas esvaziamos a fila. Armazenamento
+    // estático alinhado (o operator new do C++14 ignora o alignas(64) da fila).
+    alignas(AsyncLogger) static unsigned char storage[sizeof(AsyncLogger)];
+    static AsyncLogger* logger = [] {
+        AsyncLogger* created = new (storage) AsyncLogger(std::cout);
+        std::atexit(flushGlobalLogger);
+        return created;
+    }();
+    return *logger;
+}
+
+uint64_t AsyncLogger::nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void AsyncLogger::flush() {
+    uint64_t target = pushed.load(std::memory_order_acquire);
+    while (written.load(std::memory_order_acquire) < target) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void AsyncLogger::format(std::ostream& out, const LogRecord& record, uint64_t startNs) {
+    char stamp[32];
+    double seconds = record.timestampNs >= startNs ? (record.timestampNs - startNs) / 1e9 : 0.0;
+    std::snprintf(stamp, sizeof(stamp), "[%9.3f] ", seconds);
+    out << stamp;
+
+    switch (record.level) {
+        case LogLevel::Warn: out << "AVISO: "; break;
+        case LogLevel::Error: out << "ERRO: "; break;
+        default: break;
+    }
+
+    int next = 0;
+    for (const char* p = record.format; *p; ++p) {
+        if (p[0] == '{' && p[1] == '}' && next < record.argCount) {
+            const LogArg& arg = record.args[next++];
+            char number[32];
+            switch (arg.type) {
+                case LogArg::Int:
+                    std::snprintf(number, sizeof(number), "%lld", static_cast<long long>(arg.i));
+                    out << number;
+                    break;
+                case LogArg::Double:
+                    std::snprintf(number, sizeof(number), "%.4f", arg.d);
+                    out << number;
+                    break;
+                case LogArg::String:
+                    out << (arg.s ? arg.s : "(null)");
+                    break;
+            }
+            ++p;
+        } else {
+            out << *p;
+        }
+    }
+
+    if (record.suppressed > 0) {
+        out << " (+" << record.suppressed << " suprimidas)";
+    }
+    out << '\n';
+}
+
+void AsyncLogger::writerLoop() {
+    LogRecord record;
+    uint64_t reportedDrops = 0;
+
+    for (;;) {
+        // Ler o estado antes de esvaziar: após running=false, um último lote completo
+        bool stopping = !running.load(std::memory_order_acquire);
+
+        uint64_t batch = 0;
+        while (queue.tryPop(record)) {
+            format(output, record, startNs);
+            ++batch;
+        }
+
+        uint64_t drops = dropped.load(std::memory_order_relaxed);
+        if (drops != reportedDrops) {
+            output << "[logger] " << (drops - reportedDrops)
+                   << " registros descartados (fila cheia)\n";
+            reportedDrops = drops;
+        }
+
+        if (batch > 0) {
+            output.flush();
+            written.fetch_add(batch, std::memory_order_release);
+        }
+
+        if (stopping) {
+            break;
+        }
+        if (batch == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+}
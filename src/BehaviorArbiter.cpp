@@ -0,0 +1,109 @@
+#include "BehaviorArbiter.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+BehaviorArbiter::BehaviorArbiter(ArbitrationMode arbitrationMode)
+    : mode(arbitrationMode), lastWinner(nullptr), cycles(0) {
+}
+
+void BehaviorArbiter::addBehavior(Behavior& behavior, int priority, double weight) {
+    Entry entry;
+    entry.behavior = &behavior;
+    entry.priority = priority;
+    entry.weight = weight;
+    entry.wins.reset(new std::atomic<uint64_t>(0));
+
+    // Inserção estável: prioridades iguais mantêm a ordem de registro
+    std::vector<Entry>::iterator position = std::find_if(
+        entries.begin(), entries.end(),
+        [priority](const Entry& other) { return other.priority < priority; });
+    entries.insert(position, std::move(entry));
+}
+
+void BehaviorArbiter::countWin(Entry& entry) {
+    entry.wins->store(entry.wins->load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    lastWinner = entry.behavior;
+}
+
+MotionCommand BehaviorArbiter::arbitrate(const SensorSnapshot& snapshot) {
+    cycles.store(cycles.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    lastWinner = nullptr;
+
+    if (mode == ArbitrationMode::Subsumption) {
+        for (Entry& entry : entries) {
+            entry.proposal = entry.behavior->propose(snapshot);
+            if (entry.proposal.active) {
+                countWin(entry);
+                return entry.proposal.command;
+            }
+        }
+        return MotionCommand::hold();
+    }
+
+    // Fusão: todas as camadas propõem
+    Entry* leader = nullptr;
+    for (Entry& entry : entries) {
+        entry.proposal = entry.behavior->propose(snapshot);
+        if (leader == nullptr && entry.proposal.active) {
+            leader = &entry;
+        }
+    }
+    if (leader == nullptr) {
+        return MotionCommand::hold();
+    }
+    countWin(*leader);
+    if (leader->proposal.command.kind != MotionCommand::Move) {
+        return leader->proposal.command;
+    }
+
+    double totalWeight = 0.0;
+    double left = 0.0;
+    double right = 0.0;
+    for (const Entry& entry : entries) {
+        const Proposal& proposal = entry.proposal;
+        if (!proposal.active || proposal.command.kind != MotionCommand::Move) {
+            continue;
+        }
+        double w = entry.weight * proposal.urgency;
+        left += w * proposal.command.left;
+        right += w * proposal.command.right;
+        totalWeight += w;
+    }
+    if (totalWeight <= 0.0) {
+        return leader->proposal.command;
+    }
+    return MotionCommand::move(left / totalWeight, right / totalWeight);
+}
+
+uint64_t BehaviorArbiter::getWins(size_t index) const {
+    return entries[index].wins->load(std::memory_order_relaxed);
+}
+
+void BehaviorArbiter::printStatistics(std::ostream& out) const {
+    uint64_t total = getCycles();
+
+    out << "\n========================================" << std::endl;
+    out << "Arbitragem de comportamentos ("
+        << (mode == ArbitrationMode::Subsumption ? "subsunção" : "fusão ponderada") << ")" << std::endl;
+    out << "========================================" << std::endl;
+    out << "Ciclos: " << total << std::endl;
+
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    uint64_t controlled = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        uint64_t wins = getWins(i);
+        controlled += wins;
+        out << "  " << std::left << std::setw(24) << entries[i].behavior->getName() << std::right
+            << " prio " << std::setw(3) << entries[i].priority << ": " << std::setw(8) << wins;
+        if (total > 0) {
+            out << " (" << std::fixed << std::setprecision(2) << (100.0 * wins / total) << "%)";
+        }
+        out << std::endl;
+    }
+    out.flags(flags);
+    out.precision(precision);
+    out << "  Sem comportamento ativo: " << (total - controlled) << std::endl;
+    out << "========================================\n" << std::endl;
+}
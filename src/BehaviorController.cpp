@@ -0,0 +1,42 @@
+#include "BehaviorController.h"
+#include "Config.h"
+#include "PeriodicScheduler.h"
+
+BehaviorController::BehaviorController(PioneerRobot *_robo, BehaviorArbiter &_arbiter)
+    : robo(_robo), arbiter(_arbiter), latency("BehaviorController")
+{
+}
+
+void *BehaviorController::runThread(void *)
+{
+    PeriodicTimer timer(FREQUENCIA_COLISAO);
+    timer.start();
+
+    while (this->getRunningWithLock())
+    {
+        runCycle();
+        timer.waitNextPeriod();
+    }
+
+    ArLog::log(ArLog::Normal, "Behavior controller.");
+    return NULL;
+}
+
+void BehaviorController::runCycle()
+{
+    latency.attachToCurrentThread();
+    latency.beginCycle();
+    myMutex.lock();
+    robo->getSnapshot(snapshot);
+    latency.tracepoint(TraceStage::SensorRead);
+    MotionCommand command = arbiter.arbitrate(snapshot);
+    latency.tracepoint(TraceStage::Predict);
+    robo->execute(command);
+    latency.tracepoint(TraceStage::Action);
+    myMutex.unlock();
+    latency.endCycle();
+}
+
+void BehaviorController::lockMutex() { myMutex.lock(); }
+
+void BehaviorController::unlockMutex() { myMutex.unlock(); }
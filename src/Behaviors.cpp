@@ -0,0 +1,181 @@
+#include "Behaviors.h"
+#include "Config.h"
+#include "AsyncLogger.h"
+#include <algorithm>
+
+// ===== CollisionAvoidanceBehavior =====
+
+CollisionAvoidanceBehavior::CollisionAvoidanceBehavior() {
+}
+
+Proposal CollisionAvoidanceBehavior::propose(const SensorSnapshot& snapshot) {
+    // Decide a cada ciclo, mesmo durante uma rotação: a MotionQueue coalesce
+    // a mesma rotação e troca o alvo quando a decisão muda
+    const int* sonar = snapshot.sonar;
+    int sumD = (sonar[3] * LIMIARFRENTE) + ((sonar[2] + sonar[1]) * LIMIARDIAGONAIS) + (sonar[0] * LIMIARLATERAIS);
+    int sumE = (sonar[4] * LIMIARFRENTE) + ((sonar[5] + sonar[6]) * LIMIARDIAGONAIS) + (sonar[7] * LIMIARLATERAIS);
+    int dirMov = sumD > sumE ? 2 : 1;
+
+    // Urgência cresce à medida que o obstáculo frontal se aproxima
+    int frontMin = std::min(sonar[3], sonar[4]);
+    double urgency = std::max(0.1, std::min(1.0, 1.0 - static_cast<double>(frontMin) / LIMIARFRENTE));
+
+    MotionCommand command;
+    if (sonar[3] <= LIMIARFRENTE / 5 || sonar[4] <= LIMIARFRENTE / 5)
+    {
+        LOG_RATE_LIMITED(LogLevel::Info, 2, "Frente perto");
+        return Proposal(MotionCommand::move(-VELOCIDADEDESLOCAMENTO, -VELOCIDADEDESLOCAMENTO), 1.0);
+    }
+    else if (sonar[0] <= LIMIARLATERAIS)
+    {
+        LOG_RATE_LIMITED(LogLevel::Info, 2, "Esquerda perto");
+        command = MotionCommand::rotate(5, dirMov, VELOCIDADEROTACAO);
+    }
+    else if (sonar[1] <= LIMIARDIAGONAIS || sonar[2] <= LIMIARDIAGONAIS)
+    {
+        LOG_RATE_LIMITED(LogLevel::Info, 2, "DDE perto");
+        command = MotionCommand::rotate(15, dirMov, VELOCIDADEROTACAO);
+    }
+    else if (sonar[3] <= LIMIARFRENTE || sonar[4] <= LIMIARFRENTE)
+    {
+        LOG_RATE_LIMITED(LogLevel::Info, 2, "Frente afastado");
+        command = MotionCommand::rotate(45, dirMov, VELOCIDADEROTACAO);
+    }
+    else if (sonar[5] <= LIMIARDIAGONAIS || sonar[6] <= LIMIARDIAGONAIS)
+    {
+        LOG_RATE_LIMITED(LogLevel::Info, 2, "DDD perto");
+        command = MotionCommand::rotate(15, dirMov, VELOCIDADEROTACAO);
+    }
+    else if (sonar[7] <= LIMIARLATERAIS)
+    {
+        LOG_RATE_LIMITED(LogLevel::Info, 2, "Direita perto");
+        command = MotionCommand::rotate(5, dirMov, VELOCIDADEROTACAO);
+    }
+    else
+    {
+        LOG_RATE_LIMITED(LogLevel::Info, 2, "Seguir em frente");
+        return Proposal::inactive(MotionCommand::move(VELOCIDADEDESLOCAMENTO, VELOCIDADEDESLOCAMENTO));
+    }
+
+    return Proposal(command, urgency);
+}
+
+// ===== WallFollowerBehavior =====
+
+WallFollowerBehavior::WallFollowerBehavior() : followingWall(false) {
+}
+
+Proposal WallFollowerBehavior::propose(const SensorSnapshot& snapshot) {
+    const int* sonar = snapshot.sonar;
+    const double urgency = 0.5;
+
+    // Uma re para nao beijar a parede
+    if (sonar[3] <= LIMIARFRENTE / 5 || sonar[4] <= LIMIARFRENTE / 5)
+    {
+        LOG_RATE_LIMITED(LogLevel::Info, 2, "Frente perto");
+        return Proposal(MotionCommand::move(-VELOCIDADEDESLOCAMENTO, -VELOCIDADEDESLOCAMENTO), urgency);
+    }
+    // Uma re para nao beijar a parede
+    else if (sonar[2] <= LIMIARFRENTE / 4 || sonar[5] <= LIMIARFRENTE / 4)
+    {
+        LOG_RATE_LIMITED(LogLevel::Info, 2, "DDD ou DDE perto");
+        return Proposal(MotionCommand::move(-VELOCIDADEDESLOCAMENTO, -VELOCIDADEDESLOCAMENTO), urgency);
+    }
+    // Parede em frente
+    else if (sonar[3] < LIMITELEITURA / 4 && sonar[4] < LIMITELEITURA / 4)
+    {
+        LOG_RATE_LIMITED(LogLevel::Info, 2, "Parede em frente");
+        followingWall = false;
+        return Proposal(MotionCommand::rotate(10, 1, VELOCIDADEROTACAO), urgency); // virar a esquerda
+    }
+    // Procurar parede
+    else if (followingWall && sonar[7] == LIMITELEITURA)
+    {
+        LOG_RATE_LIMITED(LogLevel::Info, 2, "Procurar parede");
+        return Proposal(MotionCommand::rotate(-15, 1, VELOCIDADEROTACAO), urgency); // virar a direita
+    }
+    // Parede a direita
+    else if (sonar[7] < LIMITELEITURA || sonar[6] < LIMITELEITURA || sonar[5] < LIMITELEITURA)
+    {
+        LOG_RATE_LIMITED(LogLevel::Info, 2, "Direita: {} Parede: {}", sonar[7], static_cast<int>(followingWall));
+        followingWall = true;
+
+        const MotionCommand left = MotionCommand::rotate(5, 1, VELOCIDADEROTACAO); // virar a esquerda
+        if (sonar[7] <= 200)
+        {
+            LOG_RATE_LIMITED(LogLevel::Info, 2, "Correcao a esquerda 7");
+            return Proposal(left, urgency);
+        }
+        else if (sonar[6] <= 500)
+        {
+            LOG_RATE_LIMITED(LogLevel::Info, 2, "Correcao a esquerda 6");
+            return Proposal(left, urgency);
+        }
+        else if (sonar[5] <= 700)
+        {
+            LOG_RATE_LIMITED(LogLevel::Info, 2, "Correcao a esquerda 5");
+            return Proposal(left, urgency);
+        }
+        else if (sonar[3] <= 1000 || sonar[4] <= 1000)
+        {
+            LOG_RATE_LIMITED(LogLevel::Info, 2, "Correcao a esquerda 3 4");
+            return Proposal(left, urgency);
+        }
+        else if (sonar[7] > 500)
+        {
+            LOG_RATE_LIMITED(LogLevel::Info, 2, "Correcao a direita");
+            return Proposal(MotionCommand::rotate(-5, 1, VELOCIDADEROTACAO), urgency); // virar a direita
+        }
+        LOG_RATE_LIMITED(LogLevel::Info, 2, "Parede a direita, mas seguir em frente");
+        return Proposal(MotionCommand::move(VELOCIDADEDESLOCAMENTO, VELOCIDADEDESLOCAMENTO), urgency);
+    }
+    // Quina
+    else if ((sonar[3] <= LIMITELEITURA / 5 && sonar[4] <= LIMITELEITURA / 5) && sonar[7] < LIMITELEITURA / 5)
+    {
+        followingWall = true;
+        LOG_RATE_LIMITED(LogLevel::Info, 2, "Quina a direita");
+        return Proposal(MotionCommand::rotate(90, 1, VELOCIDADEROTACAO), urgency); // virar a esquerda
+    }
+
+    followingWall = false;
+    LOG_RATE_LIMITED(LogLevel::Info, 2, "Nenhuma parede detectada");
+    return Proposal(MotionCommand::move(VELOCIDADEDESLOCAMENTO, VELOCIDADEDESLOCAMENTO), urgency); // seguir em frente
+}
+
+// ===== DwaBehavior =====
+
+DwaBehavior::DwaBehavior(const DwaConfig& config) : planner(config), goalBearing(0.0), navigator(nullptr) {
+}
+
+Proposal DwaBehavior::propose(const SensorSnapshot& snapshot) {
+    if (navigator != nullptr && snapshot.map != nullptr && navigator->hasGoal()) {
+        double bearing;
+        if (navigator->update(snapshot.pose, *snapshot.map, bearing)) {
+            goalBearing = bearing;
+        } else if (navigator->isGoalReached()) {
+            LOG_RATE_LIMITED(LogLevel::Info, 2, "Objetivo alcancado");
+            return Proposal(MotionCommand::stop(), 1.0);
+        }
+    }
+
+    planner.clearObstacles();
+    planner.addSonar(snapshot.sonar, 8, LIMITELEITURA);
+    if (snapshot.laser != nullptr) {
+        planner.addScan(snapshot.pose, snapshot.laser, snapshot.laserCount);
+    }
+
+    lastResult = planner.plan(snapshot.velocity, snapshot.rotVelocity, goalBearing);
+    if (!lastResult.valid) {
+        LOG_RATE_LIMITED(LogLevel::Warn, 2, "DWA sem trajetoria admissivel, dando re");
+        return Proposal(MotionCommand::move(-VELOCIDADEDESLOCAMENTO / 4, -VELOCIDADEDESLOCAMENTO / 4), 1.0);
+    }
+
+    double left, right;
+    planner.toWheelSpeeds(lastResult.velocity, lastResult.rotVelocity, left, right);
+    LOG_RATE_LIMITED(LogLevel::Info, 2, "DWA v={} w={} livre={} ({} admissiveis)",
+                     lastResult.velocity, lastResult.rotVelocity, lastResult.clearance, lastResult.admissible);
+
+    // Urgência cresce à medida que a trajetória escolhida fica curta
+    double urgency = std::max(0.1, 1.0 - lastResult.clearance / planner.getConfig().maxClearance);
+    return Proposal(MotionCommand::move(left, right), urgency);
+}
@@ -3,8 +3,12 @@
 #include <time.h>
 #include <stdlib.h>
 #include <string.h>
+#include <string>
 #include "ClassRobo.h"
 #include "Aria.h"
+#include "LatencyTracer.h"
+#include "PeriodicScheduler.h"
+#include "Telemetry.h"
 
 #define REAL 0
 int PioneerRobot::isConnected()
@@ -13,6 +17,7 @@ int PioneerRobot::isConnected()
 }
 
 PioneerRobot::PioneerRobot(int tipoConexao, const char *info, int *sucesso)
+    : motion(*this), map(NULL), localizer(NULL)
 {
   int argc = 0;
   char **argv;
@@ -38,7 +43,7 @@ PioneerRobot::PioneerRobot(int tipoConexao, const char *info, int *sucesso)
   case ConexaoRadio:
   {
     argc = 4;
-    argv = (char **)new char[4];
+    argv = new char *[4];
     argv[0] = new char[4];
     argv[1] = new char[20];
     argv[2] = new char[20];
@@ -68,14 +73,32 @@ PioneerRobot::PioneerRobot(int tipoConexao, const char *info, int *sucesso)
   case ConexaoSimulacao:
 
   {
-    argc = 2;
-    argv = (char **)new char[2];
+    // info = "host[:porta]" do MobileSim (vazio = localhost, porta padrão);
+    // várias instâncias do MobileSim escutam em portas consecutivas
+    std::string address = (info != NULL && info[0] != '\0') ? info : "localhost";
+    std::string host = address;
+    std::string port;
+    size_t colon = address.rfind(':');
+    if (colon != std::string::npos)
+    {
+      host = address.substr(0, colon);
+      port = address.substr(colon + 1);
+    }
 
-    argv[0] = new char[4];
-    argv[1] = new char[20];
+    argc = port.empty() ? 2 : 4;
+    argv = new char *[4];
 
+    argv[0] = new char[4];
+    argv[1] = new char[host.size() + 1];
     strcpy(argv[0], "-rh");
-    strcpy(argv[1], "localhost");
+    strcpy(argv[1], host.c_str());
+    if (!port.empty())
+    {
+      argv[2] = new char[7];
+      argv[3] = new char[port.size() + 1];
+      strcpy(argv[2], "-rrtp");
+      strcpy(argv[3], port.c_str());
+    }
 
     parser = new ArArgumentParser(&argc, argv);
 
@@ -122,7 +145,11 @@ void PioneerRobot::destroy()
   desconectar();
   Aria::shutdown();
 }
-void PioneerRobot::pararMovimento() { robot.stop(); }
+void PioneerRobot::pararMovimento()
+{
+  robot.stop();
+  LatencyTracer::commandIssued();
+}
 void PioneerRobot::desconectar() { robot.stopRunning(true); }
 
 int PioneerRobot::getSonar(int i) { return (Sensores[i]); }
@@ -131,6 +158,85 @@ void PioneerRobot::getAllSonar(int *sensores)
   for (int i = 0; i < 8; i++)
     sensores[i] = (int)(robot.getSonarRange(i));
 }
+void PioneerRobot::getSnapshot(SensorSnapshot &snapshot)
+{
+  static TelemetryCounter &snapshots = Telemetry::instance().counter(
+      "robot_sensor_snapshots_total", "Leituras de sensores por origem", "source=\"pioneer\"");
+  static TelemetryCounter &laserScans = Telemetry::instance().counter(
+      "robot_laser_scans_total", "Varreduras do laser lidas nos snapshots");
+  snapshots.add();
+  // Um ciclo de controle por snapshot: avança a fila de movimento
+  motion.update();
+  getAllSonar(snapshot.sonar);
+  snapshot.headingDone = robot.isHeadingDone();
+  snapshot.moveDone = robot.isMoveDone();
+  snapshot.timestampNs = PeriodicTimer::nowNs();
+  snapshot.pose = getPose();
+  snapshot.velocity = robot.getVel();
+  snapshot.rotVelocity = robot.getRotVel();
+  snapshot.laser = NULL;
+  snapshot.laserCount = 0;
+  if (sick.isConnected())
+  {
+    getLaserPoints(laserPoints, localizer != NULL ? &localLaserPoints : NULL);
+    snapshot.laser = laserPoints.data();
+    snapshot.laserCount = laserPoints.size();
+    laserScans.add();
+  }
+  if (localizer != NULL)
+  {
+    // Odometria só como deslocamento; a pose vem do filtro de partículas
+    Pose2D odometry = snapshot.pose;
+    localizer->predict(lastOdometry, odometry);
+    lastOdometry = odometry;
+    if (snapshot.laserCount > 0)
+      localizer->update(localLaserPoints.data(), localLaserPoints.size());
+    snapshot.pose = localizer->estimate();
+    // Pontos do laser refeitos a partir da pose corrigida
+    double c = cos(snapshot.pose.theta * M_PI / 180.0);
+    double s = sin(snapshot.pose.theta * M_PI / 180.0);
+    for (size_t i = 0; i < localLaserPoints.size(); i++)
+    {
+      const ScanPoint &p = localLaserPoints[i];
+      laserPoints[i] = ScanPoint(snapshot.pose.x + c * p.x - s * p.y, snapshot.pose.y + s * p.x + c * p.y, p.hit);
+    }
+  }
+  snapshot.map = map;
+  if (map != NULL)
+  {
+    map->integrateSonar(snapshot.pose, snapshot.sonar);
+    if (snapshot.laserCount > 0)
+      map->integrateScan(snapshot.pose, snapshot.laser, snapshot.laserCount);
+  }
+}
+void PioneerRobot::setMap(OccupancyGrid *grid) { map = grid; }
+void PioneerRobot::setLocalizer(ParticleFilter *filter)
+{
+  lastOdometry = getPose();
+  localizer = filter;
+}
+void PioneerRobot::execute(const MotionCommand &command, MotionCallback onDone)
+{
+  motion.submit(command, onDone);
+}
+bool PioneerRobot::isHeadingDone() { return robot.isHeadingDone(); }
+void PioneerRobot::apply(const MotionCommand &command)
+{
+  switch (command.kind)
+  {
+  case MotionCommand::Move:
+    Move(command.left, command.right);
+    break;
+  case MotionCommand::Rotate:
+    Rotaciona(command.degrees, command.direction, command.speed);
+    break;
+  case MotionCommand::Stop:
+    pararMovimento();
+    break;
+  case MotionCommand::Hold:
+    break;
+  }
+}
 void PioneerRobot::readSensores()
 {
   for (int i = 0; i < 8; i++)
@@ -139,6 +245,7 @@ void PioneerRobot::readSensores()
 float PioneerRobot::getXPos() { return (robot.getX() / 10); }
 float PioneerRobot::getYPos() { return (robot.getY() / 10); }
 float PioneerRobot::getAngBase() { return (robot.getTh()); }
+Pose2D PioneerRobot::getPose() { return Pose2D(getXPos() * 10.0, getYPos() * 10.0, getAngBase()); }
 
 void PioneerRobot::initMov() { robot.setVel2(50, 50); }
 
@@ -169,6 +276,29 @@ void PioneerRobot::getWriteLaserReadings()
   ArUtil::sleep(1000);
 }
 
+void PioneerRobot::getLaserPoints(std::vector<ScanPoint> &points, std::vector<ScanPoint> *local)
+{
+  points.clear();
+  if (local != NULL)
+    local->clear();
+  double maxRange = sick.getMaxRange();
+
+  sick.lockDevice();
+  std::vector<ArSensorReading> *readings = sick.getRawReadingsAsVector();
+  if (readings != NULL)
+  {
+    for (std::vector<ArSensorReading>::iterator it = readings->begin(); it != readings->end(); it++)
+    {
+      if ((*it).getIgnoreThisReading())
+        continue;
+      points.push_back(ScanPoint((*it).getX(), (*it).getY(), (*it).getRange() < maxRange));
+      if (local != NULL)
+        local->push_back(ScanPoint((*it).getLocalX(), (*it).getLocalY(), (*it).getRange() < maxRange));
+    }
+  }
+  sick.unlockDevice();
+}
+
 void PioneerRobot::getLaser()
 {
   sick.getRawReadings();
@@ -199,8 +329,10 @@ void PioneerRobot::Rotaciona(double degrees, int Sentido, int velocidade)
     robot.setVel(velocidade);
   else if (Sentido == 2)
     robot.setVel(-velocidade);
+  LatencyTracer::commandIssued();
 }
 void PioneerRobot::Move(double vl, double vr)
 {
   robot.setVel2(vl, vr);
+  LatencyTracer::commandIssued();
 }
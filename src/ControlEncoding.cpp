@@ -0,0 +1,60 @@
+#include "ControlEncoding.h"
+#include <algorithm>
+
+std::vector<double> encodeSonarInput(const int* sonar, double nearThreshold) {
+    int rightSide = std::max({sonar[0], sonar[1], sonar[2]});
+    int leftSide = std::max({sonar[7], sonar[6], sonar[5]});
+    int frontSide = std::max(sonar[3], sonar[4]);
+    
+    std::vector<double> input(4);
+    input[0] = rightSide > nearThreshold ? 1.0 : 0.0;
+    input[1] = leftSide > nearThreshold ? 1.0 : 0.0;
+    input[2] = frontSide > nearThreshold ? 1.0 : 0.0;
+    input[3] = 1.0;
+    return input;
+}
+
+int outputBand(double networkOutput) {
+    for (int band = 0; band < BandCount; ++band) {
+        if (networkOutput >= CONTROL_BAND_BOUNDS[band] && networkOutput < CONTROL_BAND_BOUNDS[band + 1]) {
+            return band;
+        }
+    }
+    return -1;
+}
+
+int commandBand(const MotionCommand& command) {
+    switch (command.kind) {
+        case MotionCommand::Rotate: return command.direction == 1 ? BandLeft : BandRight;
+        case MotionCommand::Move: return command.left < 0 ? BandBackward : BandForward;
+        case MotionCommand::Stop: return BandStop;
+        case MotionCommand::Hold: break;
+    }
+    return -1;
+}
+
+int overrideLabelBand(const std::vector<double>& input, double networkOutput,
+                      const MotionCommand& command) {
+    // Frente livre na entrada: a correção veio de algo que a rede não vê
+    if (input.size() != 4 || input[2] != 0.0) {
+        return -1;
+    }
+    int predicted = outputBand(networkOutput);
+    int executed = commandBand(command);
+    if (predicted < 0 || executed < 0 || executed == predicted) {
+        return -1;
+    }
+    
+    // Desvio que os bits de direita/esquerda determinam sozinhos
+    bool rightFree = input[0] != 0.0;
+    bool leftFree = input[1] != 0.0;
+    int expected = -1;
+    if (!rightFree && !leftFree) {
+        expected = BandBackward;
+    } else if (leftFree && !rightFree) {
+        expected = BandLeft;
+    } else if (rightFree && !leftFree) {
+        expected = BandRight;
+    }
+    return executed == expected ? executed : -1;
+}
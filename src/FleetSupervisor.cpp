@@ -0,0 +1,111 @@
+#include "FleetSupervisor.h"
+#include "AsyncLogger.h"
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+
+FleetMember::FleetMember(const std::string& memberName, RobotInterface& memberRobot, ArbitrationMode mode)
+    : name(memberName), robot(memberRobot), arbiter(mode), latency(memberName),
+      busy(false), cycles(0), skipped(0), failures(0) {
+}
+
+void FleetMember::addBehavior(std::unique_ptr<Behavior> behavior, int priority, double weight) {
+    arbiter.addBehavior(*behavior, priority, weight);
+    owned.push_back(std::move(behavior));
+}
+
+void FleetMember::addBehavior(Behavior& behavior, int priority, double weight) {
+    arbiter.addBehavior(behavior, priority, weight);
+}
+
+void FleetMember::runCycle() {
+    // A thread do pool muda a cada ciclo: o tracer é reanexado sempre
+    latency.attachToCurrentThread();
+    latency.beginCycle();
+    robot.getSnapshot(snapshot);
+    latency.tracepoint(TraceStage::SensorRead);
+    MotionCommand command = arbiter.arbitrate(snapshot);
+    latency.tracepoint(TraceStage::Predict);
+    robot.execute(command, MotionCallback());
+    latency.tracepoint(TraceStage::Action);
+    latency.endCycle();
+    cycles.fetch_add(1, std::memory_order_relaxed);
+}
+
+FleetSupervisor::FleetSupervisor(const FleetConfig& fleetConfig)
+    : config(fleetConfig), pool(fleetConfig.workers) {
+    scheduler.addTask("Frota", TaskConfig(config.rateHz, config.priority, config.cpu),
+                      [this] { dispatch(); });
+}
+
+FleetSupervisor::~FleetSupervisor() {
+    stop();
+}
+
+FleetMember& FleetSupervisor::addRobot(const std::string& name, RobotInterface& robot, ArbitrationMode mode) {
+    if (scheduler.isRunning()) {
+        throw std::logic_error("FleetSupervisor: robôs só podem ser adicionados antes de start()");
+    }
+    members.push_back(std::unique_ptr<FleetMember>(new FleetMember(name, robot, mode)));
+    return *members.back();
+}
+
+void FleetSupervisor::start() {
+    scheduler.start();
+}
+
+void FleetSupervisor::stop() {
+    scheduler.stop();
+    pool.waitIdle();
+}
+
+void FleetSupervisor::dispatch() {
+    for (size_t index = 0; index < members.size(); ++index) {
+        FleetMember* m = members[index].get();
+        // busy é liberado só no fim do ciclo: nunca dois ciclos do mesmo robô
+        if (m->busy.exchange(true, std::memory_order_acquire)) {
+            m->skipped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        pool.submit([m, index] {
+            // Um ciclo que falha não pode deixar o robô marcado como ocupado
+            try {
+                m->runCycle();
+            } catch (...) {
+                m->failures.fetch_add(1, std::memory_order_relaxed);
+                LOG_RATE_LIMITED(LogLevel::Error, 1, "Frota: ciclo do robô #{} falhou ({} falhas)",
+                                 index, m->getFailures());
+            }
+            m->busy.store(false, std::memory_order_release);
+        });
+    }
+}
+
+void FleetSupervisor::printStatistics(std::ostream& out) const {
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    const PeriodicTimer& timer = scheduler.getTimer(0);
+    out << "\n========================================" << std::endl;
+    out << "Frota: " << members.size() << " robôs, " << pool.getThreadCount() << " workers" << std::endl;
+    out << "========================================" << std::endl;
+    out << "Despacho " << std::fixed << std::setprecision(1) << config.rateHz << " Hz"
+        << " (" << scheduler.getRealtimeStatus(0) << ")"
+        << " | Taxa real: " << std::setprecision(2) << timer.getAchievedRateHz() << " Hz"
+        << " | Overruns: " << timer.getOverruns() << std::endl;
+    out << "  " << std::left << std::setw(16) << "Robô" << std::right
+        << std::setw(10) << "Ciclos" << std::setw(10) << "Pulados" << std::setw(10) << "Falhas"
+        << std::setw(12) << "p50" << std::setw(12) << "p99" << std::setw(12) << "máx" << std::endl;
+    for (const std::unique_ptr<FleetMember>& member : members) {
+        const LatencyHistogram& cycle = member->latency.getHistogram(TraceStage::Cycle);
+        out << "  " << std::left << std::setw(16) << member->name << std::right
+            << std::setw(10) << member->getCycles() << std::setw(10) << member->getSkipped()
+            << std::setw(10) << member->getFailures()
+            << std::setw(12) << formatLatency(cycle.percentile(50.0))
+            << std::setw(12) << formatLatency(cycle.percentile(99.0))
+            << std::setw(12) << formatLatency(cycle.getMax()) << std::endl;
+    }
+    out.flags(flags);
+    out.precision(precision);
+    out << "========================================\n" << std::endl;
+}
@@ -1,4 +1,6 @@
 #include "Laserthread.h"
+#include "Config.h"
+#include "PeriodicScheduler.h"
 #include <iostream>
 
 LaserThread::LaserThread(PioneerRobot *_robo)
@@ -8,18 +10,26 @@ LaserThread::LaserThread(PioneerRobot *_robo)
 
 void *LaserThread::runThread(void *)
 {
+    PeriodicTimer timer(FREQUENCIA_LASER);
+    timer.start();
+
     while (this->getRunningWithLock())
     {
-        myMutex.lock();
-        robo->getLaser();
-        myMutex.unlock();
-        ArUtil::sleep(2000);
+        runCycle();
+        timer.waitNextPeriod();
     }
 
     ArLog::log(ArLog::Normal, "Example thread: requested stop running, ending thread.");
     return NULL;
 }
 
+void LaserThread::runCycle()
+{
+    myMutex.lock();
+    robo->getLaser();
+    myMutex.unlock();
+}
+
 void LaserThread::waitOnCondition() { myCondition.wait(); }
 
 void LaserThread::lockMutex() { myMutex.lock(); }
@@ -0,0 +1,311 @@
+#include "LatencyTracer.h"
+#include <algorithm>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Tracer da thread atual (para commandIssued)
+thread_local LatencyTracer* currentTracer = nullptr;
+
+// Dump solicitado por sinal ou por outra thread
+std::atomic<bool> dumpRequested(false);
+
+// Lista global de tracers (o mutex só é usado no registro e nos relatórios)
+std::mutex& registryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::vector<LatencyTracer*>& registry() {
+    static std::vector<LatencyTracer*> tracers;
+    return tracers;
+}
+
+const int STAGES = static_cast<int>(TraceStage::Count);
+
+void printHistograms(std::ostream& out, const std::string& name, const LatencyHistogram* histograms) {
+    out << "Latência [" << name << "] ("
+        << histograms[static_cast<int>(TraceStage::Cycle)].getCount() << " ciclos)" << std::endl;
+    out << "  " << std::left << std::setw(20) << "Etapa" << std::right
+        << std::setw(12) << "p50" << std::setw(12) << "p99" << std::setw(12) << "máx" << std::endl;
+
+    for (int s = 0; s < STAGES; ++s) {
+        const LatencyHistogram& h = histograms[s];
+        if (h.getCount() == 0) continue;
+        out << "  " << std::left << std::setw(20) << LatencyTracer::stageName(static_cast<TraceStage>(s)) << std::right
+            << std::setw(12) << formatLatency(h.percentile(50.0))
+            << std::setw(12) << formatLatency(h.percentile(99.0))
+            << std::setw(12) << formatLatency(h.getMax()) << std::endl;
+    }
+}
+
+void printHeader(std::ostream& out) {
+    out << "\n========================================" << std::endl;
+    out << "Latência do laço de controle" << std::endl;
+    out << "========================================" << std::endl;
+}
+
+void printFooter(std::ostream& out) {
+    out << "========================================\n" << std::endl;
+}
+
+// Cópia dos histogramas de um tracer no momento do dump
+struct TracerSnapshot {
+    std::string name;
+    LatencyHistogram histograms[STAGES];
+};
+
+typedef std::vector<std::unique_ptr<TracerSnapshot>> DumpSnapshot;
+
+/**
+ * Thread de fundo que formata e imprime os dumps pedidos por requestDump,
+ * para que o iostream nunca rode dentro de um ciclo de controle.
+ */
+class DumpWriter {
+public:
+    // Nunca destruído (como o AsyncLogger): laços ainda podem pedir dumps no exit()
+    static DumpWriter& instance() {
+        alignas(DumpWriter) static unsigned char storage[sizeof(DumpWriter)];
+        static DumpWriter* writer = new (storage) DumpWriter();
+        return *writer;
+    }
+
+    void post(DumpSnapshot snapshot) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.push_back(std::move(snapshot));
+        }
+        ready.notify_one();
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::vector<DumpSnapshot> pending;
+    std::thread thread;
+
+    DumpWriter() : thread(&DumpWriter::run, this) {
+        thread.detach();
+    }
+
+    void run() {
+        for (;;) {
+            std::vector<DumpSnapshot> dumps;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                ready.wait(lock, [this] { return !pending.empty(); });
+                dumps.swap(pending);
+            }
+            for (const DumpSnapshot& dump : dumps) {
+                printHeader(std::cout);
+                for (const auto& tracer : dump) {
+                    printHistograms(std::cout, tracer->name, tracer->histograms);
+                }
+                printFooter(std::cout);
+            }
+        }
+    }
+};
+
+int highestBit(uint64_t value) {
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(value);
+#else
+    int bit = 0;
+    while (value >>= 1) ++bit;
+    return bit;
+#endif
+}
+
+} // namespace
+
+std::string formatLatency(uint64_t ns) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    if (ns < 1000) {
+        out << ns << " ns";
+    } else if (ns < 1000000) {
+        out << ns / 1e3 << " us";
+    } else {
+        out << ns / 1e6 << " ms";
+    }
+    return out.str();
+}
+
+// ===== LatencyHistogram =====
+
+LatencyHistogram::LatencyHistogram() : count(0), sum(0), max(0) {
+    for (int i = 0; i < BUCKETS; ++i) {
+        counts[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+int LatencyHistogram::bucketIndex(uint64_t ns) {
+    if (ns < static_cast<uint64_t>(SUB_BUCKETS)) {
+        return static_cast<int>(ns);
+    }
+    int exponent = highestBit(ns);
+    if (exponent >= MAX_EXPONENT) {
+        return BUCKETS - 1;
+    }
+    int shift = exponent - SUB_BUCKET_BITS;
+    int mantissa = static_cast<int>((ns >> shift) & (SUB_BUCKETS - 1));
+    return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + mantissa;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(int index) {
+    if (index < SUB_BUCKETS) {
+        return static_cast<uint64_t>(index);
+    }
+    int exponent = index / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+    int mantissa = index % SUB_BUCKETS;
+    int shift = exponent - SUB_BUCKET_BITS;
+    return ((static_cast<uint64_t>(SUB_BUCKETS + mantissa + 1)) << shift) - 1;
+}
+
+double LatencyHistogram::getMean() const {
+    uint64_t n = getCount();
+    return n ? static_cast<double>(sum.load(std::memory_order_relaxed)) / n : 0.0;
+}
+
+void LatencyHistogram::copyFrom(const LatencyHistogram& other) {
+    // Contagem por último: percentile() nunca vê buckets somando mais que count
+    for (int i = 0; i < BUCKETS; ++i) {
+        counts[i].store(other.counts[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    sum.store(other.sum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    max.store(other.max.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    uint64_t n = 0;
+    for (int i = 0; i < BUCKETS; ++i) {
+        n += counts[i].load(std::memory_order_relaxed);
+    }
+    count.store(n, std::memory_order_release);
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+    uint64_t n = getCount();
+    if (n == 0) {
+        return 0;
+    }
+
+    uint64_t rank = static_cast<uint64_t>(p / 100.0 * n + 0.5);
+    rank = std::max<uint64_t>(1, std::min(rank, n));
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; ++i) {
+        seen += counts[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return std::min(bucketUpperBound(i), getMax());
+        }
+    }
+    return getMax();
+}
+
+// ===== LatencyTracer =====
+
+LatencyTracer::LatencyTracer(const std::string& tracerName)
+    : name(tracerName), cycleStart(0), lastMark(0), commandSeen(true) {
+    DumpWriter::instance();   // Thread de dump criada aqui, fora dos laços de controle
+    std::lock_guard<std::mutex> lock(registryMutex());
+    registry().push_back(this);
+}
+
+LatencyTracer::~LatencyTracer() {
+    if (currentTracer == this) {
+        currentTracer = nullptr;
+    }
+    std::lock_guard<std::mutex> lock(registryMutex());
+    std::vector<LatencyTracer*>& tracers = registry();
+    tracers.erase(std::remove(tracers.begin(), tracers.end(), this), tracers.end());
+}
+
+void LatencyTracer::attachToCurrentThread() {
+    currentTracer = this;
+}
+
+void LatencyTracer::endCycle() {
+    histograms[static_cast<int>(TraceStage::Cycle)].record(now() - cycleStart);
+    commandSeen = true;
+
+    if (dumpRequested.load(std::memory_order_relaxed) &&
+        dumpRequested.exchange(false, std::memory_order_acq_rel)) {
+        DumpSnapshot snapshot;
+        forEach([&snapshot](const LatencyTracer& tracer) {
+            std::unique_ptr<TracerSnapshot> copy(new TracerSnapshot());
+            copy->name = tracer.name;
+            for (int s = 0; s < STAGES; ++s) {
+                copy->histograms[s].copyFrom(tracer.histograms[s]);
+            }
+            snapshot.push_back(std::move(copy));
+        });
+        DumpWriter::instance().post(std::move(snapshot));
+    }
+}
+
+void LatencyTracer::commandIssued() {
+    LatencyTracer* tracer = currentTracer;
+    if (tracer == nullptr || tracer->commandSeen) {
+        return;
+    }
+    tracer->commandSeen = true;
+    tracer->histograms[static_cast<int>(TraceStage::SensorToCommand)].record(
+        now() - tracer->cycleStart);
+}
+
+const char* LatencyTracer::stageName(TraceStage stage) {
+    switch (stage) {
+        case TraceStage::SensorRead: return "Leitura sensores";
+        case TraceStage::Normalize: return "Normalização";
+        case TraceStage::Predict: return "Predição";
+        case TraceStage::Action: return "Ação";
+        case TraceStage::SensorToCommand: return "Sensor -> comando";
+        case TraceStage::Cycle: return "Ciclo completo";
+        case TraceStage::Count: break;
+    }
+    return "?";
+}
+
+const char* LatencyTracer::stageId(TraceStage stage) {
+    switch (stage) {
+        case TraceStage::SensorRead: return "sensor_read";
+        case TraceStage::Normalize: return "normalize";
+        case TraceStage::Predict: return "predict";
+        case TraceStage::Action: return "action";
+        case TraceStage::SensorToCommand: return "sensor_to_command";
+        case TraceStage::Cycle: return "cycle";
+        case TraceStage::Count: break;
+    }
+    return "unknown";
+}
+
+void LatencyTracer::print(std::ostream& out) const {
+    printHistograms(out, name, histograms);
+}
+
+void LatencyTracer::printAll(std::ostream& out) {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    printHeader(out);
+    for (const LatencyTracer* tracer : registry()) {
+        tracer->print(out);
+    }
+    printFooter(out);
+}
+
+void LatencyTracer::forEach(const std::function<void(const LatencyTracer&)>& visit) {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    for (const LatencyTracer* tracer : registry()) {
+        visit(*tracer);
+    }
+}
+
+void LatencyTracer::requestDump() {
+    dumpRequested.store(true, std::memory_order_relaxed);
+}
@@ -0,0 +1,176 @@
+#include "MockRobot.h"
+#include "Telemetry.h"
+#include "navigation/OccupancyGrid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+
+double normalizeDegrees(double angle) {
+    while (angle > 180.0) angle -= 360.0;
+    while (angle < -180.0) angle += 360.0;
+    return angle;
+}
+
+} // namespace
+
+void MockWorld::addWall(double x0, double y0, double x1, double y1) {
+    walls.push_back(WallSegment(x0, y0, x1, y1));
+}
+
+void MockWorld::addRoom(double minX, double minY, double maxX, double maxY) {
+    addWall(minX, minY, maxX, minY);
+    addWall(maxX, minY, maxX, maxY);
+    addWall(maxX, maxY, minX, maxY);
+    addWall(minX, maxY, minX, minY);
+}
+
+double MockWorld::raycast(double x, double y, double angle, double maxRange) const {
+    const double dx = std::cos(angle * DEG_TO_RAD);
+    const double dy = std::sin(angle * DEG_TO_RAD);
+    double best = maxRange;
+    for (const WallSegment& wall : walls) {
+        // Interseção de p + t*d com a + u*(b - a), t >= 0 e 0 <= u <= 1
+        const double ex = wall.x1 - wall.x0;
+        const double ey = wall.y1 - wall.y0;
+        const double denominator = dx * ey - dy * ex;
+        if (std::fabs(denominator) < 1e-12) {
+            continue;
+        }
+        const double wx = wall.x0 - x;
+        const double wy = wall.y0 - y;
+        const double t = (wx * ey - wy * ex) / denominator;
+        const double u = (wx * dy - wy * dx) / denominator;
+        if (t >= 0.0 && u >= 0.0 && u <= 1.0 && t < best) {
+            best = t;
+        }
+    }
+    return best;
+}
+
+double MockWorld::clearance(double x, double y) const {
+    double best = 1e300;
+    for (const WallSegment& wall : walls) {
+        const double ex = wall.x1 - wall.x0;
+        const double ey = wall.y1 - wall.y0;
+        const double length2 = ex * ex + ey * ey;
+        double u = length2 > 0.0 ? ((x - wall.x0) * ex + (y - wall.y0) * ey) / length2 : 0.0;
+        u = std::max(0.0, std::min(1.0, u));
+        const double px = wall.x0 + u * ex - x;
+        const double py = wall.y0 + u * ey - y;
+        best = std::min(best, std::sqrt(px * px + py * py));
+    }
+    return best;
+}
+
+MockRobot::MockRobot(const MockWorld& mockWorld, const Pose2D& start, double step)
+    : world(mockWorld), motion(*this), dt(step), x(start.x), y(start.y), theta(start.theta),
+      left(0.0), right(0.0), rotating(false), headingTarget(start.theta), rotationSpeed(0.0),
+      distance(0.0), steps(0), collisions(0) {
+}
+
+void MockRobot::getSnapshot(SensorSnapshot& snapshot) {
+    static TelemetryCounter& snapshots = Telemetry::instance().counter(
+        "robot_sensor_snapshots_total", "Leituras de sensores por origem", "source=\"mock\"");
+    snapshots.add();
+    step();
+    motion.update();
+
+    const SonarGeometry* geometry = pioneerSonarGeometry();
+    const double c = std::cos(theta * DEG_TO_RAD);
+    const double s = std::sin(theta * DEG_TO_RAD);
+    for (int i = 0; i < 8; ++i) {
+        const double sx = x + c * geometry[i].x - s * geometry[i].y;
+        const double sy = y + s * geometry[i].x + c * geometry[i].y;
+        snapshot.sonar[i] = static_cast<int>(world.raycast(sx, sy, theta + geometry[i].angle, SONAR_RANGE));
+    }
+    snapshot.headingDone = !rotating;
+    snapshot.moveDone = true;
+    snapshot.timestampNs = static_cast<uint64_t>(steps * dt * 1e9);
+    snapshot.pose = getPose();
+    snapshot.velocity = rotating ? rotationSpeed : 0.5 * (left + right);
+    snapshot.rotVelocity = rotating ? 0.0 : (right - left) / AXLE / DEG_TO_RAD;
+    snapshot.laser = nullptr;
+    snapshot.laserCount = 0;
+    snapshot.map = nullptr;
+}
+
+void MockRobot::execute(const MotionCommand& command, MotionCallback onDone) {
+    motion.submit(command, onDone);
+}
+
+void MockRobot::apply(const MotionCommand& command) {
+    switch (command.kind) {
+    case MotionCommand::Move:
+        rotating = false;
+        left = command.left;
+        right = command.right;
+        break;
+    case MotionCommand::Rotate:
+        rotating = true;
+        headingTarget = normalizeDegrees(theta + command.degrees);
+        rotationSpeed = command.direction == 1 ? command.speed
+                      : command.direction == 2 ? -command.speed : 0.0;
+        break;
+    case MotionCommand::Stop:
+        rotating = false;
+        left = right = 0.0;
+        break;
+    case MotionCommand::Hold:
+        break;
+    }
+}
+
+bool MockRobot::isHeadingDone() {
+    return !rotating;
+}
+
+Pose2D MockRobot::getPose() const {
+    return Pose2D(x, y, theta);
+}
+
+void MockRobot::step() {
+    double v;
+    double w;   // Graus/s
+    if (rotating) {
+        const double error = normalizeDegrees(headingTarget - theta);
+        const double limit = MAX_ROT_VELOCITY * dt;
+        if (std::fabs(error) <= limit) {
+            // Termina a rotação neste passo mantendo a velocidade linear,
+            // como setDeltaHeading + setVel; o Move pendente entra no update()
+            w = error / dt;
+            rotating = false;
+            left = right = rotationSpeed;
+        } else {
+            w = error > 0.0 ? MAX_ROT_VELOCITY : -MAX_ROT_VELOCITY;
+        }
+        v = rotationSpeed;
+    } else {
+        v = 0.5 * (left + right);
+        w = (right - left) / AXLE / DEG_TO_RAD;
+    }
+
+    const double heading = (theta + 0.5 * w * dt) * DEG_TO_RAD;
+    const double nx = x + v * dt * std::cos(heading);
+    const double ny = y + v * dt * std::sin(heading);
+    theta = normalizeDegrees(theta + w * dt);
+    steps++;
+
+    if (v == 0.0) {
+        return;
+    }
+    // Só bloqueia passos que aproximam o corpo da parede: encostado, ainda
+    // pode se afastar
+    const double after = world.clearance(nx, ny);
+    if (after < RADIUS && after < world.clearance(x, y)) {
+        collisions.fetch_add(1, std::memory_order_relaxed);
+        left = right = 0.0;
+        rotationSpeed = 0.0;
+        return;
+    }
+    distance += std::fabs(v) * dt;
+    x = nx;
+    y = ny;
+}
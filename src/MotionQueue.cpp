@@ -0,0 +1,130 @@
+#include "MotionQueue.h"
+#include <cmath>
+#include <iostream>
+
+MotionQueue::MotionQueue(MotionBackend& motionBackend)
+    : backend(motionBackend), submitted(0), issued(0), coalesced(0), preempted(0) {
+}
+
+bool MotionQueue::sameRotation(const MotionCommand& a, const MotionCommand& b) {
+    return a.kind == MotionCommand::Rotate && b.kind == MotionCommand::Rotate &&
+           std::fabs(a.degrees - b.degrees) < 1e-6 && a.direction == b.direction && a.speed == b.speed;
+}
+
+void MotionQueue::release(Slot& slot, MotionStatus status, Notifications& out) {
+    for (MotionCallback& callback : slot.callbacks) {
+        if (callback) {
+            out.emplace_back(std::move(callback), status);
+        }
+    }
+    slot.callbacks.clear();
+    slot.occupied = false;
+}
+
+void MotionQueue::issue(const MotionCommand& command) {
+    backend.apply(command);
+    issued++;
+}
+
+void MotionQueue::notify(Notifications& pending) {
+    for (std::pair<MotionCallback, MotionStatus>& entry : pending) {
+        entry.first(entry.second);
+    }
+    pending.clear();
+}
+
+void MotionQueue::submit(const MotionCommand& command, MotionCallback onDone) {
+    Notifications notifications;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        submitted++;
+
+        switch (command.kind) {
+            case MotionCommand::Hold:
+                if (onDone) ready.emplace_back(std::move(onDone), MotionStatus::Completed);
+                break;
+
+            case MotionCommand::Stop:
+                if (rotation.occupied) preempted++;
+                release(rotation, MotionStatus::Preempted, ready);
+                release(pendingMove, MotionStatus::Superseded, ready);
+                issue(command);
+                if (onDone) ready.emplace_back(std::move(onDone), MotionStatus::Completed);
+                break;
+
+            case MotionCommand::Rotate:
+                if (rotation.occupied && sameRotation(rotation.command, command)) {
+                    coalesced++;
+                } else {
+                    if (rotation.occupied) {
+                        preempted++;
+                        release(rotation, MotionStatus::Preempted, ready);
+                    }
+                    rotation.occupied = true;
+                    rotation.command = command;
+                    issue(command);
+                }
+                rotation.callbacks.push_back(std::move(onDone));
+                break;
+
+            case MotionCommand::Move:
+                if (rotation.occupied) {
+                    if (pendingMove.occupied) {
+                        coalesced++;
+                        release(pendingMove, MotionStatus::Superseded, ready);
+                    }
+                    pendingMove.occupied = true;
+                    pendingMove.command = command;
+                    pendingMove.callbacks.push_back(std::move(onDone));
+                } else {
+                    issue(command);
+                    if (onDone) ready.emplace_back(std::move(onDone), MotionStatus::Completed);
+                }
+                break;
+        }
+        notifications.swap(ready);
+    }
+    notify(notifications);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (ready.empty()) {
+        ready.swap(notifications);  // Devolve a capacidade já alocada
+    }
+}
+
+void MotionQueue::update() {
+    Notifications notifications;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!rotation.occupied || !backend.isHeadingDone()) {
+            return;
+        }
+        release(rotation, MotionStatus::Completed, ready);
+        if (pendingMove.occupied) {
+            issue(pendingMove.command);
+            release(pendingMove, MotionStatus::Completed, ready);
+        }
+        notifications.swap(ready);
+    }
+    notify(notifications);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (ready.empty()) {
+        ready.swap(notifications);
+    }
+}
+
+bool MotionQueue::isRotating() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return rotation.occupied;
+}
+
+bool MotionQueue::hasPending() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return pendingMove.occupied;
+}
+
+void MotionQueue::printStatistics(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    out << "Fila de movimento: " << submitted << " comandos recebidos, "
+        << issued << " enviados ao robô, " << coalesced << " coalescidos, "
+        << preempted << " rotações preemptadas" << std::endl;
+}
@@ -1,23 +1,33 @@
 #include "../include/NeuralCollisionAvoidance.h"
 #include "../include/neuralnetwork/ActivationFunction.h"
 #include "../include/Config.h"
+#include "../include/AsyncLogger.h"
+#include "../include/ControlEncoding.h"
+#include "../include/PeriodicScheduler.h"
+#include "../include/navigation/OccupancyGrid.h"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
 
 NeuralCollisionAvoidance::NeuralCollisionAvoidance(PioneerRobot* _robo)
     : robo(_robo),
+      modelReader(model),
+      inferenceServer(nullptr),
+      latency("NeuralCollisionAvoidance"),
+      telemetry{
+          Telemetry::instance().counter("robot_decisions_total", "Decisões da rede por ação", "action=\"right\""),
+          Telemetry::instance().counter("robot_decisions_total", "Decisões da rede por ação", "action=\"left\""),
+          Telemetry::instance().counter("robot_decisions_total", "Decisões da rede por ação", "action=\"forward\""),
+          Telemetry::instance().counter("robot_decisions_total", "Decisões da rede por ação", "action=\"backward\""),
+          Telemetry::instance().counter("robot_decisions_total", "Decisões da rede por ação", "action=\"stop\""),
+          Telemetry::instance().histogram("robot_network_output", "Saída da rede de controle", 0.0, 1.0, 20)},
       decisionCount(0),
       rightDecisions(0),
       leftDecisions(0),
       forwardDecisions(0),
       backwardDecisions(0),
-      stopDecisions(0) {
-    
-    // Inicializar array de sensores
-    for (int i = 0; i < 8; ++i) {
-        sonar[i] = 0;
-    }
+      stopDecisions(0),
+      overrideTarget(1) {
 }
 
 bool NeuralCollisionAvoidance::initializeNetwork(const std::string& weightsFile) {
@@ -26,16 +36,7 @@ bool NeuralCollisionAvoidance::initializeNetwork(const std::string& weightsFile)
         std::cout << "Inicializando Collision Avoidance Neural" << std::endl;
         std::cout << "========================================\n" << std::endl;
         
-        // Criar rede neural
-        // Input: 4 (direita, esquerda, frente, trás)
-        // Output: 1 (ação codificada)
-        network = std::make_unique<NeuralNetwork>(4, 1, 0.3, 0.9);
-        
-        // Adicionar camada oculta com 5 neurônios (baseado no exemplo original)
-        network->addHiddenLayer(5, std::make_shared<SigmoidActivation>(), 0.5);
-        
-        // Finalizar com camada de saída usando sigmoid
-        network->finalize(std::make_shared<SigmoidActivation>(), 0.5);
+        network = createNetwork();
         
         std::cout << network->getArchitectureInfo() << "\n" << std::endl;
         
@@ -43,6 +44,7 @@ bool NeuralCollisionAvoidance::initializeNetwork(const std::string& weightsFile)
         if (!weightsFile.empty()) {
             std::cout << "Tentando carregar pesos de: " << weightsFile << std::endl;
             if (network->loadWeights(weightsFile)) {
+                controlNetwork.load(*network);
                 std::cout << "✓ Pesos carregados com sucesso!" << std::endl;
                 return true;
             } else {
@@ -65,6 +67,8 @@ bool NeuralCollisionAvoidance::initializeNetwork(const std::string& weightsFile)
     std::vector<std::vector<double>>& validationTargets = validationData.second;
     network->validate(validationInputs, validationTargets, true);
     
+    controlNetwork.load(*network);
+    
     std::cout << "\n✓ Rede neural inicializada e treinada com sucesso!" << std::endl;
     std::cout << "========================================\n" << std::endl;
     
@@ -74,6 +78,20 @@ bool NeuralCollisionAvoidance::initializeNetwork(const std::string& weightsFile)
     }
 }
 
+std::unique_ptr<NeuralNetwork> NeuralCollisionAvoidance::createNetwork() {
+    // Criar rede neural
+    // Input: 4 (direita, esquerda, frente, trás)
+    // Output: 1 (ação codificada)
+    std::unique_ptr<NeuralNetwork> created = std::make_unique<NeuralNetwork>(4, 1, 0.3, 0.9);
+    
+    // Adicionar camada oculta com 5 neurônios (baseado no exemplo original)
+    created->addHiddenLayer(5, std::make_shared<SigmoidActivation>(), 0.5);
+    
+    // Finalizar com camada de saída usando sigmoid
+    created->finalize(std::make_shared<SigmoidActivation>(), 0.5);
+    return created;
+}
+
 std::pair<std::vector<std::vector<double>>, std::vector<std::vector<double>>>
 NeuralCollisionAvoidance::createTrainingData() {
     
@@ -181,30 +199,44 @@ std::vector<double> NeuralCollisionAvoidance::normalizeSensorData(const int* sen
     // Isso permite que o robô ande pra trás quando necessário
     int backSide = 3000;  // Assume que trás está sempre livre
     
-    // Normalizar: 1 = livre (> threshold), 0 = obstruído (<= threshold)
-    std::vector<double> normalized(4);
-    normalized[0] = (rightSide > NEAR_THRESHOLD) ? 1.0 : 0.0;  // Direita
-    normalized[1] = (leftSide > NEAR_THRESHOLD) ? 1.0 : 0.0;   // Esquerda
-    normalized[2] = (frontSide > NEAR_THRESHOLD) ? 1.0 : 0.0;  // Frente
-    normalized[3] = (backSide > NEAR_THRESHOLD) ? 1.0 : 0.0;   // Trás (sempre livre)
-    
-    // Log detalhado a cada 5 leituras para debug
-    static int logCounter = 0;
-    if (++logCounter % 5 == 0) {
-        std::cout << "\n[SENSORES] R:" << rightSide << " L:" << leftSide 
-                  << " F:" << frontSide << " B:" << backSide
-                  << " | Norm: [R:" << normalized[0] << " L:" << normalized[1] 
-                  << " F:" << normalized[2] << " B:" << normalized[3] << "]"
-                  << " | Threshold: " << NEAR_THRESHOLD << std::endl;
-    }
+    // Normalizar: 1 = livre (> threshold), 0 = obstruído (<= threshold).
+    // Mesma codificação usada para rotular as correções (ControlEncoding)
+    std::vector<double> normalized = encodeSonarInput(sensorValues, NEAR_THRESHOLD);
+    
+    // Log detalhado a cada 5 leituras para debug (assíncrono, fora do laço de controle)
+    LOG_SAMPLED(LogLevel::Info, 5,
+                "[SENSORES] R:{} L:{} F:{} B:{} | Norm: [R:{} L:{} F:{} B:{}] | Threshold: {}",
+                rightSide, leftSide, frontSide, backSide,
+                static_cast<int>(normalized[0]), static_cast<int>(normalized[1]),
+                static_cast<int>(normalized[2]), static_cast<int>(normalized[3]),
+                static_cast<int>(NEAR_THRESHOLD));
     
     return normalized;
 }
 
-void NeuralCollisionAvoidance::executeAction(double networkOutput) {
-    decisionCount++;
+void NeuralCollisionAvoidance::sideSpace(const SensorSnapshot& current, int& leftSpace, int& rightSpace) const {
+    const int* sonar = current.sonar;
+    leftSpace = std::max({sonar[7], sonar[6], sonar[5]});
+    rightSpace = std::max({sonar[0], sonar[1], sonar[2]});
+    if (current.map == nullptr) {
+        return;
+    }
     
-    std::string actionName;
+    const SonarGeometry* geometry = pioneerSonarGeometry();
+    double mapLeft = 0.0;
+    double mapRight = 0.0;
+    for (int i = 0; i < 3; ++i) {
+        mapRight = std::max(mapRight, current.map->freeDistance(current.pose, geometry[i].angle, MAP_LOOKAHEAD));
+        mapLeft = std::max(mapLeft, current.map->freeDistance(current.pose, geometry[7 - i].angle, MAP_LOOKAHEAD));
+    }
+    leftSpace = std::min(leftSpace, static_cast<int>(mapLeft));
+    rightSpace = std::min(rightSpace, static_cast<int>(mapRight));
+}
+
+MotionCommand NeuralCollisionAvoidance::chooseAction(double networkOutput, const SensorSnapshot& current,
+                                                     const char*& actionName) {
+    const int* sonar = current.sonar;
+    actionName = nullptr;
     
     // Verificar parada de emergência primeiro
     int frontMin = std::min(sonar[3], sonar[4]);
@@ -212,171 +244,233 @@ void NeuralCollisionAvoidance::executeAction(double networkOutput) {
     
     // Log detalhado a cada 5 decisões para debug
     if (decisionCount % 5 == 0) {
-        std::cout << "\n[DECISÃO #" << decisionCount << "] Output: " << networkOutput 
-                  << " | Front: " << frontMin << "/" << frontMax 
-                  << " | DangerThresh: " << DANGER_THRESHOLD 
-                  << " | NearThresh: " << NEAR_THRESHOLD << std::endl;
+        LOG_INFO("[DECISÃO #{}] Output: {} | Front: {}/{} | DangerThresh: {} | NearThresh: {}",
+                 decisionCount, networkOutput, frontMin, frontMax,
+                 static_cast<int>(DANGER_THRESHOLD), static_cast<int>(NEAR_THRESHOLD));
     }
     
     // Se obstáculo MUITO próximo na frente (< 250mm), PARAR imediatamente
     if (frontMin < DANGER_THRESHOLD) {
-        robo->robot.stop();
-        stopDecisions++;
-        actionName = "PARAR (EMERGÊNCIA)";
-        
-        std::cout << "🛑 PARADA DE EMERGÊNCIA! Front=" << frontMin 
-                  << " < Danger=" << DANGER_THRESHOLD << " (MUITO PERTO!)" << std::endl;
-        return;
+        LOG_RATE_LIMITED(LogLevel::Warn, 5, "🛑 PARADA DE EMERGÊNCIA! Front={} < Danger={} (MUITO PERTO!)",
+                         frontMin, static_cast<int>(DANGER_THRESHOLD));
+        return MotionCommand::stop();
     }
     
     // Se obstáculo próximo mas não crítico (250-600mm), priorizar DESVIO ao invés de seguir em frente
     if (frontMin < NEAR_THRESHOLD && frontMin >= DANGER_THRESHOLD) {
         // Força desvio imediato - não espera rede neural decidir
-        int leftSpace = std::max({sonar[7], sonar[6], sonar[5]});
-        int rightSpace = std::max({sonar[0], sonar[1], sonar[2]});
+        int leftSpace, rightSpace;
+        sideSpace(current, leftSpace, rightSpace);
         
-        std::cout << "⚠️  OBSTÁCULO PRÓXIMO! Front=" << frontMin 
-                  << " (entre " << DANGER_THRESHOLD << " e " << NEAR_THRESHOLD 
-                  << ") | L=" << leftSpace << " R=" << rightSpace << std::endl;
+        LOG_RATE_LIMITED(LogLevel::Warn, 5, "⚠️  OBSTÁCULO PRÓXIMO! Front={} (entre {} e {}) | L={} R={}",
+                         frontMin, static_cast<int>(DANGER_THRESHOLD), static_cast<int>(NEAR_THRESHOLD),
+                         leftSpace, rightSpace);
         
         if (leftSpace > rightSpace && leftSpace > NEAR_THRESHOLD) {
-            if (robo->robot.isHeadingDone()) {
-                robo->Rotaciona(ROTATION_ANGLE, 1, VELOCITY_ROTATION);
-                leftDecisions++;
-                std::cout << "🔄 DESVIO FORÇADO ESQUERDA" << std::endl;
-            }
-            return;
+            LOG_RATE_LIMITED(LogLevel::Info, 2, "🔄 DESVIO FORÇADO ESQUERDA");
+            return MotionCommand::rotate(ROTATION_ANGLE, 1, VELOCITY_ROTATION);
         } else if (rightSpace > NEAR_THRESHOLD) {
-            if (robo->robot.isHeadingDone()) {
-                robo->Rotaciona(ROTATION_ANGLE, 2, VELOCITY_ROTATION);
-                rightDecisions++;
-                std::cout << "🔄 DESVIO FORÇADO DIREITA" << std::endl;
-            }
-            return;
+            LOG_RATE_LIMITED(LogLevel::Info, 2, "🔄 DESVIO FORÇADO DIREITA");
+            return MotionCommand::rotate(ROTATION_ANGLE, 2, VELOCITY_ROTATION);
         } else {
             // Ambos os lados bloqueados, andar para trás
-            robo->Move(-VELOCITY_MOVE/2, -VELOCITY_MOVE/2);
-            backwardDecisions++;
-            std::cout << "⬇️  ANDANDO PARA TRÁS (lados bloqueados)" << std::endl;
-            return;
+            LOG_RATE_LIMITED(LogLevel::Info, 2, "⬇️  ANDANDO PARA TRÁS (lados bloqueados)");
+            return MotionCommand::move(-VELOCITY_MOVE/2, -VELOCITY_MOVE/2);
         }
     }
     
-    // Interpretar saída da rede e executar ação correspondente
+    // Interpretar saída da rede e escolher a ação correspondente.
+    // Sem esperar rotações em curso: a MotionQueue do robô coalesce a mesma
+    // rotação, troca o alvo quando a decisão muda e segura o Move até o giro terminar.
+    MotionCommand command;
     if (networkOutput >= ACTION_RIGHT_MIN && networkOutput < ACTION_RIGHT_MAX) {
         // VIRAR DIREITA
-        if (robo->robot.isHeadingDone()) {
-            robo->Rotaciona(ROTATION_ANGLE, 2, VELOCITY_ROTATION);
-            rightDecisions++;
-            actionName = "DIREITA";
-            if (decisionCount % 5 == 0) {
-                std::cout << "➡️  VIRANDO DIREITA" << std::endl;
-            }
-        } else {
-            actionName = "AGUARDANDO ROTAÇÃO";
+        command = MotionCommand::rotate(ROTATION_ANGLE, 2, VELOCITY_ROTATION);
+        actionName = "DIREITA";
+        if (decisionCount % 5 == 0) {
+            LOG_INFO("➡️  VIRANDO DIREITA");
         }
     }
     else if (networkOutput >= ACTION_LEFT_MIN && networkOutput < ACTION_LEFT_MAX) {
         // VIRAR ESQUERDA
-        if (robo->robot.isHeadingDone()) {
-            robo->Rotaciona(ROTATION_ANGLE, 1, VELOCITY_ROTATION);
-            leftDecisions++;
-            actionName = "ESQUERDA";
-            if (decisionCount % 5 == 0) {
-                std::cout << "⬅️  VIRANDO ESQUERDA" << std::endl;
-            }
-        } else {
-            actionName = "AGUARDANDO ROTAÇÃO";
+        command = MotionCommand::rotate(ROTATION_ANGLE, 1, VELOCITY_ROTATION);
+        actionName = "ESQUERDA";
+        if (decisionCount % 5 == 0) {
+            LOG_INFO("⬅️  VIRANDO ESQUERDA");
         }
     }
     else if (networkOutput >= ACTION_FORWARD_MIN && networkOutput < ACTION_FORWARD_MAX) {
         // SEGUIR EM FRENTE (mas só se caminho estiver livre)
-        if (frontMin > NEAR_THRESHOLD && robo->robot.isHeadingDone()) {
-            robo->Move(VELOCITY_MOVE, VELOCITY_MOVE);
-            forwardDecisions++;
+        if (frontMin > NEAR_THRESHOLD) {
+            command = MotionCommand::move(VELOCITY_MOVE, VELOCITY_MOVE);
             actionName = "FRENTE";
             if (decisionCount % 5 == 0) {
-                std::cout << "⬆️  SEGUINDO EM FRENTE (Front=" << frontMin << " > " << NEAR_THRESHOLD << ")" << std::endl;
+                LOG_INFO("⬆️  SEGUINDO EM FRENTE (Front={} > {})", frontMin, static_cast<int>(NEAR_THRESHOLD));
             }
-        } else if (frontMin <= NEAR_THRESHOLD) {
+        } else {
             // Se a rede mandou ir pra frente mas está bloqueado, DESVIAR!
             // Escolhe o lado com mais espaço
-            int leftSpace = std::max({sonar[7], sonar[6], sonar[5]});
-            int rightSpace = std::max({sonar[0], sonar[1], sonar[2]});
+            int leftSpace, rightSpace;
+            sideSpace(current, leftSpace, rightSpace);
             
-            std::cout << "🚧 FRENTE BLOQUEADA! Front=" << frontMin << " <= " << NEAR_THRESHOLD 
-                      << " | L=" << leftSpace << " R=" << rightSpace << std::endl;
+            LOG_RATE_LIMITED(LogLevel::Warn, 5, "🚧 FRENTE BLOQUEADA! Front={} <= {} | L={} R={}",
+                             frontMin, static_cast<int>(NEAR_THRESHOLD), leftSpace, rightSpace);
             
             if (leftSpace > rightSpace) {
-                robo->Rotaciona(ROTATION_ANGLE, 1, VELOCITY_ROTATION);  // Esquerda
-                leftDecisions++;
+                command = MotionCommand::rotate(ROTATION_ANGLE, 1, VELOCITY_ROTATION);  // Esquerda
                 actionName = "ESQUERDA (desvio inteligente)";
-                std::cout << "🔄 DESVIANDO ESQUERDA (mais espaço)" << std::endl;
+                LOG_RATE_LIMITED(LogLevel::Info, 2, "🔄 DESVIANDO ESQUERDA (mais espaço)");
             } else {
-                robo->Rotaciona(ROTATION_ANGLE, 2, VELOCITY_ROTATION);  // Direita
-                rightDecisions++;
+                command = MotionCommand::rotate(ROTATION_ANGLE, 2, VELOCITY_ROTATION);  // Direita
                 actionName = "DIREITA (desvio inteligente)";
-                std::cout << "🔄 DESVIANDO DIREITA (mais espaço)" << std::endl;
+                LOG_RATE_LIMITED(LogLevel::Info, 2, "🔄 DESVIANDO DIREITA (mais espaço)");
             }
-        } else {
-            actionName = "AGUARDANDO ROTAÇÃO";
         }
     }
     else if (networkOutput >= ACTION_BACKWARD_MIN && networkOutput < ACTION_BACKWARD_MAX) {
         // MOVER PARA TRÁS
-        if (robo->robot.isHeadingDone()) {
-            robo->Move(-VELOCITY_MOVE/2, -VELOCITY_MOVE/2);  // Metade da velocidade pra trás
-            backwardDecisions++;
-            actionName = "TRÁS";
-        } else {
-            actionName = "AGUARDANDO ROTAÇÃO";
-        }
+        command = MotionCommand::move(-VELOCITY_MOVE/2, -VELOCITY_MOVE/2);  // Metade da velocidade pra trás
+        actionName = "TRÁS";
     }
     else if (networkOutput >= ACTION_STOP_MIN && networkOutput < ACTION_STOP_MAX) {
         // PARAR
-        robo->pararMovimento();
-        stopDecisions++;
+        command = MotionCommand::stop();
         actionName = "PARAR";
     }
     else {
         // Valor fora dos intervalos esperados - comportamento padrão
-        std::cout << "⚠ Saída inesperada da rede: " << networkOutput << std::endl;
-        robo->Move(VELOCITY_MOVE, VELOCITY_MOVE);
-        forwardDecisions++;
+        LOG_WARN("⚠ Saída inesperada da rede: {}", networkOutput);
+        command = MotionCommand::move(VELOCITY_MOVE, VELOCITY_MOVE);
         actionName = "FRENTE (padrão)";
     }
     
-    // Log da decisão
-    std::cout << std::fixed << std::setprecision(4);
-    std::cout << "Decisão #" << decisionCount << " | Saída NN: " << networkOutput 
-             << " | Ação: " << actionName << std::endl;
+    return command;
+}
+
+void NeuralCollisionAvoidance::recordDecision(double networkOutput, const MotionCommand& command) {
+    telemetry.output.observe(networkOutput);
+    switch (command.kind) {
+        case MotionCommand::Move:
+            if (command.left < 0) { backwardDecisions++; telemetry.backward.add(); }
+            else { forwardDecisions++; telemetry.forward.add(); }
+            break;
+        case MotionCommand::Rotate:
+            if (command.direction == 1) { leftDecisions++; telemetry.left.add(); }
+            else { rightDecisions++; telemetry.right.add(); }
+            break;
+        case MotionCommand::Stop:
+            stopDecisions++;
+            telemetry.stop.add();
+            break;
+        case MotionCommand::Hold:
+            break;
+    }
+}
+
+void NeuralCollisionAvoidance::learnFromOverride(const std::vector<double>& input, double networkOutput,
+                                                 const MotionCommand& command) {
+    if (!learner) {
+        return;
+    }
+    int band = overrideLabelBand(input, networkOutput, command);
+    if (band < 0) {
+        return;
+    }
+    // Rótulo: centro da faixa da ação que a zona de segurança impôs
+    overrideTarget[0] = 0.5 * (CONTROL_BAND_BOUNDS[band] + CONTROL_BAND_BOUNDS[band + 1]);
+    learner->record(input, overrideTarget);
+}
+
+bool NeuralCollisionAvoidance::enableOnlineLearning(const OnlineLearningConfig& config) {
+    if (!network) {
+        return false;
+    }
+    std::pair<std::vector<std::vector<double>>, std::vector<std::vector<double>>> base = createTrainingData();
+    learner.reset(new OnlineLearner(*network, base.first, base.second,
+        [this](const NeuralNetwork& improved) {
+            shareNetwork(std::make_shared<const ControlNetwork>(improved));
+        }, config));
+    learner->start();
+    return true;
+}
+
+MotionCommand NeuralCollisionAvoidance::executeAction(double networkOutput) {
+    decisionCount++;
+    
+    const char* actionName = nullptr;
+    MotionCommand command = chooseAction(networkOutput, snapshot, actionName);
+    robo->execute(command);
+    recordDecision(networkOutput, command);
+    
+    // Log da decisão (as zonas de alerta/perigo já registram o próprio aviso)
+    if (actionName != nullptr) {
+        LOG_INFO("Decisão #{} | Saída NN: {} | Ação: {}", decisionCount, networkOutput, actionName);
+    }
+    return command;
+}
+
+Proposal NeuralCollisionAvoidance::propose(const SensorSnapshot& current) {
+    std::vector<double> normalizedInput = normalizeSensorData(current.sonar);
+    ControlNetwork::Input input = {{
+        normalizedInput[0], normalizedInput[1], normalizedInput[2], normalizedInput[3]
+    }};
+    double networkOutput = predictOutput(input)[0];
+    
+    decisionCount++;
+    const char* actionName = nullptr;
+    MotionCommand command = chooseAction(networkOutput, current, actionName);
+    recordDecision(networkOutput, command);
+    learnFromOverride(normalizedInput, networkOutput, command);
+    
+    // Controlador completo: sempre ativo, mais urgente na zona de alerta
+    int frontMin = std::min(current.sonar[3], current.sonar[4]);
+    return Proposal(command, frontMin < NEAR_THRESHOLD ? 1.0 : 0.5);
+}
+
+
+void NeuralCollisionAvoidance::runCycle() {
+    latency.attachToCurrentThread();
+    latency.beginCycle();
+    myMutex.lock();
+    
+    // Obter leituras dos sensores
+    robo->getSnapshot(snapshot);
+    latency.tracepoint(TraceStage::SensorRead);
+    
+    // Normalizar dados dos sensores
+    std::vector<double> normalizedInput = normalizeSensorData(snapshot.sonar);
+    latency.tracepoint(TraceStage::Normalize);
+    
+    // Obter predição da rede neural (cópia de tamanho fixo, sem alocação)
+    ControlNetwork::Input input = {{
+        normalizedInput[0], normalizedInput[1], normalizedInput[2], normalizedInput[3]
+    }};
+    ControlNetwork::Output output = predictOutput(input);
+    latency.tracepoint(TraceStage::Predict);
+    
+    // Executar ação baseada na predição
+    MotionCommand command = executeAction(output[0]);
+    learnFromOverride(normalizedInput, output[0], command);
+    latency.tracepoint(TraceStage::Action);
+    
+    myMutex.unlock();
+    latency.endCycle();
 }
 
 void* NeuralCollisionAvoidance::runThread(void*) {
     std::cout << "Thread de Collision Avoidance Neural iniciada." << std::endl;
     
+    // Prazos absolutos: o período não varia com a duração do ciclo
+    PeriodicTimer timer(FREQUENCIA_DECISAO);
+    timer.start();
+    
     while (this->getRunningWithLock()) {
-        myMutex.lock();
-        
-        // Obter leituras dos sensores
-        robo->getAllSonar(sonar);
-        
-        // Normalizar dados dos sensores
-        std::vector<double> normalizedInput = normalizeSensorData(sonar);
-        
-        // Obter predição da rede neural
-        std::vector<double> output = network->predict(normalizedInput);
-        
-        // Executar ação baseada na predição
-        executeAction(output[0]);
-        
-        myMutex.unlock();
-        
-        // Pequeno delay para não sobrecarregar o sistema
-        ArUtil::sleep(100);
+        runCycle();
+        timer.waitNextPeriod();
     }
     
     // Exibir estatísticas ao finalizar
+    AsyncLogger::instance().flush();
     printStatistics();
     
     ArLog::log(ArLog::Normal, "Thread de Collision Avoidance Neural encerrada.");
@@ -402,6 +496,42 @@ bool NeuralCollisionAvoidance::saveNetworkWeights(const std::string& filename) {
     return false;
 }
 
+std::shared_ptr<const NeuralCollisionAvoidance::ControlNetwork> NeuralCollisionAvoidance::exportNetwork() const {
+    std::shared_ptr<const ControlNetwork> shared = model.get();
+    return shared ? shared : std::make_shared<const ControlNetwork>(controlNetwork);
+}
+
+void NeuralCollisionAvoidance::shareNetwork(std::shared_ptr<const ControlNetwork> weights) {
+    model.publish(std::move(weights));
+}
+
+bool NeuralCollisionAvoidance::reloadNetwork(const std::string& weightsFile) {
+    static TelemetryCounter& reloads = Telemetry::instance().counter(
+        "robot_model_reloads_total", "Pesos recarregados do arquivo sem parar o controle");
+    try {
+        std::unique_ptr<NeuralNetwork> loaded = createNetwork();
+        if (!loaded->loadWeights(weightsFile)) {
+            return false;
+        }
+        std::shared_ptr<const ControlNetwork> weights = std::make_shared<const ControlNetwork>(*loaded);
+        // Antes de publicar: uma rodada do aprendiz que termine depois não
+        // pode sobrescrever a rede recarregada com a antiga ajustada
+        if (learner) {
+            learner->rebase(*loaded);
+        }
+        shareNetwork(std::move(weights));
+        reloads.add();
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Erro ao recarregar pesos: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+void NeuralCollisionAvoidance::useInferenceServer(InferenceServer<ControlNetwork>* server) {
+    inferenceServer = server;
+}
+
 void NeuralCollisionAvoidance::printStatistics() const {
     std::cout << "\n========================================" << std::endl;
     std::cout << "Estatísticas de Decisões" << std::endl;
@@ -422,11 +552,21 @@ void NeuralCollisionAvoidance::printStatistics() const {
                  << " (" << (100.0 * stopDecisions / decisionCount) << "%)" << std::endl;
     }
     
+    if (learner) {
+        std::cout << "Aprendizado online: " << learner->getRecorded() << " correções ("
+                  << learner->getDropped() << " descartadas), " << learner->getAccepted() << "/"
+                  << learner->getRounds() << " rodadas publicadas, erro de validação "
+                  << learner->getValidationError() << std::endl;
+    }
+    
+    std::cout << "----------------------------------------" << std::endl;
+    latency.print(std::cout);
     std::cout << "========================================\n" << std::endl;
 }
 
 int NeuralCollisionAvoidance::determineBestDirection() const {
     // Calcular soma ponderada para cada lado
+    const int* sonar = snapshot.sonar;
     int sumRight = (sonar[3] * 3) + ((sonar[2] + sonar[1]) * 2) + sonar[0];
     int sumLeft = (sonar[4] * 3) + ((sonar[5] + sonar[6]) * 2) + sonar[7];
     
@@ -0,0 +1,240 @@
+#include "PeriodicScheduler.h"
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#endif
+
+// ===== PeriodicTimer =====
+
+PeriodicTimer::PeriodicTimer(double rateHz)
+    : periodNs(rateHz > 0.0 ? static_cast<uint64_t>(1e9 / rateHz + 0.5) : 0),
+      nextDeadline(0),
+      lastWake(0),
+      startedAt(0),
+      lastWakeAt(0),
+      cycles(0),
+      overruns(0),
+      missedPeriods(0) {
+    if (periodNs == 0) {
+        throw std::invalid_argument("PeriodicTimer: frequência deve ser positiva");
+    }
+}
+
+uint64_t PeriodicTimer::nowNs() {
+#if defined(__linux__)
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+void PeriodicTimer::sleepUntil(uint64_t deadlineNs) {
+#if defined(__linux__)
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(deadlineNs / 1000000000ULL);
+    ts.tv_nsec = static_cast<long>(deadlineNs % 1000000000ULL);
+    // Com TIMER_ABSTIME, repetir após um sinal não acumula erro
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+    }
+#else
+    std::this_thread::sleep_until(std::chrono::steady_clock::time_point(
+        std::chrono::nanoseconds(deadlineNs)));
+#endif
+}
+
+void PeriodicTimer::start() {
+    lastWake = nowNs();
+    nextDeadline = lastWake + periodNs;
+    startedAt.store(lastWake, std::memory_order_relaxed);
+    lastWakeAt.store(lastWake, std::memory_order_relaxed);
+}
+
+bool PeriodicTimer::waitNextPeriod() {
+    uint64_t now = nowNs();
+    execution.record(now - lastWake);
+
+    bool onTime = true;
+    if (now > nextDeadline) {
+        // Pular os prazos já vencidos e voltar à grade
+        uint64_t missed = (now - nextDeadline) / periodNs + 1;
+        nextDeadline += missed * periodNs;
+        overruns.store(overruns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        missedPeriods.store(missedPeriods.load(std::memory_order_relaxed) + missed,
+                            std::memory_order_relaxed);
+        onTime = false;
+    }
+
+    sleepUntil(nextDeadline);
+
+    uint64_t wake = nowNs();
+    jitter.record(wake > nextDeadline ? wake - nextDeadline : 0);
+    lastWake = wake;
+    nextDeadline += periodNs;
+    lastWakeAt.store(wake, std::memory_order_relaxed);
+    cycles.store(cycles.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return onTime;
+}
+
+double PeriodicTimer::getAchievedRateHz() const {
+    uint64_t n = getCycles();
+    uint64_t elapsed = lastWakeAt.load(std::memory_order_relaxed) -
+                       startedAt.load(std::memory_order_relaxed);
+    return (n > 0 && elapsed > 0) ? n * 1e9 / elapsed : 0.0;
+}
+
+// ===== PeriodicScheduler =====
+
+PeriodicScheduler::PeriodicScheduler() : running(false) {
+}
+
+PeriodicScheduler::~PeriodicScheduler() {
+    stop();
+}
+
+size_t PeriodicScheduler::addTask(const std::string& name, const TaskConfig& config,
+                                  std::function<void()> body) {
+    if (isRunning()) {
+        throw std::logic_error("PeriodicScheduler: tarefas devem ser registradas antes de start()");
+    }
+    tasks.emplace_back(new Task(name, config, std::move(body)));
+    return tasks.size() - 1;
+}
+
+void PeriodicScheduler::start() {
+    if (running.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    for (std::unique_ptr<Task>& task : tasks) {
+        Task* t = task.get();
+        t->thread = std::thread([this, t] { runTask(*t); });
+    }
+}
+
+void PeriodicScheduler::stop() {
+    running.store(false, std::memory_order_release);
+    for (std::unique_ptr<Task>& task : tasks) {
+        if (task->thread.joinable()) {
+            task->thread.join();
+        }
+    }
+}
+
+void PeriodicScheduler::runTask(Task& task) {
+    std::string error;
+    if (applyRealtime(task.config.priority, task.config.cpu, &error)) {
+        std::ostringstream status;
+        if (task.config.priority > 0) {
+            status << "SCHED_FIFO " << task.config.priority;
+        } else {
+            status << "padrão";
+        }
+        if (task.config.cpu >= 0) {
+            status << ", CPU " << task.config.cpu;
+        }
+        task.realtimeStatus = status.str();
+    } else {
+        task.realtimeStatus = "padrão (" + error + ")";
+    }
+    task.ready.store(true, std::memory_order_release);
+
+    task.timer.start();
+    while (running.load(std::memory_order_acquire)) {
+        task.body();
+        task.timer.waitNextPeriod();
+    }
+}
+
+std::string PeriodicScheduler::getRealtimeStatus(size_t index) const {
+    const Task& task = *tasks[index];
+    return task.ready.load(std::memory_order_acquire) ? task.realtimeStatus : "não iniciada";
+}
+
+bool PeriodicScheduler::applyRealtime(int priority, int cpu, std::string* error) {
+    bool ok = true;
+    std::string message;
+
+#if defined(__linux__)
+    if (priority > 0) {
+        sched_param param;
+        std::memset(&param, 0, sizeof(param));
+        param.sched_priority = priority;
+        int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (rc != 0) {
+            ok = false;
+            message += "SCHED_FIFO " + std::to_string(priority) + ": " + std::strerror(rc);
+        }
+    }
+    if (cpu >= 0) {
+        int rc = EINVAL;
+        if (cpu < CPU_SETSIZE) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        }
+        if (rc != 0) {
+            ok = false;
+            if (!message.empty()) message += "; ";
+            message += "CPU " + std::to_string(cpu) + ": " + std::strerror(rc);
+        }
+    }
+#else
+    if (priority > 0 || cpu >= 0) {
+        ok = false;
+        message = "prioridade/afinidade não suportadas nesta plataforma";
+    }
+#endif
+
+    if (error != nullptr) {
+        *error = message;
+    }
+    return ok;
+}
+
+void PeriodicScheduler::printStatistics(std::ostream& out) const {
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    out << "\n========================================" << std::endl;
+    out << "Escalonador de controle" << std::endl;
+    out << "========================================" << std::endl;
+
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        const Task& task = *tasks[i];
+        const PeriodicTimer& timer = task.timer;
+        const LatencyHistogram& jitter = timer.getJitter();
+        const LatencyHistogram& execution = timer.getExecution();
+
+        out << "Tarefa [" << task.name << "] " << std::fixed << std::setprecision(1)
+            << task.config.rateHz << " Hz (" << getRealtimeStatus(i) << ")" << std::endl;
+        out << "  Ciclos: " << timer.getCycles()
+            << " | Taxa real: " << std::setprecision(2) << timer.getAchievedRateHz() << " Hz"
+            << " | Overruns: " << timer.getOverruns()
+            << " | Períodos perdidos: " << timer.getMissedPeriods() << std::endl;
+        out << "  " << std::left << std::setw(12) << "" << std::right
+            << std::setw(12) << "p50" << std::setw(12) << "p99" << std::setw(12) << "máx" << std::endl;
+        out << "  " << std::left << std::setw(12) << "Jitter" << std::right
+            << std::setw(12) << formatLatency(jitter.percentile(50.0))
+            << std::setw(12) << formatLatency(jitter.percentile(99.0))
+            << std::setw(12) << formatLatency(jitter.getMax()) << std::endl;
+        out << "  " << std::left << std::setw(12) << "Execução" << std::right
+            << std::setw(12) << formatLatency(execution.percentile(50.0))
+            << std::setw(12) << formatLatency(execution.percentile(99.0))
+            << std::setw(12) << formatLatency(execution.getMax()) << std::endl;
+    }
+    out.flags(flags);
+    out.precision(precision);
+    out << "========================================\n" << std::endl;
+}
@@ -1,28 +1,44 @@
 #include "Sonarthread.h"
+#include "AsyncLogger.h"
+#include "Config.h"
+#include "PeriodicScheduler.h"
 #include <iostream>
 
 SonarThread::SonarThread(PioneerRobot *_robo)
+    : latency("SonarThread")
 {
   this->robo = _robo;
 }
 
 void *SonarThread::runThread(void *)
 {
+  PeriodicTimer timer(FREQUENCIA_SONAR);
+  timer.start();
+
   while (this->getRunningWithLock())
   {
-    myMutex.lock();
-
-    robo->getAllSonar(sonar);
-    printSonarReadings();
-
-    myMutex.unlock();
-    ArUtil::sleep(1000);
+    runCycle();
+    timer.waitNextPeriod();
   }
 
   ArLog::log(ArLog::Normal, "Example thread: requested stop running, ending thread.");
   return NULL;
 }
 
+void SonarThread::runCycle()
+{
+  latency.attachToCurrentThread();
+  latency.beginCycle();
+  myMutex.lock();
+
+  robo->getAllSonar(sonar);
+  latency.tracepoint(TraceStage::SensorRead);
+  printSonarReadings();
+
+  myMutex.unlock();
+  latency.endCycle();
+}
+
 void SonarThread::waitOnCondition() { myCondition.wait(); }
 
 void SonarThread::lockMutex() { myMutex.lock(); }
@@ -33,7 +49,7 @@ int *SonarThread::getCurrentSonarReadings() { return sonar; }
 
 void SonarThread::printSonarReadings()
 {
-  for (int i = 0; i < 8; i++)
-    std::cout << "Sonar " << i << " " << sonar[i] << "\t";
-  std::cout << "\n";
+  LOG_SAMPLED(LogLevel::Info, 5,
+              "Sonar 0 {}\tSonar 1 {}\tSonar 2 {}\tSonar 3 {}\tSonar 4 {}\tSonar 5 {}\tSonar 6 {}\tSonar 7 {}",
+              sonar[0], sonar[1], sonar[2], sonar[3], sonar[4], sonar[5], sonar[6], sonar[7]);
 }
@@ -0,0 +1,346 @@
+#include "Telemetry.h"
+#include "LatencyTracer.h"
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <poll.h>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+bool validName(const std::string& name) {
+    if (name.empty()) {
+        return false;
+    }
+    for (size_t i = 0; i < name.size(); ++i) {
+        char c = name[i];
+        bool letter = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':';
+        if (!letter && !(i > 0 && c >= '0' && c <= '9')) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Rótulos entre chaves, com um rótulo extra opcional (le, quantile...)
+std::string labelSet(const std::string& labels, const std::string& extra = "") {
+    if (labels.empty() && extra.empty()) {
+        return "";
+    }
+    if (labels.empty() || extra.empty()) {
+        return "{" + labels + extra + "}";
+    }
+    return "{" + labels + "," + extra + "}";
+}
+
+// Prometheus usa "+Inf" e ponto decimal independente de locale
+std::string formatValue(double value) {
+    if (std::isinf(value)) {
+        return value > 0 ? "+Inf" : "-Inf";
+    }
+    std::ostringstream out;
+    out.imbue(std::locale::classic());
+    out.precision(10);
+    out << value;
+    return out.str();
+}
+
+void writeAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return;
+        }
+        sent += static_cast<size_t>(n);
+    }
+}
+
+} // namespace
+
+TelemetryHistogram::TelemetryHistogram(double minValue, double maxValue, int buckets)
+    : min(minValue), width(0.0), counts(buckets > 0 ? buckets : 1), sumMicro(0) {
+    if (!(maxValue > minValue)) {
+        throw std::invalid_argument("TelemetryHistogram: intervalo vazio");
+    }
+    width = (maxValue - minValue) / counts.size();
+}
+
+void TelemetryHistogram::observe(double value) {
+    int bucket = static_cast<int>(std::floor((value - min) / width));
+    if (bucket < 0 || value != value) {
+        bucket = 0;
+    } else if (bucket >= static_cast<int>(counts.size())) {
+        bucket = static_cast<int>(counts.size()) - 1;
+    }
+    counts[bucket].fetch_add(1, std::memory_order_relaxed);
+    sumMicro.fetch_add(static_cast<int64_t>(std::llround(value * 1e6)), std::memory_order_relaxed);
+}
+
+uint64_t TelemetryHistogram::getCount() const {
+    uint64_t total = 0;
+    for (const std::atomic<uint64_t>& count : counts) {
+        total += count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+struct Telemetry::Metric {
+    std::string labels;
+    TelemetryCounter counter;
+    TelemetryGauge gauge;
+    std::unique_ptr<TelemetryHistogram> histogram;
+};
+
+struct Telemetry::Family {
+    std::string name;
+    std::string help;
+    Type type;
+    std::vector<std::unique_ptr<Metric>> metrics;
+};
+
+Telemetry& Telemetry::instance() {
+    // Nunca destruída: métricas podem ser atualizadas até o fim do processo
+    static Telemetry* registry = new Telemetry();
+    return *registry;
+}
+
+Telemetry::Telemetry() {
+}
+
+Telemetry::~Telemetry() {
+}
+
+Telemetry::Metric& Telemetry::find(const std::string& name, const std::string& help, Type type,
+                                   const std::string& labels, double min, double max, int buckets) {
+    if (!validName(name)) {
+        throw std::invalid_argument("Telemetry: nome de métrica inválido: " + name);
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    Family* family = nullptr;
+    for (std::unique_ptr<Family>& candidate : families) {
+        if (candidate->name == name) {
+            family = candidate.get();
+            break;
+        }
+    }
+    if (family == nullptr) {
+        families.push_back(std::unique_ptr<Family>(new Family()));
+        family = families.back().get();
+        family->name = name;
+        family->help = help;
+        family->type = type;
+    } else if (family->type != type) {
+        throw std::invalid_argument("Telemetry: " + name + " já registrada com outro tipo");
+    }
+    for (std::unique_ptr<Metric>& metric : family->metrics) {
+        if (metric->labels == labels) {
+            return *metric;
+        }
+    }
+    family->metrics.push_back(std::unique_ptr<Metric>(new Metric()));
+    Metric& metric = *family->metrics.back();
+    metric.labels = labels;
+    if (type == Type::Histogram) {
+        metric.histogram.reset(new TelemetryHistogram(min, max, buckets));
+    }
+    return metric;
+}
+
+TelemetryCounter& Telemetry::counter(const std::string& name, const std::string& help, const std::string& labels) {
+    return find(name, help, Type::Counter, labels, 0.0, 0.0, 0).counter;
+}
+
+TelemetryGauge& Telemetry::gauge(const std::string& name, const std::string& help, const std::string& labels) {
+    return find(name, help, Type::Gauge, labels, 0.0, 0.0, 0).gauge;
+}
+
+TelemetryHistogram& Telemetry::histogram(const std::string& name, const std::string& help,
+                                         double min, double max, int buckets, const std::string& labels) {
+    return *find(name, help, Type::Histogram, labels, min, max, buckets).histogram;
+}
+
+std::string Telemetry::escapeLabel(const std::string& value) {
+    std::string escaped;
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            escaped += '\\';
+            escaped += c;
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+void Telemetry::render(std::ostream& out) const {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const std::unique_ptr<Family>& family : families) {
+            const char* type = family->type == Type::Counter ? "counter"
+                             : family->type == Type::Gauge ? "gauge" : "histogram";
+            out << "# HELP " << family->name << " " << family->help << "\n";
+            out << "# TYPE " << family->name << " " << type << "\n";
+            for (const std::unique_ptr<Metric>& metric : family->metrics) {
+                if (family->type == Type::Counter) {
+                    out << family->name << labelSet(metric->labels) << " " << metric->counter.get() << "\n";
+                } else if (family->type == Type::Gauge) {
+                    out << family->name << labelSet(metric->labels) << " " << formatValue(metric->gauge.get()) << "\n";
+                } else {
+                    // Buckets cumulativos; o último limite vira +Inf
+                    const TelemetryHistogram& histogram = *metric->histogram;
+                    uint64_t cumulative = 0;
+                    for (int b = 0; b < histogram.getBuckets(); ++b) {
+                        cumulative += histogram.getBucketCount(b);
+                        double bound = b + 1 == histogram.getBuckets() ? INFINITY : histogram.getUpperBound(b);
+                        out << family->name << "_bucket"
+                            << labelSet(metric->labels, "le=\"" + formatValue(bound) + "\"") << " " << cumulative << "\n";
+                    }
+                    out << family->name << "_sum" << labelSet(metric->labels) << " " << formatValue(histogram.getSum()) << "\n";
+                    out << family->name << "_count" << labelSet(metric->labels) << " " << cumulative << "\n";
+                }
+            }
+        }
+    }
+
+    // Latência dos laços de controle (um summary por tracer e etapa)
+    const char* name = "robot_loop_latency_seconds";
+    out << "# HELP " << name << " Latência por etapa do laço de controle\n";
+    out << "# TYPE " << name << " summary\n";
+    LatencyTracer::forEach([&](const LatencyTracer& tracer) {
+        for (int s = 0; s < static_cast<int>(TraceStage::Count); ++s) {
+            const LatencyHistogram& h = tracer.getHistogram(static_cast<TraceStage>(s));
+            uint64_t count = h.getCount();
+            if (count == 0) {
+                continue;
+            }
+            std::string labels = "loop=\"" + escapeLabel(tracer.getName()) + "\",stage=\"" +
+                                 LatencyTracer::stageId(static_cast<TraceStage>(s)) + "\"";
+            const double quantiles[] = {0.5, 0.9, 0.99};
+            for (double q : quantiles) {
+                out << name << labelSet(labels, "quantile=\"" + formatValue(q) + "\"") << " "
+                    << formatValue(h.percentile(q * 100.0) * 1e-9) << "\n";
+            }
+            out << name << "_sum" << labelSet(labels) << " " << formatValue(h.getMean() * count * 1e-9) << "\n";
+            out << name << "_count" << labelSet(labels) << " " << count << "\n";
+        }
+    });
+}
+
+TelemetryServer::TelemetryServer(const std::string& socketPath, Telemetry& registry)
+    : path(socketPath), telemetry(registry), listenFd(-1), scrapes(0) {
+    wakeFd[0] = wakeFd[1] = -1;
+}
+
+TelemetryServer::~TelemetryServer() {
+    stop();
+}
+
+bool TelemetryServer::start() {
+    if (thread.joinable()) {
+        return true;
+    }
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        error = "caminho do socket inválido: " + path;
+        return false;
+    }
+    std::strcpy(address.sun_path, path.c_str());
+
+    // Socket de uma execução anterior que não foi removido; qualquer outro
+    // arquivo no caminho (TELEMETRIA_SOCKET errado) é mantido e recusado
+    struct stat existing;
+    if (::lstat(path.c_str(), &existing) == 0) {
+        if (!S_ISSOCK(existing.st_mode)) {
+            error = path + ": já existe e não é um socket";
+            return false;
+        }
+        ::unlink(path.c_str());
+    }
+
+    listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        error = std::string("socket: ") + std::strerror(errno);
+        return false;
+    }
+    if (::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        ::listen(listenFd, 8) < 0 || ::pipe(wakeFd) < 0) {
+        error = path + ": " + std::strerror(errno);
+        ::close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    thread = std::thread(&TelemetryServer::serve, this);
+    return true;
+}
+
+void TelemetryServer::stop() {
+    if (!thread.joinable()) {
+        return;
+    }
+    char byte = 0;
+    ssize_t ignored = ::write(wakeFd[1], &byte, 1);
+    (void)ignored;
+    thread.join();
+    ::close(listenFd);
+    ::close(wakeFd[0]);
+    ::close(wakeFd[1]);
+    listenFd = wakeFd[0] = wakeFd[1] = -1;
+    ::unlink(path.c_str());
+}
+
+void TelemetryServer::serve() {
+    for (;;) {
+        pollfd fds[2] = {{listenFd, POLLIN, 0}, {wakeFd[0], POLLIN, 0}};
+        if (::poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        if (fds[1].revents != 0) {
+            return;
+        }
+        if (fds[0].revents & POLLIN) {
+            int client = ::accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (client >= 0) {
+                respond(client);
+                ::close(client);
+            }
+        }
+    }
+}
+
+void TelemetryServer::respond(int client) {
+    // Espera brevemente por uma requisição HTTP; leitores simples não enviam nada
+    char request[512];
+    ssize_t received = 0;
+    pollfd fd = {client, POLLIN, 0};
+    if (::poll(&fd, 1, 50) > 0) {
+        received = ::recv(client, request, sizeof(request), 0);
+    }
+    std::ostringstream body;
+    telemetry.render(body);
+    std::string text = body.str();
+    if (received >= 4 && std::strncmp(request, "GET ", 4) == 0) {
+        std::ostringstream header;
+        header << "HTTP/1.0 200 OK\r\n"
+               << "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+               << "Content-Length: " << text.size() << "\r\n\r\n";
+        writeAll(client, header.str());
+    }
+    writeAll(client, text);
+    scrapes.fetch_add(1, std::memory_order_relaxed);
+}
@@ -1,26 +1,43 @@
 #include "Wallfollowerthread.h"
 #include "Config.h"
+#include "AsyncLogger.h"
+#include "PeriodicScheduler.h"
 #include <iostream>
 
 WallFollowerThread::WallFollowerThread(PioneerRobot *_robo)
+    : latency("WallFollowerThread")
 {
     this->robo = _robo;
 }
 
 void *WallFollowerThread::runThread(void *)
 {
+    PeriodicTimer timer(FREQUENCIA_PAREDE);
+    timer.start();
+
     while (this->getRunningWithLock())
     {
-        myMutex.lock();
-        robo->getAllSonar(sonar);
-        seguirParedeDSImples();
-        myMutex.unlock();
+        runCycle();
+        timer.waitNextPeriod();
     }
 
     ArLog::log(ArLog::Normal, "Colision Avoidance.");
     return NULL;
 }
 
+void WallFollowerThread::runCycle()
+{
+    latency.attachToCurrentThread();
+    latency.beginCycle();
+    myMutex.lock();
+    robo->getSnapshot(snapshot);
+    latency.tracepoint(TraceStage::SensorRead);
+    seguirParedeDSImples();
+    latency.tracepoint(TraceStage::Action);
+    myMutex.unlock();
+    latency.endCycle();
+}
+
 void WallFollowerThread::waitOnCondition() { myCondition.wait(); }
 
 void WallFollowerThread::lockMutex() { myMutex.lock(); }
@@ -38,121 +55,39 @@ float WallFollowerThread::Proporcional(float erro, float pGain)
 
 void WallFollowerThread::seguirParedeDSImples()
 {
-    float angulo = Proporcional(200 - sonar[7], 0.05);
-    // Usa a variável angulo para evitar warning (pode ser usada no futuro)
-    (void)angulo;
-
-    if (robo->robot.isHeadingDone() && robo->robot.isMoveDone())
-    {
-        // Uma re para nao beijar a parede
-        if (sonar[3] <= LIMIARFRENTE / 5 || sonar[4] <= LIMIARFRENTE / 5)
-        {
-            robo->Move(-VELOCIDADEDESLOCAMENTO, -VELOCIDADEDESLOCAMENTO);
-            std::cout << "Frente perto \n";
-        }
-        // Uma re para nao beijar a parede
-        else if (sonar[2] <= LIMIARFRENTE / 4 || sonar[5] <= LIMIARFRENTE / 4)
-        {
-            robo->Move(-VELOCIDADEDESLOCAMENTO, -VELOCIDADEDESLOCAMENTO);
-            std::cout << "DDD ou DDE perto \n";
-        }
-        // Parede em frente
-        else if (sonar[3] < LIMITELEITURA / 4 && sonar[4] < LIMITELEITURA / 4)
-        {
-            std::cout << "Parede em frente \n";
-            robo->Rotaciona(10, 1, VELOCIDADEROTACAO); // virar a esquerda
-            parede_direita = 0;
-        }
-        // Procurar parede
-        else if (parede_direita && sonar[7] == LIMITELEITURA)
-        {
-            std::cout << "Procurar parede \n";
-            robo->Rotaciona(-15, 1, VELOCIDADEROTACAO); // virar a direita para procurar a parede
-        }
-        // Parede a direita
-        else if (sonar[7] < LIMITELEITURA || sonar[6] < LIMITELEITURA || sonar[5] < LIMITELEITURA)
-        {
-            std::cout << "Direita: " << sonar[7] << " Parede: " << parede_direita << "\n";
-            parede_direita = 1;
-            std::cout << "Parede a direita \n";
-
-            if (sonar[7] <= 200)
-            {
-                std::cout << "Correcao a esquerda 7\n";
-                robo->Rotaciona(5, 1, VELOCIDADEROTACAO); // virar a esquerda
-            }
-            else if (sonar[6] <= 500)
-            {
-                std::cout << "Correcao a esquerda 6\n";
-                robo->Rotaciona(5, 1, VELOCIDADEROTACAO); // virar a esquerda
-            }
-            else if (sonar[5] <= 700)
-            {
-                std::cout << "Correcao a esquerda 5\n";
-                robo->Rotaciona(5, 1, VELOCIDADEROTACAO); // virar a esquerda
-            }
-            else if (sonar[3] <= 1000 || sonar[4] <= 1000)
-            {
-                std::cout << "Correcao a esquerda 3 4\n";
-                robo->Rotaciona(5, 1, VELOCIDADEROTACAO); // virar a esquerda
-            }
-            else if (sonar[7] > 500)
-            {
-                std::cout << "Correcao a direita \n";
-                robo->Rotaciona(-5, 1, VELOCIDADEROTACAO); // virar a direita
-            }
-            else
-            {
-                std::cout << "Parede a direita, mas seguir em frente \n";
-                robo->Move(VELOCIDADEDESLOCAMENTO, VELOCIDADEDESLOCAMENTO); // seguir em frente
-            }
-        }
-        // Quina
-        else if ((sonar[3] <= LIMITELEITURA / 5 && sonar[4] <= LIMITELEITURA / 5) && sonar[7] < LIMITELEITURA / 5)
-        {
-            parede_direita = 1;
-            std::cout << "Quina a direita \n";
-            robo->Rotaciona(90, 1, VELOCIDADEROTACAO); // virar a esquerda
-        }
-        else
-        {
-            parede_direita = 0;
-            std::cout << "Nenhuma parede detectada \n";
-            robo->Move(VELOCIDADEDESLOCAMENTO, VELOCIDADEDESLOCAMENTO); // seguir em frente
-        }
-        //}
-    }
+    robo->execute(behavior.propose(snapshot).command);
 }
 
 void WallFollowerThread::seguirParedeDComP()
 {
+    const int *sonar = snapshot.sonar;
     float angulo = 0, velF = 0;
 
     angulo = Proporcional(200 - sonar[7], 0.05);
     velF = Proporcional(1000 - (sonar[3] + sonar[4]) / 2, 0.5);
     
     // distDDD_DDE = Proporcional(1250 - (sonar[2]+sonar[5])/2, 0.05);
-    std::cout << "VelF: " << velF;
+    LOG_RATE_LIMITED(LogLevel::Info, 2, "VelF: {}", velF);
 
     // Procurar parede
-    if (parede_direita && sonar[7] == LIMITELEITURA)
+    if (behavior.isFollowingWall() && sonar[7] == LIMITELEITURA)
     {
-        std::cout << "Procurar parede \n";
+        LOG_RATE_LIMITED(LogLevel::Info, 2, "Procurar parede");
         robo->Rotaciona(-angulo, 1, VELOCIDADEROTACAO); // virar a direita para procurar a parede -15
     }
     // Parede a direita
     else if (sonar[7] < LIMITELEITURA)
     {
-        std::cout << "Direita: " << sonar[7] << " Parede: " << parede_direita << "\n";
-        parede_direita = 1;
-        std::cout << "Parede a direita \n";
+        LOG_RATE_LIMITED(LogLevel::Info, 2, "Direita: {} Parede: {}", sonar[7], static_cast<int>(behavior.isFollowingWall()));
+        behavior.setFollowingWall(true);
+        LOG_RATE_LIMITED(LogLevel::Info, 2, "Parede a direita");
         robo->Rotaciona(angulo, 1, VELOCIDADEROTACAO);
     }
     // Quina
     else if ((sonar[3] <= LIMITELEITURA && sonar[4] <= LIMITELEITURA) && sonar[7] < LIMITELEITURA)
     {
-        parede_direita = 1;
-        std::cout << "Quina a direita \n";
+        behavior.setFollowingWall(true);
+        LOG_RATE_LIMITED(LogLevel::Info, 2, "Quina a direita");
         robo->Rotaciona(angulo, 1, VELOCIDADEROTACAO);
     }
 
@@ -0,0 +1,74 @@
+#include "WorkerPool.h"
+#include <algorithm>
+
+WorkerPool::WorkerPool(int count) : active(0), stopping(false), executed(0), failed(0) {
+    if (count <= 0) {
+        count = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    for (int i = 0; i < count; ++i) {
+        threads.push_back(std::thread(&WorkerPool::workerLoop, this));
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+bool WorkerPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) {
+            return false;
+        }
+        queue.push_back(std::move(task));
+    }
+    wake.notify_one();
+    return true;
+}
+
+void WorkerPool::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return queue.empty() && active == 0; });
+}
+
+size_t WorkerPool::getQueued() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return queue.size();
+}
+
+void WorkerPool::workerLoop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            // Só encerra com a fila vazia: tarefas já aceitas sempre rodam
+            wake.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) {
+                return;
+            }
+            task = std::move(queue.front());
+            queue.pop_front();
+            active++;
+        }
+        try {
+            task();
+        } catch (...) {
+            failed.fetch_add(1, std::memory_order_relaxed);
+        }
+        executed.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            active--;
+            if (queue.empty() && active == 0) {
+                idle.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,478 @@
+/**
+ * @file benchmark.cpp
+ * @brief Suíte de microbenchmarks da biblioteca neuralnetwork
+ *
+ * Mede Layer::forward, Layer::backward, Layer::updateWeights,
+ * NeuralNetwork::predict, train e trainBatch variando largura das camadas,
+ * profundidade da rede e função de ativação, além dos caminhos de inferência
+ * da rede de produção 4→5→1 (FixedNetwork e QuantizedNetwork).
+ *
+ * Para cada caso:
+ * - o número de iterações é calibrado até uma repetição durar --min-time ms;
+ * - são feitas --repetitions repetições, reportando média, mediana, desvio
+ *   padrão e mínimo de ns/op;
+ * - alocações/op são contadas substituindo o operator new global;
+ * - throughput é reportado em itens/s (amostras para train/trainBatch).
+ *
+ * Uso:
+ *   ./build/benchmark [opções]
+ *
+ * Opções:
+ *   --filter <texto>         Executa apenas casos cujo nome contém o texto
+ *   --repetitions <n>        Repetições por caso (padrão: 5)
+ *   --min-time <ms>          Duração mínima de cada repetição (padrão: 20)
+ *   --json <arquivo>         Grava os resultados em JSON
+ *   --baseline <arquivo>     Compara a mediana com um JSON anterior
+ *   --max-regression <pct>   Falha (código 1) se algum caso ficar mais lento
+ *                            que isso em relação ao baseline (padrão: 10)
+ *   --weights <arquivo>      Pesos da rede de produção (padrão: treino rápido)
+ *
+ * Exemplo (gate de desempenho):
+ *   ./build/benchmark --json antes.json
+ *   ... alteração ...
+ *   ./build/benchmark --baseline antes.json --max-regression 5
+ *
+ * @author Grupo IA - La Salle
+ * @date Novembro/Dezembro 2025
+ */
+
+#include "../include/neuralnetwork/NeuralNetwork.h"
+#include "../include/neuralnetwork/Layer.h"
+#include "../include/neuralnetwork/ActivationFunction.h"
+#include "../include/neuralnetwork/FixedNetwork.h"
+#include "../include/neuralnetwork/QuantizedNetwork.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ===== Contagem de alocações =====
+// Substitui o operator new global: toda alocação da biblioteca passa por aqui.
+
+static std::atomic<unsigned long long> allocationCount(0);
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+// ===== Infraestrutura =====
+
+struct BenchmarkOptions {
+    std::string filter;
+    int repetitions = 5;
+    double minTimeMs = 20.0;
+    std::string jsonFile;
+    std::string baselineFile;
+    double maxRegression = 10.0;
+    std::string weightsFile;
+};
+
+struct BenchmarkResult {
+    std::string name;
+    long iterations = 0;          // Operações por repetição
+    int repetitions = 0;
+    double meanNs = 0.0;          // ns/op
+    double medianNs = 0.0;
+    double stddevNs = 0.0;
+    double minNs = 0.0;
+    double allocsPerOp = 0.0;
+    double itemsPerSecond = 0.0;  // Baseado na mediana
+};
+
+class BenchmarkSuite {
+private:
+    BenchmarkOptions options;
+    std::vector<BenchmarkResult> results;
+
+    typedef std::chrono::steady_clock Clock;
+
+    static double timeLoop(const std::function<void()>& op, long iterations) {
+        Clock::time_point start = Clock::now();
+        for (long i = 0; i < iterations; ++i) op();
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    }
+
+public:
+    explicit BenchmarkSuite(const BenchmarkOptions& opts) : options(opts) {}
+
+    /**
+     * @brief Mede uma operação
+     * @param name Nome do caso (usado no filtro, no JSON e na comparação)
+     * @param itemsPerOp Itens processados por chamada (para throughput)
+     * @param op Operação a medir
+     */
+    void run(const std::string& name, double itemsPerOp, const std::function<void()>& op) {
+        if (!options.filter.empty() && name.find(options.filter) == std::string::npos) {
+            return;
+        }
+
+        // Calibração: dobrar iterações até atingir o tempo mínimo
+        double minNs = options.minTimeMs * 1e6;
+        long iterations = 1;
+        double elapsed = timeLoop(op, iterations);
+        while (elapsed < minNs && iterations < (1L << 30)) {
+            double factor = elapsed > 0.0 ? std::min(10.0, std::max(2.0, 1.2 * minNs / elapsed)) : 10.0;
+            iterations = static_cast<long>(iterations * factor);
+            elapsed = timeLoop(op, iterations);
+        }
+
+        std::vector<double> samples;
+        samples.reserve(options.repetitions);
+        unsigned long long allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+        for (int r = 0; r < options.repetitions; ++r) {
+            samples.push_back(timeLoop(op, iterations) / iterations);
+        }
+        unsigned long long allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+
+        BenchmarkResult result;
+        result.name = name;
+        result.iterations = iterations;
+        result.repetitions = options.repetitions;
+
+        std::vector<double> sorted = samples;
+        std::sort(sorted.begin(), sorted.end());
+        size_t n = sorted.size();
+        result.medianNs = n % 2 ? sorted[n / 2] : 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+        result.minNs = sorted.front();
+        double sum = 0.0;
+        for (double s : samples) sum += s;
+        result.meanNs = sum / n;
+        double variance = 0.0;
+        for (double s : samples) variance += (s - result.meanNs) * (s - result.meanNs);
+        result.stddevNs = n > 1 ? std::sqrt(variance / (n - 1)) : 0.0;
+        result.allocsPerOp = static_cast<double>(allocations) / (static_cast<double>(iterations) * n);
+        result.itemsPerSecond = result.medianNs > 0.0 ? itemsPerOp * 1e9 / result.medianNs : 0.0;
+
+        std::cout << std::left << std::setw(52) << name << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(12) << result.medianNs
+                  << " ±" << std::setw(7) << result.stddevNs
+                  << std::setprecision(2) << std::setw(9) << result.allocsPerOp
+                  << std::scientific << std::setprecision(3) << std::setw(13) << result.itemsPerSecond
+                  << std::defaultfloat << std::endl;
+
+        results.push_back(result);
+    }
+
+    const std::vector<BenchmarkResult>& getResults() const { return results; }
+
+    bool writeJson(const std::string& filename) const {
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Erro ao abrir arquivo para escrita: " << filename << std::endl;
+            return false;
+        }
+
+        file << std::setprecision(6);
+        file << "{\n";
+        file << "  \"context\": {\"compiler\": \"" << __VERSION__ << "\", \"repetitions\": "
+             << options.repetitions << ", \"min_time_ms\": " << options.minTimeMs << "},\n";
+        file << "  \"benchmarks\": [\n";
+        // Um caso por linha (facilita diff e a leitura em readBaseline)
+        for (size_t i = 0; i < results.size(); ++i) {
+            const BenchmarkResult& r = results[i];
+            file << "    {\"name\": \"" << r.name << "\", \"iterations\": " << r.iterations
+                 << ", \"repetitions\": " << r.repetitions
+                 << ", \"mean_ns\": " << r.meanNs << ", \"median_ns\": " << r.medianNs
+                 << ", \"stddev_ns\": " << r.stddevNs << ", \"min_ns\": " << r.minNs
+                 << ", \"allocs_per_op\": " << r.allocsPerOp
+                 << ", \"items_per_second\": " << r.itemsPerSecond << "}"
+                 << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        file << "  ]\n}\n";
+        return true;
+    }
+
+    /**
+     * @brief Lê nome → mediana de um JSON gravado por writeJson
+     */
+    static std::map<std::string, double> readBaseline(const std::string& filename) {
+        std::map<std::string, double> baseline;
+        std::ifstream file(filename);
+        std::string line;
+        const std::string nameKey = "\"name\": \"";
+        const std::string medianKey = "\"median_ns\": ";
+        while (std::getline(file, line)) {
+            size_t namePos = line.find(nameKey);
+            size_t medianPos = line.find(medianKey);
+            if (namePos == std::string::npos || medianPos == std::string::npos) continue;
+            namePos += nameKey.size();
+            std::string name = line.substr(namePos, line.find('"', namePos) - namePos);
+            baseline[name] = std::atof(line.c_str() + medianPos + medianKey.size());
+        }
+        return baseline;
+    }
+
+    /**
+     * @brief Compara com o baseline e retorna quantos casos regrediram
+     */
+    int compareWithBaseline(const std::string& filename, double maxRegression) const {
+        std::map<std::string, double> baseline = readBaseline(filename);
+        if (baseline.empty()) {
+            std::cerr << "Erro: baseline vazio ou inválido: " << filename << std::endl;
+            return -1;
+        }
+
+        int regressions = 0;
+        std::cout << "\nComparação com " << filename << " (mediana ns/op):" << std::endl;
+        for (const BenchmarkResult& r : results) {
+            auto it = baseline.find(r.name);
+            if (it == baseline.end() || it->second <= 0.0) continue;
+            double delta = 100.0 * (r.medianNs - it->second) / it->second;
+            bool regressed = delta > maxRegression;
+            if (regressed) regressions++;
+            std::cout << "  " << std::left << std::setw(52) << r.name << std::right << std::fixed
+                      << std::setprecision(1) << std::setw(10) << it->second << " -> "
+                      << std::setw(10) << r.medianNs << "  " << std::showpos << delta << "%"
+                      << std::noshowpos << (regressed ? "  ✗ REGRESSÃO" : "") << std::endl;
+        }
+        return regressions;
+    }
+};
+
+// ===== Casos =====
+
+static std::vector<double> randomVector(size_t size) {
+    std::vector<double> values(size);
+    for (size_t i = 0; i < size; ++i) {
+        values[i] = static_cast<double>(std::rand()) / RAND_MAX;
+    }
+    return values;
+}
+
+static std::string shapeName(int inputs, const std::vector<int>& hidden, int outputs) {
+    std::ostringstream name;
+    name << inputs;
+    for (int width : hidden) name << "-" << width;
+    name << "-" << outputs;
+    return name.str();
+}
+
+static std::unique_ptr<NeuralNetwork> makeNetwork(int inputs, const std::vector<int>& hidden,
+                                                  int outputs, const std::string& activation) {
+    std::unique_ptr<NeuralNetwork> network(new NeuralNetwork(inputs, outputs, 0.3, 0.9));
+    for (int width : hidden) {
+        network->addHiddenLayer(width, createActivation(activation), 0.5);
+    }
+    network->finalize(std::make_shared<SigmoidActivation>(), 0.5);
+    return network;
+}
+
+/**
+ * @brief Layer::forward/backward/updateWeights em camadas quadradas
+ */
+static void benchmarkLayers(BenchmarkSuite& suite) {
+    const char* activations[] = {"Sigmoid", "Tanh", "ReLU", "Linear"};
+    const int widths[] = {4, 16, 64, 256};
+
+    for (int width : widths) {
+        for (const char* activation : activations) {
+            // Varredura completa de ativações apenas numa largura intermediária
+            if (width != 64 && std::string(activation) != "Sigmoid") continue;
+
+            std::ostringstream suffix;
+            suffix << "/" << width << "x" << width << "/" << activation;
+
+            Layer layer(width, width, createActivation(activation));
+            std::vector<double> input = randomVector(width);
+            std::vector<double> gradients = randomVector(width);
+
+            suite.run("Layer::forward" + suffix.str(), 1.0, [&]() {
+                layer.forward(input);
+            });
+
+            layer.forward(input);
+            suite.run("Layer::backward" + suffix.str(), 1.0, [&]() {
+                layer.backward(gradients);
+            });
+
+            suite.run("Layer::updateWeights" + suffix.str(), 1.0, [&]() {
+                layer.updateWeights(1e-9, 0.0);
+            });
+        }
+    }
+}
+
+/**
+ * @brief predict/train/trainBatch variando profundidade, largura e ativação
+ */
+static void benchmarkNetworks(BenchmarkSuite& suite) {
+    struct Shape {
+        std::vector<int> hidden;
+        const char* activation;
+    };
+    const Shape shapes[] = {
+        {{5}, "Sigmoid"},              // Produção
+        {{32}, "Sigmoid"},             // Largura
+        {{128}, "Sigmoid"},
+        {{32, 32}, "Sigmoid"},         // Profundidade
+        {{32, 32, 32, 32}, "Sigmoid"},
+        {{32}, "Tanh"},                // Ativação
+        {{32}, "ReLU"}
+    };
+
+    const size_t batchSize = 16;
+    for (const Shape& shape : shapes) {
+        std::string suffix = "/" + shapeName(4, shape.hidden, 1) + "/" + shape.activation;
+        std::unique_ptr<NeuralNetwork> network = makeNetwork(4, shape.hidden, 1, shape.activation);
+
+        std::vector<std::vector<double>> inputs, targets;
+        for (size_t s = 0; s < batchSize; ++s) {
+            inputs.push_back(randomVector(4));
+            targets.push_back({0.5 + 0.3 * static_cast<double>(s) / batchSize});
+        }
+
+        suite.run("NeuralNetwork::predict" + suffix, 1.0, [&]() {
+            network->predict(inputs[0]);
+        });
+        suite.run("NeuralNetwork::train" + suffix, 1.0, [&]() {
+            network->train(inputs[0], targets[0]);
+        });
+        // Uma época sobre 16 amostras por chamada
+        suite.run("NeuralNetwork::trainBatch" + suffix + "/16", static_cast<double>(batchSize), [&]() {
+            network->trainBatch(inputs, targets, 1, 0.0, false);
+        });
+    }
+}
+
+/**
+ * @brief Caminhos de inferência da rede de produção 4→5→1
+ * @return false se FixedNetwork divergir de predict
+ */
+static bool benchmarkProduction(BenchmarkSuite& suite, const std::string& weightsFile) {
+    std::unique_ptr<NeuralNetwork> network = makeNetwork(4, {5}, 1, "Sigmoid");
+
+    std::vector<std::vector<double>> patterns, targets;
+    for (int mask = 0; mask < 16; ++mask) {
+        patterns.push_back({
+            static_cast<double>(mask & 1), static_cast<double>((mask >> 1) & 1),
+            static_cast<double>((mask >> 2) & 1), static_cast<double>((mask >> 3) & 1)
+        });
+        targets.push_back({0.65});
+    }
+
+    if (!weightsFile.empty()) {
+        if (!network->loadWeights(weightsFile)) {
+            std::cerr << "Erro: não foi possível carregar " << weightsFile << std::endl;
+            return false;
+        }
+    } else {
+        network->trainBatch(patterns, targets, 200, 0.0, false);
+    }
+
+    FixedNetwork<4, 5, 1> fixed(*network);
+    QuantizedNetwork quantized(*network);
+    MemoryDataset calibration(patterns, targets);
+    quantized.calibrate(calibration);
+
+    // A rede fixa deve reproduzir predict exatamente
+    bool identical = true;
+    for (const auto& p : patterns) {
+        FixedNetwork<4, 5, 1>::Input in = {{p[0], p[1], p[2], p[3]}};
+        if (fixed.predict(in)[0] != network->predict(p)[0]) identical = false;
+    }
+
+    const std::vector<double>& input = patterns[5];
+    FixedNetwork<4, 5, 1>::Input fixedInput = {{input[0], input[1], input[2], input[3]}};
+    volatile double sink = 0.0;
+
+    suite.run("Production::predict/4-5-1", 1.0, [&]() {
+        sink = network->predict(input)[0];
+    });
+    suite.run("Production::FixedNetwork/4-5-1", 1.0, [&]() {
+        sink = fixed.predict(fixedInput)[0];
+    });
+    suite.run("Production::predictFloat/4-5-1", 1.0, [&]() {
+        sink = quantized.predictFloat(input)[0];
+    });
+    suite.run("Production::predictInt8/4-5-1", 1.0, [&]() {
+        sink = quantized.predictInt8(input)[0];
+    });
+    (void)sink;
+
+    if (!identical) {
+        std::cerr << "✗ FixedNetwork diverge de NeuralNetwork::predict" << std::endl;
+    }
+    return identical;
+}
+
+int main(int argc, char* argv[]) {
+    BenchmarkOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            options.repetitions = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            options.minTimeMs = std::atof(argv[++i]);
+        } else if (arg == "--json" && i + 1 < argc) {
+            options.jsonFile = argv[++i];
+        } else if (arg == "--baseline" && i + 1 < argc) {
+            options.baselineFile = argv[++i];
+        } else if (arg == "--max-regression" && i + 1 < argc) {
+            options.maxRegression = std::atof(argv[++i]);
+        } else if (arg == "--weights" && i + 1 < argc) {
+            options.weightsFile = argv[++i];
+        } else {
+            std::cerr << "Opção desconhecida: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    std::srand(42);
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "Microbenchmarks neuralnetwork" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << options.repetitions << " repetições de >= " << options.minTimeMs
+              << " ms por caso\n" << std::endl;
+    std::cout << std::left << std::setw(52) << "Caso" << std::right
+              << std::setw(12) << "ns/op" << std::setw(9) << "desvio"
+              << std::setw(9) << "aloc/op" << std::setw(13) << "itens/s" << std::endl;
+    std::cout << std::string(95, '-') << std::endl;
+
+    BenchmarkSuite suite(options);
+    benchmarkLayers(suite);
+    benchmarkNetworks(suite);
+    bool ok = benchmarkProduction(suite, options.weightsFile);
+
+    if (!options.jsonFile.empty() && suite.writeJson(options.jsonFile)) {
+        std::cout << "\n✓ Resultados salvos em " << options.jsonFile << std::endl;
+    }
+
+    if (!options.baselineFile.empty()) {
+        int regressions = suite.compareWithBaseline(options.baselineFile, options.maxRegression);
+        if (regressions != 0) {
+            std::cout << "\n✗ " << (regressions < 0 ? 0 : regressions)
+                      << " caso(s) acima do limite de " << options.maxRegression << "%" << std::endl;
+            ok = false;
+        } else {
+            std::cout << "\n✓ Nenhuma regressão acima de " << options.maxRegression << "%" << std::endl;
+        }
+    }
+
+    std::cout << "========================================" << std::endl;
+    return ok ? 0 : 1;
+}
@@ -2,13 +2,27 @@
 #include "Aria.h"
 #include <iostream>
 #include "Config.h"
-#include "Colisionavoidancethread.h"
-#include "Wallfollowerthread.h"
 #include "Sonarthread.h"
 #include "Laserthread.h"
+#include "LatencyTracer.h"
+#include "AsyncLogger.h"
+#include "PeriodicScheduler.h"
+#include "Telemetry.h"
+#include "BehaviorController.h"
+#include "Behaviors.h"
+#include "navigation/LikelihoodField.h"
+#include "navigation/ParticleFilter.h"
+#include <csignal>
+#include <memory>
 
 PioneerRobot *robo;
 
+// SIGUSR1: imprime os histogramas de latência no próximo ciclo de controle
+static void onLatencyDumpSignal(int)
+{
+    LatencyTracer::requestDump();
+}
+
 int main(int argc, char **argv)
 {
     int sucesso;
@@ -16,24 +30,108 @@ int main(int argc, char **argv)
     robo = new PioneerRobot(ConexaoSimulacao, "", &sucesso);
 
     ArLog::log(ArLog::Normal, "Criando as theads...");
-    ColisionAvoidanceThread colisionAvoidanceThread(robo);
-    // WallFollowerThread wallFollowerThread(robo);
     SonarThread sonarReadingThread(robo);
     // LaserThread laserReadingThread(robo);
 
+    std::signal(SIGUSR1, onLatencyDumpSignal);
+
+    PeriodicScheduler scheduler;
+
     ArLog::log(ArLog::Normal, "Sonar Readings thread ...");
-    sonarReadingThread.runAsync();
+    scheduler.addTask("SonarThread", TaskConfig(FREQUENCIA_SONAR),
+                      [&sonarReadingThread] { sonarReadingThread.runCycle(); });
 
     // ArLog::log(ArLog::Normal, "Laser Readings thread ...");
-    // laserReadingThread.runAsync();
+    // scheduler.addTask("LaserThread", TaskConfig(FREQUENCIA_LASER),
+    //                   [&laserReadingThread] { laserReadingThread.runCycle(); });
+
+    // Desvio de obstáculos subsume o seguidor de parede: um único laço lê os
+    // sensores uma vez e emite um único comando por ciclo
+    ArLog::log(ArLog::Normal, "Behavior controller (colision avoidance + wall following) ...");
+    CollisionAvoidanceBehavior collisionAvoidance;
+    WallFollowerBehavior wallFollower;
+    BehaviorArbiter arbiter(ArbitrationMode::Subsumption);
+    // Com o planejador DWA (sempre ativo) ele assume sozinho o laço de controle
+    DwaConfig dwaConfig;
+    dwaConfig.maxVelocity = DWA_VELOCIDADE_MAX;
+    DwaBehavior dwa(dwaConfig);
+    OccupancyGrid occupancyGrid;
+    GlobalNavigator navigator;
+    // Mapa conhecido + filtro de partículas: a pose do snapshot deixa de derivar com a odometria
+    std::unique_ptr<LikelihoodField> likelihoodField;
+    std::unique_ptr<ParticleFilter> localizer;
+    if (LOCALIZACAO_ATIVA)
+    {
+        if (occupancyGrid.load(MAPA_ARQUIVO))
+        {
+            MclConfig mclConfig;
+            mclConfig.particles = MCL_PARTICULAS;
+            likelihoodField.reset(new LikelihoodField(occupancyGrid));
+            localizer.reset(new ParticleFilter(*likelihoodField, mclConfig));
+            localizer->initialize(robo->getPose(), 200.0, 10.0);
+            robo->setLocalizer(localizer.get());
+            ArLog::log(ArLog::Normal, "Localização MCL: %d partículas, %d threads",
+                       MCL_PARTICULAS, localizer->getThreads());
+        }
+        else
+        {
+            ArLog::log(ArLog::Normal, "Mapa %s não encontrado: pose só da odometria", MAPA_ARQUIVO);
+        }
+    }
+    if (CONTROLADOR_DWA)
+    {
+        arbiter.addBehavior(dwa, 10);
+        if (OBJETIVO_ATIVO)
+        {
+            // Caminho global (D* Lite sobre o mapa) guiando o planejador local
+            robo->setMap(&occupancyGrid);
+            navigator.setGoal(OBJETIVO_X, OBJETIVO_Y);
+            dwa.setNavigator(&navigator);
+        }
+    }
+    else
+    {
+        arbiter.addBehavior(collisionAvoidance, 10);
+        arbiter.addBehavior(wallFollower, 1);
+    }
+    BehaviorController behaviorController(robo, arbiter);
+    scheduler.addTask("BehaviorController",
+                      TaskConfig(FREQUENCIA_COLISAO, PRIORIDADE_CONTROLE, CPU_CONTROLE),
+                      [&behaviorController] { behaviorController.runCycle(); });
 
-    ArLog::log(ArLog::Normal, "Colision Avoidance thread ...");
-    colisionAvoidanceThread.runAsync();
+    scheduler.start();
 
-    // ArLog::log(ArLog::Normal, "Wall Following thread ...");
-    // wallFollowerThread.runAsync();
+    TelemetryServer telemetryServer(TELEMETRIA_SOCKET);
+    if (TELEMETRIA_ATIVA && telemetryServer.start())
+        ArLog::log(ArLog::Normal, "Telemetria em %s", TELEMETRIA_SOCKET);
+    else if (TELEMETRIA_ATIVA)
+        ArLog::log(ArLog::Normal, "Telemetria desativada: %s", telemetryServer.getError().c_str());
 
     robo->robot.waitForRunExit();
+    scheduler.stop();
+    // Aria::exit não destrói os objetos locais: remove o socket aqui
+    telemetryServer.stop();
+    robo->setMap(NULL);
+    robo->setLocalizer(NULL);
+
+    AsyncLogger::instance().flush();
+    LatencyTracer::printAll(std::cout);
+    scheduler.printStatistics(std::cout);
+    arbiter.printStatistics(std::cout);
+    robo->motion.printStatistics(std::cout);
+    if (localizer)
+    {
+        Pose2D pose = localizer->estimate();
+        std::cout << "Localização: " << localizer->getUpdates() << " atualizações, "
+                  << localizer->getResamples() << " reamostragens, pose final (" << pose.x << ", "
+                  << pose.y << ", " << pose.theta << ")" << std::endl;
+    }
+    if (navigator.hasGoal())
+    {
+        std::cout << "Navegação global: objetivo " << (navigator.isGoalReached() ? "alcançado" : "não alcançado")
+                  << ", " << navigator.getReplans() << " replanejamentos, "
+                  << navigator.getChangedCells() << " células alteradas" << std::endl;
+    }
 
     Aria::exit(0);
 }
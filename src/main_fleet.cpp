@@ -0,0 +1,245 @@
+/**
+ * @file main_fleet.cpp
+ * @brief Vários robôs controlados por um único processo
+ *
+ * Cada robô (Pioneer real, MobileSim ou MockRobot) tem seu próprio
+ * NeuralCollisionAvoidance como comportamento, e todos leem os mesmos
+ * pesos da rede (carregados uma única vez). Os ciclos de controle rodam
+ * num pool fixo de threads (FleetSupervisor), não numa thread por robô.
+ *
+ * USO:
+ *   ./build/main_fleet [opções] [host[:porta] ...]
+ *
+ * OPÇÕES:
+ *   --mock N       Adiciona N robôs simulados sem ARIA (MockRobot)
+ *   --workers W    Threads do pool (padrão FROTA_WORKERS)
+ *   --hz F         Frequência de controle de cada robô (padrão FREQUENCIA_FROTA)
+ *   --seconds S    Encerra após S segundos (padrão: até Ctrl+C)
+ *   --weights ARQ  Pesos da rede (sem arquivo, treina uma vez)
+ *   --batch B      Inferência em lotes de até B pedidos (padrão INFERENCIA_LOTE)
+ *
+ * EXEMPLOS:
+ *   ./build/main_fleet --mock 50 --seconds 10
+ *   ./build/main_fleet --mock 50 --workers 16 --batch 16
+ *   ./build/main_fleet localhost:8101 localhost:8102 --weights trained_weights.json
+ *
+ * Com --weights, kill -HUP <pid> recarrega o arquivo e troca os pesos de
+ * todos os robôs sem parar a frota (RECARGA_MODELO).
+ */
+
+#include "ClassRobo.h"
+#include "Aria.h"
+#include "Config.h"
+#include "FleetSupervisor.h"
+#include "MockRobot.h"
+#include "NeuralCollisionAvoidance.h"
+#include "LatencyTracer.h"
+#include "AsyncLogger.h"
+#include "Telemetry.h"
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+static volatile std::sig_atomic_t stopRequested = 0;
+
+static void onStopSignal(int)
+{
+    stopRequested = 1;
+}
+
+static void onLatencyDumpSignal(int)
+{
+    LatencyTracer::requestDump();
+}
+
+static volatile std::sig_atomic_t reloadRequested = 0;
+
+static void onReloadSignal(int)
+{
+    reloadRequested = 1;
+}
+
+int main(int argc, char **argv)
+{
+    int mockCount = 0;
+    int workers = FROTA_WORKERS;
+    double rateHz = FREQUENCIA_FROTA;
+    double seconds = 0.0;
+    int batch = INFERENCIA_LOTE;
+    std::string weightsFile;
+    std::vector<std::string> addresses;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--mock" && hasValue)
+            mockCount = std::atoi(argv[++i]);
+        else if (arg == "--workers" && hasValue)
+            workers = std::atoi(argv[++i]);
+        else if (arg == "--hz" && hasValue)
+            rateHz = std::atof(argv[++i]);
+        else if (arg == "--seconds" && hasValue)
+            seconds = std::atof(argv[++i]);
+        else if (arg == "--batch" && hasValue)
+            batch = std::atoi(argv[++i]);
+        else if (arg == "--weights" && hasValue)
+            weightsFile = argv[++i];
+        else if (arg.compare(0, 2, "--") == 0)
+        {
+            std::cerr << "Opção desconhecida: " << arg << std::endl;
+            return 1;
+        }
+        else
+            addresses.push_back(arg);
+    }
+    if (mockCount <= 0 && addresses.empty())
+    {
+        std::cerr << "Uso: " << argv[0]
+                  << " [--mock N] [--workers W] [--hz F] [--seconds S] [--weights ARQ] [--batch B] [host[:porta] ...]"
+                  << std::endl;
+        return 1;
+    }
+
+    // Pesos carregados (ou treinados) uma vez e compartilhados, somente leitura
+    NeuralCollisionAvoidance model(NULL);
+    if (!model.initializeNetwork(weightsFile))
+    {
+        std::cerr << "✗ Falha ao inicializar rede neural!" << std::endl;
+        return 1;
+    }
+    std::shared_ptr<const NeuralCollisionAvoidance::ControlNetwork> weights = model.exportNetwork();
+    // Com lote, os ciclos que rodam ao mesmo tempo (até --workers) dividem uma avaliação
+    std::unique_ptr<InferenceServer<NeuralCollisionAvoidance::ControlNetwork>> server;
+    if (batch > 0)
+        server.reset(new InferenceServer<NeuralCollisionAvoidance::ControlNetwork>(
+            weights, InferenceConfig(batch, INFERENCIA_ATRASO_US)));
+
+    std::vector<std::unique_ptr<PioneerRobot>> pioneers;
+    for (size_t i = 0; i < addresses.size(); i++)
+    {
+        int sucesso;
+        std::cout << "Conectando a " << addresses[i] << "..." << std::endl;
+        std::unique_ptr<PioneerRobot> pioneer(new PioneerRobot(ConexaoSimulacao, addresses[i].c_str(), &sucesso));
+        if (!sucesso)
+        {
+            std::cerr << "✗ Falha ao conectar a " << addresses[i] << std::endl;
+            return 1;
+        }
+        pioneers.push_back(std::move(pioneer));
+    }
+
+    // Robôs simulados numa sala 20 x 20 m com pilares, dispostos em grade
+    MockWorld world;
+    world.addRoom(-10000.0, -10000.0, 10000.0, 10000.0);
+    for (int px = -1; px <= 1; px++)
+        for (int py = -1; py <= 1; py++)
+            world.addRoom(px * 5000.0 - 400.0, py * 5000.0 - 400.0, px * 5000.0 + 400.0, py * 5000.0 + 400.0);
+    std::vector<std::unique_ptr<MockRobot>> mocks;
+    for (int cell = 0; (int)mocks.size() < mockCount; cell++)
+    {
+        // Os robôs não se enxergam: quando a grade acaba, posições se repetem
+        double x = -8000.0 + 1000.0 * (cell % 17);
+        double y = -8000.0 + 1000.0 * ((cell / 17) % 17);
+        if (world.clearance(x, y) < 2.0 * MockRobot::RADIUS)
+            continue;
+        mocks.push_back(std::unique_ptr<MockRobot>(
+            new MockRobot(world, Pose2D(x, y, 37.0 * mocks.size()), 1.0 / rateHz)));
+    }
+
+    FleetSupervisor fleet(FleetConfig(rateHz, workers, PRIORIDADE_CONTROLE, CPU_CONTROLE));
+    std::vector<NeuralCollisionAvoidance *> controllers;
+    for (size_t i = 0; i < pioneers.size(); i++)
+    {
+        FleetMember &member = fleet.addRobot(addresses[i], *pioneers[i]);
+        std::unique_ptr<NeuralCollisionAvoidance> controller(new NeuralCollisionAvoidance(pioneers[i].get()));
+        controller->shareNetwork(weights);
+        controller->useInferenceServer(server.get());
+        controllers.push_back(controller.get());
+        member.addBehavior(std::move(controller), 10);
+    }
+    for (size_t i = 0; i < mocks.size(); i++)
+    {
+        FleetMember &member = fleet.addRobot("mock" + std::to_string(i), *mocks[i]);
+        std::unique_ptr<NeuralCollisionAvoidance> controller(new NeuralCollisionAvoidance(NULL));
+        controller->shareNetwork(weights);
+        controller->useInferenceServer(server.get());
+        controllers.push_back(controller.get());
+        member.addBehavior(std::move(controller), 10);
+    }
+
+    // Depois das conexões: a ARIA instala seus próprios tratadores no init
+    std::signal(SIGINT, onStopSignal);
+    std::signal(SIGTERM, onStopSignal);
+    std::signal(SIGUSR1, onLatencyDumpSignal);
+    std::signal(SIGHUP, onReloadSignal);
+
+    fleet.start();
+    std::cout << "✓ Frota em execução: " << fleet.getRobotCount() << " robôs, "
+              << fleet.getThreadCount() << " threads de controle (Ctrl+C encerra)" << std::endl;
+
+    TelemetryServer telemetryServer(TELEMETRIA_SOCKET);
+    if (TELEMETRIA_ATIVA && telemetryServer.start())
+        std::cout << "  Métricas: curl --unix-socket " << TELEMETRIA_SOCKET << " http://localhost/metrics" << std::endl;
+    else if (TELEMETRIA_ATIVA)
+        std::cerr << "⚠ Telemetria desativada: " << telemetryServer.getError() << std::endl;
+
+    auto started = std::chrono::steady_clock::now();
+    while (!stopRequested)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (reloadRequested && RECARGA_MODELO)
+        {
+            // Carregado uma vez nesta thread; cada robô troca o ponteiro no próximo ciclo
+            reloadRequested = 0;
+            if (!weightsFile.empty() && model.reloadNetwork(weightsFile))
+            {
+                weights = model.exportNetwork();
+                for (size_t i = 0; i < controllers.size(); i++)
+                    controllers[i]->shareNetwork(weights);
+                if (server)
+                    server->publish(weights);
+                std::cout << "Pesos recarregados de " << weightsFile << std::endl;
+            }
+            else
+                std::cerr << "⚠ Recarga dos pesos falhou; pesos anteriores mantidos" << std::endl;
+        }
+        if (seconds > 0.0 &&
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count() >= seconds)
+            break;
+    }
+    fleet.stop();
+    telemetryServer.stop();
+
+    for (size_t i = 0; i < pioneers.size(); i++)
+        pioneers[i]->pararMovimento();
+
+    AsyncLogger::instance().flush();
+    fleet.printStatistics(std::cout);
+    if (server)
+        std::cout << "Inferência em lote: " << server->getRequests() << " predições em "
+                  << server->getBatches() << " lotes (média " << server->getMeanBatch()
+                  << ", maior " << server->getLargestBatch() << ")" << std::endl;
+    if (!mocks.empty())
+    {
+        uint64_t collisions = 0;
+        double distance = 0.0;
+        for (size_t i = 0; i < mocks.size(); i++)
+        {
+            collisions += mocks[i]->getCollisions();
+            distance += mocks[i]->getDistanceTravelled();
+        }
+        std::cout << "Robôs simulados: " << distance / 1000.0 << " m percorridos, "
+                  << collisions << " colisões" << std::endl;
+    }
+
+    pioneers.clear();
+    if (!addresses.empty())
+        Aria::exit(0);
+    return 0;
+}
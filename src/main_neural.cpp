@@ -42,6 +42,10 @@
  * Se o arquivo de pesos não for fornecido, treinará uma nova rede
  * (não recomendado - melhor usar pesos pré-treinados para consistência)
  * 
+ * Para trocar o modelo com o robô rodando, substitua o arquivo de pesos
+ * (ou envie kill -HUP <pid>): os novos pesos valem a partir do ciclo
+ * seguinte, sem parar o controle (RECARGA_MODELO em Config.h).
+ * 
  * @author Grupo IA - La Salle
  * @date Novembro/Dezembro 2025
  */
@@ -51,11 +55,38 @@
 #include "Config.h"
 #include "NeuralCollisionAvoidance.h"
 #include "Sonarthread.h"
+#include "LatencyTracer.h"
+#include "AsyncLogger.h"
+#include "PeriodicScheduler.h"
+#include "Telemetry.h"
+#include <sys/stat.h>
+#include <csignal>
 #include <iostream>
 #include <string>
 
 PioneerRobot* robo;
 
+// SIGUSR1: imprime os histogramas de latência no próximo ciclo de controle
+static void onLatencyDumpSignal(int) {
+    LatencyTracer::requestDump();
+}
+
+// SIGHUP: recarrega o arquivo de pesos (tarefa RecargaModelo)
+static volatile std::sig_atomic_t reloadRequested = 0;
+
+static void onReloadSignal(int) {
+    reloadRequested = 1;
+}
+
+// Data de modificação do arquivo em ns (0 se não existir)
+static long long modificationTime(const std::string& path) {
+    struct stat info;
+    if (path.empty() || stat(path.c_str(), &info) != 0) {
+        return 0;
+    }
+    return static_cast<long long>(info.st_mtim.tv_sec) * 1000000000LL + info.st_mtim.tv_nsec;
+}
+
 int main(int argc, char** argv) {
     std::cout << "\n╔════════════════════════════════════════════════════╗" << std::endl;
     std::cout << "║   COLLISION AVOIDANCE NEURAL                       ║" << std::endl;
@@ -141,11 +172,57 @@ int main(int argc, char** argv) {
     std::cout << "INICIANDO SISTEMA" << std::endl;
     std::cout << std::string(50, '=') << std::endl;
     
-    ArLog::log(ArLog::Normal, "Iniciando thread de leitura de sensores...");
-    sonarReadingThread.runAsync();
+    std::signal(SIGUSR1, onLatencyDumpSignal);
+    std::signal(SIGHUP, onReloadSignal);
     
-    ArLog::log(ArLog::Normal, "Iniciando thread de collision avoidance neural...");
-    neuralCollisionAvoidance.runAsync();
+    // Laços em taxa fixa: a decisão roda a FREQUENCIA_DECISAO independentemente
+    // da carga de log/treinamento (opcionalmente em SCHED_FIFO, ver Config.h)
+    // Mapa de ocupação atualizado a cada snapshot (sonar + laser); a decisão
+    // consulta o mapa para escolher o lado do desvio
+    OccupancyGrid occupancyGrid;
+    robo->setMap(&occupancyGrid);
+    
+    PeriodicScheduler scheduler;
+    scheduler.addTask("SonarThread", TaskConfig(FREQUENCIA_SONAR),
+                      [&sonarReadingThread] { sonarReadingThread.runCycle(); });
+    scheduler.addTask("NeuralCollisionAvoidance",
+                      TaskConfig(FREQUENCIA_DECISAO, PRIORIDADE_CONTROLE, CPU_CONTROLE),
+                      [&neuralCollisionAvoidance] { neuralCollisionAvoidance.runCycle(); });
+    
+    if (APRENDIZADO_ONLINE) {
+        OnlineLearningConfig learningConfig;
+        learningConfig.intervalSeconds = APRENDIZADO_PERIODO_S;
+        learningConfig.minNewSamples = APRENDIZADO_MIN_AMOSTRAS;
+        neuralCollisionAvoidance.enableOnlineLearning(learningConfig);
+        ArLog::log(ArLog::Normal, "Aprendizado online ligado (rodadas a cada %.0f s)", APRENDIZADO_PERIODO_S);
+    }
+    
+    // Recarga em thread própria do scheduler: leitura do arquivo e conversão
+    // fora do laço de controle, que só vê a troca do ponteiro
+    long long weightsModified = modificationTime(weightsFile);
+    if (RECARGA_MODELO && !weightsFile.empty()) {
+        scheduler.addTask("RecargaModelo", TaskConfig(1.0 / RECARGA_PERIODO_S),
+                          [&neuralCollisionAvoidance, &weightsFile, &weightsModified] {
+            long long modified = modificationTime(weightsFile);
+            if (reloadRequested || (modified != 0 && modified != weightsModified)) {
+                reloadRequested = 0;
+                weightsModified = modified;
+                if (neuralCollisionAvoidance.reloadNetwork(weightsFile))
+                    ArLog::log(ArLog::Normal, "Pesos recarregados de %s (versão %llu)", weightsFile.c_str(),
+                               static_cast<unsigned long long>(neuralCollisionAvoidance.getModelVersion()));
+                else
+                    ArLog::log(ArLog::Normal, "Recarga de %s falhou; pesos anteriores mantidos", weightsFile.c_str());
+            }
+            neuralCollisionAvoidance.collectRetiredNetworks();
+        });
+    }
+    
+    ArLog::log(ArLog::Normal, "Iniciando laços de sensores e collision avoidance neural...");
+    scheduler.start();
+    
+    TelemetryServer telemetryServer(TELEMETRIA_SOCKET);
+    if (TELEMETRIA_ATIVA && !telemetryServer.start())
+        std::cerr << "⚠ Telemetria desativada: " << telemetryServer.getError() << std::endl;
     
     std::cout << "\n✓ Sistema em execução!" << std::endl;
     std::cout << "  O robô agora está sendo controlado pela rede neural." << std::endl;
@@ -156,13 +233,36 @@ int main(int argc, char** argv) {
     std::cout << "  ⚠️  = Obstáculo próximo (250-600mm)" << std::endl;
     std::cout << "  🔄 = Desvio forçado inteligente" << std::endl;
     std::cout << "  ⬆️ ➡️ ⬅️ = Movimento executado" << std::endl;
+    std::cout << "  kill -USR1 <pid> = Latência do laço de controle (p50/p99/máx)" << std::endl;
+    if (RECARGA_MODELO && !weightsFile.empty())
+        std::cout << "  kill -HUP <pid> (ou novo " << weightsFile << ") = Recarrega os pesos" << std::endl;
+    if (TELEMETRIA_ATIVA)
+        std::cout << "  curl --unix-socket " << TELEMETRIA_SOCKET
+                  << " http://localhost/metrics = Métricas (Prometheus)" << std::endl;
     std::cout << "\n  Pressione Ctrl+C para encerrar e ver estatísticas.\n" << std::endl;
     
     // Aguardar até que o usuário encerre
     robo->robot.waitForRunExit();
+    scheduler.stop();
+    telemetryServer.stop();
+    robo->setMap(NULL);
+    if (OnlineLearner* learner = neuralCollisionAvoidance.getOnlineLearner()) {
+        learner->stop();
+        if (learner->getAccepted() > 0 && learner->saveWeights(APRENDIZADO_ARQUIVO))
+            std::cout << "Pesos do aprendizado online salvos em " << APRENDIZADO_ARQUIVO << std::endl;
+    }
     
-    // Exibir estatísticas antes de sair
+    // Exibir estatísticas antes de sair (após os logs pendentes)
+    AsyncLogger::instance().flush();
     neuralCollisionAvoidance.printStatistics();
+    scheduler.printStatistics(std::cout);
+    robo->motion.printStatistics(std::cout);
+    std::cout << "Mapa de ocupação: " << occupancyGrid.getScans() << " varreduras, "
+              << occupancyGrid.getTileCount() << " blocos ("
+              << occupancyGrid.getMemoryBytes() / 1024 << " KiB)" << std::endl;
+    // Mapa reaproveitado pela localização do main (LOCALIZACAO_ATIVA)
+    if (occupancyGrid.getTileCount() > 0 && occupancyGrid.save(MAPA_ARQUIVO))
+        std::cout << "Mapa salvo em " << MAPA_ARQUIVO << std::endl;
     
     std::cout << "\nEncerrando programa..." << std::endl;
     delete robo;
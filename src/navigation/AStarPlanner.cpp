@@ -0,0 +1,255 @@
+#include "../include/navigation/AStarPlanner.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+namespace {
+
+const float INF = std::numeric_limits<float>::infinity();
+const uint32_t NO_PARENT = 0xFFFFFFFFu;
+
+// Menor f primeiro; empate: maior g (mais perto do objetivo)
+struct HeapOrder {
+    template <typename Node>
+    bool operator()(const Node& a, const Node& b) const {
+        return a.f > b.f || (a.f == b.f && a.g < b.g);
+    }
+};
+
+uint64_t reverseBits(uint64_t v) {
+    v = ((v >> 1) & 0x5555555555555555ULL) | ((v & 0x5555555555555555ULL) << 1);
+    v = ((v >> 2) & 0x3333333333333333ULL) | ((v & 0x3333333333333333ULL) << 2);
+    v = ((v >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((v & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    return __builtin_bswap64(v);
+}
+
+// Palavra de 64 células ao longo de uma linha (horizontal) ou coluna
+inline uint64_t lineWord(const PlanningMap& map, bool horizontal, int line, int first) {
+    return horizontal ? map.rowWord(first, line) : map.columnWord(line, first);
+}
+
+} // namespace
+
+AStarPlanner::AStarPlanner(bool jumpPointSearch)
+    : jumpPoints(jumpPointSearch), capacity(0), expanded(0), pathCost(0.0f) {
+}
+
+float AStarPlanner::octile(int dx, int dy) {
+    dx = std::abs(dx);
+    dy = std::abs(dy);
+    return static_cast<float>(std::max(dx, dy) - std::min(dx, dy)) + 1.41421356f * std::min(dx, dy);
+}
+
+void AStarPlanner::prepare(size_t cells) {
+    if (cells != capacity) {
+        g.assign(cells, INF);
+        parent.assign(cells, NO_PARENT);
+        closed.assign((cells + 63) / 64, 0);
+        touched.clear();
+        capacity = cells;
+    }
+}
+
+void AStarPlanner::reset() {
+    for (uint32_t index : touched) {
+        g[index] = INF;
+        parent[index] = NO_PARENT;
+        closed[index >> 6] = 0;
+    }
+    touched.clear();
+    heap.clear();
+}
+
+void AStarPlanner::relax(uint32_t from, float fromG, int nx, int ny, int width, const GridCell& goal) {
+    const uint32_t next = static_cast<uint32_t>(ny) * width + nx;
+    if (closed[next >> 6] & (uint64_t(1) << (next & 63))) {
+        return;
+    }
+    const int fx = static_cast<int>(from % width);
+    const int fy = static_cast<int>(from / width);
+    const float candidate = fromG + octile(nx - fx, ny - fy);
+    if (candidate < g[next]) {
+        if (g[next] == INF) {
+            touched.push_back(next);
+        }
+        g[next] = candidate;
+        parent[next] = from;
+        heap.push_back(HeapNode{candidate + octile(goal.x - nx, goal.y - ny), candidate, next});
+        std::push_heap(heap.begin(), heap.end(), HeapOrder());
+    }
+}
+
+bool AStarPlanner::jumpStraight(const PlanningMap& map, int x, int y, int dx, int dy, const GridCell& goal,
+                                int& jx, int& jy) const {
+    const bool horizontal = dx != 0;
+    const int step = horizontal ? dx : dy;
+    const int line = horizontal ? y : x;
+    const int goalPosition = horizontal ? goal.x : goal.y;
+    const bool goalOnLine = (horizontal ? goal.y : goal.x) == line;
+    int position = horizontal ? x : y;
+
+    // Varre 64 células por vez; bit i = célula position + step * (i + 1)
+    for (;;) {
+        uint64_t blocked, forced, target = 0;
+        if (step > 0) {
+            const int first = position + 1;
+            blocked = lineWord(map, horizontal, line, first);
+            // Vizinho forçado: a lateral abre logo depois de um obstáculo
+            forced = (~lineWord(map, horizontal, line - 1, first) & lineWord(map, horizontal, line - 1, first - 1)) |
+                     (~lineWord(map, horizontal, line + 1, first) & lineWord(map, horizontal, line + 1, first - 1));
+            if (goalOnLine && goalPosition >= first && goalPosition < first + 64) {
+                target = uint64_t(1) << (goalPosition - first);
+            }
+        } else {
+            const int first = position - 64;
+            blocked = reverseBits(lineWord(map, horizontal, line, first));
+            forced = reverseBits(
+                (~lineWord(map, horizontal, line - 1, first) & lineWord(map, horizontal, line - 1, first + 1)) |
+                (~lineWord(map, horizontal, line + 1, first) & lineWord(map, horizontal, line + 1, first + 1)));
+            if (goalOnLine && goalPosition < position && goalPosition >= first) {
+                target = uint64_t(1) << (position - 1 - goalPosition);
+            }
+        }
+        const uint64_t stop = blocked | (forced & ~blocked) | target;
+        if (stop != 0) {
+            const int i = __builtin_ctzll(stop);
+            if (!((target >> i) & 1) && ((blocked >> i) & 1)) {
+                return false;
+            }
+            position += step * (i + 1);
+            jx = horizontal ? position : x;
+            jy = horizontal ? y : position;
+            return true;
+        }
+        position += step * 64;
+    }
+}
+
+bool AStarPlanner::jump(const PlanningMap& map, int x, int y, int dx, int dy, const GridCell& goal,
+                        int& jx, int& jy) const {
+    if (dx == 0 || dy == 0) {
+        return jumpStraight(map, x, y, dx, dy, goal, jx, jy);
+    }
+    int sx, sy;
+    for (;;) {
+        // Diagonal sem cortar quina: as duas ortogonais precisam estar livres
+        if (map.isBlocked(x + dx, y) || map.isBlocked(x, y + dy) || map.isBlocked(x + dx, y + dy)) {
+            return false;
+        }
+        x += dx;
+        y += dy;
+        if ((x == goal.x && y == goal.y) ||
+            jumpStraight(map, x, y, dx, 0, goal, sx, sy) || jumpStraight(map, x, y, 0, dy, goal, sx, sy)) {
+            jx = x;
+            jy = y;
+            return true;
+        }
+    }
+}
+
+bool AStarPlanner::plan(const PlanningMap& map, const GridCell& start, const GridCell& goal,
+                        std::vector<GridCell>& path) {
+    path.clear();
+    expanded = 0;
+    pathCost = INF;
+    const int width = map.getWidth();
+    const int height = map.getHeight();
+    if (start.x < 0 || start.y < 0 || start.x >= width || start.y >= height || map.isBlocked(goal.x, goal.y)) {
+        return false;
+    }
+
+    prepare(static_cast<size_t>(width) * height);
+    const uint32_t startIndex = static_cast<uint32_t>(start.y) * width + start.x;
+    const uint32_t goalIndex = static_cast<uint32_t>(goal.y) * width + goal.x;
+
+    g[startIndex] = 0.0f;
+    touched.push_back(startIndex);
+    heap.push_back(HeapNode{octile(goal.x - start.x, goal.y - start.y), 0.0f, startIndex});
+
+    bool found = false;
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), HeapOrder());
+        HeapNode node = heap.back();
+        heap.pop_back();
+
+        uint64_t bit = uint64_t(1) << (node.index & 63);
+        if (closed[node.index >> 6] & bit) {
+            continue;   // Entrada antiga (a célula já saiu com g menor)
+        }
+        closed[node.index >> 6] |= bit;
+        expanded++;
+        if (node.index == goalIndex) {
+            found = true;
+            break;
+        }
+
+        const int x = static_cast<int>(node.index % width);
+        const int y = static_cast<int>(node.index / width);
+        const uint32_t from = parent[node.index];
+        if (!jumpPoints || from == NO_PARENT) {
+            for (int dir = 0; dir < PlanningMap::DIRECTIONS; ++dir) {
+                if (!map.canMove(x, y, dir)) {
+                    continue;
+                }
+                int nx = x + PlanningMap::DX[dir];
+                int ny = y + PlanningMap::DY[dir];
+                if (jumpPoints) {
+                    jump(map, x, y, PlanningMap::DX[dir], PlanningMap::DY[dir], goal, nx, ny);
+                }
+                relax(node.index, node.g, nx, ny, width, goal);
+            }
+            continue;
+        }
+
+        // Sucessores podados pela direção de chegada
+        const int px = static_cast<int>(from % width);
+        const int py = static_cast<int>(from / width);
+        const int dx = (x > px) - (x < px);
+        const int dy = (y > py) - (y < py);
+        int dirs[5][2];
+        int count = 0;
+        if (dx != 0 && dy != 0) {
+            dirs[count][0] = 0;  dirs[count][1] = dy; count++;
+            dirs[count][0] = dx; dirs[count][1] = 0;  count++;
+            dirs[count][0] = dx; dirs[count][1] = dy; count++;
+        } else if (dx != 0) {
+            dirs[count][0] = dx; dirs[count][1] = 0;  count++;
+            dirs[count][0] = dx; dirs[count][1] = 1;  count++;
+            dirs[count][0] = dx; dirs[count][1] = -1; count++;
+            dirs[count][0] = 0;  dirs[count][1] = 1;  count++;
+            dirs[count][0] = 0;  dirs[count][1] = -1; count++;
+        } else {
+            dirs[count][0] = 0;  dirs[count][1] = dy; count++;
+            dirs[count][0] = 1;  dirs[count][1] = dy; count++;
+            dirs[count][0] = -1; dirs[count][1] = dy; count++;
+            dirs[count][0] = 1;  dirs[count][1] = 0;  count++;
+            dirs[count][0] = -1; dirs[count][1] = 0;  count++;
+        }
+        for (int i = 0; i < count; ++i) {
+            int jx, jy;
+            if (jump(map, x, y, dirs[i][0], dirs[i][1], goal, jx, jy)) {
+                relax(node.index, node.g, jx, jy, width, goal);
+            }
+        }
+    }
+
+    if (found) {
+        pathCost = g[goalIndex];
+        // Segmentos entre pontos de salto são retos ou diagonais puros
+        GridCell cell = goal;
+        path.push_back(cell);
+        while (cell != start) {
+            uint32_t from = parent[static_cast<size_t>(cell.y) * width + cell.x];
+            GridCell previous(static_cast<int>(from % width), static_cast<int>(from / width));
+            int sx = (previous.x > cell.x) - (previous.x < cell.x);
+            int sy = (previous.y > cell.y) - (previous.y < cell.y);
+            while (cell != previous) {
+                cell = GridCell(cell.x + sx, cell.y + sy);
+                path.push_back(cell);
+            }
+        }
+        std::reverse(path.begin(), path.end());
+    }
+    reset();
+    return found;
+}
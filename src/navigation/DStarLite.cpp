@@ -0,0 +1,195 @@
+#include "../include/navigation/DStarLite.h"
+#include "../include/navigation/AStarPlanner.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+const float INF = std::numeric_limits<float>::infinity();
+
+// Menor chave primeiro
+struct HeapOrder {
+    template <typename Node>
+    bool operator()(const Node& a, const Node& b) const {
+        return b.key < a.key;
+    }
+};
+
+} // namespace
+
+DStarLite::DStarLite(PlanningMap& planningMap)
+    : map(planningMap), width(planningMap.getWidth()), km(0.0f), expanded(0) {
+}
+
+float DStarLite::heuristic(uint32_t index) const {
+    int x = static_cast<int>(index % width);
+    int y = static_cast<int>(index / width);
+    return AStarPlanner::octile(x - start.x, y - start.y);
+}
+
+DStarLite::Key DStarLite::calculateKey(uint32_t index) const {
+    float m = std::min(g[index], rhs[index]);
+    return Key{m + heuristic(index) + km, m};
+}
+
+float DStarLite::edgeCost(int x, int y, int dir) const {
+    return map.canMove(x, y, dir) ? PlanningMap::COST[dir] : INF;
+}
+
+void DStarLite::push(uint32_t index, const Key& key) {
+    inQueue[index] = 1;
+    queuedKey[index] = key;
+    heap.push_back(HeapNode{key, index});
+    std::push_heap(heap.begin(), heap.end(), HeapOrder());
+}
+
+bool DStarLite::topKey(Key& key) {
+    while (!heap.empty()) {
+        const HeapNode& top = heap.front();
+        if (inQueue[top.index] && queuedKey[top.index] == top.key) {
+            key = top.key;
+            return true;
+        }
+        // Entrada desatualizada (estado removido ou reinserido com outra chave)
+        std::pop_heap(heap.begin(), heap.end(), HeapOrder());
+        heap.pop_back();
+    }
+    return false;
+}
+
+void DStarLite::initialize(const GridCell& robot, const GridCell& target) {
+    const size_t cells = static_cast<size_t>(map.getWidth()) * map.getHeight();
+    width = map.getWidth();
+    start = robot;
+    lastStart = robot;
+    goal = target;
+    km = 0.0f;
+    expanded = 0;
+
+    g.assign(cells, INF);
+    rhs.assign(cells, INF);
+    queuedKey.assign(cells, Key{INF, INF});
+    inQueue.assign(cells, 0);
+    heap.clear();
+
+    uint32_t goalIndex = indexOf(goal.x, goal.y);
+    rhs[goalIndex] = 0.0f;
+    push(goalIndex, Key{heuristic(goalIndex), 0.0f});
+}
+
+void DStarLite::moveStart(const GridCell& robot) {
+    km += AStarPlanner::octile(robot.x - lastStart.x, robot.y - lastStart.y);
+    lastStart = robot;
+    start = robot;
+}
+
+void DStarLite::updateVertex(uint32_t index) {
+    const int x = static_cast<int>(index % width);
+    const int y = static_cast<int>(index / width);
+    if (x != goal.x || y != goal.y) {
+        float best = INF;
+        for (int dir = 0; dir < PlanningMap::DIRECTIONS; ++dir) {
+            float cost = edgeCost(x, y, dir);
+            if (cost != INF) {
+                best = std::min(best, cost + g[indexOf(x + PlanningMap::DX[dir], y + PlanningMap::DY[dir])]);
+            }
+        }
+        rhs[index] = best;
+    }
+    if (g[index] != rhs[index]) {
+        push(index, calculateKey(index));
+    } else {
+        inQueue[index] = 0;
+    }
+}
+
+void DStarLite::computeShortestPath() {
+    const uint32_t startIndex = indexOf(start.x, start.y);
+    Key top;
+    while (topKey(top) && (top < calculateKey(startIndex) || rhs[startIndex] > g[startIndex])) {
+        uint32_t u = heap.front().index;
+        std::pop_heap(heap.begin(), heap.end(), HeapOrder());
+        heap.pop_back();
+        inQueue[u] = 0;
+        expanded++;
+
+        Key updated = calculateKey(u);
+        if (top < updated) {
+            push(u, updated);
+            continue;
+        }
+
+        const int x = static_cast<int>(u % width);
+        const int y = static_cast<int>(u / width);
+        if (g[u] > rhs[u]) {
+            g[u] = rhs[u];
+        } else {
+            g[u] = INF;
+            updateVertex(u);
+        }
+        // Predecessores de u: os vizinhos (o custo de cada aresta é checado em updateVertex)
+        for (int dir = 0; dir < PlanningMap::DIRECTIONS; ++dir) {
+            int nx = x + PlanningMap::DX[dir];
+            int ny = y + PlanningMap::DY[dir];
+            if (nx >= 0 && ny >= 0 && nx < width && ny < map.getHeight()) {
+                updateVertex(indexOf(nx, ny));
+            }
+        }
+    }
+}
+
+bool DStarLite::updateCell(int x, int y, bool blocked) {
+    if (x < 0 || y < 0 || x >= width || y >= map.getHeight() || map.isBlocked(x, y) == blocked) {
+        return false;
+    }
+    map.setBlocked(x, y, blocked);
+    // Arestas que entram na célula e diagonais que passam pela quina dela
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            int nx = x + dx;
+            int ny = y + dy;
+            if (nx >= 0 && ny >= 0 && nx < width && ny < map.getHeight()) {
+                updateVertex(indexOf(nx, ny));
+            }
+        }
+    }
+    return true;
+}
+
+bool DStarLite::computePath(std::vector<GridCell>& path) {
+    path.clear();
+    if (g.empty()) {
+        return false;
+    }
+    computeShortestPath();
+
+    // A busca para com o robô localmente consistente pelo rhs; g dele pode seguir infinito
+    GridCell cell = start;
+    if (rhs[indexOf(cell.x, cell.y)] == INF) {
+        return false;
+    }
+    path.push_back(cell);
+    const size_t limit = g.size();
+    while (cell != goal && path.size() <= limit) {
+        float best = INF;
+        int bestDir = -1;
+        for (int dir = 0; dir < PlanningMap::DIRECTIONS; ++dir) {
+            float cost = edgeCost(cell.x, cell.y, dir);
+            if (cost == INF) {
+                continue;
+            }
+            float total = cost + g[indexOf(cell.x + PlanningMap::DX[dir], cell.y + PlanningMap::DY[dir])];
+            if (total < best) {
+                best = total;
+                bestDir = dir;
+            }
+        }
+        if (bestDir < 0) {
+            path.clear();
+            return false;
+        }
+        cell = GridCell(cell.x + PlanningMap::DX[bestDir], cell.y + PlanningMap::DY[bestDir]);
+        path.push_back(cell);
+    }
+    return cell == goal;
+}
@@ -0,0 +1,239 @@
+#include "../include/navigation/DwaPlanner.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+const double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+const float FAR_AWAY = 1.0e6f;   // Preenchimento: nunca é o obstáculo mais próximo
+const int OBSTACLE_LANES = 4;
+const double AHEAD_STEP = 150.0;   // Passo da sondagem em linha reta após o arco (mm)
+const double NO_COLLISION = std::numeric_limits<double>::infinity();
+
+/**
+ * Menor distância ao quadrado de (x, y) aos obstáculos.
+ * n precisa ser múltiplo de 4 (os vetores são preenchidos com FAR_AWAY).
+ */
+float minDistanceSq(const float* ox, const float* oy, size_t n, float x, float y) {
+#if defined(__SSE2__)
+    __m128 px = _mm_set1_ps(x);
+    __m128 py = _mm_set1_ps(y);
+    __m128 best = _mm_set1_ps(FAR_AWAY * FAR_AWAY);
+    for (size_t i = 0; i < n; i += OBSTACLE_LANES) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(ox + i), px);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(oy + i), py);
+        best = _mm_min_ps(best, _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+    }
+    best = _mm_min_ps(best, _mm_shuffle_ps(best, best, _MM_SHUFFLE(1, 0, 3, 2)));
+    best = _mm_min_ps(best, _mm_shuffle_ps(best, best, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(best);
+#else
+    float best = FAR_AWAY * FAR_AWAY;
+    for (size_t i = 0; i < n; ++i) {
+        float dx = ox[i] - x;
+        float dy = oy[i] - y;
+        best = std::min(best, dx * dx + dy * dy);
+    }
+    return best;
+#endif
+}
+
+double normalizeAngle(double degrees) {
+    while (degrees > 180.0) degrees -= 360.0;
+    while (degrees < -180.0) degrees += 360.0;
+    return degrees;
+}
+
+} // namespace
+
+DwaConfig::DwaConfig()
+    : maxVelocity(600.0), maxRotVelocity(90.0), acceleration(500.0), rotAcceleration(180.0),
+      windowTime(0.25), horizon(1.5), simStep(0.1), velocitySamples(11), rotVelocitySamples(21),
+      robotRadius(260.0), safetyMargin(40.0), maxClearance(1500.0), obstacleRange(3000.0),
+      axleTrack(330.0), headingWeight(0.8), clearanceWeight(1.5), velocityWeight(0.6),
+      maxObstacles(1024) {
+}
+
+DwaPlanner::DwaPlanner(const DwaConfig& plannerConfig)
+    : config(plannerConfig), obstacleCount(0), evaluated(0) {
+    config.velocitySamples = std::max(1, config.velocitySamples);
+    config.rotVelocitySamples = std::max(1, config.rotVelocitySamples);
+    config.simStep = std::max(1e-3, config.simStep);
+
+    size_t candidates = static_cast<size_t>(config.velocitySamples) * config.rotVelocitySamples;
+    candVelocity.resize(candidates);
+    candRotVelocity.resize(candidates);
+    candClearance.resize(candidates);
+    candScoreClearance.resize(candidates);
+    candHeading.resize(candidates);
+    candAdmissible.resize(candidates);
+
+    obstacleX.reserve(config.maxObstacles + OBSTACLE_LANES);
+    obstacleY.reserve(config.maxObstacles + OBSTACLE_LANES);
+}
+
+void DwaPlanner::clearObstacles() {
+    obstacleX.clear();
+    obstacleY.clear();
+    obstacleCount = 0;
+}
+
+void DwaPlanner::addObstacle(double x, double y) {
+    if (x * x + y * y > config.obstacleRange * config.obstacleRange) {
+        return;
+    }
+    // Remove o preenchimento deixado pelo último plan()
+    obstacleX.resize(obstacleCount);
+    obstacleY.resize(obstacleCount);
+    obstacleX.push_back(static_cast<float>(x));
+    obstacleY.push_back(static_cast<float>(y));
+    obstacleCount++;
+}
+
+void DwaPlanner::addSonar(const int* sonar, int count, double maxRange, const SonarGeometry* geometry) {
+    for (int i = 0; i < count; ++i) {
+        if (sonar[i] <= 0 || sonar[i] >= maxRange) {
+            continue;
+        }
+        double angle = geometry[i].angle * DEG_TO_RAD;
+        addObstacle(geometry[i].x + sonar[i] * std::cos(angle), geometry[i].y + sonar[i] * std::sin(angle));
+    }
+}
+
+void DwaPlanner::addScan(const Pose2D& pose, const ScanPoint* points, size_t count) {
+    const double heading = pose.theta * DEG_TO_RAD;
+    const double c = std::cos(heading);
+    const double s = std::sin(heading);
+    for (size_t i = 0; i < count; ++i) {
+        if (!points[i].hit) {
+            continue;
+        }
+        double dx = points[i].x - pose.x;
+        double dy = points[i].y - pose.y;
+        addObstacle(c * dx + s * dy, -s * dx + c * dy);
+    }
+}
+
+void DwaPlanner::padObstacles() {
+    size_t padded = (obstacleCount + OBSTACLE_LANES - 1) / OBSTACLE_LANES * OBSTACLE_LANES;
+    obstacleX.resize(obstacleCount);
+    obstacleY.resize(obstacleCount);
+    obstacleX.resize(padded, FAR_AWAY);
+    obstacleY.resize(padded, FAR_AWAY);
+}
+
+double DwaPlanner::pathClearance(double velocity, double rotVelocity, double& gap, double& ahead) const {
+    gap = config.maxClearance;
+    ahead = config.maxClearance;
+    if (obstacleCount == 0) {
+        return NO_COLLISION;
+    }
+    const double radius = config.robotRadius + config.safetyMargin;
+    const float limit = static_cast<float>(radius * radius);
+    const double w = rotVelocity * DEG_TO_RAD;
+    const int steps = static_cast<int>(std::ceil(config.horizon / config.simStep));
+    const size_t n = obstacleX.size();
+
+    float nearest = FAR_AWAY * FAR_AWAY;
+    double x = 0.0, y = 0.0;
+    for (int k = 1; k <= steps; ++k) {
+        double t = k * config.simStep;
+        if (std::fabs(w) < 1e-6) {
+            x = velocity * t;
+            y = 0.0;
+        } else {
+            // Arco de raio v/w a partir da origem, orientação inicial 0
+            x = velocity / w * std::sin(w * t);
+            y = velocity / w * (1.0 - std::cos(w * t));
+        }
+        float d2 = minDistanceSq(obstacleX.data(), obstacleY.data(), n,
+                                 static_cast<float>(x), static_cast<float>(y));
+        if (d2 < limit) {
+            gap = 0.0;
+            ahead = 0.0;
+            return std::fabs(velocity) * (t - config.simStep);
+        }
+        nearest = std::min(nearest, d2);
+    }
+    gap = std::min(config.maxClearance, std::sqrt(static_cast<double>(nearest)) - radius);
+
+    // Espaço livre em linha reta a partir do fim do arco: tira o robô de
+    // frente para a parede mesmo quando parado (v = 0 não muda a folga)
+    const double endHeading = w * steps * config.simStep;
+    const double c = std::cos(endHeading);
+    const double s = std::sin(endHeading);
+    for (double d = AHEAD_STEP; d <= config.maxClearance; d += AHEAD_STEP) {
+        if (minDistanceSq(obstacleX.data(), obstacleY.data(), n,
+                          static_cast<float>(x + d * c), static_cast<float>(y + d * s)) < limit) {
+            ahead = d - AHEAD_STEP;
+            break;
+        }
+    }
+    return NO_COLLISION;
+}
+
+DwaResult DwaPlanner::plan(double velocity, double rotVelocity, double goalBearing) {
+    padObstacles();
+
+    const double vLow = std::max(0.0, velocity - config.acceleration * config.windowTime);
+    const double vHigh = std::max(vLow, std::min(config.maxVelocity, velocity + config.acceleration * config.windowTime));
+    const double wLow = std::max(-config.maxRotVelocity, rotVelocity - config.rotAcceleration * config.windowTime);
+    const double wHigh = std::max(wLow, std::min(config.maxRotVelocity, rotVelocity + config.rotAcceleration * config.windowTime));
+
+    // 1) Amostragem da janela dinâmica e simulação de cada arco
+    size_t index = 0;
+    for (int i = 0; i < config.velocitySamples; ++i) {
+        double v = config.velocitySamples == 1 ? vHigh
+            : vLow + (vHigh - vLow) * i / (config.velocitySamples - 1);
+        for (int j = 0; j < config.rotVelocitySamples; ++j, ++index) {
+            double w = config.rotVelocitySamples == 1 ? 0.5 * (wLow + wHigh)
+                : wLow + (wHigh - wLow) * j / (config.rotVelocitySamples - 1);
+            double gap, ahead;
+            double travel = pathClearance(v, w, gap, ahead);
+            double braking = v * v / (2.0 * config.acceleration);
+
+            candVelocity[index] = v;
+            candRotVelocity[index] = w;
+            candClearance[index] = gap;
+            // Trajetórias sem colisão no horizonte sempre superam as que colidem
+            candScoreClearance[index] = travel != NO_COLLISION
+                ? 0.5 * std::min(travel, config.maxClearance) / config.maxClearance
+                : 0.5 + 0.25 * (gap + ahead) / config.maxClearance;
+            candHeading[index] = 1.0 - std::fabs(normalizeAngle(goalBearing - w * config.horizon)) / 180.0;
+            // Admissível: consegue frear antes do ponto de colisão
+            candAdmissible[index] = travel > braking ? 1 : 0;
+        }
+    }
+    evaluated += index;
+
+    // 2) Pontuação das trajetórias admissíveis
+    DwaResult result;
+    for (size_t c = 0; c < index; ++c) {
+        if (!candAdmissible[c]) {
+            continue;
+        }
+        result.admissible++;
+        double score = config.headingWeight * candHeading[c] +
+                       config.clearanceWeight * candScoreClearance[c] +
+                       config.velocityWeight * candVelocity[c] / config.maxVelocity;
+        if (!result.valid || score > result.score) {
+            result.valid = true;
+            result.score = score;
+            result.velocity = candVelocity[c];
+            result.rotVelocity = candRotVelocity[c];
+            result.clearance = candClearance[c];
+        }
+    }
+    return result;
+}
+
+void DwaPlanner::toWheelSpeeds(double velocity, double rotVelocity, double& left, double& right) const {
+    double offset = rotVelocity * DEG_TO_RAD * config.axleTrack / 2.0;
+    left = velocity - offset;
+    right = velocity + offset;
+}
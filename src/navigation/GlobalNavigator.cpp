@@ -0,0 +1,127 @@
+#include "../include/navigation/GlobalNavigator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const double RAD_TO_DEG = 180.0 / 3.14159265358979323846;
+
+double normalizeAngle(double degrees) {
+    while (degrees > 180.0) degrees -= 360.0;
+    while (degrees < -180.0) degrees += 360.0;
+    return degrees;
+}
+
+} // namespace
+
+NavigatorConfig::NavigatorConfig()
+    : margin(2000.0), inflateRadius(300.0), waypointTolerance(250.0), goalTolerance(300.0),
+      replanCycles(10), unknownBlocked(false) {
+}
+
+GlobalNavigator::GlobalNavigator(const NavigatorConfig& navigatorConfig)
+    : config(navigatorConfig), goalX(0.0), goalY(0.0), goalSet(false), goalReached(false), pathFound(false),
+      nextWaypoint(0), cyclesSinceReplan(0), replans(0), changedCells(0) {
+    config.replanCycles = std::max(1, config.replanCycles);
+}
+
+void GlobalNavigator::setGoal(double x, double y) {
+    goalX = x;
+    goalY = y;
+    goalSet = true;
+    goalReached = false;
+    pathFound = false;
+    dstar.reset();
+    window.reset();
+    waypoints.clear();
+}
+
+void GlobalNavigator::clearGoal() {
+    setGoal(0.0, 0.0);
+    goalSet = false;
+}
+
+void GlobalNavigator::buildWindow(const Pose2D& pose, const OccupancyGrid& map) {
+    int cx0 = map.worldToCell(std::min(pose.x, goalX) - config.margin);
+    int cy0 = map.worldToCell(std::min(pose.y, goalY) - config.margin);
+    int cx1 = map.worldToCell(std::max(pose.x, goalX) + config.margin);
+    int cy1 = map.worldToCell(std::max(pose.y, goalY) + config.margin);
+
+    dstar.reset();
+    window.reset(new PlanningMap(PlanningMap::fromOccupancy(map, cx0, cy0, cx1 - cx0 + 1, cy1 - cy0 + 1,
+                                                            config.inflateRadius, config.unknownBlocked)));
+    dstar.reset(new DStarLite(*window));
+    dstar->initialize(window->worldToCell(pose.x, pose.y), window->worldToCell(goalX, goalY));
+    cyclesSinceReplan = 0;
+    replan();
+}
+
+void GlobalNavigator::refreshWindow(const OccupancyGrid& map) {
+    PlanningMap fresh = PlanningMap::fromOccupancy(map, window->getOriginX(), window->getOriginY(),
+                                                   window->getWidth(), window->getHeight(),
+                                                   config.inflateRadius, config.unknownBlocked);
+    for (int y = 0; y < fresh.getHeight(); ++y) {
+        for (int x = 0; x < fresh.getWidth(); ++x) {
+            if (dstar->updateCell(x, y, fresh.isBlocked(x, y))) {
+                changedCells++;
+            }
+        }
+    }
+}
+
+void GlobalNavigator::replan() {
+    replans++;
+    waypoints.clear();
+    nextWaypoint = 0;
+    pathFound = dstar->computePath(path);
+    if (!pathFound) {
+        return;
+    }
+
+    // Mantém só as quinas: cada waypoint é o último ponto em linha de visada do anterior
+    GridCell anchor = path.front();
+    for (size_t i = 1; i + 1 < path.size(); ++i) {
+        if (!window->lineOfSight(anchor, path[i + 1])) {
+            anchor = path[i];
+            Pose2D waypoint;
+            window->cellToWorld(anchor, waypoint.x, waypoint.y);
+            waypoints.push_back(waypoint);
+        }
+    }
+    waypoints.push_back(Pose2D(goalX, goalY, 0.0));
+}
+
+bool GlobalNavigator::update(const Pose2D& pose, const OccupancyGrid& map, double& bearing) {
+    if (!goalSet || goalReached) {
+        return false;
+    }
+    if (std::hypot(goalX - pose.x, goalY - pose.y) < config.goalTolerance) {
+        goalReached = true;
+        return false;
+    }
+
+    GridCell cell = window ? window->worldToCell(pose.x, pose.y) : GridCell(-1, -1);
+    if (!window || cell.x < 0 || cell.y < 0 || cell.x >= window->getWidth() || cell.y >= window->getHeight()) {
+        buildWindow(pose, map);
+    } else {
+        if (cell != dstar->getStart()) {
+            dstar->moveStart(cell);
+        }
+        if (++cyclesSinceReplan >= config.replanCycles) {
+            cyclesSinceReplan = 0;
+            refreshWindow(map);
+            replan();
+        }
+    }
+    if (!pathFound) {
+        return false;
+    }
+
+    while (nextWaypoint + 1 < waypoints.size() &&
+           std::hypot(waypoints[nextWaypoint].x - pose.x, waypoints[nextWaypoint].y - pose.y) < config.waypointTolerance) {
+        nextWaypoint++;
+    }
+    const Pose2D& target = waypoints[nextWaypoint];
+    bearing = normalizeAngle(std::atan2(target.y - pose.y, target.x - pose.x) * RAD_TO_DEG - pose.theta);
+    return true;
+}
@@ -0,0 +1,103 @@
+#include "../include/navigation/LikelihoodField.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+// "Sem obstáculo": grande, mas finito para a aritmética das parábolas
+const float FAR = 1e10f;
+
+// Transformada de distância 1D (quadrado da distância ao ponto mais próximo)
+// sobre n amostras com passo stride; v, z e buffer são áreas de trabalho
+void distanceTransform1D(float* data, int n, int stride, std::vector<int>& v, std::vector<float>& z,
+                         std::vector<float>& buffer) {
+    for (int i = 0; i < n; ++i) {
+        buffer[i] = data[static_cast<size_t>(i) * stride];
+    }
+    // Envelope inferior das parábolas (q - i)² + buffer[i]
+    int k = 0;
+    v[0] = 0;
+    z[0] = -FAR;
+    z[1] = FAR;
+    for (int q = 1; q < n; ++q) {
+        float s = ((buffer[q] + static_cast<float>(q) * q) - (buffer[v[k]] + static_cast<float>(v[k]) * v[k])) /
+                  (2.0f * (q - v[k]));
+        while (s <= z[k]) {
+            k--;
+            s = ((buffer[q] + static_cast<float>(q) * q) - (buffer[v[k]] + static_cast<float>(v[k]) * v[k])) /
+                (2.0f * (q - v[k]));
+        }
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = FAR;
+    }
+    k = 0;
+    for (int q = 0; q < n; ++q) {
+        while (z[k + 1] < q) {
+            k++;
+        }
+        float d = static_cast<float>(q - v[k]);
+        data[static_cast<size_t>(q) * stride] = std::min(FAR, d * d + buffer[v[k]]);
+    }
+}
+
+} // namespace
+
+LikelihoodField::LikelihoodField(const OccupancyGrid& map, double margin, double sigma, double zHit, double zRandom)
+    : resolution(map.getResolution()), inverseResolution(1.0 / map.getResolution()) {
+    int cx0, cy0, cx1, cy1;
+    if (!map.getBounds(cx0, cy0, cx1, cy1)) {
+        throw std::invalid_argument("LikelihoodField: mapa vazio");
+    }
+    const int pad = static_cast<int>(std::ceil(margin / resolution));
+    originX = cx0 - pad;
+    originY = cy0 - pad;
+    width = cx1 - cx0 + 1 + 2 * pad;
+    height = cy1 - cy0 + 1 + 2 * pad;
+
+    const size_t cells = static_cast<size_t>(width) * height;
+    std::vector<int8_t> logOdds(cells);
+    map.exportRegion(originX, originY, width, height, logOdds.data());
+
+    distance.assign(cells, FAR);
+    const int occupied = map.getConfig().occupiedThreshold;
+    for (size_t i = 0; i < cells; ++i) {
+        if (logOdds[i] >= occupied) {
+            distance[i] = 0.0f;
+        }
+    }
+
+    // Colunas e depois linhas: resultado é o quadrado da distância euclidiana
+    const int longest = std::max(width, height);
+    std::vector<int> v(longest);
+    std::vector<float> z(longest + 1), buffer(longest);
+    for (int x = 0; x < width; ++x) {
+        distanceTransform1D(&distance[x], height, width, v, z, buffer);
+    }
+    for (int y = 0; y < height; ++y) {
+        distanceTransform1D(&distance[static_cast<size_t>(y) * width], width, 1, v, z, buffer);
+    }
+
+    const double inverseVariance = 1.0 / (2.0 * sigma * sigma);
+    floorValue = static_cast<float>(std::log(zRandom));
+    field.resize(cells);
+    for (size_t i = 0; i < cells; ++i) {
+        const bool none = distance[i] >= FAR * 0.5f;
+        double d2 = none ? std::numeric_limits<double>::infinity() : distance[i] * resolution * resolution;
+        distance[i] = none ? FAR : std::sqrt(distance[i]);
+        field[i] = static_cast<float>(std::log(zHit * std::exp(-d2 * inverseVariance) + zRandom));
+    }
+}
+
+double LikelihoodField::obstacleDistance(double x, double y) const {
+    int cx = static_cast<int>(std::floor(x * inverseResolution)) - originX;
+    int cy = static_cast<int>(std::floor(y * inverseResolution)) - originY;
+    if (cx < 0 || cy < 0 || cx >= width || cy >= height) {
+        return std::numeric_limits<double>::infinity();
+    }
+    float d = distance[static_cast<size_t>(cy) * width + cx];
+    return d >= FAR ? std::numeric_limits<double>::infinity() : d * resolution;
+}
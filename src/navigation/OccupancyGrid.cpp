@@ -0,0 +1,401 @@
+#include "../include/navigation/OccupancyGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+const char GRID_MAGIC[4] = {'O', 'G', 'R', 'D'};
+const uint32_t GRID_VERSION = 1;
+
+const double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+
+// Ordem e posições do arquivo de parâmetros p3dx.p
+const SonarGeometry P3DX_SONAR[8] = {
+    { 69.0,  136.0,  90.0},
+    {114.0,  119.0,  50.0},
+    {148.0,   78.0,  30.0},
+    {166.0,   27.0,  10.0},
+    {166.0,  -27.0, -10.0},
+    {148.0,  -78.0, -30.0},
+    {114.0, -119.0, -50.0},
+    { 69.0, -136.0, -90.0}
+};
+
+/**
+ * Percorre as células de (x0, y0) a (x1, y1) com Bresenham (todos os
+ * octantes, só inteiros). visit(cx, cy, last) retorna false para parar.
+ */
+template <typename Visit>
+void bresenham(int x0, int y0, int x1, int y1, Visit visit) {
+    int dx = std::abs(x1 - x0);
+    int dy = -std::abs(y1 - y0);
+    int sx = x0 < x1 ? 1 : -1;
+    int sy = y0 < y1 ? 1 : -1;
+    int err = dx + dy;
+
+    while (x0 != x1 || y0 != y1) {
+        if (!visit(x0, y0, false)) {
+            return;
+        }
+        int e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+    visit(x1, y1, true);
+}
+
+/**
+ * Soma os deltas ao bloco com saturação e limita a [lo, hi].
+ * n precisa ser múltiplo de 16 (blocos têm 1024 células).
+ */
+void applyDeltas(int8_t* cells, const int8_t* deltas, int n, int8_t lo, int8_t hi) {
+#if defined(__SSE2__)
+    const __m128i vlo = _mm_set1_epi8(lo);
+    const __m128i vhi = _mm_set1_epi8(hi);
+    for (int i = 0; i < n; i += 16) {
+        __m128i v = _mm_adds_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(cells + i)),
+                                  _mm_load_si128(reinterpret_cast<const __m128i*>(deltas + i)));
+        // SSE2 não tem min/max para int8: comparação + seleção
+        __m128i below = _mm_cmpgt_epi8(vlo, v);
+        v = _mm_or_si128(_mm_and_si128(below, vlo), _mm_andnot_si128(below, v));
+        __m128i above = _mm_cmpgt_epi8(v, vhi);
+        v = _mm_or_si128(_mm_and_si128(above, vhi), _mm_andnot_si128(above, v));
+        _mm_store_si128(reinterpret_cast<__m128i*>(cells + i), v);
+    }
+#else
+    for (int i = 0; i < n; ++i) {
+        int v = static_cast<int>(cells[i]) + deltas[i];
+        cells[i] = static_cast<int8_t>(std::max<int>(lo, std::min<int>(hi, v)));
+    }
+#endif
+}
+
+} // namespace
+
+const SonarGeometry* pioneerSonarGeometry() {
+    return P3DX_SONAR;
+}
+
+GridConfig::GridConfig()
+    : resolution(50.0), hitDelta(14), missDelta(-6), clampMin(-96), clampMax(96),
+      occupiedThreshold(16), freeThreshold(-16),
+      sonarHalfAngle(15.0), sonarRays(5), sonarFreeRange(3000.0) {
+}
+
+OccupancyGrid::OccupancyGrid(const GridConfig& gridConfig)
+    : config(gridConfig), scans(0), lastDeltaKey(0), lastDelta(nullptr) {
+    config.clampMin = std::max(-127, std::min(0, config.clampMin));
+    config.clampMax = std::min(127, std::max(0, config.clampMax));
+    config.sonarRays = std::max(1, config.sonarRays);
+}
+
+int OccupancyGrid::toCell(double coordinate) const {
+    return static_cast<int>(std::floor(coordinate / config.resolution));
+}
+
+int OccupancyGrid::tileOf(int cell) {
+    // Divisão arredondando para baixo também para coordenadas negativas
+    return cell >= 0 ? cell / TILE_SIZE : -((-cell - 1) / TILE_SIZE) - 1;
+}
+
+uint64_t OccupancyGrid::tileKey(int tx, int ty) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(tx)) << 32) | static_cast<uint32_t>(ty);
+}
+
+const OccupancyGrid::Tile* OccupancyGrid::findTile(int cx, int cy) const {
+    TileMap::const_iterator it = tiles.find(tileKey(tileOf(cx), tileOf(cy)));
+    return it == tiles.end() ? nullptr : it->second.get();
+}
+
+int8_t OccupancyGrid::cellValue(int cx, int cy) const {
+    const Tile* tile = findTile(cx, cy);
+    if (tile == nullptr) {
+        return 0;
+    }
+    int lx = cx - tileOf(cx) * TILE_SIZE;
+    int ly = cy - tileOf(cy) * TILE_SIZE;
+    return tile->cells[ly * TILE_SIZE + lx];
+}
+
+// ===== Varredura =====
+
+void OccupancyGrid::beginScan() {
+    deltaIndex.clear();
+    lastDelta = nullptr;
+}
+
+void OccupancyGrid::mark(int cx, int cy, int8_t delta) {
+    int tx = tileOf(cx);
+    int ty = tileOf(cy);
+    uint64_t key = tileKey(tx, ty);
+
+    // Raios consecutivos caem quase sempre no mesmo bloco
+    if (lastDelta == nullptr || key != lastDeltaKey) {
+        std::unordered_map<uint64_t, size_t>::iterator it = deltaIndex.find(key);
+        size_t index;
+        if (it != deltaIndex.end()) {
+            index = it->second;
+        } else {
+            index = deltaIndex.size();
+            if (index == deltaPool.size()) {
+                deltaPool.emplace_back(new Tile());
+                std::memset(deltaPool.back()->cells, 0, TILE_CELLS);
+            }
+            deltaIndex.emplace(key, index);
+        }
+        lastDelta = deltaPool[index].get();
+        lastDeltaKey = key;
+    }
+
+    int8_t& cell = lastDelta->cells[(cy - ty * TILE_SIZE) * TILE_SIZE + (cx - tx * TILE_SIZE)];
+    // Retorno prevalece sobre livre; cada célula é atualizada uma vez
+    if (delta > 0 || cell == 0) {
+        cell = delta;
+    }
+}
+
+void OccupancyGrid::traceRay(int cx0, int cy0, int cx1, int cy1, bool hit) {
+    const int8_t miss = static_cast<int8_t>(config.missDelta);
+    const int8_t occupied = static_cast<int8_t>(config.hitDelta);
+    bresenham(cx0, cy0, cx1, cy1, [&](int cx, int cy, bool last) {
+        mark(cx, cy, last && hit ? occupied : miss);
+        return true;
+    });
+}
+
+void OccupancyGrid::traceRay(double x0, double y0, double x1, double y1, bool hit) {
+    traceRay(toCell(x0), toCell(y0), toCell(x1), toCell(y1), hit);
+}
+
+void OccupancyGrid::commitScan() {
+    const int8_t lo = static_cast<int8_t>(config.clampMin);
+    const int8_t hi = static_cast<int8_t>(config.clampMax);
+
+    for (const std::pair<const uint64_t, size_t>& entry : deltaIndex) {
+        std::unique_ptr<Tile>& tile = tiles[entry.first];
+        if (!tile) {
+            tile.reset(new Tile());
+            std::memset(tile->cells, 0, TILE_CELLS);
+        }
+        Tile* delta = deltaPool[entry.second].get();
+        applyDeltas(tile->cells, delta->cells, TILE_CELLS, lo, hi);
+        std::memset(delta->cells, 0, TILE_CELLS);
+    }
+    deltaIndex.clear();
+    lastDelta = nullptr;
+    scans++;
+}
+
+void OccupancyGrid::integrateSonar(const Pose2D& pose, const int* sonar, int count,
+                                   const SonarGeometry* geometry) {
+    const double heading = pose.theta * DEG_TO_RAD;
+    const double c = std::cos(heading);
+    const double s = std::sin(heading);
+
+    beginScan();
+    for (int i = 0; i < count; ++i) {
+        double range = sonar[i];
+        if (range <= 0.0) {
+            continue;
+        }
+        // Ecos além do alcance confiável só limpam o caminho
+        bool hit = range < config.sonarFreeRange;
+        double length = std::min(range, config.sonarFreeRange);
+
+        double sx = pose.x + c * geometry[i].x - s * geometry[i].y;
+        double sy = pose.y + s * geometry[i].x + c * geometry[i].y;
+        double beam = pose.theta + geometry[i].angle;
+
+        for (int k = 0; k < config.sonarRays; ++k) {
+            double offset = config.sonarRays == 1 ? 0.0
+                : -config.sonarHalfAngle + 2.0 * config.sonarHalfAngle * k / (config.sonarRays - 1);
+            double angle = (beam + offset) * DEG_TO_RAD;
+            traceRay(sx, sy, sx + length * std::cos(angle), sy + length * std::sin(angle), hit);
+        }
+    }
+    commitScan();
+}
+
+void OccupancyGrid::integrateScan(const Pose2D& origin, const ScanPoint* points, size_t count) {
+    beginScan();
+    for (size_t i = 0; i < count; ++i) {
+        traceRay(origin.x, origin.y, points[i].x, points[i].y, points[i].hit);
+    }
+    commitScan();
+}
+
+void OccupancyGrid::integrateRay(double x0, double y0, double x1, double y1, bool hit) {
+    beginScan();
+    traceRay(x0, y0, x1, y1, hit);
+    commitScan();
+}
+
+// ===== Consultas =====
+
+int8_t OccupancyGrid::getLogOdds(double x, double y) const {
+    return cellValue(toCell(x), toCell(y));
+}
+
+double OccupancyGrid::getProbability(double x, double y) const {
+    return 1.0 / (1.0 + std::exp(-getLogOdds(x, y) / LOGODDS_SCALE));
+}
+
+OccupancyGrid::CellState OccupancyGrid::getState(double x, double y) const {
+    int value = getLogOdds(x, y);
+    if (value >= config.occupiedThreshold) {
+        return Occupied;
+    }
+    if (value <= config.freeThreshold) {
+        return Free;
+    }
+    return Unknown;
+}
+
+double OccupancyGrid::freeDistance(const Pose2D& pose, double bearing, double maxRange) const {
+    double angle = (pose.theta + bearing) * DEG_TO_RAD;
+    int cx0 = toCell(pose.x);
+    int cy0 = toCell(pose.y);
+    int cx1 = toCell(pose.x + maxRange * std::cos(angle));
+    int cy1 = toCell(pose.y + maxRange * std::sin(angle));
+
+    double distance = maxRange;
+    const int threshold = config.occupiedThreshold;
+    const double half = 0.5 * config.resolution;
+    bresenham(cx0, cy0, cx1, cy1, [&](int cx, int cy, bool) {
+        if (cellValue(cx, cy) < threshold) {
+            return true;
+        }
+        double dx = cx * config.resolution + half - pose.x;
+        double dy = cy * config.resolution + half - pose.y;
+        distance = std::min(maxRange, std::sqrt(dx * dx + dy * dy));
+        return false;
+    });
+    return distance;
+}
+
+double OccupancyGrid::sectorClearance(const Pose2D& pose, double fromBearing, double toBearing,
+                                      double maxRange, int rays) const {
+    rays = std::max(2, rays);
+    double best = 0.0;
+    for (int k = 0; k < rays; ++k) {
+        double bearing = fromBearing + (toBearing - fromBearing) * k / (rays - 1);
+        best = std::max(best, freeDistance(pose, bearing, maxRange));
+    }
+    return best;
+}
+
+void OccupancyGrid::exportRegion(int cx0, int cy0, int width, int height, int8_t* out) const {
+    std::memset(out, 0, static_cast<size_t>(width) * height);
+
+    // Percorre bloco a bloco e copia trechos de linha contíguos
+    const int tx0 = tileOf(cx0), tx1 = tileOf(cx0 + width - 1);
+    const int ty0 = tileOf(cy0), ty1 = tileOf(cy0 + height - 1);
+    for (int ty = ty0; ty <= ty1; ++ty) {
+        for (int tx = tx0; tx <= tx1; ++tx) {
+            TileMap::const_iterator it = tiles.find(tileKey(tx, ty));
+            if (it == tiles.end()) {
+                continue;
+            }
+            const int8_t* cells = it->second->cells;
+            int xBegin = std::max(cx0, tx * TILE_SIZE), xEnd = std::min(cx0 + width, (tx + 1) * TILE_SIZE);
+            int yBegin = std::max(cy0, ty * TILE_SIZE), yEnd = std::min(cy0 + height, (ty + 1) * TILE_SIZE);
+            for (int cy = yBegin; cy < yEnd; ++cy) {
+                std::memcpy(out + static_cast<size_t>(cy - cy0) * width + (xBegin - cx0),
+                            cells + (cy - ty * TILE_SIZE) * TILE_SIZE + (xBegin - tx * TILE_SIZE),
+                            xEnd - xBegin);
+            }
+        }
+    }
+}
+
+bool OccupancyGrid::getBounds(int& cx0, int& cy0, int& cx1, int& cy1) const {
+    if (tiles.empty()) {
+        return false;
+    }
+    int tx0 = INT32_MAX, ty0 = INT32_MAX, tx1 = INT32_MIN, ty1 = INT32_MIN;
+    for (TileMap::const_iterator it = tiles.begin(); it != tiles.end(); ++it) {
+        int tx = static_cast<int32_t>(it->first >> 32);
+        int ty = static_cast<int32_t>(it->first & 0xFFFFFFFFu);
+        tx0 = std::min(tx0, tx);
+        ty0 = std::min(ty0, ty);
+        tx1 = std::max(tx1, tx);
+        ty1 = std::max(ty1, ty);
+    }
+    cx0 = tx0 * TILE_SIZE;
+    cy0 = ty0 * TILE_SIZE;
+    cx1 = (tx1 + 1) * TILE_SIZE - 1;
+    cy1 = (ty1 + 1) * TILE_SIZE - 1;
+    return true;
+}
+
+bool OccupancyGrid::save(const std::string& filename) const {
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+    uint64_t count = tiles.size();
+    out.write(GRID_MAGIC, 4);
+    out.write(reinterpret_cast<const char*>(&GRID_VERSION), sizeof(GRID_VERSION));
+    out.write(reinterpret_cast<const char*>(&config.resolution), sizeof(config.resolution));
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (TileMap::const_iterator it = tiles.begin(); it != tiles.end(); ++it) {
+        out.write(reinterpret_cast<const char*>(&it->first), sizeof(it->first));
+        out.write(reinterpret_cast<const char*>(it->second->cells), TILE_CELLS);
+    }
+    out.close();
+    return !out.fail();
+}
+
+bool OccupancyGrid::load(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    char magic[4];
+    uint32_t version = 0;
+    double resolution = 0.0;
+    uint64_t count = 0;
+    in.read(magic, 4);
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(&resolution), sizeof(resolution));
+    in.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!in || std::memcmp(magic, GRID_MAGIC, 4) != 0 || version != GRID_VERSION ||
+        resolution != config.resolution) {
+        return false;
+    }
+
+    TileMap loaded;
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t key = 0;
+        std::unique_ptr<Tile> tile(new Tile());
+        in.read(reinterpret_cast<char*>(&key), sizeof(key));
+        in.read(reinterpret_cast<char*>(tile->cells), TILE_CELLS);
+        if (!in) {
+            return false;
+        }
+        loaded[key] = std::move(tile);
+    }
+    clear();
+    tiles.swap(loaded);
+    return true;
+}
+
+void OccupancyGrid::clear() {
+    tiles.clear();
+    deltaIndex.clear();
+    lastDelta = nullptr;
+    scans = 0;
+}
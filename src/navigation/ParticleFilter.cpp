@@ -0,0 +1,257 @@
+#include "../include/navigation/ParticleFilter.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+const double DEG_TO_RAD = PI / 180.0;
+
+double normalizeRadians(double angle) {
+    while (angle > PI) angle -= 2.0 * PI;
+    while (angle < -PI) angle += 2.0 * PI;
+    return angle;
+}
+
+} // namespace
+
+MclConfig::MclConfig()
+    : particles(2000), threads(0), beams(60), alphaRotRot(0.05), alphaRotTrans(0.0001),
+      alphaTransTrans(0.05), alphaTransRot(5.0), resampleThreshold(0.5), seed(42) {
+}
+
+ParticleFilter::ParticleFilter(const LikelihoodField& likelihoodField, const MclConfig& mclConfig)
+    : field(likelihoodField), config(mclConfig), rng(mclConfig.seed), updates(0), resamples(0),
+      generation(0), pending(0), stopping(false) {
+    if (config.particles == 0) {
+        throw std::invalid_argument("ParticleFilter: número de partículas deve ser positivo");
+    }
+    int threads = config.threads > 0 ? config.threads : static_cast<int>(std::thread::hardware_concurrency());
+    threads = std::max(1, threads);
+
+    const size_t n = config.particles;
+    x.assign(n, 0.0f);
+    y.assign(n, 0.0f);
+    theta.assign(n, 0.0f);
+    weight.assign(n, 1.0f / n);
+    logWeight.assign(n, 0.0f);
+    nextX.resize(n);
+    nextY.resize(n);
+    nextTheta.resize(n);
+
+    for (int i = 0; i < threads; ++i) {
+        workerRng.push_back(std::mt19937(config.seed + 7919u * (i + 1)));
+    }
+    // A thread chamadora processa o bloco 0
+    for (int i = 1; i < threads; ++i) {
+        workers.push_back(std::thread(&ParticleFilter::workerLoop, this, i));
+    }
+}
+
+ParticleFilter::~ParticleFilter() {
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ParticleFilter::runBlock(int index) {
+    const size_t n = x.size();
+    const size_t blocks = workers.size() + 1;
+    const size_t begin = n * index / blocks;
+    const size_t end = n * (index + 1) / blocks;
+    if (begin < end) {
+        job(begin, end, index);
+    }
+}
+
+void ParticleFilter::workerLoop(int index) {
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(poolMutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+        }
+        runBlock(index);
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            if (--pending == 0) {
+                done.notify_one();
+            }
+        }
+    }
+}
+
+void ParticleFilter::parallelFor(const std::function<void(size_t, size_t, int)>& work) {
+    job = work;
+    if (!workers.empty()) {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        pending = static_cast<int>(workers.size());
+        generation++;
+    }
+    wake.notify_all();
+    runBlock(0);
+    if (!workers.empty()) {
+        std::unique_lock<std::mutex> lock(poolMutex);
+        done.wait(lock, [&] { return pending == 0; });
+    }
+}
+
+void ParticleFilter::initialize(const Pose2D& pose, double sigmaXY, double sigmaTheta) {
+    std::normal_distribution<float> noiseXY(0.0f, static_cast<float>(sigmaXY));
+    std::normal_distribution<float> noiseTheta(0.0f, static_cast<float>(sigmaTheta * DEG_TO_RAD));
+    const float theta0 = static_cast<float>(pose.theta * DEG_TO_RAD);
+    for (size_t i = 0; i < x.size(); ++i) {
+        x[i] = static_cast<float>(pose.x) + noiseXY(rng);
+        y[i] = static_cast<float>(pose.y) + noiseXY(rng);
+        theta[i] = theta0 + noiseTheta(rng);
+    }
+    std::fill(weight.begin(), weight.end(), 1.0f / x.size());
+}
+
+void ParticleFilter::predict(const Pose2D& before, const Pose2D& after) {
+    // Odometria decomposta em rotação, translação e rotação
+    const double dx = after.x - before.x;
+    const double dy = after.y - before.y;
+    const double trans = std::sqrt(dx * dx + dy * dy);
+    const double theta0 = before.theta * DEG_TO_RAD;
+    const double dtheta = normalizeRadians((after.theta - before.theta) * DEG_TO_RAD);
+    // Movimento muito curto: a direção do deslocamento é só ruído
+    const double rot1 = trans < 1.0 ? 0.0 : normalizeRadians(std::atan2(dy, dx) - theta0);
+    const double rot2 = normalizeRadians(dtheta - rot1);
+    if (trans < 1e-6 && std::fabs(dtheta) < 1e-9) {
+        return;
+    }
+
+    const float sigmaRot1 = static_cast<float>(config.alphaRotRot * std::fabs(rot1) + config.alphaRotTrans * trans);
+    const float sigmaTrans = static_cast<float>(config.alphaTransTrans * trans +
+                                                config.alphaTransRot * (std::fabs(rot1) + std::fabs(rot2)));
+    const float sigmaRot2 = static_cast<float>(config.alphaRotRot * std::fabs(rot2) + config.alphaRotTrans * trans);
+
+    parallelFor([&](size_t begin, size_t end, int worker) {
+        std::mt19937& generator = workerRng[worker];
+        std::normal_distribution<float> unit(0.0f, 1.0f);
+        for (size_t i = begin; i < end; ++i) {
+            float r1 = static_cast<float>(rot1) + sigmaRot1 * unit(generator);
+            float t = static_cast<float>(trans) + sigmaTrans * unit(generator);
+            float r2 = static_cast<float>(rot2) + sigmaRot2 * unit(generator);
+            float heading = theta[i] + r1;
+            x[i] += t * std::cos(heading);
+            y[i] += t * std::sin(heading);
+            theta[i] = heading + r2;
+        }
+    });
+}
+
+void ParticleFilter::update(const ScanPoint* points, size_t count) {
+    // Subamostra os feixes com retorno, espaçados por igual na varredura
+    size_t hits = 0;
+    for (size_t i = 0; i < count; ++i) {
+        hits += points[i].hit ? 1 : 0;
+    }
+    if (hits == 0) {
+        return;
+    }
+    const size_t used = std::min<size_t>(hits, static_cast<size_t>(std::max(1, config.beams)));
+    beamX.clear();
+    beamY.clear();
+    size_t seen = 0;
+    for (size_t i = 0; i < count && beamX.size() < used; ++i) {
+        if (!points[i].hit) {
+            continue;
+        }
+        if (seen * used / hits == beamX.size()) {
+            beamX.push_back(static_cast<float>(points[i].x));
+            beamY.push_back(static_cast<float>(points[i].y));
+        }
+        seen++;
+    }
+
+    const size_t beams = beamX.size();
+    parallelFor([&](size_t begin, size_t end, int) {
+        const float* bx = beamX.data();
+        const float* by = beamY.data();
+        for (size_t i = begin; i < end; ++i) {
+            const float c = std::cos(theta[i]);
+            const float s = std::sin(theta[i]);
+            const float px = x[i];
+            const float py = y[i];
+            float sum = 0.0f;
+            for (size_t b = 0; b < beams; ++b) {
+                sum += field.logLikelihood(px + c * bx[b] - s * by[b], py + s * bx[b] + c * by[b]);
+            }
+            logWeight[i] = std::log(std::max(weight[i], 1e-30f)) + sum;
+        }
+    });
+
+    normalize();
+    updates++;
+    if (getEffectiveSampleSize() < config.resampleThreshold * x.size()) {
+        resample();
+    }
+}
+
+void ParticleFilter::normalize() {
+    // Subtrai o máximo antes da exponencial para não estourar float
+    const float best = *std::max_element(logWeight.begin(), logWeight.end());
+    double total = 0.0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        weight[i] = std::exp(logWeight[i] - best);
+        total += weight[i];
+    }
+    const float inverse = static_cast<float>(1.0 / total);
+    for (float& w : weight) {
+        w *= inverse;
+    }
+}
+
+void ParticleFilter::resample() {
+    // Baixa variância: N ponteiros igualmente espaçados a partir de um único sorteio
+    const size_t n = x.size();
+    const double step = 1.0 / n;
+    double pointer = std::uniform_real_distribution<double>(0.0, step)(rng);
+    double cumulative = weight[0];
+    size_t source = 0;
+    for (size_t i = 0; i < n; ++i) {
+        while (pointer > cumulative && source + 1 < n) {
+            cumulative += weight[++source];
+        }
+        nextX[i] = x[source];
+        nextY[i] = y[source];
+        nextTheta[i] = theta[source];
+        pointer += step;
+    }
+    x.swap(nextX);
+    y.swap(nextY);
+    theta.swap(nextTheta);
+    std::fill(weight.begin(), weight.end(), static_cast<float>(step));
+    resamples++;
+}
+
+Pose2D ParticleFilter::estimate() const {
+    double sx = 0.0, sy = 0.0, sc = 0.0, ss = 0.0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        sx += weight[i] * x[i];
+        sy += weight[i] * y[i];
+        sc += weight[i] * std::cos(theta[i]);
+        ss += weight[i] * std::sin(theta[i]);
+    }
+    return Pose2D(sx, sy, std::atan2(ss, sc) / DEG_TO_RAD);
+}
+
+double ParticleFilter::getEffectiveSampleSize() const {
+    double sum = 0.0;
+    for (float w : weight) {
+        sum += static_cast<double>(w) * w;
+    }
+    return sum > 0.0 ? 1.0 / sum : 0.0;
+}
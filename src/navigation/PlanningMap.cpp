@@ -0,0 +1,165 @@
+#include "../include/navigation/PlanningMap.h"
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace {
+
+// 64 bits a partir de start de uma linha de length bits que começa em offset
+uint64_t extractLine(const std::vector<uint64_t>& bits, size_t offset, int length, int start) {
+    if (start >= 0 && start + 64 <= length) {
+        size_t index = offset + start;
+        int shift = static_cast<int>(index & 63);
+        uint64_t value = bits[index >> 6] >> shift;
+        if (shift != 0) {
+            value |= bits[(index >> 6) + 1] << (64 - shift);
+        }
+        return value;
+    }
+    // Borda do mapa: o que cai fora conta como bloqueado
+    uint64_t value = 0;
+    for (int i = 0; i < 64; ++i) {
+        int position = start + i;
+        uint64_t bit = 1;
+        if (position >= 0 && position < length) {
+            size_t index = offset + position;
+            bit = (bits[index >> 6] >> (index & 63)) & 1;
+        }
+        value |= bit << i;
+    }
+    return value;
+}
+
+} // namespace
+
+const int PlanningMap::DX[PlanningMap::DIRECTIONS] = {1, -1, 0, 0, 1, 1, -1, -1};
+const int PlanningMap::DY[PlanningMap::DIRECTIONS] = {0, 0, 1, -1, 1, -1, 1, -1};
+const float PlanningMap::COST[PlanningMap::DIRECTIONS] = {1.0f, 1.0f, 1.0f, 1.0f,
+                                                          1.41421356f, 1.41421356f, 1.41421356f, 1.41421356f};
+
+PlanningMap::PlanningMap(int mapWidth, int mapHeight, int mapOriginX, int mapOriginY, double mapResolution)
+    : width(mapWidth), height(mapHeight), originX(mapOriginX), originY(mapOriginY), resolution(mapResolution) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("PlanningMap: dimensões inválidas");
+    }
+    bits.assign((static_cast<size_t>(width) * height + 63) / 64, 0);
+    columns.assign(bits.size(), 0);
+}
+
+PlanningMap PlanningMap::fromOccupancy(const OccupancyGrid& grid, int cx0, int cy0, int width, int height,
+                                       double inflateRadius, bool unknownBlocked) {
+    PlanningMap map(width, height, cx0, cy0, grid.getResolution());
+    std::vector<int8_t> cells(static_cast<size_t>(width) * height);
+    grid.exportRegion(cx0, cy0, width, height, cells.data());
+
+    const int occupied = grid.getConfig().occupiedThreshold;
+    const int free = grid.getConfig().freeThreshold;
+    for (int y = 0; y < height; ++y) {
+        const int8_t* row = cells.data() + static_cast<size_t>(y) * width;
+        for (int x = 0; x < width; ++x) {
+            if (row[x] >= occupied || (unknownBlocked && row[x] > free)) {
+                map.setBlocked(x, y, true);
+            }
+        }
+    }
+    map.inflate(static_cast<int>(std::ceil(inflateRadius / grid.getResolution())));
+    return map;
+}
+
+void PlanningMap::setBlocked(int x, int y, bool blocked) {
+    if (x < 0 || y < 0 || x >= width || y >= height) {
+        return;
+    }
+    size_t index = static_cast<size_t>(y) * width + x;
+    size_t transposed = static_cast<size_t>(x) * height + y;
+    uint64_t mask = uint64_t(1) << (index & 63);
+    uint64_t columnMask = uint64_t(1) << (transposed & 63);
+    if (blocked) {
+        bits[index >> 6] |= mask;
+        columns[transposed >> 6] |= columnMask;
+    } else {
+        bits[index >> 6] &= ~mask;
+        columns[transposed >> 6] &= ~columnMask;
+    }
+}
+
+uint64_t PlanningMap::rowWord(int x, int y) const {
+    if (y < 0 || y >= height) {
+        return ~uint64_t(0);
+    }
+    return extractLine(bits, static_cast<size_t>(y) * width, width, x);
+}
+
+uint64_t PlanningMap::columnWord(int x, int y) const {
+    if (x < 0 || x >= width) {
+        return ~uint64_t(0);
+    }
+    return extractLine(columns, static_cast<size_t>(x) * height, height, y);
+}
+
+void PlanningMap::inflate(int radiusCells) {
+    if (radiusCells <= 0) {
+        return;
+    }
+    std::vector<GridCell> disk;
+    for (int dy = -radiusCells; dy <= radiusCells; ++dy) {
+        for (int dx = -radiusCells; dx <= radiusCells; ++dx) {
+            if (dx * dx + dy * dy <= radiusCells * radiusCells) {
+                disk.push_back(GridCell(dx, dy));
+            }
+        }
+    }
+
+    // Carimba o disco a partir de uma cópia, para não dilatar o que já foi dilatado
+    const std::vector<uint64_t> source = bits;
+    for (size_t word = 0; word < source.size(); ++word) {
+        uint64_t value = source[word];
+        while (value != 0) {
+            int bit = __builtin_ctzll(value);
+            value &= value - 1;
+            size_t index = word * 64 + bit;
+            int x = static_cast<int>(index % width);
+            int y = static_cast<int>(index / width);
+            for (const GridCell& offset : disk) {
+                setBlocked(x + offset.x, y + offset.y, true);
+            }
+        }
+    }
+}
+
+bool PlanningMap::lineOfSight(const GridCell& a, const GridCell& b) const {
+    int x0 = a.x, y0 = a.y;
+    int dx = std::abs(b.x - x0);
+    int dy = -std::abs(b.y - y0);
+    int sx = x0 < b.x ? 1 : -1;
+    int sy = y0 < b.y ? 1 : -1;
+    int err = dx + dy;
+
+    while (true) {
+        if (isBlocked(x0, y0)) {
+            return false;
+        }
+        if (x0 == b.x && y0 == b.y) {
+            return true;
+        }
+        int e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+GridCell PlanningMap::worldToCell(double x, double y) const {
+    return GridCell(static_cast<int>(std::floor(x / resolution)) - originX,
+                    static_cast<int>(std::floor(y / resolution)) - originY);
+}
+
+void PlanningMap::cellToWorld(const GridCell& cell, double& x, double& y) const {
+    x = (cell.x + originX + 0.5) * resolution;
+    y = (cell.y + originY + 0.5) * resolution;
+}
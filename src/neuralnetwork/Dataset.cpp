@@ -0,0 +1,460 @@
+#include "../include/neuralnetwork/Dataset.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char DATASET_MAGIC[4] = {'N', 'N', 'D', 'S'};
+const uint32_t DATASET_VERSION = 1;
+const size_t DATASET_HEADER_SIZE = 4 + 4 + 8 + 4 + 4;
+
+// Converte uma linha CSV em valores; retorna false se algum campo não for numérico
+bool parseCsvLine(const char* begin, const char* end, std::vector<double>& values) {
+    values.clear();
+    const char* p = begin;
+    while (p < end) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == ',' || *p == ';' || *p == '\r')) ++p;
+        if (p >= end) break;
+        char* next = nullptr;
+        double value = std::strtod(p, &next);
+        if (next == p) return false;
+        values.push_back(value);
+        p = next;
+    }
+    return true;
+}
+
+bool isBlankLine(const char* begin, const char* end) {
+    for (const char* p = begin; p < end; ++p) {
+        if (*p != ' ' && *p != '\t' && *p != '\r') return false;
+    }
+    return true;
+}
+
+} // namespace
+
+// ===== Dataset =====
+
+void Dataset::readBatch(const size_t* indices, size_t count,
+                        double* inputs, double* targets) const {
+    const size_t inputSize = static_cast<size_t>(getInputSize());
+    const size_t outputSize = static_cast<size_t>(getOutputSize());
+    std::vector<double> input, target;
+    for (size_t b = 0; b < count; ++b) {
+        getSample(indices[b], input, target);
+        if (input.size() != inputSize || target.size() != outputSize) {
+            throw std::invalid_argument("Sample size mismatch in dataset batch");
+        }
+        std::copy(input.begin(), input.end(), inputs + b * inputSize);
+        std::copy(target.begin(), target.end(), targets + b * outputSize);
+    }
+}
+
+// ===== MemoryDataset =====
+
+MemoryDataset::MemoryDataset(const std::vector<std::vector<double>>& inputs,
+                             const std::vector<std::vector<double>>& targets)
+    : inputs(inputs), targets(targets) {
+    if (inputs.size() != targets.size()) {
+        throw std::invalid_argument("Number of inputs and targets must match");
+    }
+}
+
+int MemoryDataset::getInputSize() const {
+    return inputs.empty() ? 0 : static_cast<int>(inputs[0].size());
+}
+
+int MemoryDataset::getOutputSize() const {
+    return targets.empty() ? 0 : static_cast<int>(targets[0].size());
+}
+
+void MemoryDataset::getSample(size_t index, std::vector<double>& input,
+                              std::vector<double>& target) const {
+    input = inputs[index];
+    target = targets[index];
+}
+
+void MemoryDataset::readBatch(const size_t* indices, size_t count,
+                              double* batchInputs, double* batchTargets) const {
+    const size_t inputSize = static_cast<size_t>(getInputSize());
+    const size_t outputSize = static_cast<size_t>(getOutputSize());
+    for (size_t b = 0; b < count; ++b) {
+        const std::vector<double>& input = inputs[indices[b]];
+        const std::vector<double>& target = targets[indices[b]];
+        if (input.size() != inputSize || target.size() != outputSize) {
+            throw std::invalid_argument("Sample size mismatch in dataset batch");
+        }
+        std::copy(input.begin(), input.end(), batchInputs + b * inputSize);
+        std::copy(target.begin(), target.end(), batchTargets + b * outputSize);
+    }
+}
+
+// ===== CsvDataset =====
+
+CsvDataset::CsvDataset(const std::string& filename, int inputSize, int outputSize,
+                       size_t blockSize)
+    : filename(filename),
+      file(filename, std::ios::binary),
+      inputSize(inputSize),
+      outputSize(outputSize),
+      blockSize(blockSize),
+      numSamples(0),
+      cachedBlock(static_cast<size_t>(-1)) {
+
+    if (inputSize <= 0 || outputSize <= 0 || blockSize == 0) {
+        throw std::invalid_argument("Dataset sizes must be positive");
+    }
+    if (!file.is_open()) {
+        throw std::runtime_error("Não foi possível abrir o dataset: " + filename);
+    }
+    buildIndex();
+}
+
+void CsvDataset::buildIndex() {
+    // Percorre o arquivo em pedaços de 1 MB, marcando o início de cada bloco
+    const size_t chunkSize = 1 << 20;
+    std::vector<char> chunk(chunkSize);
+    std::string partial;          // Linha incompleta no fim do pedaço anterior
+    uint64_t partialOffset = 0;   // Posição no arquivo onde a linha começa
+    uint64_t position = 0;
+    uint64_t lineNumber = 0;
+    std::vector<double> values;
+
+    auto handleLine = [&](const char* begin, const char* end, uint64_t lineOffset) {
+        bool header = ++lineNumber == 1;
+        if (isBlankLine(begin, end)) return;
+        if (!parseCsvLine(begin, end, values)) {
+            if (header) return;   // Cabeçalho com nomes das colunas
+            throw std::runtime_error("Linha inválida no dataset " + filename +
+                                     " (linha " + std::to_string(lineNumber) + ")");
+        }
+        if (values.size() != static_cast<size_t>(inputSize + outputSize)) {
+            throw std::runtime_error("Número de colunas incorreto no dataset " + filename +
+                                     " (linha " + std::to_string(lineNumber) + ")");
+        }
+        if (numSamples % blockSize == 0) {
+            blockOffsets.push_back(lineOffset);
+            blockLines.push_back(lineNumber);
+        }
+        ++numSamples;
+    };
+
+    file.clear();
+    file.seekg(0);
+    while (file) {
+        file.read(chunk.data(), chunkSize);
+        std::streamsize got = file.gcount();
+        if (got <= 0) break;
+
+        const char* data = chunk.data();
+        const char* end = data + got;
+        const char* lineStart = data;
+        for (const char* p = data; p < end; ++p) {
+            if (*p != '\n') continue;
+            if (!partial.empty()) {
+                partial.append(lineStart, p);
+                handleLine(partial.data(), partial.data() + partial.size(), partialOffset);
+                partial.clear();
+            } else {
+                handleLine(lineStart, p, position + (lineStart - data));
+            }
+            lineStart = p + 1;
+        }
+        if (lineStart < end) {
+            if (partial.empty()) partialOffset = position + (lineStart - data);
+            partial.append(lineStart, end);
+        }
+        position += got;
+    }
+    if (!partial.empty()) {
+        handleLine(partial.data(), partial.data() + partial.size(), partialOffset);
+    }
+
+    // Marca o fim do último bloco
+    blockOffsets.push_back(position);
+    file.clear();
+}
+
+void CsvDataset::loadBlock(size_t block) const {
+    uint64_t begin = blockOffsets[block];
+    uint64_t end = blockOffsets[block + 1];
+    std::string buffer(static_cast<size_t>(end - begin), '\0');
+
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(begin));
+    file.read(&buffer[0], buffer.size());
+
+    size_t rows = std::min(blockSize, numSamples - block * blockSize);
+    size_t columns = inputSize + outputSize;
+    blockValues.resize(rows * columns);
+
+    std::vector<double> values;
+    size_t row = 0;
+    uint64_t lineNumber = blockLines[block];
+    const char* p = buffer.data();
+    const char* bufferEnd = p + buffer.size();
+    while (p < bufferEnd && row < rows) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', bufferEnd - p));
+        if (!lineEnd) lineEnd = bufferEnd;
+        if (!isBlankLine(p, lineEnd)) {
+            // O arquivo pode ter mudado depois da indexação: nunca copiar
+            // uma linha com outro número de colunas para o bloco
+            if (!parseCsvLine(p, lineEnd, values) || values.size() != columns) {
+                throw std::runtime_error("Número de colunas incorreto no dataset " + filename +
+                                         " (linha " + std::to_string(lineNumber) + ")");
+            }
+            std::copy(values.begin(), values.end(), blockValues.begin() + row * columns);
+            ++row;
+        }
+        ++lineNumber;
+        p = lineEnd + 1;
+    }
+    if (row != rows) {
+        throw std::runtime_error("Dataset alterado durante a leitura: " + filename);
+    }
+    cachedBlock = block;
+}
+
+void CsvDataset::getSample(size_t index, std::vector<double>& input,
+                           std::vector<double>& target) const {
+    if (index >= numSamples) {
+        throw std::out_of_range("Sample index out of range");
+    }
+    size_t block = index / blockSize;
+    if (block != cachedBlock) {
+        loadBlock(block);
+    }
+    const double* row = blockValues.data() + (index % blockSize) * (inputSize + outputSize);
+    input.assign(row, row + inputSize);
+    target.assign(row + inputSize, row + inputSize + outputSize);
+}
+
+// ===== BinaryDataset =====
+
+BinaryDataset::BinaryDataset(const std::string& filename, size_t blockSize)
+    : filename(filename),
+      numSamples(0),
+      inputSize(0),
+      outputSize(0),
+      blockSize(blockSize),
+      mapped(nullptr),
+      mappedLength(0),
+      cachedBlock(static_cast<size_t>(-1)) {
+
+    if (blockSize == 0) {
+        throw std::invalid_argument("Block size must be positive");
+    }
+
+    file.open(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Não foi possível abrir o dataset: " + filename);
+    }
+
+    char magic[4];
+    uint32_t version = 0, in = 0, out = 0;
+    uint64_t samples = 0;
+    file.read(magic, 4);
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&samples), sizeof(samples));
+    file.read(reinterpret_cast<char*>(&in), sizeof(in));
+    file.read(reinterpret_cast<char*>(&out), sizeof(out));
+    if (!file || std::memcmp(magic, DATASET_MAGIC, 4) != 0 ||
+        version != DATASET_VERSION || in == 0 || out == 0) {
+        throw std::runtime_error("Arquivo de dataset inválido: " + filename);
+    }
+    numSamples = static_cast<size_t>(samples);
+    inputSize = static_cast<int>(in);
+    outputSize = static_cast<int>(out);
+
+    size_t expected = DATASET_HEADER_SIZE + numSamples * (in + out) * sizeof(float);
+
+#ifndef _WIN32
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    struct stat info;
+    if (fd >= 0 && ::fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= expected) {
+        void* address = ::mmap(nullptr, expected, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            mapped = static_cast<const unsigned char*>(address);
+            mappedLength = expected;
+        }
+    }
+    if (fd >= 0) ::close(fd);
+#endif
+
+    if (mapped) {
+        file.close();   // Páginas lidas pelo mapeamento; o stream só serve ao fallback
+    } else {
+        file.seekg(0, std::ios::end);
+        if (static_cast<size_t>(file.tellg()) < expected) {
+            throw std::runtime_error("Arquivo de dataset truncado: " + filename);
+        }
+    }
+}
+
+BinaryDataset::~BinaryDataset() {
+#ifndef _WIN32
+    if (mapped) {
+        ::munmap(const_cast<unsigned char*>(mapped), mappedLength);
+    }
+#endif
+}
+
+void BinaryDataset::loadBlock(size_t block) const {
+    size_t first = block * blockSize;
+    size_t rows = std::min(blockSize, numSamples - first);
+    size_t columns = inputSize + outputSize;
+    blockValues.resize(columns * blockSize);
+
+    // Uma leitura contígua por coluna
+    for (size_t c = 0; c < columns; ++c) {
+        uint64_t offset = DATASET_HEADER_SIZE + (c * numSamples + first) * sizeof(float);
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(offset));
+        file.read(reinterpret_cast<char*>(&blockValues[c * blockSize]), rows * sizeof(float));
+    }
+    if (!file) {
+        throw std::runtime_error("Erro de leitura no dataset: " + filename);
+    }
+    cachedBlock = block;
+}
+
+void BinaryDataset::getSample(size_t index, std::vector<double>& input,
+                              std::vector<double>& target) const {
+    if (index >= numSamples) {
+        throw std::out_of_range("Sample index out of range");
+    }
+    input.resize(inputSize);
+    target.resize(outputSize);
+
+    if (mapped) {
+        const float* columns = reinterpret_cast<const float*>(mapped + DATASET_HEADER_SIZE);
+        for (int c = 0; c < inputSize; ++c) {
+            input[c] = columns[c * numSamples + index];
+        }
+        for (int c = 0; c < outputSize; ++c) {
+            target[c] = columns[(inputSize + c) * numSamples + index];
+        }
+        return;
+    }
+
+    size_t block = index / blockSize;
+    if (block != cachedBlock) {
+        loadBlock(block);
+    }
+    size_t row = index % blockSize;
+    for (int c = 0; c < inputSize; ++c) {
+        input[c] = blockValues[c * blockSize + row];
+    }
+    for (int c = 0; c < outputSize; ++c) {
+        target[c] = blockValues[(inputSize + c) * blockSize + row];
+    }
+}
+
+bool BinaryDataset::write(const std::string& filename, const Dataset& source) {
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    uint64_t samples = source.size();
+    uint32_t in = source.getInputSize();
+    uint32_t outSize = source.getOutputSize();
+    size_t columns = in + outSize;
+
+    out.write(DATASET_MAGIC, 4);
+    out.write(reinterpret_cast<const char*>(&DATASET_VERSION), sizeof(DATASET_VERSION));
+    out.write(reinterpret_cast<const char*>(&samples), sizeof(samples));
+    out.write(reinterpret_cast<const char*>(&in), sizeof(in));
+    out.write(reinterpret_cast<const char*>(&outSize), sizeof(outSize));
+
+    // Lê a origem sequencialmente, transpondo um bloco de cada vez para as colunas
+    const size_t chunkRows = 4096;
+    std::vector<float> chunk(columns * chunkRows);
+    std::vector<double> input, target;
+
+    for (size_t first = 0; first < samples; first += chunkRows) {
+        size_t rows = std::min<size_t>(chunkRows, samples - first);
+        for (size_t r = 0; r < rows; ++r) {
+            source.getSample(first + r, input, target);
+            for (size_t c = 0; c < in; ++c) {
+                chunk[c * chunkRows + r] = static_cast<float>(input[c]);
+            }
+            for (size_t c = 0; c < outSize; ++c) {
+                chunk[(in + c) * chunkRows + r] = static_cast<float>(target[c]);
+            }
+        }
+        for (size_t c = 0; c < columns; ++c) {
+            uint64_t offset = DATASET_HEADER_SIZE + (c * samples + first) * sizeof(float);
+            out.seekp(static_cast<std::streamoff>(offset));
+            out.write(reinterpret_cast<const char*>(&chunk[c * chunkRows]), rows * sizeof(float));
+        }
+    }
+
+    out.close();
+    return !out.fail();
+}
+
+// ===== BlockShuffler =====
+
+BlockShuffler::BlockShuffler(size_t total, size_t blockSize, uint64_t seed)
+    : total(total),
+      blockSize(std::max<size_t>(1, std::min(blockSize, std::max<size_t>(total, 1)))),
+      currentBlock(static_cast<size_t>(-1)),
+      seed(seed),
+      epoch(0),
+      epochRng(seed, 0) {
+
+    size_t numBlocks = (total + this->blockSize - 1) / this->blockSize;
+    blockOrder.resize(numBlocks);
+    for (size_t b = 0; b < numBlocks; ++b) {
+        blockOrder[b] = b;
+    }
+}
+
+void BlockShuffler::shuffle() {
+    shuffle(epoch + 1);
+}
+
+void BlockShuffler::shuffle(uint64_t epochIndex) {
+    epoch = epochIndex;
+    epochRng = CounterRng(seed, epoch);
+    // Parte da identidade: a ordem da época não depende das anteriores
+    for (size_t b = 0; b < blockOrder.size(); ++b) {
+        blockOrder[b] = b;
+    }
+    // Um bloco final incompleto fica sempre por último, para que a posição k
+    // continue mapeando para o bloco k / blockSize
+    size_t fullBlocks = total / blockSize;
+    CounterRng orderRng = epochRng.split(0);
+    shuffleRange(blockOrder.begin(), blockOrder.begin() + fullBlocks, orderRng);
+    currentBlock = static_cast<size_t>(-1);
+}
+
+void BlockShuffler::shuffleBlock(size_t block) {
+    size_t first = blockOrder[block] * blockSize;
+    size_t rows = std::min(blockSize, total - first);
+    withinBlock.resize(rows);
+    for (size_t r = 0; r < rows; ++r) {
+        withinBlock[r] = first + r;
+    }
+    CounterRng blockRng = epochRng.split(block + 1);
+    shuffleRange(withinBlock.begin(), withinBlock.end(), blockRng);
+    currentBlock = block;
+}
+
+size_t BlockShuffler::at(size_t k) {
+    size_t block = k / blockSize;
+    if (block != currentBlock) {
+        shuffleBlock(block);
+    }
+    return withinBlock[k % blockSize];
+}
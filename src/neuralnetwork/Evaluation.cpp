@@ -0,0 +1,94 @@
+#include "../include/neuralnetwork/Evaluation.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+// Largura na tela de um texto UTF-8 ("TRÁS" = 4), para alinhar a tabela
+std::size_t displayWidth(const std::string& text) {
+    std::size_t width = 0;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        if ((static_cast<unsigned char>(text[i]) & 0xC0) != 0x80) {
+            width++;
+        }
+    }
+    return width;
+}
+
+std::string pad(const std::string& text, std::size_t width, bool left) {
+    std::size_t shown = displayWidth(text);
+    std::string fill(shown < width ? width - shown : 0, ' ');
+    return left ? text + fill : fill + text;
+}
+
+} // namespace
+
+int ActionBands::classify(double output) const {
+    for (std::size_t k = 0; k < names.size() && k + 1 < bounds.size(); ++k) {
+        if (output >= bounds[k] && output < bounds[k + 1]) {
+            return static_cast<int>(k);
+        }
+    }
+    return -1;
+}
+
+double EvaluationResult::recall(std::size_t band) const {
+    std::size_t total = 0;
+    for (std::size_t p = 0; p < confusion[band].size(); ++p) {
+        total += confusion[band][p];
+    }
+    return total > 0 ? static_cast<double>(confusion[band][band]) / total : 0.0;
+}
+
+double EvaluationResult::precision(std::size_t band) const {
+    std::size_t total = 0;
+    for (std::size_t e = 0; e < confusion.size(); ++e) {
+        total += confusion[e][band];
+    }
+    return total > 0 ? static_cast<double>(confusion[band][band]) / total : 0.0;
+}
+
+void printEvaluationReport(const EvaluationResult& result) {
+    const std::ios::fmtflags flags = std::cout.flags();
+    const std::streamsize precision = std::cout.precision();
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Avaliação: " << result.samples << " amostras, " << result.threads << " threads, "
+              << std::fixed << std::setprecision(3) << result.seconds * 1000.0 << " ms";
+    if (result.seconds > 0.0) {
+        std::cout << " (" << std::setprecision(0) << result.samples / result.seconds << " amostras/s)";
+    }
+    std::cout << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << std::scientific << std::setprecision(4);
+    std::cout << "Erro (validate): " << result.loss << " | MSE: " << result.mse
+              << " | Maior erro absoluto: " << result.maxAbsError << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Acurácia: " << 100.0 * result.accuracy() << "% (" << result.correct << "/"
+              << result.labeled << " amostras com ação esperada)" << std::endl;
+
+    // Matriz de confusão: linhas = ação esperada, colunas = ação predita
+    std::size_t width = 8;
+    for (std::size_t k = 0; k < result.labels.size(); ++k) {
+        width = std::max(width, displayWidth(result.labels[k]) + 1);
+    }
+    std::cout << "\nEsperada \\ Predita" << std::endl;
+    std::cout << pad("", width, true);
+    for (std::size_t k = 0; k < result.labels.size(); ++k) {
+        std::cout << pad(result.labels[k], width, false);
+    }
+    std::cout << std::setw(9) << "Recall" << std::endl;
+    for (std::size_t e = 0; e < result.confusion.size(); ++e) {
+        std::cout << pad(result.labels[e], width, true);
+        for (std::size_t p = 0; p < result.confusion[e].size(); ++p) {
+            std::cout << std::setw(width) << result.confusion[e][p];
+        }
+        if (e + 1 < result.confusion.size()) {
+            std::cout << std::setw(8) << 100.0 * result.recall(e) << "%";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "========================================\n" << std::endl;
+    std::cout.flags(flags);
+    std::cout.precision(precision);
+}
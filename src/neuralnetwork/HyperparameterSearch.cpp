@@ -0,0 +1,410 @@
+#include "../include/neuralnetwork/HyperparameterSearch.h"
+#include "../include/neuralnetwork/ActivationFunction.h"
+#include "../include/neuralnetwork/Parallel.h"
+#include "../include/neuralnetwork/Random.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+double median(std::vector<double> values) {
+    std::size_t middle = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + middle, values.end());
+    if (values.size() % 2 == 1) {
+        return values[middle];
+    }
+    double upper = values[middle];
+    return 0.5 * (upper + *std::max_element(values.begin(), values.begin() + middle));
+}
+
+/**
+ * @brief Treina até mais `epochs` épocas
+ * @return Épocas realmente treinadas (menos que epochs se convergiu)
+ */
+int trainFor(NeuralNetwork& network, const Dataset& data, int epochs, double errorThreshold,
+             bool& converged) {
+    // trainBatch devolve a época da convergência, ou epochs + 1 se não convergiu
+    int last = network.trainBatch(data, epochs, errorThreshold, false);
+    converged = last <= epochs;
+    return std::min(last, epochs);
+}
+
+/**
+ * @brief Dataset que os trials leem em paralelo
+ * @param guard Recebe o SynchronizedDataset quando data não aceita leituras simultâneas
+ */
+const Dataset& sharedReads(const Dataset& data, std::unique_ptr<SynchronizedDataset>& guard) {
+    if (data.concurrentReads()) {
+        return data;
+    }
+    guard.reset(new SynchronizedDataset(data));
+    return *guard;
+}
+
+// Fluxos da semente da busca: sorteio das configurações e sementes dos trials
+const uint64_t DRAW_STREAM = 0;
+const uint64_t TRIAL_STREAM = 1;
+
+} // namespace
+
+std::size_t SearchSpace::gridSize() const {
+    return hiddenSizes.size() * depths.size() * activations.size() *
+           learningRates.size() * momenta.size() * initRanges.size();
+}
+
+std::string TrialConfig::architecture(int inputSize, int outputSize) const {
+    std::ostringstream text;
+    text << inputSize;
+    for (int d = 0; d < depth; ++d) {
+        text << "-" << hiddenSize;
+    }
+    text << "-" << outputSize;
+    return text.str();
+}
+
+std::unique_ptr<NeuralNetwork> TrialConfig::build(int inputSize, int outputSize) const {
+    return build(inputSize, outputSize, CounterRng::entropySeed());
+}
+
+std::unique_ptr<NeuralNetwork> TrialConfig::build(int inputSize, int outputSize, uint64_t seed) const {
+    if (!createActivation(activation)) {
+        throw std::invalid_argument("Ativação desconhecida: " + activation);
+    }
+    std::unique_ptr<NeuralNetwork> network(new NeuralNetwork(inputSize, outputSize, learningRate, momentum));
+    network->setSeed(seed);
+    for (int d = 0; d < depth; ++d) {
+        network->addHiddenLayer(hiddenSize, createActivation(activation), initRange);
+    }
+    network->finalize(std::make_shared<SigmoidActivation>(), initRange);
+    return network;
+}
+
+HyperparameterSearch::HyperparameterSearch(const SearchSpace& searchSpace, const SearchConfig& searchConfig)
+    : space(searchSpace), config(searchConfig) {
+    if (space.gridSize() == 0) {
+        throw std::invalid_argument("HyperparameterSearch: lista de valores vazia no espaço de busca");
+    }
+    for (std::size_t i = 0; i < space.activations.size(); ++i) {
+        if (!createActivation(space.activations[i])) {
+            throw std::invalid_argument("HyperparameterSearch: ativação desconhecida: " + space.activations[i]);
+        }
+    }
+    for (std::size_t i = 0; i < space.hiddenSizes.size(); ++i) {
+        if (space.hiddenSizes[i] <= 0) {
+            throw std::invalid_argument("HyperparameterSearch: tamanho de camada deve ser positivo");
+        }
+    }
+    for (std::size_t i = 0; i < space.depths.size(); ++i) {
+        if (space.depths[i] <= 0) {
+            throw std::invalid_argument("HyperparameterSearch: profundidade deve ser positiva");
+        }
+    }
+    if (config.maxEpochs <= 0 || config.trials <= 0) {
+        throw std::invalid_argument("HyperparameterSearch: maxEpochs e trials devem ser positivos");
+    }
+    if (config.strategy == SearchStrategy::SuccessiveHalving && (config.minEpochs <= 0 || config.eta < 2)) {
+        throw std::invalid_argument("HyperparameterSearch: successive halving exige minEpochs > 0 e eta >= 2");
+    }
+    if (config.strategy != SearchStrategy::SuccessiveHalving && config.evaluationInterval <= 0) {
+        throw std::invalid_argument("HyperparameterSearch: evaluationInterval deve ser positivo");
+    }
+}
+
+TrialConfig HyperparameterSearch::configAt(std::size_t index) const {
+    // Índice em base mista; o último hiperparâmetro varia mais rápido
+    TrialConfig trial;
+    trial.initRange = space.initRanges[index % space.initRanges.size()];
+    index /= space.initRanges.size();
+    trial.momentum = space.momenta[index % space.momenta.size()];
+    index /= space.momenta.size();
+    trial.learningRate = space.learningRates[index % space.learningRates.size()];
+    index /= space.learningRates.size();
+    trial.activation = space.activations[index % space.activations.size()];
+    index /= space.activations.size();
+    trial.depth = space.depths[index % space.depths.size()];
+    index /= space.depths.size();
+    trial.hiddenSize = space.hiddenSizes[index % space.hiddenSizes.size()];
+    return trial;
+}
+
+std::vector<TrialConfig> HyperparameterSearch::candidates() const {
+    const std::size_t grid = space.gridSize();
+    std::vector<std::size_t> indices(grid);
+    for (std::size_t i = 0; i < grid; ++i) {
+        indices[i] = i;
+    }
+    std::size_t count = grid;
+    if (config.strategy != SearchStrategy::Grid) {
+        // Sorteio sem repetição: Fisher-Yates parcial com semente fixa
+        count = std::min(grid, static_cast<std::size_t>(config.trials));
+        CounterRng rng(config.seed, DRAW_STREAM);
+        for (std::size_t i = 0; i < count; ++i) {
+            std::size_t pick = i + static_cast<std::size_t>(rng.below(grid - i));
+            std::swap(indices[i], indices[pick]);
+        }
+    }
+    std::vector<TrialConfig> configs;
+    configs.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        configs.push_back(configAt(indices[i]));
+    }
+    return configs;
+}
+
+uint64_t HyperparameterSearch::trialSeed(std::size_t index) const {
+    return CounterRng(config.seed, TRIAL_STREAM).at(index);
+}
+
+int HyperparameterSearch::threadCount(std::size_t trials) const {
+    int threads = config.threads > 0 ? config.threads : static_cast<int>(std::thread::hardware_concurrency());
+    threads = std::max(threads, 1);
+    return static_cast<int>(std::min<std::size_t>(threads, trials));
+}
+
+SearchReport HyperparameterSearch::run(const std::vector<std::vector<double>>& trainInputs,
+                                       const std::vector<std::vector<double>>& trainTargets,
+                                       const std::vector<std::vector<double>>& validationInputs,
+                                       const std::vector<std::vector<double>>& validationTargets) {
+    if (trainInputs.empty() || trainInputs.size() != trainTargets.size() ||
+        validationInputs.empty() || validationInputs.size() != validationTargets.size()) {
+        throw std::invalid_argument("HyperparameterSearch: conjuntos de treino/validação vazios ou incompletos");
+    }
+    MemoryDataset training(trainInputs, trainTargets);
+    MemoryDataset validation(validationInputs, validationTargets);
+    return run(training, validation);
+}
+
+SearchReport HyperparameterSearch::run(const Dataset& training, const Dataset& validation) {
+    if (training.size() == 0 || validation.size() == 0) {
+        throw std::invalid_argument("HyperparameterSearch: conjuntos de treino/validação vazios");
+    }
+    if (training.getInputSize() != validation.getInputSize() ||
+        training.getOutputSize() != validation.getOutputSize()) {
+        throw std::invalid_argument("HyperparameterSearch: treino e validação com tamanhos diferentes");
+    }
+    // O mesmo objeto nos dois papéis usa um único mutex
+    std::unique_ptr<SynchronizedDataset> trainingGuard, validationGuard;
+    const Dataset& trainData = sharedReads(training, trainingGuard);
+    const Dataset& validationData = &validation == &training ? trainData
+                                                             : sharedReads(validation, validationGuard);
+
+    const auto started = std::chrono::steady_clock::now();
+    const std::vector<TrialConfig> configs = candidates();
+    const std::size_t count = configs.size();
+
+    SearchReport report;
+    report.strategy = config.strategy;
+    report.inputSize = training.getInputSize();
+    report.outputSize = training.getOutputSize();
+    report.threads = threadCount(count);
+    report.results.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        report.results[i].id = static_cast<int>(i) + 1;
+        report.results[i].config = configs[i];
+        report.results[i].seed = trialSeed(i);
+    }
+
+    // Cada trial só escreve no seu próprio slot; os datasets são só lidos
+    std::vector<std::unique_ptr<NeuralNetwork>> networks(count);
+    std::vector<char> converged(count, 0);
+    auto fail = [&](std::size_t i, const std::exception& e) {
+        report.results[i].error = e.what();
+        report.results[i].validationError = std::numeric_limits<double>::infinity();
+        networks[i].reset();
+    };
+    auto measure = [&](std::size_t i) {
+        // Treino divergente (NaN) conta como o pior resultado, para a ordenação continuar válida
+        double validationError = networks[i]->validate(validationData, false);
+        double trainingError = networks[i]->validate(trainData, false);
+        report.results[i].validationError = std::isfinite(validationError) ? validationError : std::numeric_limits<double>::infinity();
+        report.results[i].trainingError = std::isfinite(trainingError) ? trainingError : std::numeric_limits<double>::infinity();
+    };
+
+    if (config.strategy == SearchStrategy::SuccessiveHalving) {
+        std::vector<std::size_t> alive(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            alive[i] = i;
+        }
+        for (int budget = std::min(config.minEpochs, config.maxEpochs);; ) {
+            parallelFor(alive.size(), std::min<int>(report.threads, static_cast<int>(alive.size())),
+                        [&](std::size_t k) {
+                std::size_t i = alive[k];
+                TrialResult& result = report.results[i];
+                auto trialStart = std::chrono::steady_clock::now();
+                try {
+                    if (!networks[i]) {
+                        networks[i] = result.config.build(report.inputSize, report.outputSize, result.seed);
+                    }
+                    // Continua de onde parou: cada rodada só paga as épocas novas
+                    if (!converged[i] && result.epochs < budget) {
+                        bool done;
+                        result.epochs += trainFor(*networks[i], trainData,
+                                                  budget - result.epochs, config.errorThreshold, done);
+                        converged[i] = done;
+                    }
+                    measure(i);
+                } catch (const std::exception& e) {
+                    fail(i, e);
+                }
+                result.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - trialStart).count();
+            });
+            if (budget >= config.maxEpochs || alive.size() <= 1) {
+                break;
+            }
+            // Só o melhor 1/eta segue para a próxima rodada, com eta vezes o orçamento
+            std::stable_sort(alive.begin(), alive.end(), [&](std::size_t a, std::size_t b) {
+                return report.results[a].validationError < report.results[b].validationError;
+            });
+            std::size_t keep = std::max<std::size_t>(1, alive.size() / config.eta);
+            for (std::size_t k = keep; k < alive.size(); ++k) {
+                report.results[alive[k]].stopped = true;
+                networks[alive[k]].reset();
+            }
+            alive.resize(keep);
+            budget = static_cast<int>(std::min<long long>(config.maxEpochs,
+                                                          static_cast<long long>(budget) * config.eta));
+        }
+    } else {
+        // Parada pela mediana, determinística: o trial i se compara só com os
+        // trials j < i no mesmo ponto, e espera cada um deles chegar ao ponto
+        // (ou terminar antes). Com qualquer número de threads, o conjunto
+        // comparado é o mesmo da execução sequencial. Os índices são pegos
+        // em ordem crescente, então todo j < i já está rodando: a espera
+        // termina sempre.
+        std::mutex curvesMutex;
+        std::condition_variable curvesChanged;
+        std::vector<std::vector<double>> curves(count);   // Erro de validação em cada ponto
+        std::vector<char> finished(count, 0);
+        parallelFor(count, report.threads, [&](std::size_t i) {
+            TrialResult& result = report.results[i];
+            auto trialStart = std::chrono::steady_clock::now();
+            try {
+                networks[i] = result.config.build(report.inputSize, report.outputSize, result.seed);
+                for (std::size_t point = 0; result.epochs < config.maxEpochs; ++point) {
+                    int chunk = std::min(config.evaluationInterval, config.maxEpochs - result.epochs);
+                    bool done;
+                    result.epochs += trainFor(*networks[i], trainData, chunk,
+                                              config.errorThreshold, done);
+                    if (done || result.epochs >= config.maxEpochs) {
+                        break;
+                    }
+                    double error = networks[i]->validate(validationData, false);
+                    if (!std::isfinite(error)) {
+                        error = std::numeric_limits<double>::infinity();
+                    }
+                    bool losing = false;
+                    {
+                        std::unique_lock<std::mutex> lock(curvesMutex);
+                        if (config.medianStopping) {
+                            curvesChanged.wait(lock, [&] {
+                                for (std::size_t j = 0; j < i; ++j) {
+                                    if (!finished[j] && curves[j].size() <= point) {
+                                        return false;
+                                    }
+                                }
+                                return true;
+                            });
+                            std::vector<double> others;
+                            for (std::size_t j = 0; j < i; ++j) {
+                                if (curves[j].size() > point) {
+                                    others.push_back(curves[j][point]);
+                                }
+                            }
+                            if (others.size() >= static_cast<std::size_t>(config.minTrialsForMedian)) {
+                                losing = error > median(others);
+                            }
+                        }
+                        curves[i].push_back(error);
+                    }
+                    curvesChanged.notify_all();
+                    if (losing) {
+                        result.stopped = true;
+                        break;
+                    }
+                }
+                measure(i);
+            } catch (const std::exception& e) {
+                fail(i, e);
+            }
+            networks[i].reset();
+            {
+                std::lock_guard<std::mutex> lock(curvesMutex);
+                finished[i] = 1;
+            }
+            curvesChanged.notify_all();
+            result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - trialStart).count();
+        });
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        report.epochsTrained += report.results[i].epochs;
+    }
+    report.epochsBudget = static_cast<long long>(count) * config.maxEpochs;
+    // Empates ficam na ordem dos ids: o ranking não depende de qual thread terminou antes
+    std::stable_sort(report.results.begin(), report.results.end(), [](const TrialResult& a, const TrialResult& b) {
+        return a.validationError < b.validationError;
+    });
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return report;
+}
+
+const char* searchStrategyName(SearchStrategy strategy) {
+    switch (strategy) {
+        case SearchStrategy::Grid: return "grade";
+        case SearchStrategy::Random: return "aleatória";
+        case SearchStrategy::SuccessiveHalving: return "successive halving";
+    }
+    return "?";
+}
+
+void printSearchReport(const SearchReport& report, std::size_t rows) {
+    const std::ios::fmtflags flags = std::cout.flags();
+    const std::streamsize precision = std::cout.precision();
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Busca de hiperparâmetros (" << searchStrategyName(report.strategy) << "): "
+              << report.results.size() << " configurações, " << report.threads << " threads, "
+              << std::fixed << std::setprecision(1) << report.seconds << " s" << std::endl;
+    if (report.epochsBudget > 0) {
+        std::cout << "Épocas treinadas: " << report.epochsTrained << " de " << report.epochsBudget
+                  << " (" << 100.0 * report.epochsTrained / report.epochsBudget << "% do orçamento sem interrupção)"
+                  << std::endl;
+    }
+    std::cout << "========================================" << std::endl;
+    std::cout << "   # | Arquitetura | Ativação | Taxa  | Mom. | Init | Épocas | Erro valid. | Erro treino | Situação" << std::endl;
+
+    std::size_t shown = rows == 0 ? report.results.size() : std::min(rows, report.results.size());
+    for (std::size_t r = 0; r < shown; ++r) {
+        const TrialResult& result = report.results[r];
+        const TrialConfig& trial = result.config;
+        std::cout << "  " << std::setw(2) << r + 1
+                  << " | " << std::left << std::setw(11) << trial.architecture(report.inputSize, report.outputSize)
+                  << " | " << std::setw(8) << trial.activation << std::right
+                  << " | " << std::fixed << std::setprecision(2) << std::setw(5) << trial.learningRate
+                  << " | " << std::setprecision(1) << std::setw(4) << trial.momentum
+                  << " | " << std::setprecision(1) << std::setw(4) << trial.initRange
+                  << " | " << std::setw(6) << result.epochs;
+        if (!result.error.empty()) {
+            std::cout << " | " << std::setw(11) << "-" << " | " << std::setw(11) << "-"
+                      << " | falhou: " << result.error << std::endl;
+            continue;
+        }
+        std::cout << " | " << std::scientific << std::setprecision(3) << std::setw(11) << result.validationError
+                  << " | " << std::setw(11) << result.trainingError
+                  << " | " << (result.stopped ? "interrompido" : "completo") << std::endl;
+    }
+    if (shown < report.results.size()) {
+        std::cout << "  ... " << report.results.size() - shown << " configurações omitidas" << std::endl;
+    }
+    std::cout << "========================================\n" << std::endl;
+    std::cout.flags(flags);
+    std::cout.precision(precision);
+}
@@ -1,19 +1,54 @@
 #include "../include/neuralnetwork/Layer.h"
-#include <random>
+#include "../include/neuralnetwork/Random.h"
+#include <algorithm>
+#include <cmath>
 #include <ctime>
 #include <iostream>
 #include <stdexcept>
 
+namespace {
+
+LayerConfig uniformConfig(double weightInitRange) {
+    LayerConfig config;
+    config.weightInitRange = weightInitRange;
+    return config;
+}
+
+} // namespace
+
 Layer::Layer(int inputSize, int neurons, 
              std::shared_ptr<ActivationFunction> activationFunc,
              double weightInitRange)
+    : Layer(inputSize, neurons, activationFunc, weightInitRange, CounterRng::entropySeed(), 0) {
+}
+
+Layer::Layer(int inputSize, int neurons,
+             std::shared_ptr<ActivationFunction> activationFunc,
+             double weightInitRange, uint64_t seed, uint64_t stream)
+    : Layer(inputSize, neurons, activationFunc, uniformConfig(weightInitRange), seed, stream) {
+}
+
+Layer::Layer(int inputSize, int neurons,
+             std::shared_ptr<ActivationFunction> activationFunc,
+             const LayerConfig& config, uint64_t seed, uint64_t stream)
     : inputSize(inputSize),
       neurons(neurons),
-      activationFunction(activationFunc) {
+      activationFunction(activationFunc),
+      init(config.init),
+      dropout(config.dropout),
+      masked(false),
+      weightDecay(config.weightDecay),
+      gradientNormSquared(0.0) {
     
     if (inputSize <= 0 || neurons <= 0) {
         throw std::invalid_argument("Input size and neurons must be positive");
     }
+    if (!(config.dropout >= 0.0 && config.dropout < 1.0)) {
+        throw std::invalid_argument("Dropout must be in [0, 1)");
+    }
+    if (!(config.weightDecay >= 0.0)) {
+        throw std::invalid_argument("Weight decay must be non-negative");
+    }
     
     // Inicializar estruturas de dados
     weights.resize(inputSize, std::vector<double>(neurons));
@@ -27,27 +62,42 @@ Layer::Layer(int inputSize, int neurons,
     
     activations.resize(neurons, 0.0);
     weightedSums.resize(neurons, 0.0);
+    if (dropout > 0.0) {
+        dropoutMask.resize(neurons, 1.0);
+    }
     
     // Inicializar pesos aleatoriamente
-    initializeWeights(weightInitRange);
+    initializeWeights(config, seed, stream);
 }
 
-void Layer::initializeWeights(double range) {
-    // Gerador de números aleatórios com seed baseada no tempo
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_real_distribution<> dis(-range, range);
+void Layer::initializeWeights(const LayerConfig& config, uint64_t seed, uint64_t stream) {
+    // Fluxo próprio da camada: sem estado global, seguro em paralelo
+    // (HyperparameterSearch) e igual em qualquer número de threads
+    CounterRng rng(seed, stream);
+    
+    // Xavier/He: amplitude pelo fan-in (e fan-out), para a variância das
+    // ativações não crescer nem sumir com a profundidade
+    double range = config.weightInitRange;
+    if (config.init == WeightInit::Xavier) {
+        range = std::sqrt(6.0 / (inputSize + neurons));
+    } else if (config.init == WeightInit::He) {
+        range = std::sqrt(6.0 / inputSize);
+    }
     
     // Inicializar pesos com valores aleatórios uniformes
     for (int i = 0; i < inputSize; ++i) {
         for (int j = 0; j < neurons; ++j) {
-            weights[i][j] = dis(gen);
+            weights[i][j] = rng.uniform(-range, range);
         }
     }
     
+    if (config.init != WeightInit::Uniform) {
+        return;   // Bias começam em zero
+    }
+    
     // Inicializar bias com valores pequenos aleatórios
     for (int j = 0; j < neurons; ++j) {
-        bias[j] = dis(gen) * 0.1;  // Bias com amplitude reduzida
+        bias[j] = rng.uniform(-range, range) * 0.1;  // Bias com amplitude reduzida
     }
 }
 
@@ -61,6 +111,7 @@ std::vector<double> Layer::forward(const std::vector<double>& input) {
     
     // Guardar entrada para uso no backpropagation
     inputs = input;
+    masked = false;
     
     // Calcular saída de cada neurônio
     for (int j = 0; j < neurons; ++j) {
@@ -80,6 +131,46 @@ std::vector<double> Layer::forward(const std::vector<double>& input) {
     return activations;
 }
 
+std::vector<double> Layer::forwardTraining(const std::vector<double>& input, CounterRng& rng) {
+    forward(input);
+    if (dropout <= 0.0) {
+        return activations;
+    }
+    
+    // Inverted dropout: a escala fica no treino, a predição não muda
+    const double keep = 1.0 / (1.0 - dropout);
+    std::vector<double> output(neurons);
+    for (int j = 0; j < neurons; ++j) {
+        dropoutMask[j] = rng.uniform() < dropout ? 0.0 : keep;
+        output[j] = activations[j] * dropoutMask[j];
+    }
+    masked = true;
+    return output;
+}
+
+void Layer::forwardBatch(const double* input, size_t rows, std::vector<double>& output) const {
+    output.resize(rows * neurons);
+    for (size_t r = 0; r < rows; ++r) {
+        const double* x = input + r * inputSize;
+        double* sums = output.data() + r * neurons;
+        // Acumula linha a linha da matriz de pesos: o laço interno é contíguo
+        // em weights[i] e vetorizável; cada soma segue a ordem de forward()
+        for (int j = 0; j < neurons; ++j) {
+            sums[j] = bias[j];
+        }
+        for (int i = 0; i < inputSize; ++i) {
+            const double xi = x[i];
+            const double* row = weights[i].data();
+            for (int j = 0; j < neurons; ++j) {
+                sums[j] += xi * row[j];
+            }
+        }
+        for (int j = 0; j < neurons; ++j) {
+            sums[j] = activationFunction->activate(sums[j]);
+        }
+    }
+}
+
 std::vector<double> Layer::backward(const std::vector<double>& outputGradients) {
     if (outputGradients.size() != static_cast<size_t>(neurons)) {
         throw std::invalid_argument("Output gradients size mismatch");
@@ -88,14 +179,20 @@ std::vector<double> Layer::backward(const std::vector<double>& outputGradients)
     // Calcular gradientes para propagar para a camada anterior
     std::vector<double> inputGradients(inputSize, 0.0);
     
+    // ||gradiente||² = Σ local² · (Σ entrada² + 1): sem percorrer a matriz de novo
+    double localSquared = 0.0;
+    
     // Para cada neurônio nesta camada
     for (int j = 0; j < neurons; ++j) {
         // Calcular gradiente local: output_gradient * derivative(activation)
+        // (saídas desligadas pelo dropout não recebem gradiente)
         double derivative = activationFunction->derivative(activations[j]);
-        double localGradient = outputGradients[j] * derivative;
+        double outputGradient = masked ? outputGradients[j] * dropoutMask[j] : outputGradients[j];
+        double localGradient = outputGradient * derivative;
         
         // Atualizar gradientes dos pesos e bias
         biasGradients[j] = localGradient;
+        localSquared += localGradient * localGradient;
         
         for (int i = 0; i < inputSize; ++i) {
             // Gradiente do peso: local_gradient * input
@@ -106,6 +203,12 @@ std::vector<double> Layer::backward(const std::vector<double>& outputGradients)
         }
     }
     
+    double inputSquared = 1.0;   // Entrada constante do bias
+    for (int i = 0; i < inputSize; ++i) {
+        inputSquared += inputs[i] * inputs[i];
+    }
+    gradientNormSquared = localSquared * inputSquared;
+    
     return inputGradients;
 }
 
@@ -114,9 +217,9 @@ void Layer::updateWeights(double learningRate, double momentum) {
     for (int i = 0; i < inputSize; ++i) {
         for (int j = 0; j < neurons; ++j) {
             // Calcular mudança com momentum:
-            // velocity = momentum * velocity - learningRate * gradient
+            // velocity = momentum * velocity - learningRate * (gradient + λ * weight)
             weightVelocity[i][j] = momentum * weightVelocity[i][j] 
-                                  - learningRate * weightGradients[i][j];
+                                  - learningRate * (weightGradients[i][j] + weightDecay * weights[i][j]);
             
             // Atualizar peso
             weights[i][j] += weightVelocity[i][j];
@@ -149,3 +252,39 @@ void Layer::setBias(const std::vector<double>& newBias) {
     }
     bias = newBias;
 }
+
+void Layer::setConfig(const LayerConfig& config) {
+    if (!(config.dropout >= 0.0 && config.dropout < 1.0)) {
+        throw std::invalid_argument("Dropout must be in [0, 1)");
+    }
+    if (!(config.weightDecay >= 0.0)) {
+        throw std::invalid_argument("Weight decay must be non-negative");
+    }
+    init = config.init;
+    dropout = config.dropout;
+    weightDecay = config.weightDecay;
+    masked = false;
+    if (dropout > 0.0) {
+        dropoutMask.assign(neurons, 1.0);
+    } else {
+        dropoutMask.clear();
+    }
+}
+
+void Layer::setVelocity(const std::vector<std::vector<double>>& newWeightVelocity,
+                        const std::vector<double>& newBiasVelocity) {
+    if (newWeightVelocity.size() != static_cast<size_t>(inputSize) ||
+        (newWeightVelocity.size() > 0 && newWeightVelocity[0].size() != static_cast<size_t>(neurons)) ||
+        newBiasVelocity.size() != static_cast<size_t>(neurons)) {
+        throw std::invalid_argument("Velocity dimensions mismatch");
+    }
+    weightVelocity = newWeightVelocity;
+    biasVelocity = newBiasVelocity;
+}
+
+void Layer::resetVelocity() {
+    for (auto& row : weightVelocity) {
+        std::fill(row.begin(), row.end(), 0.0);
+    }
+    std::fill(biasVelocity.begin(), biasVelocity.end(), 0.0);
+}
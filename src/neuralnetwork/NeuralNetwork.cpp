@@ -1,4 +1,6 @@
 #include "../include/neuralnetwork/NeuralNetwork.h"
+#include "../include/neuralnetwork/Parallel.h"
+#include "../include/neuralnetwork/Random.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -6,6 +8,33 @@
 #include <cmath>
 #include <iomanip>
 #include <stdexcept>
+#include <limits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+#include <chrono>
+#include <numeric>
+#include <thread>
+
+namespace {
+const uint64_t SHUFFLE_STREAM = ~static_cast<uint64_t>(0);
+const uint64_t DROPOUT_STREAM = SHUFFLE_STREAM - 1;
+
+bool fileExists(const std::string& filename) {
+    std::ifstream probe(filename);
+    return probe.good();
+}
+
+// Arquivo temporário com a mesma extensão (o formato segue a extensão)
+std::string temporaryFileFor(const std::string& filename) {
+    size_t dot = filename.find_last_of('.');
+    size_t slash = filename.find_last_of('/');
+    bool hasExtension = dot != std::string::npos && (slash == std::string::npos || dot > slash);
+    return filename + ".tmp" + (hasExtension ? filename.substr(dot) : std::string());
+}
+} // namespace
 
 NeuralNetwork::NeuralNetwork(int inputSize, int outputSize,
                              double learningRate, double momentum)
@@ -14,32 +43,70 @@ NeuralNetwork::NeuralNetwork(int inputSize, int outputSize,
       learningRate(learningRate),
       momentum(momentum),
       lastError(0.0),
-      trainingIterations(0) {
+      trainingIterations(0),
+      lastGradientNormSquared(0.0),
+      completedEpochs(0),
+      bestValidationError(std::numeric_limits<double>::infinity()),
+      bestValidationEpoch(0),
+      stalledValidations(0),
+      seed(CounterRng::entropySeed()),
+      shuffledEpochs(0),
+      trainedSamples(0) {
     
     if (inputSize <= 0 || outputSize <= 0) {
         throw std::invalid_argument("Input and output sizes must be positive");
     }
 }
 
+void NeuralNetwork::setSeed(uint64_t networkSeed) {
+    if (!layers.empty()) {
+        throw std::logic_error("setSeed must be called before adding layers");
+    }
+    seed = networkSeed;
+    shuffledEpochs = 0;
+    trainedSamples = 0;
+}
+
 void NeuralNetwork::addHiddenLayer(int neurons,
                                   std::shared_ptr<ActivationFunction> activationFunc,
                                   double weightInitRange) {
+    LayerConfig config;
+    config.weightInitRange = weightInitRange;
+    addHiddenLayer(neurons, activationFunc, config);
+}
+
+void NeuralNetwork::addHiddenLayer(int neurons,
+                                  std::shared_ptr<ActivationFunction> activationFunc,
+                                  const LayerConfig& config) {
     // Determinar o tamanho da entrada para esta camada
     int layerInputSize = layers.empty() ? inputSize : layers.back()->getOutputSize();
     
     // Criar e adicionar a nova camada
     auto layer = std::make_shared<Layer>(layerInputSize, neurons, 
-                                         activationFunc, weightInitRange);
+                                         activationFunc, config,
+                                         seed, layers.size());
     layers.push_back(layer);
 }
 
 void NeuralNetwork::finalize(std::shared_ptr<ActivationFunction> activationFunc,
                              double weightInitRange) {
+    LayerConfig config;
+    config.weightInitRange = weightInitRange;
+    finalize(activationFunc, config);
+}
+
+void NeuralNetwork::finalize(std::shared_ptr<ActivationFunction> activationFunc,
+                             const LayerConfig& config) {
+    if (config.dropout != 0.0) {
+        throw std::invalid_argument("Dropout is not supported on the output layer");
+    }
+    
     // Adicionar camada de saída
     int layerInputSize = layers.empty() ? inputSize : layers.back()->getOutputSize();
     
     auto outputLayer = std::make_shared<Layer>(layerInputSize, outputSize,
-                                               activationFunc, weightInitRange);
+                                               activationFunc, config,
+                                               seed, layers.size());
     layers.push_back(outputLayer);
 }
 
@@ -71,8 +138,18 @@ double NeuralNetwork::train(const std::vector<double>& input,
         throw std::invalid_argument("Target size mismatch");
     }
     
-    // Forward propagation
-    std::vector<double> output = predict(input);
+    if (layers.empty()) {
+        throw std::runtime_error("Network not finalized. Call finalize() first.");
+    }
+    
+    // Forward propagation com dropout: máscaras do fluxo (seed, amostra, camada),
+    // as mesmas em qualquer execução com a mesma semente
+    const CounterRng sampleRng = CounterRng(seed, DROPOUT_STREAM).split(trainedSamples++);
+    std::vector<double> output = input;
+    for (size_t l = 0; l < layers.size(); ++l) {
+        CounterRng layerRng = sampleRng.split(l);
+        output = layers[l]->forwardTraining(output, layerRng);
+    }
     
     // Calcular erro
     double error = calculateError(output, target);
@@ -82,8 +159,10 @@ double NeuralNetwork::train(const std::vector<double>& input,
     std::vector<double> gradients = calculateOutputGradients(output, target);
     
     // Propagar gradientes de trás para frente
+    lastGradientNormSquared = 0.0;
     for (int i = layers.size() - 1; i >= 0; --i) {
         gradients = layers[i]->backward(gradients);
+        lastGradientNormSquared += layers[i]->getGradientNormSquared();
     }
     
     // Atualizar pesos de todas as camadas
@@ -101,67 +180,244 @@ int NeuralNetwork::trainBatch(const std::vector<std::vector<double>>& inputs,
                               int epochs,
                               double errorThreshold,
                               bool verbose) {
-    if (inputs.size() != targets.size()) {
-        throw std::invalid_argument("Number of inputs and targets must match");
+    return trainBatch(inputs, targets, epochs, errorThreshold, verbose,
+                      EarlyStoppingConfig());
+}
+
+int NeuralNetwork::trainBatch(const std::vector<std::vector<double>>& inputs,
+                              const std::vector<std::vector<double>>& targets,
+                              int epochs,
+                              double errorThreshold,
+                              bool verbose,
+                              const EarlyStoppingConfig& config) {
+    MemoryDataset data(inputs, targets);
+    return trainBatch(data, epochs, errorThreshold, verbose, config);
+}
+
+int NeuralNetwork::trainBatch(const Dataset& data,
+                              int epochs,
+                              double errorThreshold,
+                              bool verbose,
+                              const EarlyStoppingConfig& config) {
+    // Conjunto de validação: dataset explícito ou vetores em memória
+    const Dataset* validation = config.validationDataset;
+    std::unique_ptr<MemoryDataset> validationView;
+    if (!validation && config.validationInputs && config.validationTargets) {
+        validationView.reset(new MemoryDataset(*config.validationInputs,
+                                               *config.validationTargets));
+        validation = validationView.get();
     }
     
-    int numPatterns = inputs.size();
-    std::vector<int> indices(numPatterns);
+    bool useValidation = validation != nullptr && validation->size() > 0;
+    if (useValidation && config.validationInterval <= 0) {
+        throw std::invalid_argument("Validation interval must be positive");
+    }
+    
+    // Melhor modelo em memória (para restaurar ao final)
+    ParameterSnapshot bestParameters;
+    bool earlyStopped = false;
+    
+    // Retomar: o estado periódico traz pesos, momentum, época e paciência;
+    // sem ele, o melhor modelo (arquivos anteriores ao stateFile)
+    int startEpoch = 1;
+    bestValidationError = std::numeric_limits<double>::infinity();
+    bestValidationEpoch = 0;
+    stalledValidations = 0;
+    const std::string& resumeFile = (!config.stateFile.empty() && fileExists(config.stateFile))
+                                        ? config.stateFile : config.checkpointFile;
+    if (config.resume && !resumeFile.empty() && fileExists(resumeFile) && loadWeights(resumeFile)) {
+        startEpoch = completedEpochs + 1;
+        shuffledEpochs = completedEpochs;   // Mesma ordem que o treino interrompido teria
+        trainedSamples = static_cast<uint64_t>(completedEpochs) * data.size();
+        // Pesos do melhor modelo só vêm do checkpoint: o estado periódico guarda
+        // o erro dele, não os pesos. Sem checkpoint, nada a restaurar no final
+        if (std::isfinite(bestValidationError)) {
+            if (resumeFile == config.checkpointFile) {
+                bestParameters = captureParameters();
+            } else if (!config.checkpointFile.empty() && fileExists(config.checkpointFile)) {
+                std::unique_ptr<NeuralNetwork> best = clone();
+                if (best->loadWeights(config.checkpointFile)) {
+                    bestParameters = best->captureParameters();
+                }
+            }
+        }
+        if (verbose) {
+            std::cout << "↻ Retomando de " << resumeFile
+                      << " (época " << completedEpochs << ")" << std::endl;
+        }
+    }
     
-    // Inicializar índices para embaralhamento
-    for (int i = 0; i < numPatterns; ++i) {
-        indices[i] = i;
+    size_t numPatterns = data.size();
+    if (numPatterns == 0) {
+        throw std::invalid_argument("Training dataset is empty");
     }
     
+    // Embaralhamento por blocos (blocos = páginas do arquivo para datasets em disco)
+    // Semente: fluxo da rede que nenhuma camada usa (camadas usam 0..L-1)
+    BlockShuffler shuffler(numPatterns, data.getBlockSize(),
+                           CounterRng(seed, SHUFFLE_STREAM).next());
+    std::vector<double> input, target;
+    
+    // Amostras lidas em lotes contíguos (readBatch), treinadas na ordem embaralhada
+    const size_t readSize = std::min<size_t>(numPatterns, 256);
+    const size_t sampleInputs = static_cast<size_t>(data.getInputSize());
+    const size_t sampleTargets = static_cast<size_t>(data.getOutputSize());
+    std::vector<size_t> readIndices(readSize);
+    std::vector<double> inputRows(readSize * sampleInputs), targetRows(readSize * sampleTargets);
+    
+    // Observadores: a saída no console é só mais um, fora do laço de treino
+    ConsoleTrainingObserver console;
+    std::vector<TrainingObserver*> observers;
     if (verbose) {
-        std::cout << "\n========================================" << std::endl;
-        std::cout << "Iniciando treinamento da rede neural" << std::endl;
-        std::cout << "========================================" << std::endl;
-        std::cout << "Padrões de treinamento: " << numPatterns << std::endl;
-        std::cout << "Épocas máximas: " << epochs << std::endl;
-        std::cout << "Limiar de erro: " << errorThreshold << std::endl;
-        std::cout << getArchitectureInfo() << std::endl;
-        std::cout << "========================================\n" << std::endl;
+        observers.push_back(&console);
+    }
+    observers.insert(observers.end(), config.observers.begin(), config.observers.end());
+    const bool observed = !observers.empty();
+    
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point started = Clock::now();
+    TrainingEnd end;
+    end.samples = numPatterns;
+    
+    if (observed) {
+        TrainingStart start;
+        start.samples = numPatterns;
+        start.startEpoch = startEpoch;
+        start.maxEpochs = epochs;
+        start.errorThreshold = errorThreshold;
+        if (useValidation) {
+            start.validationSamples = validation->size();
+            start.validationInterval = config.validationInterval;
+            start.patience = config.patience;
+        }
+        start.architecture = getArchitectureInfo();
+        for (TrainingObserver* observer : observers) {
+            observer->onTrainingBegin(start);
+        }
     }
     
     int epoch;
-    for (epoch = 1; epoch <= epochs; ++epoch) {
+    for (epoch = startEpoch; epoch <= epochs; ++epoch) {
+        const Clock::time_point epochStart = observed ? Clock::now() : Clock::time_point();
+        
         // Embaralhar padrões de treinamento para evitar mínimos locais
-        std::random_shuffle(indices.begin(), indices.end());
+        // (época contada na rede: chamadas seguidas de trainBatch continuam a sequência)
+        shuffler.shuffle(++shuffledEpochs);
         
         double totalError = 0.0;
+        double totalGradientSquared = 0.0;
         
         // Treinar com cada padrão
-        for (int idx : indices) {
-            double error = train(inputs[idx], targets[idx]);
-            totalError += error;
+        for (size_t k = 0; k < numPatterns; k += readSize) {
+            const size_t rows = std::min(readSize, numPatterns - k);
+            for (size_t r = 0; r < rows; ++r) {
+                readIndices[r] = shuffler.at(k + r);
+            }
+            data.readBatch(readIndices.data(), rows, inputRows.data(), targetRows.data());
+            for (size_t r = 0; r < rows; ++r) {
+                const double* row = inputRows.data() + r * sampleInputs;
+                const double* out = targetRows.data() + r * sampleTargets;
+                input.assign(row, row + sampleInputs);
+                target.assign(out, out + sampleTargets);
+                double error = train(input, target);
+                totalError += error;
+                totalGradientSquared += lastGradientNormSquared;
+            }
         }
         
         double avgError = totalError / numPatterns;
+        completedEpochs = epoch;
+        end.finalError = avgError;
         
-        // Exibir progresso periodicamente
-        if (verbose && (epoch % 1000 == 0 || epoch == 1)) {
-            std::cout << std::fixed << std::setprecision(6);
-            std::cout << "Época " << std::setw(6) << epoch 
-                     << " | Erro médio: " << avgError << std::endl;
+        EpochStats stats;
+        Clock::time_point trained;
+        if (observed) {
+            trained = Clock::now();
+            stats.epoch = epoch;
+            stats.trainingError = avgError;
+            stats.gradientNorm = std::sqrt(totalGradientSquared / numPatterns);
+            stats.learningRate = learningRate;
+            stats.samples = numPatterns;
+            stats.trainSeconds = std::chrono::duration<double>(trained - epochStart).count();
+        }
+        
+        // Validação periódica com seleção do melhor modelo
+        if (useValidation && epoch % config.validationInterval == 0) {
+            double validationError = validate(*validation, false);
+            stats.validationError = validationError;
+            
+            if (validationError < bestValidationError - config.minDelta) {
+                bestValidationError = validationError;
+                bestValidationEpoch = epoch;
+                bestParameters = captureParameters();
+                stalledValidations = 0;
+                
+                if (!config.checkpointFile.empty()) {
+                    if (!writeModelFile(config.checkpointFile)) {
+                        std::cerr << "Erro ao gravar checkpoint: "
+                                  << config.checkpointFile << std::endl;
+                    }
+                }
+            } else if (config.patience > 0 &&
+                       ++stalledValidations >= config.patience) {
+                end.reason = StopReason::EarlyStopped;
+                earlyStopped = true;
+            }
         }
         
         // Verificar convergência
-        if (avgError < errorThreshold) {
-            if (verbose) {
-                std::cout << "\n✓ Convergência alcançada na época " << epoch << std::endl;
-                std::cout << "  Erro final: " << avgError << std::endl;
+        if (!earlyStopped && avgError < errorThreshold) {
+            end.reason = StopReason::Converged;
+        }
+        
+        // Estado para retomar: periódico e na última época (arquivo temporário
+        // + rename, para uma interrupção no meio da gravação não perder o anterior)
+        const bool lastEpoch = epoch == epochs || end.reason != StopReason::MaxEpochs;
+        if (!config.stateFile.empty() &&
+            (lastEpoch || (config.checkpointInterval > 0 && epoch % config.checkpointInterval == 0))) {
+            const std::string temporary = temporaryFileFor(config.stateFile);
+            if (!writeModelFile(temporary, true) ||
+                std::rename(temporary.c_str(), config.stateFile.c_str()) != 0) {
+                std::cerr << "Erro ao gravar estado do treinamento: "
+                          << config.stateFile << std::endl;
+            }
+        }
+        
+        if (observed) {
+            const Clock::time_point now = Clock::now();
+            stats.validationSeconds = std::chrono::duration<double>(now - trained).count();
+            stats.elapsedSeconds = std::chrono::duration<double>(now - started).count();
+            end.trainSeconds += stats.trainSeconds;
+            end.validationSeconds += stats.validationSeconds;
+            for (TrainingObserver* observer : observers) {
+                observer->onEpochEnd(stats);
             }
+        }
+        
+        if (end.reason != StopReason::MaxEpochs) {
             break;
         }
     }
     
-    if (verbose) {
-        if (epoch > epochs) {
-            std::cout << "\n⚠ Número máximo de épocas atingido" << std::endl;
+    // Voltar ao melhor modelo visto na validação
+    if (config.restoreBestWeights && !bestParameters.empty()) {
+        double currentError = earlyStopped ? std::numeric_limits<double>::infinity()
+                                           : validate(*validation, false);
+        if (currentError > bestValidationError) {
+            restoreParameters(bestParameters);
+            end.restoredBest = true;
+        }
+    }
+    
+    if (observed) {
+        end.lastEpoch = completedEpochs;
+        end.epochsTrained = std::max(0, std::min(epoch, epochs) - startEpoch + 1);
+        end.bestValidationError = bestValidationError;
+        end.stalledValidations = stalledValidations;
+        end.seconds = std::chrono::duration<double>(Clock::now() - started).count();
+        for (TrainingObserver* observer : observers) {
+            observer->onTrainingEnd(end);
         }
-        std::cout << "\nTreinamento concluído." << std::endl;
-        std::cout << "========================================\n" << std::endl;
     }
     
     return epoch;
@@ -170,145 +426,858 @@ int NeuralNetwork::trainBatch(const std::vector<std::vector<double>>& inputs,
 double NeuralNetwork::validate(const std::vector<std::vector<double>>& inputs,
                               const std::vector<std::vector<double>>& targets,
                               bool verbose) {
-    if (inputs.size() != targets.size()) {
-        throw std::invalid_argument("Number of inputs and targets must match");
+    MemoryDataset data(inputs, targets);
+    return validate(data, verbose);
+}
+
+double NeuralNetwork::validate(const Dataset& data, bool verbose) {
+    if (!verbose) {
+        return evaluate(data).loss;
     }
     
     double totalError = 0.0;
+    std::vector<double> input, target;
     
-    if (verbose) {
-        std::cout << "\n========================================" << std::endl;
-        std::cout << "Validação da rede neural" << std::endl;
-        std::cout << "========================================" << std::endl;
-    }
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Validação da rede neural" << std::endl;
+    std::cout << "========================================" << std::endl;
     
-    for (size_t i = 0; i < inputs.size(); ++i) {
-        std::vector<double> output = predict(inputs[i]);
-        double error = calculateError(output, targets[i]);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data.getSample(i, input, target);
+        std::vector<double> output = predict(input);
+        double error = calculateError(output, target);
         totalError += error;
         
-        if (verbose) {
-            std::cout << "Padrão " << (i + 1) << ":" << std::endl;
-            
-            std::cout << "  Entrada:   [";
-            for (size_t j = 0; j < inputs[i].size(); ++j) {
-                std::cout << std::fixed << std::setprecision(2) << inputs[i][j];
-                if (j < inputs[i].size() - 1) std::cout << ", ";
-            }
-            std::cout << "]" << std::endl;
-            
-            std::cout << "  Esperado:  [";
-            for (size_t j = 0; j < targets[i].size(); ++j) {
-                std::cout << std::fixed << std::setprecision(4) << targets[i][j];
-                if (j < targets[i].size() - 1) std::cout << ", ";
+        std::cout << "Padrão " << (i + 1) << ":" << std::endl;
+        
+        std::cout << "  Entrada:   [";
+        for (size_t j = 0; j < input.size(); ++j) {
+            std::cout << std::fixed << std::setprecision(2) << input[j];
+            if (j < input.size() - 1) std::cout << ", ";
+        }
+        std::cout << "]" << std::endl;
+        
+        std::cout << "  Esperado:  [";
+        for (size_t j = 0; j < target.size(); ++j) {
+            std::cout << std::fixed << std::setprecision(4) << target[j];
+            if (j < target.size() - 1) std::cout << ", ";
+        }
+        std::cout << "]" << std::endl;
+        
+        std::cout << "  Predição:  [";
+        for (size_t j = 0; j < output.size(); ++j) {
+            std::cout << std::fixed << std::setprecision(4) << output[j];
+            if (j < output.size() - 1) std::cout << ", ";
+        }
+        std::cout << "]" << std::endl;
+        
+        std::cout << "  Erro:      " << std::fixed << std::setprecision(6) 
+                 << error << "\n" << std::endl;
+    }
+    
+    double avgError = totalError / data.size();
+    
+    std::cout << "Erro médio de validação: " << std::fixed 
+             << std::setprecision(6) << avgError << std::endl;
+    std::cout << "========================================\n" << std::endl;
+    
+    return avgError;
+}
+
+EvaluationResult NeuralNetwork::evaluate(const std::vector<std::vector<double>>& inputs,
+                                         const std::vector<std::vector<double>>& targets,
+                                         const EvaluationConfig& config) const {
+    MemoryDataset data(inputs, targets);
+    return evaluate(data, config);
+}
+
+EvaluationResult NeuralNetwork::evaluate(const Dataset& data, const EvaluationConfig& config) const {
+    if (layers.empty()) {
+        throw std::runtime_error("Network not finalized. Call finalize() first.");
+    }
+    if (data.size() > 0 && (data.getInputSize() != inputSize || data.getOutputSize() != outputSize)) {
+        throw std::invalid_argument("Dataset dimensions do not match the network");
+    }
+    if (config.outputIndex < 0 || config.outputIndex >= outputSize) {
+        throw std::invalid_argument("Evaluation output index out of range");
+    }
+    
+    const auto started = std::chrono::steady_clock::now();
+    const size_t samples = data.size();
+    const size_t batchSize = std::max<size_t>(1, config.batchSize);
+    const size_t batches = (samples + batchSize - 1) / batchSize;
+    const size_t classes = config.bands.size() + 1;   // Última classe = fora das faixas
+    
+    int threads = 1;
+    if (samples >= config.parallelThreshold) {
+        threads = config.threads > 0 ? config.threads : static_cast<int>(std::thread::hardware_concurrency());
+        threads = static_cast<int>(std::min<size_t>(std::max(threads, 1), batches));
+    }
+    
+    // Parciais por lote, reduzidas depois na ordem dos lotes
+    struct Partial {
+        double loss = 0.0;
+        double squared = 0.0;
+        double maxAbs = 0.0;
+    };
+    std::vector<Partial> partials(batches);
+    std::vector<size_t> confusion(batches * classes * classes, 0);
+    
+    // Lote b já lido: forward em lote e parciais do lote
+    auto evaluateBatch = [&](size_t b, const double* inputBatch, const double* targetBatch) {
+        const size_t rows = std::min(batchSize, samples - b * batchSize);
+        std::vector<double> current, next;
+        layers[0]->forwardBatch(inputBatch, rows, current);
+        for (size_t l = 1; l < layers.size(); ++l) {
+            layers[l]->forwardBatch(current.data(), rows, next);
+            current.swap(next);
+        }
+        
+        Partial& partial = partials[b];
+        size_t* counts = confusion.data() + b * classes * classes;
+        for (size_t r = 0; r < rows; ++r) {
+            const double* output = current.data() + r * outputSize;
+            const double* target = targetBatch + r * outputSize;
+            double error = 0.0;   // Mesma conta de calculateError
+            for (int o = 0; o < outputSize; ++o) {
+                double diff = target[o] - output[o];
+                error += 0.5 * diff * diff;
+                partial.squared += diff * diff;
+                partial.maxAbs = std::max(partial.maxAbs, std::fabs(diff));
             }
-            std::cout << "]" << std::endl;
+            partial.loss += error;
             
-            std::cout << "  Predição:  [";
-            for (size_t j = 0; j < output.size(); ++j) {
-                std::cout << std::fixed << std::setprecision(4) << output[j];
-                if (j < output.size() - 1) std::cout << ", ";
+            int expected = config.bands.classify(target[config.outputIndex]);
+            int predicted = config.bands.classify(output[config.outputIndex]);
+            size_t e = expected < 0 ? classes - 1 : static_cast<size_t>(expected);
+            size_t p = predicted < 0 ? classes - 1 : static_cast<size_t>(predicted);
+            counts[e * classes + p]++;
+        }
+    };
+    
+    if (data.concurrentReads()) {
+        // Cada worker lê o seu próprio intervalo de índices, sem trava
+        parallelFor(batches, threads, [&](size_t b) {
+            const size_t first = b * batchSize;
+            const size_t rows = std::min(batchSize, samples - first);
+            std::vector<size_t> indices(rows);
+            std::iota(indices.begin(), indices.end(), first);
+            std::vector<double> inputBatch(rows * inputSize), targetBatch(rows * outputSize);
+            data.readBatch(indices.data(), rows, inputBatch.data(), targetBatch.data());
+            evaluateBatch(b, inputBatch.data(), targetBatch.data());
+        });
+    } else {
+        // Dataset com bloco em cache: esta thread lê vários lotes de uma vez,
+        // em sequência, e os workers só leem esse buffer compartilhado
+        const size_t roundBatches = static_cast<size_t>(threads) * 8;
+        std::vector<size_t> indices;
+        std::vector<double> inputRows, targetRows;
+        for (size_t firstBatch = 0; firstBatch < batches; firstBatch += roundBatches) {
+            const size_t count = std::min(roundBatches, batches - firstBatch);
+            const size_t first = firstBatch * batchSize;
+            const size_t rows = std::min(count * batchSize, samples - first);
+            indices.resize(rows);
+            std::iota(indices.begin(), indices.end(), first);
+            inputRows.resize(rows * inputSize);
+            targetRows.resize(rows * outputSize);
+            data.readBatch(indices.data(), rows, inputRows.data(), targetRows.data());
+            parallelFor(count, std::min<int>(threads, static_cast<int>(count)), [&](size_t k) {
+                evaluateBatch(firstBatch + k, inputRows.data() + k * batchSize * inputSize,
+                              targetRows.data() + k * batchSize * outputSize);
+            });
+        }
+    }
+    
+    EvaluationResult result;
+    result.samples = samples;
+    result.threads = threads;
+    result.labels = config.bands.names;
+    result.labels.push_back("fora");
+    result.confusion.assign(classes, std::vector<size_t>(classes, 0));
+    double loss = 0.0, squared = 0.0;
+    for (size_t b = 0; b < batches; ++b) {
+        loss += partials[b].loss;
+        squared += partials[b].squared;
+        result.maxAbsError = std::max(result.maxAbsError, partials[b].maxAbs);
+        const size_t* counts = confusion.data() + b * classes * classes;
+        for (size_t e = 0; e < classes; ++e) {
+            for (size_t p = 0; p < classes; ++p) {
+                result.confusion[e][p] += counts[e * classes + p];
             }
-            std::cout << "]" << std::endl;
-            
-            std::cout << "  Erro:      " << std::fixed << std::setprecision(6) 
-                     << error << "\n" << std::endl;
         }
     }
+    if (samples > 0) {
+        result.loss = loss / samples;
+        result.mse = squared / (static_cast<double>(samples) * outputSize);
+    }
+    for (size_t e = 0; e + 1 < classes; ++e) {
+        for (size_t p = 0; p < classes; ++p) {
+            result.labeled += result.confusion[e][p];
+        }
+        result.correct += result.confusion[e][e];
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return result;
+}
+
+namespace {
+
+// Modelos com extensão ".bin" usam o formato binário; os demais, JSON
+bool isBinaryModelFile(const std::string& filename) {
+    const std::string ext = ".bin";
+    return filename.size() >= ext.size() &&
+           filename.compare(filename.size() - ext.size(), ext.size(), ext) == 0;
+}
+
+// Cabeçalho do formato binário: "NNWB" + versão
+// (versão 2: época do melhor modelo, paciência e momentum opcional;
+//  versão 3: inicialização, dropout e weight decay de cada camada)
+const char BINARY_MAGIC[4] = {'N', 'N', 'W', 'B'};
+const uint32_t BINARY_VERSION = 3;
+
+// Nomes da inicialização no JSON (o binário grava o valor do enum)
+const char* weightInitName(WeightInit init) {
+    switch (init) {
+        case WeightInit::Xavier: return "xavier";
+        case WeightInit::He: return "he";
+        default: return "uniform";
+    }
+}
+
+bool parseWeightInit(const std::string& name, WeightInit& init) {
+    if (name == "uniform") init = WeightInit::Uniform;
+    else if (name == "xavier") init = WeightInit::Xavier;
+    else if (name == "he") init = WeightInit::He;
+    else return false;
+    return true;
+}
+
+template <typename T>
+void writePod(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readPod(std::istream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+/**
+ * Parser JSON mínimo, suficiente para o formato gravado por saveWeights
+ * (objetos, arrays, strings sem escapes unicode e números).
+ */
+struct JsonValue {
+    enum Type { Null, Number, String, Array, Object } type = Null;
+    double number = 0.0;
+    std::string text;
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string, JsonValue>> members;
     
-    double avgError = totalError / inputs.size();
+    const JsonValue* get(const std::string& key) const {
+        for (const auto& member : members) {
+            if (member.first == key) return &member.second;
+        }
+        return nullptr;
+    }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& text) : src(text), pos(0) {}
     
-    if (verbose) {
-        std::cout << "Erro médio de validação: " << std::fixed 
-                 << std::setprecision(6) << avgError << std::endl;
-        std::cout << "========================================\n" << std::endl;
+    JsonValue parse() {
+        JsonValue value = parseValue();
+        skipSpaces();
+        if (pos != src.size()) fail("conteúdo extra após o fim do documento");
+        return value;
     }
+
+private:
+    const std::string& src;
+    size_t pos;
     
-    return avgError;
+    void fail(const std::string& what) const {
+        throw std::runtime_error("JSON inválido (posição " + std::to_string(pos) + "): " + what);
+    }
+    
+    void skipSpaces() {
+        while (pos < src.size() && std::isspace(static_cast<unsigned char>(src[pos]))) ++pos;
+    }
+    
+    void expect(char c) {
+        skipSpaces();
+        if (pos >= src.size() || src[pos] != c) fail(std::string("esperado '") + c + "'");
+        ++pos;
+    }
+    
+    JsonValue parseValue() {
+        skipSpaces();
+        if (pos >= src.size()) fail("fim inesperado");
+        char c = src[pos];
+        if (c == '{') return parseObject();
+        if (c == '[') return parseArray();
+        if (c == '"') {
+            JsonValue value;
+            value.type = JsonValue::String;
+            value.text = parseString();
+            return value;
+        }
+        if (src.compare(pos, 4, "null") == 0) {
+            pos += 4;
+            return JsonValue();
+        }
+        return parseNumber();
+    }
+    
+    JsonValue parseObject() {
+        JsonValue value;
+        value.type = JsonValue::Object;
+        expect('{');
+        skipSpaces();
+        if (pos < src.size() && src[pos] == '}') { ++pos; return value; }
+        while (true) {
+            skipSpaces();
+            std::string key = parseString();
+            expect(':');
+            value.members.emplace_back(key, parseValue());
+            skipSpaces();
+            if (pos < src.size() && src[pos] == ',') { ++pos; continue; }
+            expect('}');
+            return value;
+        }
+    }
+    
+    JsonValue parseArray() {
+        JsonValue value;
+        value.type = JsonValue::Array;
+        expect('[');
+        skipSpaces();
+        if (pos < src.size() && src[pos] == ']') { ++pos; return value; }
+        while (true) {
+            value.items.push_back(parseValue());
+            skipSpaces();
+            if (pos < src.size() && src[pos] == ',') { ++pos; continue; }
+            expect(']');
+            return value;
+        }
+    }
+    
+    std::string parseString() {
+        if (pos >= src.size() || src[pos] != '"') fail("esperado string");
+        ++pos;
+        std::string out;
+        while (pos < src.size() && src[pos] != '"') {
+            if (src[pos] == '\\' && pos + 1 < src.size()) ++pos;
+            out += src[pos++];
+        }
+        if (pos >= src.size()) fail("string não terminada");
+        ++pos;
+        return out;
+    }
+    
+    JsonValue parseNumber() {
+        const char* begin = src.c_str() + pos;
+        char* end = nullptr;
+        double number = std::strtod(begin, &end);
+        if (end == begin) fail("valor inválido");
+        pos += end - begin;
+        JsonValue value;
+        value.type = JsonValue::Number;
+        value.number = number;
+        return value;
+    }
+};
+
+void writeJsonArray(std::ostream& file, const std::vector<double>& values) {
+    file << "[";
+    for (size_t i = 0; i < values.size(); ++i) {
+        file << values[i];
+        if (i < values.size() - 1) file << ", ";
+    }
+    file << "]";
 }
 
+void writeJsonMatrix(std::ostream& file, const std::vector<std::vector<double>>& matrix) {
+    file << "[\n";
+    for (size_t i = 0; i < matrix.size(); ++i) {
+        file << "        ";
+        writeJsonArray(file, matrix[i]);
+        if (i < matrix.size() - 1) file << ",";
+        file << "\n";
+    }
+    file << "      ]";
+}
+
+bool readNumberArray(const JsonValue* value, std::vector<double>& out) {
+    if (!value || value->type != JsonValue::Array) return false;
+    out.clear();
+    out.reserve(value->items.size());
+    for (const auto& item : value->items) {
+        if (item.type != JsonValue::Number) return false;
+        out.push_back(item.number);
+    }
+    return true;
+}
+
+bool readNumberMatrix(const JsonValue* value, int rows, int columns,
+                      std::vector<std::vector<double>>& out) {
+    if (!value || value->type != JsonValue::Array ||
+        value->items.size() != static_cast<size_t>(rows)) {
+        return false;
+    }
+    out.assign(rows, std::vector<double>());
+    for (int i = 0; i < rows; ++i) {
+        if (!readNumberArray(&value->items[i], out[i]) ||
+            out[i].size() != static_cast<size_t>(columns)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
 bool NeuralNetwork::saveWeights(const std::string& filename) const {
+    if (!writeModelFile(filename)) {
+        std::cerr << "Erro ao abrir arquivo para salvar: " << filename << std::endl;
+        return false;
+    }
+    std::cout << "✓ Pesos salvos com sucesso em: " << filename << std::endl;
+    return true;
+}
+
+bool NeuralNetwork::writeModelFile(const std::string& filename, bool withVelocity) const {
     try {
-        std::ofstream file(filename);
+        bool binary = isBinaryModelFile(filename);
+        std::ofstream file(filename, binary ? std::ios::binary : std::ios::out);
         if (!file.is_open()) {
-            std::cerr << "Erro ao abrir arquivo para salvar: " << filename << std::endl;
             return false;
         }
+        bool ok = binary ? writeBinary(file, withVelocity) : writeJson(file, withVelocity);
+        file.close();
+        return ok && !file.fail();
         
-        // Salvar arquitetura básica
-        file << "{\n";
-        file << "  \"architecture\": {\n";
-        file << "    \"inputSize\": " << inputSize << ",\n";
-        file << "    \"outputSize\": " << outputSize << ",\n";
-        file << "    \"numLayers\": " << layers.size() << "\n";
-        file << "  },\n";
+    } catch (const std::exception& e) {
+        std::cerr << "Erro ao salvar pesos: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool NeuralNetwork::writeJson(std::ostream& file, bool withVelocity) const {
+    // Precisão suficiente para reproduzir exatamente cada double ao recarregar
+    file << std::setprecision(std::numeric_limits<double>::max_digits10);
+    
+    // Salvar arquitetura básica
+    file << "{\n";
+    file << "  \"architecture\": {\n";
+    file << "    \"inputSize\": " << inputSize << ",\n";
+    file << "    \"outputSize\": " << outputSize << ",\n";
+    file << "    \"numLayers\": " << layers.size() << "\n";
+    file << "  },\n";
+    
+    // Salvar hiperparâmetros
+    file << "  \"hyperparameters\": {\n";
+    file << "    \"learningRate\": " << learningRate << ",\n";
+    file << "    \"momentum\": " << momentum << "\n";
+    file << "  },\n";
+    
+    // Salvar estado do treinamento (usado para retomar de checkpoint)
+    file << "  \"training\": {\n";
+    file << "    \"epochs\": " << completedEpochs << ",\n";
+    file << "    \"iterations\": " << trainingIterations << ",\n";
+    file << "    \"bestValidationError\": ";
+    if (std::isfinite(bestValidationError)) {
+        file << bestValidationError << ",\n";
+    } else {
+        file << "null,\n";
+    }
+    file << "    \"bestEpoch\": " << bestValidationEpoch << ",\n";
+    file << "    \"stalledValidations\": " << stalledValidations << "\n";
+    file << "  },\n";
+    
+    // Salvar cada camada
+    file << "  \"layers\": [\n";
+    for (size_t l = 0; l < layers.size(); ++l) {
+        const auto& layer = layers[l];
+        const auto& weights = layer->getWeights();
+        const auto& bias = layer->getBias();
         
-        // Salvar hiperparâmetros
-        file << "  \"hyperparameters\": {\n";
-        file << "    \"learningRate\": " << learningRate << ",\n";
-        file << "    \"momentum\": " << momentum << "\n";
-        file << "  },\n";
+        file << "    {\n";
+        file << "      \"inputSize\": " << layer->getInputSize() << ",\n";
+        file << "      \"neurons\": " << layer->getOutputSize() << ",\n";
+        file << "      \"activation\": \"" << layer->getActivationName() << "\",\n";
+        file << "      \"init\": \"" << weightInitName(layer->getInit()) << "\",\n";
+        file << "      \"dropout\": " << layer->getDropout() << ",\n";
+        file << "      \"weightDecay\": " << layer->getWeightDecay() << ",\n";
         
-        // Salvar cada camada
-        file << "  \"layers\": [\n";
-        for (size_t l = 0; l < layers.size(); ++l) {
-            const auto& layer = layers[l];
-            const auto& weights = layer->getWeights();
-            const auto& bias = layer->getBias();
-            
-            file << "    {\n";
-            file << "      \"inputSize\": " << layer->getInputSize() << ",\n";
-            file << "      \"neurons\": " << layer->getOutputSize() << ",\n";
-            file << "      \"activation\": \"" << layer->getActivationName() << "\",\n";
-            
-            // Salvar pesos
-            file << "      \"weights\": [\n";
-            for (size_t i = 0; i < weights.size(); ++i) {
-                file << "        [";
-                for (size_t j = 0; j < weights[i].size(); ++j) {
-                    file << std::setprecision(10) << weights[i][j];
-                    if (j < weights[i].size() - 1) file << ", ";
-                }
-                file << "]";
-                if (i < weights.size() - 1) file << ",";
-                file << "\n";
-            }
-            file << "      ],\n";
-            
-            // Salvar bias
-            file << "      \"bias\": [";
-            for (size_t i = 0; i < bias.size(); ++i) {
-                file << std::setprecision(10) << bias[i];
-                if (i < bias.size() - 1) file << ", ";
+        // Salvar pesos
+        file << "      \"weights\": ";
+        writeJsonMatrix(file, weights);
+        file << ",\n";
+        
+        // Salvar bias
+        file << "      \"bias\": ";
+        writeJsonArray(file, bias);
+        
+        // Momentum (só no estado para retomar o treinamento)
+        if (withVelocity) {
+            file << ",\n      \"weightVelocity\": ";
+            writeJsonMatrix(file, layer->getWeightVelocity());
+            file << ",\n      \"biasVelocity\": ";
+            writeJsonArray(file, layer->getBiasVelocity());
+        }
+        file << "\n";
+        
+        file << "    }";
+        if (l < layers.size() - 1) file << ",";
+        file << "\n";
+    }
+    file << "  ]\n";
+    file << "}\n";
+    
+    return true;
+}
+
+bool NeuralNetwork::writeBinary(std::ostream& out, bool withVelocity) const {
+    // Formato (little-endian nativo):
+    // magic[4] versão:u32 inputSize:i32 outputSize:i32 numLayers:i32
+    // learningRate:f64 momentum:f64 epochs:i32 iterations:i32 bestValidationError:f64
+    // bestEpoch:i32 stalledValidations:i32 hasVelocity:u8
+    // por camada: inputSize:i32 neurons:i32 nameLen:u8 name init:u8 dropout:f64 weightDecay:f64
+    //             pesos[in*neurons]:f64 bias[neurons]:f64
+    //             e, se hasVelocity, momentum dos pesos[in*neurons]:f64 e dos bias[neurons]:f64
+    out.write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    writePod(out, BINARY_VERSION);
+    writePod(out, static_cast<int32_t>(inputSize));
+    writePod(out, static_cast<int32_t>(outputSize));
+    writePod(out, static_cast<int32_t>(layers.size()));
+    writePod(out, learningRate);
+    writePod(out, momentum);
+    writePod(out, static_cast<int32_t>(completedEpochs));
+    writePod(out, static_cast<int32_t>(trainingIterations));
+    writePod(out, bestValidationError);
+    writePod(out, static_cast<int32_t>(bestValidationEpoch));
+    writePod(out, static_cast<int32_t>(stalledValidations));
+    writePod(out, static_cast<uint8_t>(withVelocity ? 1 : 0));
+    
+    for (const auto& layer : layers) {
+        const std::string name = layer->getActivationName();
+        writePod(out, static_cast<int32_t>(layer->getInputSize()));
+        writePod(out, static_cast<int32_t>(layer->getOutputSize()));
+        writePod(out, static_cast<uint8_t>(name.size()));
+        out.write(name.data(), name.size());
+        writePod(out, static_cast<uint8_t>(layer->getInit()));
+        writePod(out, layer->getDropout());
+        writePod(out, layer->getWeightDecay());
+        
+        for (const auto& row : layer->getWeights()) {
+            out.write(reinterpret_cast<const char*>(row.data()), row.size() * sizeof(double));
+        }
+        const auto& bias = layer->getBias();
+        out.write(reinterpret_cast<const char*>(bias.data()), bias.size() * sizeof(double));
+        
+        if (withVelocity) {
+            for (const auto& row : layer->getWeightVelocity()) {
+                out.write(reinterpret_cast<const char*>(row.data()), row.size() * sizeof(double));
             }
-            file << "]\n";
-            
-            file << "    }";
-            if (l < layers.size() - 1) file << ",";
-            file << "\n";
+            const auto& biasVelocity = layer->getBiasVelocity();
+            out.write(reinterpret_cast<const char*>(biasVelocity.data()),
+                      biasVelocity.size() * sizeof(double));
+        }
+    }
+    
+    return static_cast<bool>(out);
+}
+
+bool NeuralNetwork::loadWeights(const std::string& filename) {
+    try {
+        bool binary = isBinaryModelFile(filename);
+        std::ifstream file(filename, binary ? std::ios::binary : std::ios::in);
+        if (!file.is_open()) {
+            std::cerr << "Erro ao abrir arquivo de pesos: " << filename << std::endl;
+            return false;
         }
-        file << "  ]\n";
-        file << "}\n";
         
-        file.close();
-        std::cout << "✓ Pesos salvos com sucesso em: " << filename << std::endl;
-        return true;
+        bool ok = binary ? readBinary(file) : readJson(file);
+        if (!ok) {
+            std::cerr << "Arquivo de pesos incompatível com a rede: " << filename << std::endl;
+        }
+        return ok;
         
     } catch (const std::exception& e) {
-        std::cerr << "Erro ao salvar pesos: " << e.what() << std::endl;
+        std::cerr << "Erro ao carregar pesos: " << e.what() << std::endl;
         return false;
     }
 }
 
-bool NeuralNetwork::loadWeights(const std::string& filename) {
-    // Nota: Implementação simplificada - uma versão completa usaria uma biblioteca JSON
-    // Por enquanto, esta é uma implementação básica para demonstração
+bool NeuralNetwork::prepareLayers(const std::vector<std::pair<int, int>>& sizes,
+                                  const std::vector<std::string>& activations,
+                                  const std::vector<LayerConfig>& configs) {
+    if (sizes.empty() || sizes.front().first != inputSize ||
+        sizes.back().second != outputSize) {
+        return false;
+    }
+    if (!configs.empty()) {
+        if (configs.size() != sizes.size() || configs.back().dropout != 0.0) return false;
+        for (const auto& config : configs) {
+            if (!(config.dropout >= 0.0 && config.dropout < 1.0) || !(config.weightDecay >= 0.0)) {
+                return false;
+            }
+        }
+    }
+    
+    if (!layers.empty()) {
+        // Rede já construída: arquitetura precisa coincidir exatamente
+        if (layers.size() != sizes.size()) return false;
+        for (size_t l = 0; l < layers.size(); ++l) {
+            if (layers[l]->getInputSize() != sizes[l].first ||
+                layers[l]->getOutputSize() != sizes[l].second ||
+                layers[l]->getActivationName() != activations[l]) {
+                return false;
+            }
+        }
+        // A configuração gravada vale para a continuação do treino
+        for (size_t l = 0; l < configs.size(); ++l) {
+            layers[l]->setConfig(configs[l]);
+        }
+        return true;
+    }
+    
+    // Rede vazia: criar camadas a partir do arquivo
+    // (arquivos sem configuração: uniforme ±0.5, sem dropout nem L2)
+    std::vector<std::shared_ptr<Layer>> created;
+    for (size_t l = 0; l < sizes.size(); ++l) {
+        auto activation = createActivation(activations[l]);
+        if (!activation) return false;
+        if (l > 0 && sizes[l].first != sizes[l - 1].second) return false;
+        const LayerConfig config = configs.empty() ? LayerConfig() : configs[l];
+        created.push_back(std::make_shared<Layer>(sizes[l].first, sizes[l].second, activation,
+                                                  config, seed, l));
+    }
+    layers = created;
+    return true;
+}
+
+bool NeuralNetwork::readJson(std::istream& in) {
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    const std::string text = buffer.str();
+    JsonValue root = JsonParser(text).parse();
+    
+    const JsonValue* layerList = root.get("layers");
+    if (!layerList || layerList->type != JsonValue::Array) return false;
+    
+    std::vector<std::pair<int, int>> sizes;
+    std::vector<std::string> activations;
+    std::vector<LayerConfig> configs;   // Vazio em arquivos sem a configuração das camadas
+    ParameterSnapshot parameters;
+    ParameterSnapshot velocities;   // Só no estado gravado para retomar
+    
+    for (const auto& entry : layerList->items) {
+        const JsonValue* inSize = entry.get("inputSize");
+        const JsonValue* neurons = entry.get("neurons");
+        const JsonValue* activation = entry.get("activation");
+        const JsonValue* weights = entry.get("weights");
+        if (!inSize || !neurons || !activation || !weights ||
+            weights->type != JsonValue::Array) {
+            return false;
+        }
+        
+        int layerInputs = static_cast<int>(inSize->number);
+        int layerNeurons = static_cast<int>(neurons->number);
+        
+        std::vector<std::vector<double>> matrix;
+        if (!readNumberMatrix(weights, layerInputs, layerNeurons, matrix)) return false;
+        std::vector<double> bias;
+        if (!readNumberArray(entry.get("bias"), bias) ||
+            bias.size() != static_cast<size_t>(layerNeurons)) {
+            return false;
+        }
+        
+        if (const JsonValue* weightVelocity = entry.get("weightVelocity")) {
+            std::vector<std::vector<double>> velocityMatrix;
+            std::vector<double> biasVelocity;
+            if (!readNumberMatrix(weightVelocity, layerInputs, layerNeurons, velocityMatrix) ||
+                !readNumberArray(entry.get("biasVelocity"), biasVelocity) ||
+                biasVelocity.size() != static_cast<size_t>(layerNeurons)) {
+                return false;
+            }
+            velocities.emplace_back(std::move(velocityMatrix), std::move(biasVelocity));
+        }
+        
+        const JsonValue* init = entry.get("init");
+        const JsonValue* dropout = entry.get("dropout");
+        const JsonValue* weightDecay = entry.get("weightDecay");
+        if (init || dropout || weightDecay) {
+            LayerConfig config;
+            if (!init || !dropout || !weightDecay || !parseWeightInit(init->text, config.init) ||
+                dropout->type != JsonValue::Number || weightDecay->type != JsonValue::Number) {
+                return false;
+            }
+            config.dropout = dropout->number;
+            config.weightDecay = weightDecay->number;
+            configs.push_back(config);
+        }
+        
+        sizes.emplace_back(layerInputs, layerNeurons);
+        activations.push_back(activation->text);
+        parameters.emplace_back(std::move(matrix), std::move(bias));
+    }
     
-    std::cout << "⚠ Função loadWeights() ainda não implementada completamente." << std::endl;
-    std::cout << "  Para carregar pesos, será necessário implementar parser JSON." << std::endl;
-    std::cout << "  Sugestão: usar biblioteca nlohmann/json ou similar." << std::endl;
+    if (!velocities.empty() && velocities.size() != parameters.size()) return false;
+    if (!configs.empty() && configs.size() != parameters.size()) return false;
+    if (!prepareLayers(sizes, activations, configs)) return false;
+    restoreParameters(parameters);
+    restoreVelocities(velocities);
     
-    return false;
+    if (const JsonValue* hyper = root.get("hyperparameters")) {
+        if (const JsonValue* lr = hyper->get("learningRate")) learningRate = lr->number;
+        if (const JsonValue* m = hyper->get("momentum")) momentum = m->number;
+    }
+    
+    // Seção opcional: arquivos gravados antes dos checkpoints não a possuem
+    if (const JsonValue* training = root.get("training")) {
+        if (const JsonValue* e = training->get("epochs")) completedEpochs = static_cast<int>(e->number);
+        if (const JsonValue* it = training->get("iterations")) trainingIterations = static_cast<int>(it->number);
+        const JsonValue* best = training->get("bestValidationError");
+        bestValidationError = (best && best->type == JsonValue::Number)
+                                  ? best->number
+                                  : std::numeric_limits<double>::infinity();
+        const JsonValue* bestEpoch = training->get("bestEpoch");
+        bestValidationEpoch = bestEpoch ? static_cast<int>(bestEpoch->number) : 0;
+        const JsonValue* stalled = training->get("stalledValidations");
+        stalledValidations = stalled ? static_cast<int>(stalled->number) : 0;
+    }
+    
+    return true;
+}
+
+bool NeuralNetwork::readBinary(std::istream& in) {
+    char magic[4];
+    uint32_t version = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, BINARY_MAGIC, sizeof(magic)) != 0 ||
+        !readPod(in, version) || version < 1 || version > BINARY_VERSION) {
+        return false;
+    }
+    
+    int32_t fileInputSize, fileOutputSize, numLayers, epochs, iterations;
+    double fileLearningRate, fileMomentum, fileBestError;
+    if (!readPod(in, fileInputSize) || !readPod(in, fileOutputSize) || !readPod(in, numLayers) ||
+        !readPod(in, fileLearningRate) || !readPod(in, fileMomentum) ||
+        !readPod(in, epochs) || !readPod(in, iterations) || !readPod(in, fileBestError)) {
+        return false;
+    }
+    int32_t bestEpoch = 0, stalled = 0;
+    uint8_t hasVelocity = 0;
+    if (version >= 2 &&
+        (!readPod(in, bestEpoch) || !readPod(in, stalled) || !readPod(in, hasVelocity))) {
+        return false;
+    }
+    if (fileInputSize != inputSize || fileOutputSize != outputSize || numLayers <= 0) {
+        return false;
+    }
+    
+    std::vector<std::pair<int, int>> sizes;
+    std::vector<std::string> activations;
+    std::vector<LayerConfig> configs;
+    ParameterSnapshot parameters;
+    ParameterSnapshot velocities;
+    
+    for (int32_t l = 0; l < numLayers; ++l) {
+        int32_t layerInputs, layerNeurons;
+        uint8_t nameLength;
+        if (!readPod(in, layerInputs) || !readPod(in, layerNeurons) || !readPod(in, nameLength) ||
+            layerInputs <= 0 || layerNeurons <= 0) {
+            return false;
+        }
+        std::string name(nameLength, '\0');
+        if (!in.read(&name[0], nameLength)) return false;
+        
+        if (version >= 3) {
+            uint8_t init;
+            LayerConfig config;
+            if (!readPod(in, init) || !readPod(in, config.dropout) || !readPod(in, config.weightDecay) ||
+                init > static_cast<uint8_t>(WeightInit::He)) {
+                return false;
+            }
+            config.init = static_cast<WeightInit>(init);
+            configs.push_back(config);
+        }
+        
+        std::vector<std::vector<double>> matrix(layerInputs, std::vector<double>(layerNeurons));
+        for (auto& row : matrix) {
+            if (!in.read(reinterpret_cast<char*>(row.data()), row.size() * sizeof(double))) return false;
+        }
+        std::vector<double> bias(layerNeurons);
+        if (!in.read(reinterpret_cast<char*>(bias.data()), bias.size() * sizeof(double))) return false;
+        
+        if (hasVelocity) {
+            std::vector<std::vector<double>> velocityMatrix(layerInputs, std::vector<double>(layerNeurons));
+            for (auto& row : velocityMatrix) {
+                if (!in.read(reinterpret_cast<char*>(row.data()), row.size() * sizeof(double))) return false;
+            }
+            std::vector<double> biasVelocity(layerNeurons);
+            if (!in.read(reinterpret_cast<char*>(biasVelocity.data()),
+                         biasVelocity.size() * sizeof(double))) {
+                return false;
+            }
+            velocities.emplace_back(std::move(velocityMatrix), std::move(biasVelocity));
+        }
+        
+        sizes.emplace_back(layerInputs, layerNeurons);
+        activations.push_back(name);
+        parameters.emplace_back(std::move(matrix), std::move(bias));
+    }
+    
+    if (!prepareLayers(sizes, activations, configs)) return false;
+    restoreParameters(parameters);
+    restoreVelocities(velocities);
+    
+    learningRate = fileLearningRate;
+    momentum = fileMomentum;
+    completedEpochs = epochs;
+    trainingIterations = iterations;
+    bestValidationError = fileBestError;
+    bestValidationEpoch = bestEpoch;
+    stalledValidations = stalled;
+    return true;
+}
+
+NeuralNetwork::ParameterSnapshot NeuralNetwork::captureParameters() const {
+    ParameterSnapshot snapshot;
+    snapshot.reserve(layers.size());
+    for (const auto& layer : layers) {
+        snapshot.emplace_back(layer->getWeights(), layer->getBias());
+    }
+    return snapshot;
+}
+
+void NeuralNetwork::restoreParameters(const ParameterSnapshot& snapshot) {
+    if (snapshot.size() != layers.size()) {
+        throw std::invalid_argument("Parameter snapshot does not match network layers");
+    }
+    for (size_t l = 0; l < layers.size(); ++l) {
+        layers[l]->setWeights(snapshot[l].first);
+        layers[l]->setBias(snapshot[l].second);
+    }
+}
+
+void NeuralNetwork::restoreVelocities(const ParameterSnapshot& velocities) {
+    for (size_t l = 0; l < layers.size(); ++l) {
+        if (velocities.empty()) {
+            layers[l]->resetVelocity();
+        } else {
+            layers[l]->setVelocity(velocities[l].first, velocities[l].second);
+        }
+    }
+}
+
+std::unique_ptr<NeuralNetwork> NeuralNetwork::clone() const {
+    std::unique_ptr<NeuralNetwork> copy(new NeuralNetwork(*this));
+    for (auto& layer : copy->layers) {
+        layer = std::make_shared<Layer>(*layer);
+    }
+    return copy;
 }
 
 std::string NeuralNetwork::getArchitectureInfo() const {
@@ -323,7 +1292,14 @@ std::string NeuralNetwork::getArchitectureInfo() const {
             oss << "  Oculta " << (i + 1) << ": ";
         }
         oss << layers[i]->getOutputSize() << " neurônios ("
-            << layers[i]->getActivationName() << ")\n";
+            << layers[i]->getActivationName();
+        if (layers[i]->getDropout() > 0.0) {
+            oss << ", dropout " << layers[i]->getDropout();
+        }
+        if (layers[i]->getWeightDecay() > 0.0) {
+            oss << ", L2 " << layers[i]->getWeightDecay();
+        }
+        oss << ")\n";
     }
     
     oss << "  Taxa de aprendizado: " << learningRate << "\n";
@@ -0,0 +1,197 @@
+#include "../include/neuralnetwork/OnlineLearner.h"
+#include <algorithm>
+#include <chrono>
+#include <pthread.h>
+#include <sched.h>
+#include <stdexcept>
+
+OnlineLearner::OnlineLearner(const NeuralNetwork& initial,
+                             const std::vector<std::vector<double>>& baseInputs,
+                             const std::vector<std::vector<double>>& baseTargets,
+                             Publisher publisher,
+                             const OnlineLearningConfig& learningConfig)
+    : config(learningConfig),
+      publish(std::move(publisher)),
+      replayInputs(baseInputs),
+      replayTargets(baseTargets),
+      current(initial.clone()),
+      generation(0),
+      written(0),
+      trainedUpTo(0),
+      stopping(false),
+      recorded(0),
+      dropped(0),
+      rounds(0),
+      accepted(0),
+      validationError(0.0) {
+    if (config.capacity == 0) {
+        throw std::invalid_argument("OnlineLearner: capacity deve ser positiva");
+    }
+    if (config.holdoutEvery < 2) {
+        throw std::invalid_argument("OnlineLearner: holdoutEvery deve ser pelo menos 2");
+    }
+    if (replayInputs.size() != replayTargets.size()) {
+        throw std::invalid_argument("OnlineLearner: conjunto de base com tamanhos diferentes");
+    }
+    sampleInputs.assign(config.capacity, std::vector<double>(initial.getInputSize()));
+    sampleTargets.assign(config.capacity, std::vector<double>(initial.getOutputSize()));
+}
+
+OnlineLearner::~OnlineLearner() {
+    stop();
+}
+
+bool OnlineLearner::record(const std::vector<double>& input, const std::vector<double>& target) {
+    if (input.size() != sampleInputs[0].size() || target.size() != sampleTargets[0].size()) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    std::unique_lock<std::mutex> lock(samplesMutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    size_t slot = static_cast<size_t>(written % config.capacity);
+    std::copy(input.begin(), input.end(), sampleInputs[slot].begin());
+    std::copy(target.begin(), target.end(), sampleTargets[slot].begin());
+    written++;
+    recorded.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void OnlineLearner::start() {
+    if (worker.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = false;
+    }
+    worker = std::thread(&OnlineLearner::run, this);
+}
+
+void OnlineLearner::stop() {
+    if (!worker.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+void OnlineLearner::run() {
+#ifdef SCHED_IDLE
+    if (config.idlePriority) {
+        // Só usa CPU que nenhuma outra thread quer; não precisa de privilégios
+        sched_param param;
+        param.sched_priority = 0;
+        pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+    }
+#endif
+    const std::chrono::duration<double> interval(config.intervalSeconds);
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    while (!wake.wait_for(lock, interval, [this] { return stopping; })) {
+        uint64_t pending;
+        {
+            std::lock_guard<std::mutex> samplesLock(samplesMutex);
+            pending = written - trainedUpTo;
+        }
+        if (pending < config.minNewSamples) {
+            continue;
+        }
+        lock.unlock();
+        trainRound();
+        lock.lock();
+    }
+}
+
+bool OnlineLearner::trainRound() {
+    std::vector<std::vector<double>> trainInputs, trainTargets;
+    std::vector<std::vector<double>> validationInputs, validationTargets;
+    {
+        // Só a cópia do buffer segura o mutex; record() nesse intervalo descarta a amostra
+        std::lock_guard<std::mutex> lock(samplesMutex);
+        uint64_t first = written > config.capacity ? written - config.capacity : 0;
+        for (uint64_t sequence = first; sequence < written; ++sequence) {
+            size_t slot = static_cast<size_t>(sequence % config.capacity);
+            // Separação fixa pelo número de sequência: uma amostra nunca muda de conjunto
+            bool holdout = sequence % config.holdoutEvery == static_cast<uint64_t>(config.holdoutEvery - 1);
+            (holdout ? validationInputs : trainInputs).push_back(sampleInputs[slot]);
+            (holdout ? validationTargets : trainTargets).push_back(sampleTargets[slot]);
+        }
+        trainedUpTo = written;
+    }
+    rounds.fetch_add(1, std::memory_order_relaxed);
+    const size_t corrections = trainInputs.size();
+    if (corrections == 0) {
+        return false;
+    }
+
+    // Base: só as situações que nenhuma correção cobre (nas demais, a correção vale)
+    std::vector<std::vector<double>> anchorInputs, anchorTargets;
+    for (size_t i = 0; i < replayInputs.size(); ++i) {
+        bool superseded = std::find(trainInputs.begin(), trainInputs.end(), replayInputs[i]) != trainInputs.end() ||
+                          std::find(validationInputs.begin(), validationInputs.end(), replayInputs[i]) != validationInputs.end();
+        if (!superseded) {
+            anchorInputs.push_back(replayInputs[i]);
+            anchorTargets.push_back(replayTargets[i]);
+        }
+    }
+    // Base repetida até ter pelo menos o peso das correções: sem isso a rede
+    // esquece as situações que as correções não cobrem
+    for (size_t copies = 0; !anchorInputs.empty() && copies * anchorInputs.size() < corrections; ++copies) {
+        trainInputs.insert(trainInputs.end(), anchorInputs.begin(), anchorInputs.end());
+        trainTargets.insert(trainTargets.end(), anchorTargets.begin(), anchorTargets.end());
+    }
+    validationInputs.insert(validationInputs.end(), anchorInputs.begin(), anchorInputs.end());
+    validationTargets.insert(validationTargets.end(), anchorTargets.begin(), anchorTargets.end());
+
+    // Sombra: treina uma cópia; a rede em uso não é tocada
+    std::unique_ptr<NeuralNetwork> candidate;
+    uint64_t baseGeneration;
+    {
+        std::lock_guard<std::mutex> lock(currentMutex);
+        candidate = current->clone();
+        baseGeneration = generation;
+    }
+    candidate->setLearningRate(config.learningRate);
+    candidate->trainBatch(trainInputs, trainTargets, config.epochs, 1e-6, false);
+
+    double after = candidate->validate(validationInputs, validationTargets, false);
+    double anchorAfter = anchorInputs.empty() ? 0.0 : candidate->validate(anchorInputs, anchorTargets, false);
+    {
+        std::lock_guard<std::mutex> lock(currentMutex);
+        if (generation != baseGeneration) {
+            return false;   // Rede trocada por rebase durante a rodada
+        }
+        double before = current->validate(validationInputs, validationTargets, false);
+        double anchorBefore = anchorInputs.empty() ? 0.0 : current->validate(anchorInputs, anchorTargets, false);
+        if (!(after < before - config.minImprovement) || anchorAfter > anchorBefore + config.maxForgetting) {
+            validationError.store(before, std::memory_order_relaxed);
+            return false;
+        }
+        // Publicação sob o mutex: rebase não intercala entre a checagem e a troca
+        if (publish) {
+            publish(*candidate);
+        }
+        current = std::move(candidate);
+    }
+    accepted.fetch_add(1, std::memory_order_relaxed);
+    validationError.store(after, std::memory_order_relaxed);
+    return true;
+}
+
+void OnlineLearner::rebase(const NeuralNetwork& network) {
+    std::unique_ptr<NeuralNetwork> replacement = network.clone();
+    std::lock_guard<std::mutex> lock(currentMutex);
+    current = std::move(replacement);
+    generation++;
+}
+
+bool OnlineLearner::saveWeights(const std::string& filename) const {
+    std::lock_guard<std::mutex> lock(currentMutex);
+    return current->saveWeights(filename);
+}
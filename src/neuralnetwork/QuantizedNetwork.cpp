@@ -0,0 +1,347 @@
+#include "../include/neuralnetwork/QuantizedNetwork.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+const int INT8_LANES = 16;  // Entradas processadas por iteração do produto escalar
+
+int padToLanes(int n) {
+    return (n + INT8_LANES - 1) / INT8_LANES * INT8_LANES;
+}
+
+/**
+ * Produto escalar int8 x int8 com acumulação em int32.
+ * n precisa ser múltiplo de 16 (as linhas são preenchidas com zeros).
+ */
+int32_t dotInt8(const int8_t* a, const int8_t* b, int n) {
+#if defined(__AVX2__)
+    __m256i acc = _mm256_setzero_si256();
+    for (int i = 0; i < n; i += 16) {
+        __m256i va = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+        __m256i vb = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(va, vb));
+    }
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(sum);
+#elif defined(__SSE2__)
+    __m128i acc = _mm_setzero_si128();
+    for (int i = 0; i < n; i += 16) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        // Extensão de sinal int8 -> int16 (byte duplicado + shift aritmético)
+        __m128i aLo = _mm_srai_epi16(_mm_unpacklo_epi8(va, va), 8);
+        __m128i aHi = _mm_srai_epi16(_mm_unpackhi_epi8(va, va), 8);
+        __m128i bLo = _mm_srai_epi16(_mm_unpacklo_epi8(vb, vb), 8);
+        __m128i bHi = _mm_srai_epi16(_mm_unpackhi_epi8(vb, vb), 8);
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(aLo, bLo));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(aHi, bHi));
+    }
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(acc);
+#else
+    int32_t sum = 0;
+    for (int i = 0; i < n; ++i) {
+        sum += static_cast<int32_t>(a[i]) * static_cast<int32_t>(b[i]);
+    }
+    return sum;
+#endif
+}
+
+int8_t quantize(float value, float scale) {
+    float q = std::round(value / scale);
+    return static_cast<int8_t>(std::max(-127.0f, std::min(127.0f, q)));
+}
+
+double squaredError(const std::vector<double>& output, const std::vector<double>& target) {
+    // Mesma métrica de NeuralNetwork::calculateError: 0.5 * sum((t - o)^2)
+    double error = 0.0;
+    for (size_t i = 0; i < output.size(); ++i) {
+        double diff = target[i] - output[i];
+        error += 0.5 * diff * diff;
+    }
+    return error;
+}
+
+} // namespace
+
+QuantizedNetwork::QuantizedNetwork(const NeuralNetwork& network)
+    : inputSize(network.getInputSize()),
+      outputSize(network.getOutputSize()),
+      calibrated(false) {
+
+    if (network.getLayers().empty()) {
+        throw std::runtime_error("Network not finalized. Call finalize() first.");
+    }
+
+    int widest = 0;
+    for (const auto& source : network.getLayers()) {
+        QuantLayer layer;
+        layer.inputSize = source->getInputSize();
+        layer.neurons = source->getOutputSize();
+        layer.paddedInputs = padToLanes(layer.inputSize);
+        layer.activation = activationFromName(source->getActivationName());
+        layer.inputScale = 1.0f;
+
+        // Transpor [entrada][neurônio] -> [neurônio][entrada] para produtos contíguos
+        const auto& weights = source->getWeights();
+        layer.weights.assign(static_cast<size_t>(layer.neurons) * layer.paddedInputs, 0.0f);
+        float maxAbs = 0.0f;
+        for (int i = 0; i < layer.inputSize; ++i) {
+            for (int j = 0; j < layer.neurons; ++j) {
+                float w = static_cast<float>(weights[i][j]);
+                layer.weights[j * layer.paddedInputs + i] = w;
+                maxAbs = std::max(maxAbs, std::fabs(w));
+            }
+        }
+        layer.bias.assign(source->getBias().begin(), source->getBias().end());
+
+        layer.weightScale = maxAbs > 0.0f ? maxAbs / 127.0f : 1.0f;
+        layer.qweights.resize(layer.weights.size());
+        for (size_t k = 0; k < layer.weights.size(); ++k) {
+            layer.qweights[k] = quantize(layer.weights[k], layer.weightScale);
+        }
+
+        widest = std::max(widest, std::max(layer.paddedInputs, layer.neurons));
+        layers.push_back(std::move(layer));
+    }
+
+    bufferA.assign(widest, 0.0f);
+    bufferB.assign(widest, 0.0f);
+    quantizedInput.assign(widest, 0);
+}
+
+QuantizedNetwork::Activation QuantizedNetwork::activationFromName(const std::string& name) {
+    if (name == "Sigmoid") return Activation::Sigmoid;
+    if (name == "Tanh") return Activation::Tanh;
+    if (name == "ReLU") return Activation::ReLU;
+    if (name == "Linear") return Activation::Linear;
+    throw std::runtime_error("Ativação não suportada na quantização: " + name);
+}
+
+float QuantizedNetwork::activate(Activation activation, float x) {
+    switch (activation) {
+        case Activation::Sigmoid: return 1.0f / (1.0f + std::exp(-x));
+        case Activation::Tanh: return std::tanh(x);
+        case Activation::ReLU: return x > 0.0f ? x : 0.0f;
+        case Activation::Linear: return x;
+    }
+    return x;
+}
+
+void QuantizedNetwork::forwardFloat(const QuantLayer& layer, const float* in, float* out) {
+    for (int j = 0; j < layer.neurons; ++j) {
+        const float* w = &layer.weights[j * layer.paddedInputs];
+        float sum = layer.bias[j];
+        for (int i = 0; i < layer.inputSize; ++i) {
+            sum += w[i] * in[i];
+        }
+        out[j] = activate(layer.activation, sum);
+    }
+}
+
+void QuantizedNetwork::calibrate(const Dataset& data) {
+    std::vector<float> maxAbs(layers.size(), 0.0f);
+    std::vector<double> input, target;
+
+    for (size_t s = 0; s < data.size(); ++s) {
+        data.getSample(s, input, target);
+
+        // Forward em float registrando o maior valor absoluto na entrada de cada camada
+        std::fill(bufferA.begin(), bufferA.end(), 0.0f);
+        for (int i = 0; i < inputSize; ++i) bufferA[i] = static_cast<float>(input[i]);
+        float* in = bufferA.data();
+        float* out = bufferB.data();
+
+        for (size_t l = 0; l < layers.size(); ++l) {
+            const QuantLayer& layer = layers[l];
+            for (int i = 0; i < layer.inputSize; ++i) {
+                maxAbs[l] = std::max(maxAbs[l], std::fabs(in[i]));
+            }
+            forwardFloat(layer, in, out);
+            std::swap(in, out);
+        }
+    }
+
+    for (size_t l = 0; l < layers.size(); ++l) {
+        layers[l].inputScale = maxAbs[l] > 0.0f ? maxAbs[l] / 127.0f : 1.0f;
+    }
+    calibrated = true;
+}
+
+std::vector<double> QuantizedNetwork::predictFloat(const std::vector<double>& input) {
+    if (input.size() != static_cast<size_t>(inputSize)) {
+        throw std::invalid_argument(
+            "Input size mismatch. Expected " + std::to_string(inputSize) +
+            " but got " + std::to_string(input.size())
+        );
+    }
+
+    for (int i = 0; i < inputSize; ++i) bufferA[i] = static_cast<float>(input[i]);
+    float* in = bufferA.data();
+    float* out = bufferB.data();
+
+    for (const QuantLayer& layer : layers) {
+        forwardFloat(layer, in, out);
+        std::swap(in, out);
+    }
+
+    return std::vector<double>(in, in + outputSize);
+}
+
+std::vector<double> QuantizedNetwork::predictInt8(const std::vector<double>& input) {
+    if (!calibrated) {
+        throw std::runtime_error("Quantized network not calibrated. Call calibrate() first.");
+    }
+    if (input.size() != static_cast<size_t>(inputSize)) {
+        throw std::invalid_argument(
+            "Input size mismatch. Expected " + std::to_string(inputSize) +
+            " but got " + std::to_string(input.size())
+        );
+    }
+
+    for (int i = 0; i < inputSize; ++i) bufferA[i] = static_cast<float>(input[i]);
+    float* in = bufferA.data();
+    float* out = bufferB.data();
+
+    for (const QuantLayer& layer : layers) {
+        // Quantizar a entrada da camada (preenchimento com zeros até múltiplo de 16)
+        for (int i = 0; i < layer.inputSize; ++i) {
+            quantizedInput[i] = quantize(in[i], layer.inputScale);
+        }
+        std::fill(quantizedInput.begin() + layer.inputSize,
+                  quantizedInput.begin() + layer.paddedInputs, 0);
+
+        float rescale = layer.weightScale * layer.inputScale;
+        for (int j = 0; j < layer.neurons; ++j) {
+            int32_t acc = dotInt8(&layer.qweights[j * layer.paddedInputs],
+                                  quantizedInput.data(), layer.paddedInputs);
+            out[j] = activate(layer.activation, acc * rescale + layer.bias[j]);
+        }
+        std::swap(in, out);
+    }
+
+    return std::vector<double>(in, in + outputSize);
+}
+
+size_t QuantizedNetwork::getFloatWeightBytes() const {
+    size_t bytes = 0;
+    for (const QuantLayer& layer : layers) {
+        bytes += (static_cast<size_t>(layer.inputSize) * layer.neurons + layer.neurons) * sizeof(float);
+    }
+    return bytes;
+}
+
+size_t QuantizedNetwork::getInt8WeightBytes() const {
+    size_t bytes = 0;
+    for (const QuantLayer& layer : layers) {
+        // Pesos int8 + bias float + duas escalas por camada
+        bytes += static_cast<size_t>(layer.inputSize) * layer.neurons +
+                 layer.neurons * sizeof(float) + 2 * sizeof(float);
+    }
+    return bytes;
+}
+
+QuantizationReport compareQuantization(NeuralNetwork& reference,
+                                       QuantizedNetwork& quantized,
+                                       const Dataset& data,
+                                       int repetitions) {
+    QuantizationReport report;
+    report.samples = data.size();
+    if (data.size() == 0) {
+        return report;
+    }
+
+    // Carregar o conjunto uma vez para não medir leitura de disco
+    std::vector<std::vector<double>> inputs(data.size()), targets(data.size());
+    for (size_t s = 0; s < data.size(); ++s) {
+        data.getSample(s, inputs[s], targets[s]);
+    }
+
+    // Precisão
+    for (size_t s = 0; s < inputs.size(); ++s) {
+        std::vector<double> expected = reference.predict(inputs[s]);
+        std::vector<double> asFloat = quantized.predictFloat(inputs[s]);
+        std::vector<double> asInt8 = quantized.predictInt8(inputs[s]);
+
+        report.mseDouble += squaredError(expected, targets[s]);
+        report.mseFloat += squaredError(asFloat, targets[s]);
+        report.mseInt8 += squaredError(asInt8, targets[s]);
+
+        for (size_t k = 0; k < expected.size(); ++k) {
+            report.maxDiffFloat = std::max(report.maxDiffFloat, std::fabs(asFloat[k] - expected[k]));
+            report.maxDiffInt8 = std::max(report.maxDiffInt8, std::fabs(asInt8[k] - expected[k]));
+        }
+    }
+    report.mseDouble /= inputs.size();
+    report.mseFloat /= inputs.size();
+    report.mseInt8 /= inputs.size();
+
+    // Velocidade: média de várias passadas pelo conjunto
+    typedef std::chrono::steady_clock Clock;
+    volatile double sink = 0.0;
+    double evaluations = static_cast<double>(repetitions) * inputs.size();
+
+    Clock::time_point start = Clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        for (const auto& input : inputs) sink = sink + reference.predict(input)[0];
+    }
+    report.nsDouble = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / evaluations;
+
+    start = Clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        for (const auto& input : inputs) sink = sink + quantized.predictFloat(input)[0];
+    }
+    report.nsFloat = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / evaluations;
+
+    start = Clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        for (const auto& input : inputs) sink = sink + quantized.predictInt8(input)[0];
+    }
+    report.nsInt8 = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / evaluations;
+
+    for (const auto& layer : reference.getLayers()) {
+        report.bytesDouble += (static_cast<size_t>(layer->getInputSize()) * layer->getOutputSize() +
+                               layer->getOutputSize()) * sizeof(double);
+    }
+    report.bytesFloat = quantized.getFloatWeightBytes();
+    report.bytesInt8 = quantized.getInt8WeightBytes();
+
+    return report;
+}
+
+void printQuantizationReport(const QuantizationReport& report) {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Precisão x velocidade (" << report.samples << " amostras)" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "  Modo     |   Erro médio |  Máx |Δ|  |  ns/inf | Pesos (bytes)" << std::endl;
+
+    auto row = [](const char* name, double mse, double diff, double ns, size_t bytes) {
+        std::cout << "  " << std::left << std::setw(8) << name << std::right
+                  << " | " << std::fixed << std::setprecision(6) << std::setw(12) << mse
+                  << " | " << std::setw(9) << diff
+                  << " | " << std::setprecision(1) << std::setw(7) << ns
+                  << " | " << bytes << std::endl;
+    };
+    row("double", report.mseDouble, 0.0, report.nsDouble, report.bytesDouble);
+    row("float32", report.mseFloat, report.maxDiffFloat, report.nsFloat, report.bytesFloat);
+    row("int8", report.mseInt8, report.maxDiffInt8, report.nsInt8, report.bytesInt8);
+
+    if (report.nsFloat > 0.0 && report.nsInt8 > 0.0) {
+        std::cout << std::setprecision(2)
+                  << "  Speedup: float32 " << report.nsDouble / report.nsFloat << "x, "
+                  << "int8 " << report.nsDouble / report.nsInt8 << "x" << std::endl;
+    }
+    std::cout << "========================================\n" << std::endl;
+}
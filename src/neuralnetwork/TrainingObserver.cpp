@@ -0,0 +1,221 @@
+#include "../include/neuralnetwork/TrainingObserver.h"
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+const char LOG_MAGIC[4] = {'N', 'N', 'T', 'L'};
+const uint32_t LOG_VERSION = 1;
+
+template<typename T>
+void writePod(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+bool readPod(std::istream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+std::string formatDuration(double seconds) {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(3);
+    if (seconds < 1.0) {
+        text << seconds * 1000.0 << " ms";
+    } else {
+        text << seconds << " s";
+    }
+    return text.str();
+}
+
+bool hasBinaryExtension(const std::string& filename) {
+    return filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".bin") == 0;
+}
+
+} // namespace
+
+const char* stopReasonName(StopReason reason) {
+    switch (reason) {
+        case StopReason::MaxEpochs: return "máximo de épocas";
+        case StopReason::Converged: return "convergência";
+        case StopReason::EarlyStopped: return "early stopping";
+    }
+    return "?";
+}
+
+// ===== ConsoleTrainingObserver =====
+
+ConsoleTrainingObserver::ConsoleTrainingObserver(int interval)
+    : interval(interval > 0 ? interval : 1000) {
+}
+
+void ConsoleTrainingObserver::onTrainingBegin(const TrainingStart& start) {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Iniciando treinamento da rede neural" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "Padrões de treinamento: " << start.samples << std::endl;
+    std::cout << "Épocas máximas: " << start.maxEpochs << std::endl;
+    std::cout << "Limiar de erro: " << start.errorThreshold << std::endl;
+    if (start.validationSamples > 0) {
+        std::cout << "Validação: " << start.validationSamples
+                  << " padrões a cada " << start.validationInterval
+                  << " épocas (paciência " << start.patience << ")" << std::endl;
+    }
+    std::cout << start.architecture << std::endl;
+    std::cout << "========================================\n" << std::endl;
+}
+
+void ConsoleTrainingObserver::onEpochEnd(const EpochStats& stats) {
+    if (stats.epoch % interval != 0 && stats.epoch != 1) {
+        return;
+    }
+    std::cout << std::fixed << std::setprecision(6);
+    std::cout << "Época " << std::setw(6) << stats.epoch
+              << " | Erro médio: " << stats.trainingError;
+    if (stats.validated()) {
+        std::cout << " | Validação: " << stats.validationError;
+    }
+    std::cout << std::endl;
+}
+
+void ConsoleTrainingObserver::onTrainingEnd(const TrainingEnd& end) {
+    if (end.reason == StopReason::EarlyStopped) {
+        std::cout << "\n⏹ Early stopping na época " << end.lastEpoch
+                  << " (sem melhora na validação há "
+                  << end.stalledValidations << " validações)" << std::endl;
+        std::cout << "  Melhor erro de validação: " << end.bestValidationError << std::endl;
+    } else if (end.reason == StopReason::Converged) {
+        std::cout << "\n✓ Convergência alcançada na época " << end.lastEpoch << std::endl;
+        std::cout << "  Erro final: " << end.finalError << std::endl;
+    }
+    if (end.restoredBest) {
+        std::cout << "↺ Pesos restaurados para o melhor modelo de validação" << std::endl;
+    }
+    if (end.reason == StopReason::MaxEpochs) {
+        std::cout << "\n⚠ Número máximo de épocas atingido" << std::endl;
+    }
+
+    // Onde o tempo foi gasto: "outros" = embaralhamento, observadores, restauração
+    double other = end.seconds - end.trainSeconds - end.validationSeconds;
+    std::cout << "\nTempo: " << formatDuration(end.seconds)
+              << " (treino " << formatDuration(end.trainSeconds)
+              << ", validação " << formatDuration(end.validationSeconds)
+              << ", outros " << formatDuration(other > 0.0 ? other : 0.0) << ")";
+    if (end.trainSeconds > 0.0 && end.epochsTrained > 0) {
+        std::cout << std::fixed << std::setprecision(0) << " | "
+                  << end.samples * static_cast<double>(end.epochsTrained) / end.trainSeconds
+                  << " amostras/s" << std::setprecision(6);
+    }
+    std::cout << std::endl;
+
+    std::cout << "\nTreinamento concluído." << std::endl;
+    std::cout << "========================================\n" << std::endl;
+}
+
+// ===== TrainingHistory =====
+
+void TrainingHistory::onTrainingBegin(const TrainingStart& start) {
+    (void)start;
+    finished = false;
+}
+
+void TrainingHistory::onEpochEnd(const EpochStats& stats) {
+    epochs.push_back(stats);
+}
+
+void TrainingHistory::onTrainingEnd(const TrainingEnd& trainingEnd) {
+    end = trainingEnd;
+    finished = true;
+}
+
+// ===== CsvTrainingLog =====
+
+CsvTrainingLog::CsvTrainingLog(const std::string& filename)
+    : out(filename, std::ios::trunc) {
+    if (!out.is_open()) {
+        throw std::runtime_error("Não foi possível criar o log de treinamento: " + filename);
+    }
+    out << "epoch,training_error,validation_error,gradient_norm,learning_rate,samples,"
+           "samples_per_second,train_seconds,validation_seconds,elapsed_seconds\n";
+    out << std::setprecision(9);
+}
+
+void CsvTrainingLog::onEpochEnd(const EpochStats& stats) {
+    out << stats.epoch << ',' << stats.trainingError << ',';
+    if (stats.validated()) {
+        out << stats.validationError;
+    }
+    out << ',' << stats.gradientNorm << ',' << stats.learningRate << ',' << stats.samples
+        << ',' << stats.samplesPerSecond() << ',' << stats.trainSeconds
+        << ',' << stats.validationSeconds << ',' << stats.elapsedSeconds << '\n';
+}
+
+void CsvTrainingLog::onTrainingEnd(const TrainingEnd& end) {
+    (void)end;
+    out.flush();
+}
+
+// ===== BinaryTrainingLog =====
+
+BinaryTrainingLog::BinaryTrainingLog(const std::string& filename)
+    : out(filename, std::ios::binary | std::ios::trunc) {
+    if (!out.is_open()) {
+        throw std::runtime_error("Não foi possível criar o log de treinamento: " + filename);
+    }
+    out.write(LOG_MAGIC, sizeof(LOG_MAGIC));
+    writePod(out, LOG_VERSION);
+}
+
+void BinaryTrainingLog::onEpochEnd(const EpochStats& stats) {
+    writePod(out, static_cast<int64_t>(stats.epoch));
+    writePod(out, static_cast<uint64_t>(stats.samples));
+    writePod(out, stats.trainingError);
+    writePod(out, stats.validationError);
+    writePod(out, stats.gradientNorm);
+    writePod(out, stats.learningRate);
+    writePod(out, stats.trainSeconds);
+    writePod(out, stats.validationSeconds);
+    writePod(out, stats.elapsedSeconds);
+}
+
+void BinaryTrainingLog::onTrainingEnd(const TrainingEnd& end) {
+    (void)end;
+    out.flush();
+}
+
+std::vector<EpochStats> BinaryTrainingLog::read(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    char magic[4];
+    uint32_t version = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, LOG_MAGIC, sizeof(magic)) != 0 ||
+        !readPod(in, version) || version != LOG_VERSION) {
+        throw std::runtime_error("Log de treinamento inválido: " + filename);
+    }
+    std::vector<EpochStats> epochs;
+    int64_t epoch;
+    while (readPod(in, epoch)) {
+        EpochStats stats;
+        uint64_t samples = 0;
+        stats.epoch = static_cast<int>(epoch);
+        if (!readPod(in, samples) || !readPod(in, stats.trainingError) ||
+            !readPod(in, stats.validationError) || !readPod(in, stats.gradientNorm) ||
+            !readPod(in, stats.learningRate) || !readPod(in, stats.trainSeconds) ||
+            !readPod(in, stats.validationSeconds) || !readPod(in, stats.elapsedSeconds)) {
+            throw std::runtime_error("Log de treinamento truncado: " + filename);
+        }
+        stats.samples = static_cast<std::size_t>(samples);
+        epochs.push_back(stats);
+    }
+    return epochs;
+}
+
+std::unique_ptr<TrainingObserver> openTrainingLog(const std::string& filename) {
+    if (hasBinaryExtension(filename)) {
+        return std::unique_ptr<TrainingObserver>(new BinaryTrainingLog(filename));
+    }
+    return std::unique_ptr<TrainingObserver>(new CsvTrainingLog(filename));
+}
@@ -14,10 +14,49 @@
 
 #include "neuralnetwork/NeuralNetwork.h"
 #include "neuralnetwork/ActivationFunction.h"
+#include "neuralnetwork/QuantizedNetwork.h"
+#include "neuralnetwork/FixedNetwork.h"
+#include "neuralnetwork/InferenceServer.h"
+#include "neuralnetwork/OnlineLearner.h"
+#include "neuralnetwork/ModelHandle.h"
+#include "neuralnetwork/HyperparameterSearch.h"
+#include "LatencyTracer.h"
+#include "AsyncLogger.h"
+#include "PeriodicScheduler.h"
+#include "BehaviorArbiter.h"
+#include "Behaviors.h"
+#include "MotionQueue.h"
+#include "navigation/OccupancyGrid.h"
+#include "navigation/DwaPlanner.h"
+#include "navigation/AStarPlanner.h"
+#include "navigation/DStarLite.h"
+#include "navigation/GlobalNavigator.h"
+#include "navigation/LikelihoodField.h"
+#include "navigation/ParticleFilter.h"
+#include "WorkerPool.h"
+#include "MockRobot.h"
+#include "FleetSupervisor.h"
+#include "Telemetry.h"
+#include "ControlEncoding.h"
+#include <sstream>
+#include <algorithm>
+#include <initializer_list>
 #include <iostream>
 #include <vector>
 #include <cassert>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <memory>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 
 // Função auxiliar para comparar doubles
 bool approximately_equal(double a, double b, double epsilon = 0.1) {
@@ -249,7 +288,2367 @@ bool test_weight_saving() {
     }
 }
 
+// Teste 7: Carregamento de pesos (JSON e binário) e checkpoint com early stopping
+bool test_weight_loading_and_checkpoint() {
+    std::cout << "\n[TEST 7] Carregamento de pesos e checkpoint..." << std::endl;
+    
+    try {
+        std::vector<std::vector<double>> inputs = {
+            {1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 0}
+        };
+        std::vector<std::vector<double>> targets = {{0.53}, {0.59}, {0.65}, {0.77}};
+        
+        NeuralNetwork network(4, 1, 0.3, 0.9);
+        network.addHiddenLayer(5, std::make_shared<SigmoidActivation>());
+        network.finalize(std::make_shared<SigmoidActivation>());
+        
+        // Early stopping: paciência curta força parada antes do máximo de épocas
+        EarlyStoppingConfig config;
+        config.validationInputs = &inputs;
+        config.validationTargets = &targets;
+        config.validationInterval = 10;
+        config.patience = 3;
+        config.minDelta = 1.0;  // Nenhuma melhora é suficiente após a primeira validação
+        config.checkpointFile = "test_checkpoint_temp.bin";
+        
+        int epochs = network.trainBatch(inputs, targets, 100000, 0.0, false, config);
+        bool stoppedEarly = epochs <= 40;
+        
+        // Checkpoint guarda o melhor modelo (primeira validação, época 10)
+        NeuralNetwork resumed(4, 1);
+        bool checkpointLoaded = resumed.loadWeights(config.checkpointFile) &&
+                                resumed.getCompletedEpochs() == 10;
+        std::remove("test_checkpoint_temp.bin");
+        
+        // Ida e volta em JSON e binário deve reproduzir as mesmas saídas
+        network.saveWeights("test_weights_temp.json");
+        network.saveWeights("test_weights_temp.bin");
+        
+        NeuralNetwork fromJson(4, 1);
+        NeuralNetwork fromBinary(4, 1);
+        bool loaded = fromJson.loadWeights("test_weights_temp.json") &&
+                      fromBinary.loadWeights("test_weights_temp.bin");
+        std::remove("test_weights_temp.json");
+        std::remove("test_weights_temp.bin");
+        
+        bool identical = loaded;
+        for (size_t i = 0; loaded && i < inputs.size(); ++i) {
+            double expected = network.predict(inputs[i])[0];
+            identical = identical &&
+                        fromJson.predict(inputs[i])[0] == expected &&
+                        fromBinary.predict(inputs[i])[0] == expected;
+        }
+        
+        // Retomada: 30 épocas interrompidas + retomada até 60 = 60 épocas seguidas
+        // (estado periódico com pesos, momentum e paciência; JSON e binário)
+        auto build = [] {
+            std::unique_ptr<NeuralNetwork> created(new NeuralNetwork(4, 1, 0.3, 0.9));
+            created->setSeed(99);
+            created->addHiddenLayer(5, std::make_shared<SigmoidActivation>());
+            created->finalize(std::make_shared<SigmoidActivation>());
+            return created;
+        };
+        EarlyStoppingConfig periodic;
+        periodic.validationInputs = &inputs;
+        periodic.validationTargets = &targets;
+        periodic.validationInterval = 10;
+        periodic.patience = 0;
+        std::unique_ptr<NeuralNetwork> straight = build();
+        straight->trainBatch(inputs, targets, 60, 0.0, false, periodic);
+        
+        bool resumedSame = true;
+        const char* extensions[] = {".json", ".bin"};
+        for (const char* extension : extensions) {
+            periodic.checkpointFile = std::string("test_best_temp") + extension;
+            periodic.stateFile = std::string("test_state_temp") + extension;
+            periodic.checkpointInterval = 20;
+            periodic.resume = false;
+            build()->trainBatch(inputs, targets, 30, 0.0, false, periodic);
+            
+            std::unique_ptr<NeuralNetwork> continued = build();
+            TrainingHistory history;
+            periodic.resume = true;
+            periodic.observers = {&history};
+            int lastEpoch = continued->trainBatch(inputs, targets, 60, 0.0, false, periodic);
+            periodic.observers.clear();
+            std::remove(periodic.checkpointFile.c_str());
+            std::remove(periodic.stateFile.c_str());
+            
+            resumedSame = resumedSame && lastEpoch == 61 && history.getEnd().epochsTrained == 30 &&
+                          continued->getBestValidationEpoch() == straight->getBestValidationEpoch();
+            for (size_t l = 0; l < straight->getLayers().size(); ++l) {
+                const Layer& a = *straight->getLayers()[l];
+                const Layer& b = *continued->getLayers()[l];
+                resumedSame = resumedSame && a.getWeights() == b.getWeights() && a.getBias() == b.getBias() &&
+                              a.getWeightVelocity() == b.getWeightVelocity();
+            }
+        }
+        
+        // Retomada só do estado, sem checkpoint: os pesos da retomada não são o
+        // melhor modelo e não podem ser restaurados como se fossem. O treino
+        // retomado usa alvos deslocados para a validação piorar em relação ao melhor
+        bool stateOnlyKept = false;
+        {
+            EarlyStoppingConfig stateOnly;
+            stateOnly.validationInputs = &inputs;
+            stateOnly.validationTargets = &targets;
+            stateOnly.validationInterval = 10;
+            stateOnly.patience = 0;
+            stateOnly.stateFile = "test_state_only_temp.bin";
+            build()->trainBatch(inputs, targets, 30, 0.0, false, stateOnly);
+            
+            std::vector<std::vector<double>> shifted = targets;
+            for (auto& target : shifted) target[0] = std::min(1.0, target[0] + 0.2);
+            std::unique_ptr<NeuralNetwork> resumed = build();
+            TrainingHistory history;
+            stateOnly.resume = true;
+            stateOnly.minDelta = 1e9;
+            stateOnly.observers = {&history};
+            resumed->trainBatch(inputs, shifted, 60, 0.0, false, stateOnly);
+            std::remove(stateOnly.stateFile.c_str());
+            stateOnlyKept = !history.getEnd().restoredBest &&
+                            resumed->validate(inputs, targets, false) > resumed->getBestValidationError();
+        }
+        
+        std::cout << "  Early stopping na época " << epochs
+                  << (stoppedEarly ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Checkpoint do melhor modelo"
+                  << (checkpointLoaded ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Pesos recarregados (JSON/binário)"
+                  << (identical ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Retomada do estado igual ao treino sem interrupção (JSON/binário)"
+                  << (resumedSame ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Retomada sem checkpoint não restaura pesos sem o melhor erro"
+                  << (stateOnlyKept ? " ✓" : " ✗") << std::endl;
+        
+        return stoppedEarly && checkpointLoaded && identical && resumedSame && stateOnlyKept;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Teste 8: Datasets em disco (CSV e binário colunar) e embaralhamento por blocos
+bool test_streaming_dataset() {
+    std::cout << "\n[TEST 8] Datasets em disco..." << std::endl;
+    
+    try {
+        // CSV com cabeçalho, linha vazia e blocos pequenos para forçar trocas de bloco
+        {
+            std::ofstream csv("test_dataset_temp.csv");
+            csv << "direita,esquerda,frente,tras,acao\n";
+            for (int i = 0; i < 10; ++i) {
+                csv << (i & 1) << "," << ((i >> 1) & 1) << "," << ((i >> 2) & 1) << ",0,"
+                    << (0.5 + i * 0.01) << "\n";
+                if (i == 4) csv << "\n";
+            }
+        }
+        
+        CsvDataset csv("test_dataset_temp.csv", 4, 1, 3);
+        bool csvOk = csv.size() == 10;
+        
+        bool written = BinaryDataset::write("test_dataset_temp.bin", csv);
+        BinaryDataset binary("test_dataset_temp.bin", 3);
+        bool binaryOk = written && binary.size() == 10 && binary.getInputSize() == 4;
+        
+        // Leitura em ordem aleatória por índice deve bater entre os formatos
+        std::vector<double> a, b, ta, tb;
+        for (size_t i : {7u, 0u, 9u, 3u, 4u}) {
+            csv.getSample(i, a, ta);
+            binary.getSample(i, b, tb);
+            csvOk = csvOk && approximately_equal(ta[0], 0.5 + i * 0.01, 1e-9);
+            binaryOk = binaryOk && a == b && approximately_equal(tb[0], ta[0], 1e-6);
+        }
+        
+        // Embaralhamento por blocos precisa ser uma permutação completa
+        BlockShuffler shuffler(10, 3);
+        shuffler.shuffle();
+        std::set<size_t> seen;
+        for (size_t k = 0; k < 10; ++k) seen.insert(shuffler.at(k));
+        bool permutation = seen.size() == 10 && *seen.rbegin() == 9;
+        
+        // Treino direto do arquivo (semente fixa: o erro inicial já é pequeno
+        // e alguns pesos sorteados não melhoram em 500 épocas)
+        NeuralNetwork network(4, 1, 0.3, 0.9);
+        network.setSeed(8);
+        network.addHiddenLayer(5, std::make_shared<SigmoidActivation>());
+        network.finalize(std::make_shared<SigmoidActivation>());
+        double before = network.validate(binary, false);
+        network.trainBatch(binary, 500, 0.0, false);
+        double after = network.validate(binary, false);
+        
+        // Arquivo editado depois da indexação: a linha 6 (amostra 4) perde uma
+        // coluna, com o mesmo tamanho em bytes; a releitura do bloco recusa
+        {
+            std::ofstream edited("test_dataset_temp.csv", std::ios::trunc);
+            edited << "direita,esquerda,frente,tras,acao\n";
+            for (int i = 0; i < 10; ++i) {
+                if (i == 4) {
+                    edited << "0,0,1,0.54  \n\n";
+                    continue;
+                }
+                edited << (i & 1) << "," << ((i >> 1) & 1) << "," << ((i >> 2) & 1) << ",0,"
+                       << (0.5 + i * 0.01) << "\n";
+            }
+        }
+        bool editedRejected = false;
+        try {
+            csv.getSample(9, a, ta);
+            csv.getSample(4, a, ta);
+        } catch (const std::runtime_error& e) {
+            editedRejected = std::string(e.what()).find("linha 6") != std::string::npos;
+        }
+        
+        std::remove("test_dataset_temp.csv");
+        std::remove("test_dataset_temp.bin");
+        
+        std::cout << "  CSV indexado" << (csvOk ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Binário colunar" << (binaryOk ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Permutação por blocos" << (permutation ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Erro " << before << " -> " << after
+                  << (after < before ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Linha alterada após a indexação rejeitada" << (editedRejected ? " ✓" : " ✗") << std::endl;
+        
+        return csvOk && binaryOk && permutation && after < before && editedRejected;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Teste 9: Dataset compacto (matriz float32 contígua)
+bool test_matrix_dataset() {
+    std::cout << "\n[TEST 9] Dataset compacto float32..." << std::endl;
+    
+    try {
+        std::vector<std::vector<double>> inputs = {
+            {1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}, {0, 0, 0, 0}
+        };
+        std::vector<std::vector<double>> targets = {{0.53}, {0.59}, {0.65}, {0.71}, {0.77}};
+        
+        FloatDataset data = FloatDataset::fromVectors(inputs, targets);
+        
+        // Linhas contíguas e alinhadas: 4 floats = 16 bytes por linha
+        bool layout = data.size() == 5 && data.getStride() == 4 &&
+                      reinterpret_cast<uintptr_t>(data.getRow(0)) % FloatDataset::ALIGNMENT == 0 &&
+                      data.getRow(1) == data.getRow(0) + 4;
+        
+        // Mini-batch com memcpy por linha
+        size_t indices[2] = {3, 1};
+        std::vector<float> batchFeatures(2 * data.getStride());
+        std::vector<float> batchTargets(2);
+        data.gatherBatch(indices, 2, batchFeatures.data(), batchTargets.data());
+        bool gathered = batchFeatures[3] == 1.0f && batchFeatures[4 + 1] == 1.0f &&
+                        batchTargets[0] == 0.71f && batchTargets[1] == 0.59f;
+        
+        // Leitura em lote usada pelo treino/avaliação (float -> double)
+        std::vector<double> readInputs(2 * 4), readTargets(2);
+        data.readBatch(indices, 2, readInputs.data(), readTargets.data());
+        bool read = readInputs[3] == 1.0 && readInputs[4 + 1] == 1.0 &&
+                    readTargets[0] == static_cast<double>(0.71f) &&
+                    reinterpret_cast<uintptr_t>(data.getTarget(0)) % FloatDataset::ALIGNMENT == 0;
+        
+        // Aceito pelas mesmas entradas de treino/validação
+        NeuralNetwork network(4, 1, 0.3, 0.9);
+        network.addHiddenLayer(5, std::make_shared<SigmoidActivation>());
+        network.finalize(std::make_shared<SigmoidActivation>());
+        double before = network.validate(data, false);
+        network.trainBatch(data, 2000, 0.0, false);
+        double after = network.validate(data, false);
+        
+        std::cout << "  Layout contíguo/alinhado" << (layout ? " ✓" : " ✗") << std::endl;
+        std::cout << "  gatherBatch" << (gathered ? " ✓" : " ✗") << std::endl;
+        std::cout << "  readBatch" << (read ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Erro " << before << " -> " << after
+                  << (after < before ? " ✓" : " ✗") << std::endl;
+        
+        return layout && gathered && read && after < before;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Teste 10: Inferência quantizada (float32 / int8)
+bool test_quantized_inference() {
+    std::cout << "\n[TEST 10] Inferência float32 e int8..." << std::endl;
+    
+    try {
+        std::vector<std::vector<double>> inputs = {
+            {1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1},
+            {1, 1, 0, 0}, {1, 1, 1, 1}, {0, 0, 0, 0}
+        };
+        std::vector<std::vector<double>> targets = {
+            {0.53}, {0.59}, {0.65}, {0.71}, {0.53}, {0.65}, {0.77}
+        };
+        
+        NeuralNetwork network(4, 1, 0.3, 0.9);
+        network.addHiddenLayer(5, std::make_shared<SigmoidActivation>());
+        network.finalize(std::make_shared<SigmoidActivation>());
+        network.trainBatch(inputs, targets, 2000, 0.0, false);
+        
+        MemoryDataset data(inputs, targets);
+        QuantizedNetwork quantized(network);
+        quantized.calibrate(data);
+        
+        double maxFloat = 0.0, maxInt8 = 0.0;
+        for (const auto& input : inputs) {
+            double expected = network.predict(input)[0];
+            maxFloat = std::max(maxFloat, std::fabs(quantized.predictFloat(input)[0] - expected));
+            maxInt8 = std::max(maxInt8, std::fabs(quantized.predictInt8(input)[0] - expected));
+        }
+        
+        QuantizationReport report = compareQuantization(network, quantized, data, 10);
+        bool smaller = report.bytesInt8 < report.bytesFloat && report.bytesFloat < report.bytesDouble;
+        
+        std::cout << "  Máx |Δ| float32: " << maxFloat << (maxFloat < 1e-5 ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Máx |Δ| int8:    " << maxInt8 << (maxInt8 < 0.02 ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Pesos " << report.bytesDouble << " -> " << report.bytesFloat
+                  << " -> " << report.bytesInt8 << " bytes" << (smaller ? " ✓" : " ✗") << std::endl;
+        
+        return maxFloat < 1e-5 && maxInt8 < 0.02 && smaller;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Teste 11: Rede de tamanho fixo (caminho de controle do robô)
+bool test_fixed_network() {
+    std::cout << "\n[TEST 11] FixedNetwork<4,5,1>..." << std::endl;
+    
+    try {
+        NeuralNetwork network(4, 1, 0.3, 0.9);
+        network.addHiddenLayer(5, std::make_shared<SigmoidActivation>());
+        network.finalize(std::make_shared<SigmoidActivation>());
+        
+        FixedNetwork<4, 5, 1> fixed(network);
+        
+        // Mesmos pesos e mesma ordem de soma => saída idêntica
+        bool identical = true;
+        for (int mask = 0; mask < 16; ++mask) {
+            std::vector<double> input = {
+                double(mask & 1), double((mask >> 1) & 1), double((mask >> 2) & 1), double((mask >> 3) & 1)
+            };
+            FixedNetwork<4, 5, 1>::Input in = {{input[0], input[1], input[2], input[3]}};
+            if (fixed.predict(in)[0] != network.predict(input)[0]) identical = false;
+        }
+        
+        // Arquitetura diferente deve ser rejeitada
+        bool rejected = false;
+        try {
+            FixedNetwork<4, 6, 1> wrong(network);
+        } catch (const std::invalid_argument&) {
+            rejected = true;
+        }
+        
+        std::cout << "  Saídas idênticas a predict" << (identical ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Arquitetura incompatível rejeitada" << (rejected ? " ✓" : " ✗") << std::endl;
+        
+        return identical && rejected;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Teste 12: Histogramas de latência do laço de controle
+bool test_latency_tracer() {
+    std::cout << "\n[TEST 12] Tracepoints de latência..." << std::endl;
+    
+    try {
+        // 1..1000 us: p50 ~ 500 us, p99 ~ 990 us (erro de bucket <= 6.25%)
+        LatencyHistogram histogram;
+        for (uint64_t us = 1; us <= 1000; ++us) {
+            histogram.record(us * 1000);
+        }
+        double p50 = static_cast<double>(histogram.percentile(50.0));
+        double p99 = static_cast<double>(histogram.percentile(99.0));
+        bool percentiles = histogram.getCount() == 1000 && histogram.getMax() == 1000000 &&
+                           std::fabs(p50 - 500000.0) / 500000.0 < 0.07 &&
+                           std::fabs(p99 - 990000.0) / 990000.0 < 0.07;
+        
+        // Cópia usada pelo dump em segundo plano
+        LatencyHistogram copy;
+        copy.copyFrom(histogram);
+        bool copied = copy.getCount() == 1000 && copy.getMax() == histogram.getMax() &&
+                      copy.percentile(99.0) == histogram.percentile(99.0) &&
+                      copy.getMean() == histogram.getMean();
+        
+        // Um ciclo com duas etapas e um comando no meio
+        LatencyTracer tracer("teste");
+        tracer.attachToCurrentThread();
+        for (int cycle = 0; cycle < 3; ++cycle) {
+            tracer.beginCycle();
+            tracer.tracepoint(TraceStage::SensorRead);
+            LatencyTracer::commandIssued();
+            LatencyTracer::commandIssued();  // Apenas o primeiro comando conta
+            tracer.tracepoint(TraceStage::Action);
+            tracer.endCycle();
+        }
+        LatencyTracer::commandIssued();      // Fora de um ciclo: ignorado
+        bool stages = tracer.getHistogram(TraceStage::SensorRead).getCount() == 3 &&
+                      tracer.getHistogram(TraceStage::Action).getCount() == 3 &&
+                      tracer.getHistogram(TraceStage::SensorToCommand).getCount() == 3 &&
+                      tracer.getHistogram(TraceStage::Cycle).getCount() == 3 &&
+                      tracer.getHistogram(TraceStage::Predict).getCount() == 0;
+        
+        std::cout << "  p50=" << p50 / 1000.0 << " us, p99=" << p99 / 1000.0 << " us"
+                  << (percentiles ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Cópia do histograma" << (copied ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Etapas registradas" << (stages ? " ✓" : " ✗") << std::endl;
+        
+        return percentiles && copied && stages;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Teste 13: Logger assíncrono (fila lock-free, limitação de taxa e amostragem)
+bool test_async_logger() {
+    std::cout << "\n[TEST 13] Logger assíncrono..." << std::endl;
+    
+    try {
+        std::ostringstream out;
+        {
+            AsyncLogger logger(out);
+            logger.log(LogLevel::Info, 0, "Decisão #{} | Saída NN: {} | Ação: {}", 7, 0.6512, "FRENTE");
+            logger.log(LogLevel::Warn, 3, "Front={}", 180);
+            logger.flush();
+        }
+        std::string text = out.str();
+        bool formatted = text.find("Decisão #7 | Saída NN: 0.6512 | Ação: FRENTE") != std::string::npos &&
+                         text.find("AVISO: Front=180 (+3 suprimidas)") != std::string::npos;
+        
+        // 10 ocorrências na mesma janela de 1 s: apenas 3 passam
+        LogSite limited(3, 1);
+        uint32_t suppressed = 0;
+        int admitted = 0;
+        for (int i = 0; i < 10; ++i) {
+            if (limited.admit(suppressed)) admitted++;
+        }
+        
+        // Amostragem 1 a cada 5
+        LogSite sampled(0, 5);
+        int sampledCount = 0;
+        for (int i = 0; i < 10; ++i) {
+            if (sampled.admit(suppressed)) sampledCount++;
+        }
+        
+        // Mensagens abaixo do nível configurado são descartadas na origem
+        std::ostringstream sink;
+        AsyncLogger burst(sink);
+        burst.setLevel(LogLevel::Warn);
+        bool filtered = !burst.isEnabled(LogLevel::Info) && burst.isEnabled(LogLevel::Error);
+        
+        std::cout << "  Formatação na thread de saída" << (formatted ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Limite de taxa: " << admitted << "/10" << (admitted == 3 ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Amostragem: " << sampledCount << "/10" << (sampledCount == 2 ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Filtro por nível" << (filtered ? " ✓" : " ✗") << std::endl;
+        
+        return formatted && admitted == 3 && sampledCount == 2 && filtered;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Teste 14: Escalonador periódico (prazos absolutos e contagem de overruns)
+bool test_periodic_scheduler() {
+    std::cout << "\n[TEST 14] Escalonador periódico..." << std::endl;
+    
+    try {
+        // 20 períodos de 5 ms: o trabalho não desloca a grade de prazos
+        PeriodicTimer timer(200.0);
+        timer.start();
+        uint64_t begin = PeriodicTimer::nowNs();
+        bool allOnTime = true;
+        for (int i = 0; i < 20; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            allOnTime = timer.waitNextPeriod() && allOnTime;
+        }
+        double elapsedMs = (PeriodicTimer::nowNs() - begin) / 1e6;
+        bool grid = elapsedMs >= 99.0 && elapsedMs < 140.0 && timer.getCycles() == 20;
+        
+        // Um ciclo de 12 ms num período de 5 ms: 1 overrun, 2 prazos pulados
+        PeriodicTimer slowCycle(200.0);
+        slowCycle.start();
+        std::this_thread::sleep_for(std::chrono::milliseconds(12));
+        bool late = !slowCycle.waitNextPeriod();
+        bool overrun = late && slowCycle.getOverruns() == 1 && slowCycle.getMissedPeriods() >= 2;
+        
+        // Duas tarefas em frequências diferentes, cada uma na sua thread
+        std::atomic<int> fast(0);
+        std::atomic<int> slow(0);
+        PeriodicScheduler scheduler;
+        scheduler.addTask("rapida", TaskConfig(100.0), [&fast] { fast++; });
+        scheduler.addTask("lenta", TaskConfig(25.0), [&slow] { slow++; });
+        scheduler.start();
+        std::this_thread::sleep_for(std::chrono::milliseconds(400));
+        scheduler.stop();
+        bool rates = fast >= 30 && fast <= 45 && slow >= 7 && slow <= 12 &&
+                     scheduler.getTimer(0).getOverruns() == 0;
+        
+        bool rejected = false;
+        try {
+            PeriodicTimer invalid(0.0);
+        } catch (const std::invalid_argument&) {
+            rejected = true;
+        }
+        
+        std::cout << "  20 períodos de 5 ms em " << elapsedMs << " ms" << (grid ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Overrun detectado (" << slowCycle.getMissedPeriods() << " prazos pulados)"
+                  << (overrun ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Tarefas: " << fast << " ciclos a 100 Hz, " << slow << " a 25 Hz em 400 ms"
+                  << (rates ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Frequência inválida rejeitada" << (rejected ? " ✓" : " ✗") << std::endl;
+        
+        return grid && overrun && rates && rejected;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Comportamento de teste: devolve sempre a mesma proposta
+class FixedBehavior : public Behavior {
+public:
+    FixedBehavior(const char* behaviorName, const Proposal& fixed)
+        : name(behaviorName), proposal(fixed), calls(0) {}
+    
+    Proposal propose(const SensorSnapshot&) override {
+        calls++;
+        return proposal;
+    }
+    const char* getName() const override { return name; }
+    
+    const char* name;
+    Proposal proposal;
+    int calls;
+};
+
+// Teste 15: Arbitragem de comportamentos (subsunção e fusão ponderada)
+bool test_behavior_arbiter() {
+    std::cout << "\n[TEST 15] Arbitragem de comportamentos..." << std::endl;
+    
+    try {
+        SensorSnapshot snapshot;
+        
+        // Subsunção: a primeira proposta ativa (por prioridade) vence
+        FixedBehavior idle("ocioso", Proposal::inactive(MotionCommand::move(50, 50)));
+        FixedBehavior turn("giro", Proposal(MotionCommand::rotate(45, 1, 40)));
+        FixedBehavior cruise("cruzeiro", Proposal(MotionCommand::move(400, 400)));
+        BehaviorArbiter subsumption(ArbitrationMode::Subsumption);
+        subsumption.addBehavior(cruise, 1);
+        subsumption.addBehavior(idle, 10);
+        subsumption.addBehavior(turn, 5);
+        MotionCommand chosen = subsumption.arbitrate(snapshot);
+        bool layered = chosen.kind == MotionCommand::Rotate && chosen.degrees == 45 &&
+                       subsumption.getLastWinner() == &turn &&
+                       idle.calls == 1 && turn.calls == 1 && cruise.calls == 0 &&
+                       subsumption.getWins(1) == 1;
+        
+        // Fusão: Moves ativos combinados por peso * urgência
+        FixedBehavior slow("lento", Proposal(MotionCommand::move(100, 100), 1.0));
+        FixedBehavior veer("curva", Proposal(MotionCommand::move(400, 100), 0.5));
+        BehaviorArbiter fusion(ArbitrationMode::WeightedFusion);
+        fusion.addBehavior(slow, 2, 1.0);
+        fusion.addBehavior(veer, 1, 2.0);
+        MotionCommand blended = fusion.arbitrate(snapshot);
+        bool fused = blended.kind == MotionCommand::Move &&
+                     std::fabs(blended.left - 250.0) < 1e-9 && std::fabs(blended.right - 100.0) < 1e-9;
+        
+        // Manobra discreta de maior prioridade não é combinada
+        slow.proposal = Proposal(MotionCommand::stop());
+        bool stopWins = fusion.arbitrate(snapshot).kind == MotionCommand::Stop;
+        
+        // Ninguém ativo: manter o comando atual
+        BehaviorArbiter empty(ArbitrationMode::Subsumption);
+        empty.addBehavior(idle, 1);
+        bool holds = empty.arbitrate(snapshot).kind == MotionCommand::Hold &&
+                     empty.getLastWinner() == nullptr;
+        
+        // Desvio heurístico: inativo em espaço livre, ativo perto de obstáculos
+        CollisionAvoidanceBehavior avoidance;
+        for (int i = 0; i < 8; ++i) snapshot.sonar[i] = 5000;
+        Proposal open = avoidance.propose(snapshot);
+        snapshot.sonar[3] = snapshot.sonar[4] = 800;
+        Proposal near = avoidance.propose(snapshot);
+        snapshot.headingDone = false;   // Continua decidindo durante a rotação
+        Proposal turning = avoidance.propose(snapshot);
+        snapshot.headingDone = true;
+        snapshot.sonar[3] = 150;
+        Proposal tooClose = avoidance.propose(snapshot);
+        bool heuristic = !open.active && open.command.kind == MotionCommand::Move &&
+                         near.active && near.command.kind == MotionCommand::Rotate && near.command.degrees == 45 &&
+                         turning.active && MotionQueue::sameRotation(turning.command, near.command) &&
+                         tooClose.active && tooClose.command.kind == MotionCommand::Move &&
+                         tooClose.command.left < 0;
+        
+        std::cout << "  Subsunção (camadas inferiores não avaliadas)" << (layered ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Fusão: (" << blended.left << ", " << blended.right << ")" << (fused ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Parada prevalece na fusão" << (stopWins ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Sem comportamento ativo -> Hold" << (holds ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Desvio heurístico como comportamento" << (heuristic ? " ✓" : " ✗") << std::endl;
+        
+        return layered && fused && stopWins && holds && heuristic;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Backend de teste: registra os comandos aplicados e simula o fim da rotação
+class RecordingBackend : public MotionBackend {
+public:
+    RecordingBackend() : headingDone(true) {}
+    
+    void apply(const MotionCommand& command) override {
+        applied.push_back(command);
+        if (command.kind == MotionCommand::Rotate) headingDone = false;
+    }
+    bool isHeadingDone() override { return headingDone; }
+    
+    std::vector<MotionCommand> applied;
+    bool headingDone;
+};
+
+// Teste 16: Fila de movimento (coalescência, preempção e callbacks)
+bool test_motion_queue() {
+    std::cout << "\n[TEST 16] Fila de comandos de movimento..." << std::endl;
+    
+    try {
+        RecordingBackend backend;
+        MotionQueue queue(backend);
+        std::vector<MotionStatus> first, second, moves;
+        MotionCallback recordFirst = [&first](MotionStatus status) { first.push_back(status); };
+        MotionCallback recordSecond = [&second](MotionStatus status) { second.push_back(status); };
+        MotionCallback recordMove = [&moves](MotionStatus status) { moves.push_back(status); };
+        
+        // A mesma rotação pedida a cada ciclo não reinicia o giro
+        for (int cycle = 0; cycle < 5; ++cycle) {
+            queue.submit(MotionCommand::rotate(45, 1, 40), recordFirst);
+            queue.update();
+        }
+        bool coalesced = backend.applied.size() == 1 && queue.getCoalesced() == 4 &&
+                         queue.isRotating() && first.empty();
+        
+        // Moves durante a rotação: apenas o mais novo fica pendente
+        queue.submit(MotionCommand::move(100, 100), recordMove);
+        queue.submit(MotionCommand::move(200, 200), recordMove);
+        bool merged = backend.applied.size() == 1 && queue.hasPending() &&
+                      moves.size() == 1 && moves[0] == MotionStatus::Superseded;
+        
+        // Novo alvo de orientação preempta o anterior (callbacks notificados)
+        queue.submit(MotionCommand::rotate(15, 2, 40), recordSecond);
+        bool preempted = backend.applied.size() == 2 && first.size() == 5 &&
+                         first[0] == MotionStatus::Preempted && queue.getPreempted() == 1;
+        
+        // Fim da rotação: callback de conclusão e Move pendente aplicado
+        backend.headingDone = true;
+        queue.update();
+        bool completed = second.size() == 1 && second[0] == MotionStatus::Completed &&
+                         backend.applied.size() == 3 && backend.applied[2].kind == MotionCommand::Move &&
+                         backend.applied[2].left == 200 && moves.size() == 2 &&
+                         moves[1] == MotionStatus::Completed && !queue.isRotating();
+        
+        // Stop descarta tudo imediatamente
+        queue.submit(MotionCommand::rotate(90, 1, 40), recordFirst);
+        queue.submit(MotionCommand::move(300, 300), recordMove);
+        queue.submit(MotionCommand::stop());
+        bool stopped = backend.applied.back().kind == MotionCommand::Stop &&
+                       first.back() == MotionStatus::Preempted && moves.back() == MotionStatus::Superseded &&
+                       !queue.isRotating() && !queue.hasPending();
+        
+        std::cout << "  Rotação repetida coalescida (" << queue.getCoalesced() << ")" << (coalesced ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Moves pendentes mesclados" << (merged ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Novo alvo preempta a rotação" << (preempted ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Conclusão por callback" << (completed ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Stop preempta tudo" << (stopped ? " ✓" : " ✗") << std::endl;
+        
+        return coalesced && merged && preempted && completed && stopped;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Teste 17: Mapa de ocupação (raios, cones de sonar e consultas de espaço livre)
+bool test_occupancy_grid() {
+    std::cout << "\n[TEST 17] Mapa de ocupação incremental..." << std::endl;
+    
+    try {
+        GridConfig config;
+        OccupancyGrid grid(config);
+        const double res = grid.getResolution();
+        
+        // Dois feixes iguais na mesma varredura: cada célula muda uma vez só
+        ScanPoint twice[2] = {ScanPoint(1000, 25, true), ScanPoint(1000, 25, true)};
+        grid.integrateScan(Pose2D(25, 25, 0), twice, 2);
+        bool once = grid.getLogOdds(1000, 25) == config.hitDelta &&
+                    grid.getLogOdds(500, 25) == config.missDelta;
+        
+        // Parede em x = 1000 vista várias vezes pelo laser
+        std::vector<ScanPoint> wall;
+        for (int y = -500; y <= 500; y += 25) {
+            wall.push_back(ScanPoint(1000, y, true));
+        }
+        for (int scan = 0; scan < 20; ++scan) {
+            grid.integrateScan(Pose2D(25, 25, 0), wall.data(), wall.size());
+        }
+        bool classified = grid.getState(1000, 0) == OccupancyGrid::Occupied &&
+                          grid.getState(500, 0) == OccupancyGrid::Free &&
+                          grid.getState(3000, 3000) == OccupancyGrid::Unknown &&
+                          grid.getProbability(1000, 0) > 0.9 && grid.getProbability(500, 0) < 0.1;
+        bool saturated = grid.getLogOdds(1000, 0) == config.clampMax &&
+                         grid.getLogOdds(500, 0) == config.clampMin;
+        
+        // Espaço livre: parede à frente, lateral desconhecida
+        double ahead = grid.freeDistance(Pose2D(25, 25, 0), 0.0, 3000.0);
+        double side = grid.freeDistance(Pose2D(25, 25, 0), 90.0, 3000.0);
+        double sector = grid.sectorClearance(Pose2D(25, 25, 0), -20.0, 20.0, 3000.0);
+        bool query = std::fabs(ahead - 1000) <= res && side == 3000.0 && sector < 1100.0;
+        
+        // Coordenadas negativas e blocos alocados sob demanda
+        size_t before = grid.getTileCount();
+        grid.integrateRay(-2000, -2000, -2000, -1000, true);
+        grid.integrateRay(-2000, -2000, -2000, -1000, true);
+        bool negative = grid.getState(-2000, -1000) == OccupancyGrid::Occupied &&
+                        grid.getLogOdds(-2000, -1500) < 0 && grid.getTileCount() > before &&
+                        grid.getTileCount() <= 8;
+        
+        // Cones dos sonares frontais com obstáculo a 800 mm
+        OccupancyGrid sonarGrid(config);
+        int sonar[8] = {5000, 5000, 5000, 800, 800, 5000, 5000, 5000};
+        for (int scan = 0; scan < 5; ++scan) {
+            sonarGrid.integrateSonar(Pose2D(0, 0, 0), sonar);
+        }
+        double front = sonarGrid.freeDistance(Pose2D(0, 0, 0), 0.0, 3000.0);
+        double lateral = sonarGrid.freeDistance(Pose2D(0, 0, 0), 90.0, 3000.0);
+        bool cones = front > 800 && front < 1100 && lateral == 3000.0 &&
+                     sonarGrid.getState(1500, 0) == OccupancyGrid::Unknown &&
+                     sonarGrid.getState(75, 1500) == OccupancyGrid::Free;
+        
+        std::cout << "  Uma atualização por célula por varredura" << (once ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Células ocupada/livre/desconhecida" << (classified ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Log-odds saturado em [" << config.clampMin << ", " << config.clampMax << "]"
+                  << (saturated ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Espaço livre: frente " << ahead << " mm, lateral " << side << " mm"
+                  << (query ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Coordenadas negativas (" << grid.getTileCount() << " blocos, "
+                  << grid.getMemoryBytes() << " bytes)" << (negative ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Cones de sonar: frente livre até " << front << " mm" << (cones ? " ✓" : " ✗") << std::endl;
+        
+        return once && classified && saturated && query && negative && cones;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Teste 18: Planejador local DWA (janela dinâmica e verificação de colisão)
+bool test_dwa_planner() {
+    std::cout << "\n[TEST 18] Planejador local DWA..." << std::endl;
+    
+    try {
+        DwaConfig config;
+        DwaPlanner planner(config);
+        
+        // Caminho livre: acelera em linha reta até o limite da janela
+        DwaResult open = planner.plan(500, 0);
+        bool straight = open.valid && open.velocity == std::min(config.maxVelocity, 500 + config.acceleration * config.windowTime) &&
+                        std::fabs(open.rotVelocity) < 1e-9 &&
+                        open.admissible == static_cast<int>(planner.getCandidateCapacity());
+        
+        // Parede a 1 m à frente, aberta à direita: em malha fechada o robô
+        // antecipa, contorna pela direita e nunca encosta na parede
+        std::vector<ScanPoint> wallPoints;
+        for (int y = -200; y <= 2000; y += 50) {
+            wallPoints.push_back(ScanPoint(1000, y, true));
+        }
+        Pose2D pose(0, 0, 0);
+        double v = 500, w = 0, nearest = 1e9, travelled = 0;
+        DwaResult wall;
+        for (int cycle = 0; cycle < 60; ++cycle) {
+            planner.clearObstacles();
+            planner.addScan(pose, wallPoints.data(), wallPoints.size());
+            wall = planner.plan(v, w);
+            v = wall.valid ? wall.velocity : 0.0;
+            w = wall.valid ? wall.rotVelocity : 0.0;
+            const double dt = 0.1;
+            pose.theta += w * dt;
+            pose.x += v * dt * std::cos(pose.theta * 3.14159265 / 180.0);
+            pose.y += v * dt * std::sin(pose.theta * 3.14159265 / 180.0);
+            travelled += v * dt;
+            for (const ScanPoint& p : wallPoints) {
+                nearest = std::min(nearest, std::hypot(p.x - pose.x, p.y - pose.y));
+            }
+        }
+        bool avoided = nearest > config.robotRadius && pose.theta < -30.0 && travelled > 1500.0;
+        
+        // Cercado a 200 mm: nenhuma trajetória admissível
+        planner.clearObstacles();
+        for (int a = 0; a < 360; a += 10) {
+            planner.addObstacle(200 * std::cos(a * 3.14159265 / 180.0), 200 * std::sin(a * 3.14159265 / 180.0));
+        }
+        DwaResult boxed = planner.plan(0, 0);
+        bool trapped = !boxed.valid && boxed.admissible == 0;
+        
+        // Centenas de trajetórias por ciclo com um laser de 181 pontos
+        planner.clearObstacles();
+        std::vector<ScanPoint> scan;
+        for (int a = -90; a <= 90; ++a) {
+            double range = 2000.0 + 500.0 * std::sin(a * 0.1);
+            scan.push_back(ScanPoint(range * std::cos(a * 3.14159265 / 180.0), range * std::sin(a * 3.14159265 / 180.0), true));
+        }
+        planner.addScan(Pose2D(0, 0, 0), scan.data(), scan.size());
+        const int cycles = 50;
+        uint64_t before = planner.getEvaluated();
+        auto start = std::chrono::steady_clock::now();
+        DwaResult fast;
+        for (int i = 0; i < cycles; ++i) {
+            fast = planner.plan(400, 0);
+        }
+        double perCycleUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / cycles;
+        uint64_t perCycle = (planner.getEvaluated() - before) / cycles;
+        bool throughput = fast.valid && perCycle >= 200 && planner.getObstacleCount() == scan.size();
+        
+        // Comportamento: sem obstáculos, Move com as duas rodas para a frente
+        DwaBehavior behavior(config);
+        SensorSnapshot snapshot;
+        for (int i = 0; i < 8; ++i) snapshot.sonar[i] = 5000;
+        snapshot.velocity = 300;
+        Proposal proposal = behavior.propose(snapshot);
+        bool behaves = proposal.active && proposal.command.kind == MotionCommand::Move &&
+                       proposal.command.left > 0 && std::fabs(proposal.command.left - proposal.command.right) < 1e-6;
+        
+        std::cout << "  Caminho livre: v=" << open.velocity << " w=" << open.rotVelocity << (straight ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Parede à frente: desvio para " << pose.theta << "°, menor distância "
+                  << nearest << " mm, " << travelled << " mm percorridos" << (avoided ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Cercado: sem trajetória admissível" << (trapped ? " ✓" : " ✗") << std::endl;
+        std::cout << "  " << perCycle << " trajetórias x " << planner.getObstacleCount() << " obstáculos: "
+                  << perCycleUs << " us/ciclo" << (throughput ? " ✓" : " ✗") << std::endl;
+        std::cout << "  DwaBehavior emite Move" << (behaves ? " ✓" : " ✗") << std::endl;
+        
+        return straight && avoided && trapped && throughput && behaves;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Custo de um caminho 8-conexo; -1 se tiver passo inválido ou célula bloqueada
+float grid_path_cost(const PlanningMap& map, const std::vector<GridCell>& path) {
+    float cost = 0.0f;
+    for (size_t i = 1; i < path.size(); ++i) {
+        int dx = path[i].x - path[i - 1].x;
+        int dy = path[i].y - path[i - 1].y;
+        int dir = -1;
+        for (int d = 0; d < PlanningMap::DIRECTIONS; ++d) {
+            if (PlanningMap::DX[d] == dx && PlanningMap::DY[d] == dy) dir = d;
+        }
+        if (dir < 0 || !map.canMove(path[i - 1].x, path[i - 1].y, dir)) return -1.0f;
+        cost += PlanningMap::COST[dir];
+    }
+    return cost;
+}
+
+// Teste 19: Planejamento global (A* em mapa grande, D* Lite incremental)
+bool test_global_planner() {
+    std::cout << "\n[TEST 19] Planejamento global A* / D* Lite..." << std::endl;
+    
+    try {
+        // Mapa 4000x4000 com paredes de passagem estreita alternada
+        PlanningMap big(4000, 4000);
+        for (int wall = 1; wall <= 3; ++wall) {
+            int x = wall * 1000;
+            int gap = (wall % 2 == 1) ? 3900 : 100;
+            for (int y = 0; y < 4000; ++y) {
+                if (std::abs(y - gap) > 20) big.setBlocked(x, y, true);
+            }
+        }
+        AStarPlanner astar;
+        std::vector<GridCell> path;
+        auto start = std::chrono::steady_clock::now();
+        bool found = astar.plan(big, GridCell(10, 10), GridCell(3990, 3990), path);
+        double firstMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        start = std::chrono::steady_clock::now();
+        found = found && astar.plan(big, GridCell(10, 10), GridCell(3990, 3990), path);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        float bigCost = grid_path_cost(big, path);
+        size_t bigCells = path.size();
+        size_t bigExpanded = astar.getExpanded();
+        bool large = found && path.front() == GridCell(10, 10) && path.back() == GridCell(3990, 3990) &&
+                     bigCost > 0.0f && std::fabs(bigCost - astar.getPathCost()) < 1e-4f * bigCost &&
+                     bigCost >= AStarPlanner::octile(3980, 3980) && ms < 250.0;
+        
+        // JPS x A* simples: mesmo custo ótimo com bem menos expansões
+        PlanningMap blocks(400, 400);
+        for (int i = 0; i < 80; ++i) {
+            int bx = 20 + (i * 97) % 340, by = 20 + (i * 53) % 340, size = 5 + (i * 7) % 30;
+            for (int y = by; y < by + size; ++y) {
+                for (int x = bx; x < bx + size; ++x) blocks.setBlocked(x, y, true);
+            }
+        }
+        AStarPlanner plain(false);
+        std::vector<GridCell> plainPath;
+        bool optimal = astar.plan(blocks, GridCell(2, 2), GridCell(397, 397), path) &&
+                       plain.plan(blocks, GridCell(2, 2), GridCell(397, 397), plainPath) &&
+                       std::fabs(astar.getPathCost() - plain.getPathCost()) < 1e-4f * plain.getPathCost() &&
+                       grid_path_cost(blocks, path) > 0.0f && astar.getExpanded() < plain.getExpanded();
+        size_t jpsExpanded = astar.getExpanded();
+        
+        // Objetivo cercado: sem caminho; segunda busca no mesmo planejador continua correta
+        PlanningMap small(50, 50);
+        for (int i = 20; i <= 30; ++i) {
+            small.setBlocked(i, 20, true); small.setBlocked(i, 30, true);
+            small.setBlocked(20, i, true); small.setBlocked(30, i, true);
+        }
+        bool unreachable = !astar.plan(small, GridCell(0, 0), GridCell(25, 25), path);
+        bool reused = astar.plan(small, GridCell(0, 0), GridCell(10, 0), path) &&
+                      std::fabs(astar.getPathCost() - 10.0f) < 1e-4f;
+        
+        // D* Lite: mesmo custo do A*, e replanejamento incremental após novo obstáculo
+        PlanningMap arena(200, 200);
+        for (int y = 0; y < 150; ++y) arena.setBlocked(100, y, true);
+        DStarLite dstar(arena);
+        dstar.initialize(GridCell(20, 20), GridCell(180, 20));
+        std::vector<GridCell> dpath;
+        bool initial = dstar.computePath(dpath);
+        size_t initialExpanded = dstar.getExpanded();
+        astar.plan(arena, GridCell(20, 20), GridCell(180, 20), path);
+        bool sameCost = initial && std::fabs(grid_path_cost(arena, dpath) - astar.getPathCost()) < 1e-2f;
+        
+        // Robô anda 10 passos; a parede cresce e só deixa passagem na borda do mapa (desvio longo)
+        GridCell robot = dpath[10];
+        dstar.moveStart(robot);
+        for (int y = 150; y < 190; ++y) {
+            dstar.updateCell(100, y, true);
+        }
+        bool replanned = dstar.computePath(dpath);
+        size_t replanExpanded = dstar.getExpanded() - initialExpanded;
+        astar.plan(arena, robot, GridCell(180, 20), path);
+        bool incremental = replanned && dpath.front() == robot &&
+                           std::fabs(grid_path_cost(arena, dpath) - astar.getPathCost()) < 1e-2f &&
+                           replanExpanded < initialExpanded;
+        
+        // Obstáculo pequeno à frente no caminho: correção local, bem mais barata que a busca inicial
+        GridCell ahead = dpath[dpath.size() / 2];
+        size_t beforeLocal = dstar.getExpanded();
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) dstar.updateCell(ahead.x + dx, ahead.y + dy, true);
+        }
+        bool local = dstar.computePath(dpath);
+        size_t localExpanded = dstar.getExpanded() - beforeLocal;
+        astar.plan(arena, robot, GridCell(180, 20), path);
+        local = local && std::fabs(grid_path_cost(arena, dpath) - astar.getPathCost()) < 1e-2f &&
+                localExpanded * 4 < initialExpanded;
+        
+        // Navegador sobre o mapa de ocupação: waypoints contornam a parede
+        OccupancyGrid grid;
+        for (int scan = 0; scan < 5; ++scan) {
+            for (int y = -1500; y <= 1500; y += 25) {
+                grid.integrateRay(0, y, 1500, y, true);
+            }
+        }
+        GlobalNavigator navigator;
+        navigator.setGoal(3000, 0);
+        double bearing = 0.0;
+        bool guided = navigator.update(Pose2D(0, 0, 0), grid, bearing) && navigator.getWaypoints().size() >= 2 &&
+                      std::fabs(bearing) > 20.0;
+        bool arrived = !navigator.update(Pose2D(2900, 0, 0), grid, bearing) && navigator.isGoalReached();
+        
+        std::cout << "  JPS 4000x4000 (3 paredes): " << bigCells << " células, " << bigExpanded
+                  << " expandidas, " << ms << " ms (primeira busca " << firstMs << " ms)"
+                  << (large ? " ✓" : " ✗") << std::endl;
+        std::cout << "  JPS x A* simples (400x400): mesmo custo, " << jpsExpanded << " x "
+                  << plain.getExpanded() << " expansões" << (optimal ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Objetivo cercado sem caminho, planejador reutilizado" << (unreachable && reused ? " ✓" : " ✗") << std::endl;
+        std::cout << "  D* Lite com o custo ótimo do A*" << (sameCost ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Replanejamento incremental: " << replanExpanded << " expansões (inicial "
+                  << initialExpanded << ")" << (incremental ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Obstáculo local no caminho: " << localExpanded << " expansões" << (local ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Navegador: " << navigator.getWaypoints().size() << " waypoints, rumo " << bearing << "°"
+                  << (guided && arrived ? " ✓" : " ✗") << std::endl;
+        
+        return large && optimal && unreachable && reused && sameCost && incremental && local && guided && arrived;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Parede marcada por raios curtos que chegam de dentro (não atravessam outros obstáculos)
+void mark_wall(OccupancyGrid& grid, double x0, double y0, double x1, double y1, double inX, double inY) {
+    double length = std::hypot(x1 - x0, y1 - y0);
+    for (int scan = 0; scan < 5; ++scan) {
+        for (double t = 0.0; t <= length; t += 25.0) {
+            double px = x0 + (x1 - x0) * t / length;
+            double py = y0 + (y1 - y0) * t / length;
+            grid.integrateRay(px + inX, py + inY, px, py, true);
+        }
+    }
+}
+
+// Varredura simulada do laser (-90..90 graus) a partir da pose real, no referencial do robô
+void simulate_scan(const OccupancyGrid& grid, const Pose2D& pose, std::vector<ScanPoint>& points) {
+    points.clear();
+    for (int bearing = -90; bearing <= 90; bearing += 2) {
+        double range = grid.freeDistance(pose, bearing, 5000.0);
+        double angle = bearing * M_PI / 180.0;
+        points.push_back(ScanPoint(range * std::cos(angle), range * std::sin(angle), range < 5000.0));
+    }
+}
+
+// Teste 20: Localização de Monte Carlo (campo de verossimilhança, filtro em paralelo)
+bool test_particle_filter() {
+    std::cout << "\n[TEST 20] Localização de Monte Carlo..." << std::endl;
+    
+    try {
+        // Sala 6 x 4 m com um pilar; gravada e relida como no main
+        OccupancyGrid built;
+        mark_wall(built, -3000, -2000, 3000, -2000, 0, 300);
+        mark_wall(built, -3000, 2000, 3000, 2000, 0, -300);
+        mark_wall(built, -3000, -2000, -3000, 2000, 300, 0);
+        mark_wall(built, 3000, -2000, 3000, 2000, -300, 0);
+        mark_wall(built, 1500, 500, 1900, 500, 0, -300);
+        mark_wall(built, 1500, 900, 1900, 900, 0, 300);
+        mark_wall(built, 1500, 500, 1500, 900, -300, 0);
+        mark_wall(built, 1900, 500, 1900, 900, 300, 0);
+        bool saved = built.save("test_map_temp.grid");
+        OccupancyGrid grid;
+        bool loaded = saved && grid.load("test_map_temp.grid") && grid.getTileCount() == built.getTileCount() &&
+                      grid.getLogOdds(-3000, 0) == built.getLogOdds(-3000, 0) &&
+                      grid.getState(1500, 700) == OccupancyGrid::Occupied;
+        std::remove("test_map_temp.grid");
+        
+        LikelihoodField field(grid);
+        double wallDistance = field.obstacleDistance(-2500, 0);
+        bool fieldOk = std::fabs(wallDistance - 500.0) <= 60.0 &&
+                       field.logLikelihood(-3000, 0) > field.logLikelihood(-2500, 0) &&
+                       field.logLikelihood(50000, 0) == field.getFloor();
+        
+        // Robô percorre a sala; a odometria deriva (5% na translação, 0,5 grau por passo)
+        MclConfig config;
+        config.particles = 2000;
+        config.threads = 4;
+        ParticleFilter filter(field, config);
+        Pose2D truth(-2000, -1000, 20.0);
+        Pose2D odometry = truth;
+        filter.initialize(Pose2D(truth.x + 200, truth.y - 150, truth.theta + 5.0), 300.0, 10.0);
+        std::vector<ScanPoint> scan;
+        for (int step = 0; step < 60; ++step) {
+            double turn = (step % 20 < 10) ? 2.0 : -1.5;
+            Pose2D previousOdometry = odometry;
+            truth.theta += turn;
+            truth.x += 60.0 * std::cos(truth.theta * M_PI / 180.0);
+            truth.y += 60.0 * std::sin(truth.theta * M_PI / 180.0);
+            odometry.theta += turn + 0.5;
+            odometry.x += 63.0 * std::cos(odometry.theta * M_PI / 180.0);
+            odometry.y += 63.0 * std::sin(odometry.theta * M_PI / 180.0);
+            filter.predict(previousOdometry, odometry);
+            simulate_scan(grid, truth, scan);
+            filter.update(scan.data(), scan.size());
+        }
+        Pose2D estimate = filter.estimate();
+        double error = std::hypot(estimate.x - truth.x, estimate.y - truth.y);
+        double headingError = std::fabs(std::remainder(estimate.theta - truth.theta, 360.0));
+        double odometryError = std::hypot(odometry.x - truth.x, odometry.y - truth.y);
+        bool localized = error < 100.0 && headingError < 3.0 && odometryError > 2.0 * error &&
+                         filter.getResamples() > 0;
+        
+        // Atualizações por segundo (predição + pesos com 46 feixes) para 1k-50k partículas
+        bool throughput = true;
+        std::vector<double> rates;
+        const size_t sizes[] = {1000, 10000, 50000};
+        for (size_t particles : sizes) {
+            MclConfig bench;
+            bench.particles = particles;
+            ParticleFilter timed(field, bench);
+            timed.initialize(truth, 100.0, 3.0);
+            const int runs = 20;
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < runs; ++i) {
+                timed.predict(truth, truth);
+                timed.update(scan.data(), scan.size());
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            rates.push_back(runs / seconds);
+            if (particles == 10000 && rates.back() < 10.0) throughput = false;
+        }
+        
+        std::cout << "  Mapa gravado e relido, campo de verossimilhança: parede a " << wallDistance << " mm"
+                  << (loaded && fieldOk ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Erro final: " << error << " mm / " << headingError << "° (odometria: "
+                  << odometryError << " mm), " << filter.getResamples() << " reamostragens"
+                  << (localized ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Atualizações/s (" << ParticleFilter(field).getThreads() << " threads): 1k "
+                  << rates[0] << ", 10k " << rates[1] << ", 50k " << rates[2]
+                  << (throughput ? " ✓" : " ✗") << std::endl;
+        
+        return loaded && fieldOk && localized && throughput;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Rede somente leitura compartilhada entre os robôs da frota (como NeuralCollisionAvoidance::shareNetwork)
+class SharedNetworkBehavior : public Behavior {
+public:
+    explicit SharedNetworkBehavior(std::shared_ptr<const FixedNetwork<4, 5, 1>> weights)
+        : network(std::move(weights)), predictions(0) {}
+    
+    Proposal propose(const SensorSnapshot& snapshot) override {
+        FixedNetwork<4, 5, 1>::Input input = {{
+            snapshot.sonar[0] / 5000.0, snapshot.sonar[7] / 5000.0,
+            std::min(snapshot.sonar[3], snapshot.sonar[4]) / 5000.0, 1.0
+        }};
+        double output = network->predict(input)[0];
+        predictions++;
+        return Proposal::inactive(MotionCommand::move(100.0 * output, 100.0 * output));
+    }
+    const char* getName() const override { return "SharedNetwork"; }
+    
+    std::shared_ptr<const FixedNetwork<4, 5, 1>> network;
+    uint64_t predictions;
+};
+
+// Comportamento lento que detecta ciclos sobrepostos do mesmo robô
+class SlowBehavior : public Behavior {
+public:
+    SlowBehavior() : inside(0), overlaps(0) {}
+    
+    Proposal propose(const SensorSnapshot&) override {
+        if (inside.fetch_add(1) != 0) overlaps++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        inside.fetch_sub(1);
+        return Proposal(MotionCommand::stop());
+    }
+    const char* getName() const override { return "Slow"; }
+    
+    std::atomic<int> inside;
+    std::atomic<int> overlaps;
+};
+
+// Comportamento que lança exceção a cada dois ciclos
+class FlakyBehavior : public Behavior {
+public:
+    FlakyBehavior() : calls(0) {}
+    Proposal propose(const SensorSnapshot&) override {
+        if (calls.fetch_add(1) % 2 == 0) throw std::runtime_error("sensor indisponível");
+        return Proposal(MotionCommand::stop());
+    }
+    const char* getName() const override { return "Flaky"; }
+    
+    std::atomic<int> calls;
+};
+
+// Teste 21: Supervisor de frota (vários robôs num pool fixo de threads)
+bool test_fleet_supervisor() {
+    std::cout << "\n[TEST 21] Supervisor de frota..." << std::endl;
+    
+    try {
+        // Pool: todas as tarefas rodam; exceções são contadas, não derrubam a thread
+        std::atomic<int> counter(0);
+        {
+            WorkerPool pool(2);
+            for (int i = 0; i < 1000; ++i) {
+                pool.submit([&counter] { counter++; });
+            }
+            pool.submit([] { throw std::runtime_error("falha"); });
+            pool.waitIdle();
+            pool.submit([&counter] { counter++; });
+        }
+        bool poolOk = counter.load() == 1001;
+        
+        // 12 robôs simulados numa sala 10 x 10 m, 50 Hz cada, 2 workers
+        NeuralNetwork trained(4, 1, 0.3, 0.9);
+        trained.addHiddenLayer(5, std::make_shared<SigmoidActivation>(), 0.5);
+        trained.finalize(std::make_shared<SigmoidActivation>(), 0.5);
+        std::shared_ptr<const FixedNetwork<4, 5, 1>> weights = std::make_shared<const FixedNetwork<4, 5, 1>>(trained);
+        
+        MockWorld world;
+        world.addRoom(-5000, -5000, 5000, 5000);
+        world.addRoom(-500, -500, 500, 500);
+        const int robots = 12;
+        const double rate = 50.0;
+        std::vector<std::unique_ptr<MockRobot>> mocks;
+        std::vector<SharedNetworkBehavior*> networks;
+        FleetSupervisor fleet(FleetConfig(rate, 2));
+        for (int i = 0; i < robots; ++i) {
+            double angle = i * 30.0;
+            mocks.push_back(std::unique_ptr<MockRobot>(new MockRobot(world,
+                Pose2D(2500 * std::cos(angle * M_PI / 180.0), 2500 * std::sin(angle * M_PI / 180.0), angle + 90.0),
+                1.0 / rate)));
+            FleetMember& member = fleet.addRobot("mock" + std::to_string(i), *mocks.back());
+            member.addBehavior(std::unique_ptr<Behavior>(new CollisionAvoidanceBehavior()), 10);
+            member.addBehavior(std::unique_ptr<Behavior>(new WallFollowerBehavior()), 1);
+            // Proposta sempre inativa: consultada primeiro, nunca vence
+            SharedNetworkBehavior* network = new SharedNetworkBehavior(weights);
+            member.addBehavior(std::unique_ptr<Behavior>(network), 20);
+            networks.push_back(network);
+        }
+        // Um robô lento (50 ms por ciclo a 50 Hz) não pode atrasar os outros
+        MockRobot slowRobot(world, Pose2D(-3000, -3000, 0), 1.0 / rate);
+        SlowBehavior slow;
+        fleet.addRobot("lento", slowRobot).addBehavior(slow, 10);
+        // Um robô cujo ciclo falha continua sendo despachado
+        MockRobot flakyRobot(world, Pose2D(3000, -3000, 0), 1.0 / rate);
+        FlakyBehavior flaky;
+        fleet.addRobot("instável", flakyRobot).addBehavior(flaky, 10);
+        bool sharedWeights = weights.use_count() == robots + 1;
+        
+        bool rejected = false;
+        fleet.start();
+        try {
+            fleet.addRobot("tarde", slowRobot);
+        } catch (const std::logic_error&) {
+            rejected = true;
+        }
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        fleet.stop();
+        
+        const double expected = static_cast<double>(fleet.getDispatchTimer().getCycles());
+        uint64_t minCycles = UINT64_MAX;
+        uint64_t skipped = 0;
+        uint64_t predictions = 0;
+        uint64_t collisions = 0;
+        double distance = 0.0;
+        int stopped = 0;
+        for (int i = 0; i < robots; ++i) {
+            stopped += mocks[i]->getDistanceTravelled() > 0.0 ? 0 : 1;
+            minCycles = std::min(minCycles, fleet.getRobot(i).getCycles());
+            skipped += fleet.getRobot(i).getSkipped();
+            predictions += networks[i]->predictions;
+            collisions += mocks[i]->getCollisions();
+            distance += mocks[i]->getDistanceTravelled();
+        }
+        const FleetMember& slowMember = fleet.getRobot(robots);
+        bool onRate = expected >= 0.8 * rate && minCycles >= 0.9 * expected;
+        bool threads = fleet.getThreadCount() == 3;
+        bool moved = stopped == 0 && predictions >= robots * minCycles;
+        bool isolated = slowMember.getSkipped() > 0 && slow.overlaps.load() == 0 &&
+                        slowMember.getCycles() + slowMember.getSkipped() == static_cast<uint64_t>(expected);
+        const FleetMember& flakyMember = fleet.getRobot(robots + 1);
+        bool recovered = flakyMember.getFailures() > 0 && flakyMember.getCycles() >= 0.4 * expected &&
+                         flakyMember.getCycles() + flakyMember.getFailures() + flakyMember.getSkipped() ==
+                             static_cast<uint64_t>(expected);
+        
+        std::cout << "  Pool: " << counter.load() << " tarefas executadas" << (poolOk ? " ✓" : " ✗") << std::endl;
+        std::cout << "  " << robots << " robôs a " << rate << " Hz em " << fleet.getThreadCount()
+                  << " threads: " << minCycles << "/" << expected << " ciclos (mín.), " << skipped << " pulados"
+                  << (onRate && threads ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Percorrido: " << distance / 1000.0 << " m, " << collisions << " colisões, "
+                  << predictions << " predições" << (moved ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Robô lento: " << slowMember.getCycles() << " ciclos, " << slowMember.getSkipped()
+                  << " pulados, " << slow.overlaps.load() << " sobreposições" << (isolated ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Robô instável: " << flakyMember.getCycles() << " ciclos, " << flakyMember.getFailures()
+                  << " falhas" << (recovered ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Pesos compartilhados por " << robots << " robôs (use_count " << weights.use_count() << ")"
+                  << (sharedWeights && rejected ? " ✓" : " ✗") << std::endl;
+        
+        return poolOk && onRate && threads && moved && isolated && recovered && sharedWeights && rejected;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Custo por decisão (ns) de predict linha a linha e de predictBatch no mesmo lote
+template<class Network>
+void time_batch_inference(const Network& network, size_t rows, double& single, double& batched) {
+    std::vector<typename Network::Input> inputs(rows);
+    std::vector<typename Network::Output> outputs(rows);
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t i = 0; i < Network::INPUTS; ++i) {
+            inputs[r][i] = ((r * 7 + i * 13) % 17) / 17.0;
+        }
+    }
+    const int runs = 2000;
+    double sink = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int k = 0; k < runs; ++k) {
+        for (size_t r = 0; r < rows; ++r) {
+            outputs[r] = network.predict(inputs[r]);
+        }
+        sink += outputs[k % rows][0];
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (int k = 0; k < runs; ++k) {
+        network.predictBatch(inputs.data(), outputs.data(), rows);
+        sink += outputs[k % rows][0];
+    }
+    auto end = std::chrono::steady_clock::now();
+    single = std::chrono::duration<double, std::nano>(middle - start).count() / (runs * rows);
+    batched = std::chrono::duration<double, std::nano>(end - middle).count() / (runs * rows);
+    if (sink == -1.0) std::cout << sink;
+}
+
+// Teste 22: Servidor de inferência em lote (pedidos de vários robôs)
+bool test_inference_server() {
+    std::cout << "\n[TEST 22] Inferência em lote..." << std::endl;
+    
+    try {
+        typedef FixedNetwork<4, 5, 1> Control;
+        typedef FixedNetwork<32, 64, 8> Wide;
+        NeuralNetwork small(4, 1, 0.3, 0.9);
+        small.addHiddenLayer(5, std::make_shared<SigmoidActivation>(), 0.5);
+        small.finalize(std::make_shared<SigmoidActivation>(), 0.5);
+        NeuralNetwork large(32, 8, 0.3, 0.9);
+        large.addHiddenLayer(64, std::make_shared<ReLUActivation>(), 0.5);
+        large.finalize(std::make_shared<SigmoidActivation>(), 0.5);
+        std::shared_ptr<const Control> control = std::make_shared<const Control>(small);
+        Wide wide(large);
+        
+        // predictBatch: mesmos valores de predict, inclusive atravessando blocos de 32 linhas
+        bool identical = true;
+        std::vector<Wide::Input> wideIn(77);
+        std::vector<Wide::Output> wideOut(77);
+        for (size_t r = 0; r < wideIn.size(); ++r) {
+            for (size_t i = 0; i < Wide::INPUTS; ++i) wideIn[r][i] = std::sin(r * 0.37 + i);
+        }
+        wide.predictBatch(wideIn.data(), wideOut.data(), wideIn.size());
+        for (size_t r = 0; r < wideIn.size(); ++r) {
+            if (wide.predict(wideIn[r]) != wideOut[r]) identical = false;
+        }
+        
+        // 16 robôs pedindo ao mesmo tempo, cada um esperando a própria resposta
+        const int clients = 16;
+        const int perClient = 300;
+        std::atomic<int> mismatches(0);
+        uint64_t batches, largest;
+        double meanBatch;
+        {
+            InferenceServer<Control> server(control, InferenceConfig(8, 500.0));
+            std::vector<std::thread> threads;
+            for (int c = 0; c < clients; ++c) {
+                threads.push_back(std::thread([&, c] {
+                    for (int k = 0; k < perClient; ++k) {
+                        Control::Input input = {{(c & 1) * 1.0, (k & 1) * 1.0, ((c + k) % 3) / 2.0, 1.0}};
+                        if (server.predict(input) != control->predict(input)) mismatches++;
+                    }
+                }));
+            }
+            for (std::thread& thread : threads) thread.join();
+            batches = server.getBatches();
+            largest = server.getLargestBatch();
+            meanBatch = server.getMeanBatch();
+        }
+        bool batched = mismatches.load() == 0 && batches < static_cast<uint64_t>(clients * perClient) &&
+                       meanBatch > 1.5 && largest <= 8;
+        
+        // Prazo: um pedido sozinho espera maxDelayUs; um lote cheio sai na hora
+        InferenceServer<Control> lonely(control, InferenceConfig(32, 2000.0));
+        Control::Input one = {{1.0, 0.0, 1.0, 1.0}};
+        auto start = std::chrono::steady_clock::now();
+        lonely.predict(one);
+        double waitedUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        std::vector<std::future<Control::Output>> burst;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < 32; ++i) burst.push_back(lonely.submit(one));
+        for (std::future<Control::Output>& result : burst) result.get();
+        double burstUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        bool deadline = waitedUs >= 1800.0 && waitedUs < 50000.0 && lonely.getFullBatches() == 1 && burstUs < 1800.0;
+        
+        double controlSingle, controlBatch, wideSingle, wideBatch;
+        time_batch_inference(*control, 16, controlSingle, controlBatch);
+        time_batch_inference(wide, 16, wideSingle, wideBatch);
+        
+        std::cout << "  predictBatch igual a predict (77 linhas, rede 32-64-8)" << (identical ? " ✓" : " ✗") << std::endl;
+        std::cout << "  " << clients << " clientes x " << perClient << " pedidos: " << batches << " lotes (média "
+                  << meanBatch << ", maior " << largest << "), " << mismatches.load() << " divergências"
+                  << (batched ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Pedido sozinho: " << waitedUs << " us (prazo 2000 us); lote cheio: " << burstUs << " us"
+                  << (deadline ? " ✓" : " ✗") << std::endl;
+        std::cout << "  ns/decisão, lote de 16: 4-5-1 " << controlSingle << " -> " << controlBatch
+                  << "; 32-64-8 " << wideSingle << " -> " << wideBatch << std::endl;
+        
+        return identical && batched && deadline;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Conecta ao socket da telemetria, envia a requisição (se houver) e lê até o servidor fechar
+std::string read_telemetry(const std::string& path, const std::string& request) {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    std::string response;
+    if (fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0) {
+        if (!request.empty()) {
+            ssize_t sent = ::send(fd, request.data(), request.size(), 0);
+            (void)sent;
+        }
+        char buffer[4096];
+        ssize_t n;
+        while ((n = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+            response.append(buffer, n);
+        }
+    }
+    if (fd >= 0) ::close(fd);
+    return response;
+}
+
+bool test_telemetry() {
+    std::cout << "\n[TEST 23] Telemetria (Prometheus em socket Unix)..." << std::endl;
+    
+    try {
+        Telemetry registry;
+        const int threads = 4;
+        const int perThread = 20000;
+        
+        // Atualizações concorrentes sem mutex: totais exatos
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.push_back(std::thread([&registry, t] {
+                TelemetryCounter& decisions = registry.counter("robot_decisions_total", "Decisões", "action=\"forward\"");
+                TelemetryHistogram& output = registry.histogram("robot_network_output", "Saída", 0.0, 1.0, 4);
+                for (int k = 0; k < perThread; ++k) {
+                    decisions.add();
+                    output.observe((k % 4) * 0.25 + 0.1);
+                }
+                registry.gauge("robot_workers", "Threads").set(t + 1);
+            }));
+        }
+        for (std::thread& worker : workers) worker.join();
+        TelemetryHistogram& output = registry.histogram("robot_network_output", "Saída", 0.0, 1.0, 4);
+        uint64_t decisions = registry.counter("robot_decisions_total", "Decisões", "action=\"forward\"").get();
+        bool exact = decisions == static_cast<uint64_t>(threads * perThread) &&
+                     output.getCount() == decisions && output.getBucketCount(0) == decisions / 4 &&
+                     output.getBucketCount(3) == decisions / 4 &&
+                     std::fabs(output.getSum() - threads * perThread * 0.475) < 1e-3;
+        
+        // Nome inválido e tipo trocado são rejeitados
+        bool rejected = false;
+        try { registry.counter("2bad", ""); } catch (const std::invalid_argument&) { rejected = true; }
+        bool typeChecked = false;
+        try { registry.gauge("robot_decisions_total", ""); } catch (const std::invalid_argument&) { typeChecked = true; }
+        bool escaped = Telemetry::escapeLabel("a\"b\\c\nd") == "a\\\"b\\\\c\\nd";
+        
+        // Latência de um tracer registrado aparece como summary
+        LatencyTracer tracer("telemetria");
+        tracer.beginCycle();
+        tracer.tracepoint(TraceStage::Predict);
+        tracer.endCycle();
+        
+        std::ostringstream text;
+        registry.render(text);
+        std::string rendered = text.str();
+        std::ostringstream expectedCounter;
+        expectedCounter << "robot_decisions_total{action=\"forward\"} " << threads * perThread << "\n";
+        bool format = rendered.find("# TYPE robot_decisions_total counter\n") != std::string::npos &&
+                      rendered.find(expectedCounter.str()) != std::string::npos &&
+                      rendered.find("robot_network_output_bucket{le=\"0.5\"} 40000\n") != std::string::npos &&
+                      rendered.find("robot_network_output_bucket{le=\"+Inf\"} 80000\n") != std::string::npos &&
+                      rendered.find("robot_network_output_count 80000\n") != std::string::npos &&
+                      rendered.find("robot_loop_latency_seconds_count{loop=\"telemetria\",stage=\"predict\"} 1\n") != std::string::npos;
+        
+        // Servidor: leitor simples recebe o texto; GET recebe resposta HTTP
+        std::string path = "/tmp/test_telemetria_" + std::to_string(::getpid()) + ".sock";
+        bool served = false;
+        uint64_t scrapes = 0;
+        {
+            TelemetryServer server(path, registry);
+            if (server.start()) {
+                std::string raw = read_telemetry(path, "");
+                std::string http = read_telemetry(path, "GET /metrics HTTP/1.0\r\n\r\n");
+                scrapes = server.getScrapes();
+                served = raw.compare(0, 7, "# HELP ") == 0 && raw.find(expectedCounter.str()) != std::string::npos &&
+                         http.compare(0, 15, "HTTP/1.0 200 OK") == 0 &&
+                         http.find("version=0.0.4") != std::string::npos &&
+                         http.find(expectedCounter.str()) != std::string::npos && scrapes == 2;
+            } else {
+                std::cout << "  " << server.getError() << std::endl;
+            }
+        }
+        bool removed = ::access(path.c_str(), F_OK) != 0;
+        
+        // Arquivo comum no caminho do socket: recusado e preservado
+        bool preserved = false;
+        {
+            std::ofstream(path) << "dados";
+            TelemetryServer server(path, registry);
+            bool refused = !server.start() && server.getError().find("não é um socket") != std::string::npos;
+            std::ifstream kept(path);
+            std::string contents;
+            std::getline(kept, contents);
+            preserved = refused && contents == "dados";
+            std::remove(path.c_str());
+        }
+        
+        std::cout << "  " << threads << " threads x " << perThread << ": " << decisions << " decisões, "
+                  << output.getCount() << " amostras" << (exact ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Nomes/tipos validados e rótulos escapados" << (rejected && typeChecked && escaped ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Formato texto 0.0.4 (counter, histogram, summary)" << (format ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Socket: " << scrapes << " leituras (texto e HTTP), arquivo removido no stop"
+                  << (served && removed ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Arquivo comum no caminho recusado sem ser apagado" << (preserved ? " ✓" : " ✗") << std::endl;
+        
+        return exact && rejected && typeChecked && escaped && format && served && removed && preserved;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool test_online_learner() {
+    std::cout << "\n[TEST 24] Aprendizado online (rede sombra)..." << std::endl;
+    
+    try {
+        // Conjunto de base do NeuralCollisionAvoidance (livre = 1)
+        std::vector<std::vector<double>> inputs = {
+            {1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1},
+            {0, 0, 1, 1}, {1, 1, 0, 0}, {0, 1, 1, 0}, {1, 0, 0, 1},
+            {1, 0, 1, 0}, {0, 1, 0, 1}, {0, 1, 1, 1}, {1, 0, 1, 1},
+            {1, 1, 0, 1}, {1, 1, 1, 0}, {1, 1, 1, 1}, {0, 0, 0, 0}
+        };
+        std::vector<std::vector<double>> targets = {
+            {0.53}, {0.59}, {0.65}, {0.71}, {0.65}, {0.53}, {0.65}, {0.53},
+            {0.65}, {0.59}, {0.65}, {0.65}, {0.53}, {0.65}, {0.65}, {0.77}
+        };
+        NeuralNetwork network(4, 1, 0.3, 0.9);
+        network.addHiddenLayer(5, std::make_shared<SigmoidActivation>(), 0.5);
+        network.finalize(std::make_shared<SigmoidActivation>(), 0.5);
+        network.trainBatch(inputs, targets, 20000, 0.004, false);
+        
+        // clone(): treinar a cópia não altera a original
+        std::vector<double> blocked = {1, 1, 0, 1};
+        double originalBlocked = network.predict(blocked)[0];
+        double originalFree = network.predict({1, 1, 1, 1})[0];
+        std::unique_ptr<NeuralNetwork> copy = network.clone();
+        copy->trainBatch({blocked}, {{0.77}}, 200, 0.0, false);
+        bool independent = network.predict(blocked)[0] == originalBlocked &&
+                           copy->predict(blocked)[0] != originalBlocked;
+        
+        // Correções do controlador: leituras dos sonares, entrada normalizada e
+        // o comando que chooseAction emite nelas (rede dizendo FRENTE, 0.65)
+        auto labelFor = [](std::initializer_list<int> readings, const MotionCommand& command) {
+            int sonar[8];
+            std::copy(readings.begin(), readings.end(), sonar);
+            return overrideLabelBand(encodeSonarInput(sonar, 600.0), 0.65, command);
+        };
+        MotionCommand turnLeft = MotionCommand::rotate(45, 1, 40), turnRight = MotionCommand::rotate(45, 2, 40);
+        // Um sonar frontal bloqueado, o outro livre: a rede vê frente livre, nada é gravado
+        bool oneFrontBlocked = labelFor({2000, 2000, 2000, 400, 2000, 2000, 2000, 2000}, turnRight) < 0 &&
+                               labelFor({2000, 2000, 2000, 200, 2000, 2000, 2000, 2000}, MotionCommand::stop()) < 0;
+        // Parada de emergência e desvio com os dois lados livres não têm rótulo pela entrada
+        bool unlabeled = labelFor({2000, 2000, 2000, 200, 200, 2000, 2000, 2000}, MotionCommand::stop()) < 0 &&
+                         labelFor({2000, 2000, 2000, 400, 400, 2000, 2000, 2000}, turnRight) < 0 &&
+                         overrideLabelBand({0, 1, 0, 1}, 0.59, turnLeft) < 0;
+        // Frente bloqueada na entrada e lado determinado pelos bits
+        bool labeled = labelFor({300, 300, 300, 400, 400, 2000, 2000, 2000}, turnLeft) == BandLeft &&
+                       labelFor({2000, 2000, 2000, 400, 400, 300, 300, 300}, turnRight) == BandRight &&
+                       labelFor({300, 300, 300, 400, 400, 300, 300, 300},
+                                MotionCommand::move(-75, -75)) == BandBackward;
+        bool overrides = oneFrontBlocked && unlabeled && labeled;
+        
+        // Mecanismo do aprendiz: rótulo fixo para a mesma entrada (frente bloqueada -> PARAR)
+        std::vector<double> stopLabel = {0.77};
+        std::vector<std::shared_ptr<const FixedNetwork<4, 5, 1>>> published;
+        OnlineLearningConfig config;
+        config.intervalSeconds = 0.02;
+        config.minNewSamples = 20;
+        OnlineLearner learner(network, inputs, targets, [&](const NeuralNetwork& improved) {
+            published.push_back(std::make_shared<const FixedNetwork<4, 5, 1>>(improved));
+        }, config);
+        bool validated = !learner.record({1, 1}, stopLabel) && learner.getDropped() == 1;
+        
+        learner.start();
+        std::thread control([&] {
+            for (int k = 0; k < 40; ++k) {
+                learner.record(blocked, stopLabel);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+        control.join();
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+        while (learner.getAccepted() == 0 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        learner.stop();
+        
+        double learnedBlocked = published.empty() ? originalBlocked : published.back()->predict({{1, 1, 0, 1}})[0];
+        double learnedFree = published.empty() ? 0.0 : published.back()->predict({{1, 1, 1, 1}})[0];
+        // Frente bloqueada passa à faixa PARAR; tudo livre não se afasta de FRENTE (0.65)
+        bool learned = learner.getAccepted() >= 1 && published.size() == learner.getAccepted() &&
+                       learner.getRecorded() + learner.getDropped() == 41 &&
+                       learnedBlocked >= 0.74 && learnedBlocked < 0.80 &&
+                       std::fabs(learnedFree - 0.65) <= std::fabs(originalFree - 0.65) + 0.01;
+        
+        // Sem melhora suficiente na validação, nada é publicado
+        config.minImprovement = 1e9;
+        size_t before = published.size();
+        OnlineLearner strict(network, inputs, targets, [&](const NeuralNetwork&) {
+            published.push_back(nullptr);
+        }, config);
+        for (int k = 0; k < 30; ++k) strict.record(blocked, stopLabel);
+        bool gated = !strict.trainRound() && published.size() == before && strict.getRounds() == 1;
+        
+        std::cout << "  clone() independente da original" << (independent ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Só correções explicadas pela entrada viram amostra" << (overrides ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Amostra de tamanho errado descartada" << (validated ? " ✓" : " ✗") << std::endl;
+        std::cout << "  " << learner.getRecorded() << " correções, " << learner.getAccepted() << "/"
+                  << learner.getRounds() << " rodadas publicadas; [1,1,0,1]: " << originalBlocked
+                  << " -> " << learnedBlocked << ", [1,1,1,1]: " << originalFree << " -> " << learnedFree << (learned ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Validação sem melhora não publica" << (gated ? " ✓" : " ✗") << std::endl;
+        
+        return independent && overrides && validated && learned && gated;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
 // Main
+// Modelo de teste: o destrutor invalida o objeto, para uma leitura após a liberação aparecer
+struct VersionedModel {
+    static std::atomic<int> live;
+    static const uint32_t MAGIC = 0x5eed1234;
+    uint64_t value;
+    uint64_t check;
+    uint32_t magic;
+    
+    explicit VersionedModel(uint64_t v) : value(v), check(~v), magic(MAGIC) { live.fetch_add(1); }
+    ~VersionedModel() { magic = 0; check = value; live.fetch_sub(1); }
+};
+std::atomic<int> VersionedModel::live(0);
+
+bool test_model_handle() {
+    std::cout << "\n[TEST 25] Troca atômica de modelo (ModelHandle)..." << std::endl;
+    
+    try {
+        bool slotsOk, pinned, invariants, swapped;
+        uint64_t totalReads = 0;
+        {
+            ModelHandle<VersionedModel> handle(std::make_shared<const VersionedModel>(0), 4);
+            
+            // Slots fixos: o quinto Reader simultâneo é recusado; liberado, volta a caber
+            {
+                ModelHandle<VersionedModel>::Reader r1(handle), r2(handle), r3(handle), r4(handle);
+                bool refused = false;
+                try { ModelHandle<VersionedModel>::Reader r5(handle); } catch (const std::length_error&) { refused = true; }
+                slotsOk = refused;
+            }
+            ModelHandle<VersionedModel>::Reader again(handle);
+            
+            // Leitor dentro da leitura segura a versão antiga até sair
+            const VersionedModel* held = again.enter();
+            handle.publish(std::make_shared<const VersionedModel>(1));
+            pinned = handle.getPending() == 1 && held->magic == VersionedModel::MAGIC && held->value == 0;
+            again.exit();
+            pinned = pinned && handle.collect() == 0 && handle.getReclaimed() == 1 && VersionedModel::live == 1;
+            
+            // Leitores contínuos enquanto outra thread publica 2000 versões
+            const uint64_t versions = 2000;
+            std::atomic<bool> stop(false);
+            std::atomic<int> corrupted(0), regressed(0);
+            std::atomic<uint64_t> reads(0);
+            std::vector<std::thread> readers;
+            for (int t = 0; t < 3; ++t) {
+                readers.emplace_back([&] {
+                    ModelHandle<VersionedModel>::Reader reader(handle);
+                    uint64_t last = 0, count = 0;
+                    while (!stop.load()) {
+                        ModelHandle<VersionedModel>::ReadGuard model(reader);
+                        if (!model || model->magic != VersionedModel::MAGIC || model->check != ~model->value) {
+                            corrupted.fetch_add(1);
+                        } else if (model->value < last) {
+                            regressed.fetch_add(1);
+                        } else {
+                            last = model->value;
+                        }
+                        count++;
+                    }
+                    reads.fetch_add(count);
+                });
+            }
+            for (uint64_t v = 2; v <= versions + 1; ++v) {
+                handle.publish(std::make_shared<const VersionedModel>(v));
+                if (v % 50 == 0) std::this_thread::yield();
+            }
+            stop.store(true);
+            for (size_t t = 0; t < readers.size(); ++t) readers[t].join();
+            totalReads = reads.load();
+            
+            invariants = corrupted == 0 && regressed == 0 && handle.collect() == 0 &&
+                         handle.getVersion() == versions + 2 && handle.getReclaimed() == versions + 1 &&
+                         VersionedModel::live == 1 && handle.get()->value == versions + 1;
+            
+            // Servidor de lote: publish troca os pesos do próximo lote
+            NeuralNetwork first(4, 1, 0.3, 0.9), second(4, 1, 0.3, 0.9);
+            first.addHiddenLayer(5, std::make_shared<SigmoidActivation>(), 0.5);
+            first.finalize(std::make_shared<SigmoidActivation>(), 0.5);
+            second.addHiddenLayer(5, std::make_shared<SigmoidActivation>(), 0.5);
+            second.finalize(std::make_shared<SigmoidActivation>(), 0.5);
+            std::shared_ptr<const FixedNetwork<4, 5, 1>> weightsA = std::make_shared<const FixedNetwork<4, 5, 1>>(first);
+            std::shared_ptr<const FixedNetwork<4, 5, 1>> weightsB = std::make_shared<const FixedNetwork<4, 5, 1>>(second);
+            FixedNetwork<4, 5, 1>::Input input = {{1, 0, 1, 0}};
+            InferenceServer<FixedNetwork<4, 5, 1>> server(weightsA, InferenceConfig(4, 50.0));
+            bool beforeSwap = server.predict(input)[0] == weightsA->predict(input)[0];
+            server.publish(weightsB);
+            swapped = beforeSwap && server.predict(input)[0] == weightsB->predict(input)[0];
+        }
+        bool released = VersionedModel::live == 0;
+        
+        // Custo da leitura comparado a std::atomic_load de shared_ptr (só informativo)
+        ModelHandle<VersionedModel> timed(std::make_shared<const VersionedModel>(7));
+        ModelHandle<VersionedModel>::Reader timedReader(timed);
+        std::shared_ptr<const VersionedModel> sharedModel = std::make_shared<const VersionedModel>(7);
+        const int iterations = 1000000;
+        uint64_t sink = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            ModelHandle<VersionedModel>::ReadGuard model(timedReader);
+            sink += model->value;
+        }
+        double handleNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            sink += std::atomic_load(&sharedModel)->value;
+        }
+        double sharedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+        
+        std::cout << "  Slots de leitura limitados e reaproveitados" << (slotsOk ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Versão em uso não é liberada antes do leitor sair" << (pinned ? " ✓" : " ✗") << std::endl;
+        std::cout << "  " << totalReads << " leituras durante 2000 trocas, sem versão inválida ou antiga"
+                  << (invariants ? " ✓" : " ✗") << std::endl;
+        std::cout << "  InferenceServer::publish troca os pesos" << (swapped ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Todas as versões liberadas" << (released ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Leitura: " << handleNs << " ns (atomic_load de shared_ptr: " << sharedNs << " ns)"
+                  << (sink > 0 ? "" : " ") << std::endl;
+        
+        return slotsOk && pinned && invariants && swapped && released;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool test_hyperparameter_search() {
+    std::cout << "\n[TEST 26] Busca de hiperparâmetros..." << std::endl;
+    
+    try {
+        std::vector<std::vector<double>> inputs = {
+            {1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1},
+            {0, 0, 1, 1}, {1, 1, 0, 0}, {0, 1, 1, 0}, {1, 0, 0, 1},
+            {1, 0, 1, 0}, {0, 1, 0, 1}, {0, 1, 1, 1}, {1, 0, 1, 1},
+            {1, 1, 0, 1}, {1, 1, 1, 0}, {1, 1, 1, 1}, {0, 0, 0, 0}
+        };
+        std::vector<std::vector<double>> targets = {
+            {0.53}, {0.59}, {0.65}, {0.71}, {0.65}, {0.53}, {0.65}, {0.53},
+            {0.65}, {0.59}, {0.65}, {0.65}, {0.53}, {0.65}, {0.65}, {0.77}
+        };
+        
+        SearchSpace space;
+        space.hiddenSizes = {3, 5};
+        space.depths = {1, 2};
+        space.activations = {"Sigmoid", "Tanh"};
+        space.learningRates = {0.05, 0.5};
+        space.momenta = {0.9};
+        space.initRanges = {0.5};
+        
+        bool rejected = false;
+        SearchSpace invalid = space;
+        invalid.activations.push_back("Softmax");
+        try { HyperparameterSearch search(invalid); } catch (const std::invalid_argument&) { rejected = true; }
+        
+        // Grade: todas as 16 combinações, ordenadas pelo erro de validação
+        SearchConfig config;
+        config.strategy = SearchStrategy::Grid;
+        config.maxEpochs = 1200;
+        config.evaluationInterval = 200;
+        config.minTrialsForMedian = 3;
+        config.threads = 2;
+        SearchReport grid = HyperparameterSearch(space, config).run(inputs, targets, inputs, targets);
+        std::set<std::string> distinct;
+        bool sorted = true;
+        for (size_t i = 0; i < grid.results.size(); ++i) {
+            const TrialConfig& c = grid.results[i].config;
+            distinct.insert(c.architecture(4, 1) + c.activation + std::to_string(c.learningRate));
+            if (i > 0 && grid.results[i].validationError < grid.results[i - 1].validationError) sorted = false;
+        }
+        bool gridOk = grid.results.size() == space.gridSize() && distinct.size() == space.gridSize() &&
+                      sorted && grid.epochsTrained <= grid.epochsBudget;
+        
+        // Aleatória: o sorteio depende só da semente
+        config.strategy = SearchStrategy::Random;
+        config.trials = 6;
+        config.seed = 7;
+        std::vector<TrialConfig> first = HyperparameterSearch(space, config).candidates();
+        std::vector<TrialConfig> second = HyperparameterSearch(space, config).candidates();
+        bool reproducible = first.size() == 6;
+        for (size_t i = 0; i < first.size() && i < second.size(); ++i) {
+            reproducible = reproducible && first[i].architecture(4, 1) == second[i].architecture(4, 1) &&
+                           first[i].activation == second[i].activation &&
+                           first[i].learningRate == second[i].learningRate;
+        }
+        
+        // Successive halving: 16 -> 8 -> 4 -> 2 -> 1, orçamento dobrando a cada rodada
+        config.strategy = SearchStrategy::SuccessiveHalving;
+        config.trials = 16;
+        config.minEpochs = 100;
+        config.eta = 2;
+        config.maxEpochs = 1600;
+        SearchReport halving = HyperparameterSearch(space, config).run(inputs, targets, inputs, targets);
+        int stopped = 0;
+        for (size_t i = 0; i < halving.results.size(); ++i) {
+            if (halving.results[i].stopped) stopped++;
+        }
+        const TrialResult& best = halving.best();
+        bool halvingOk = halving.results.size() == 16 && stopped == 15 && !best.stopped &&
+                         std::isfinite(best.validationError) &&
+                         halving.epochsTrained < halving.epochsBudget / 4;
+        
+        // Mesmo halving lendo um CSV direto (leituras serializadas entre os trials)
+        {
+            std::ofstream csv("test_search_temp.csv");
+            for (size_t i = 0; i < inputs.size(); ++i) {
+                for (double v : inputs[i]) csv << v << ",";
+                csv << targets[i][0] << "\n";
+            }
+        }
+        bool fromDataset = false;
+        {
+            CsvDataset csv("test_search_temp.csv", 4, 1);
+            SearchReport streamed = HyperparameterSearch(space, config).run(csv, csv);
+            fromDataset = !csv.concurrentReads() && streamed.results.size() == halving.results.size();
+            for (size_t i = 0; fromDataset && i < streamed.results.size(); ++i) {
+                fromDataset = streamed.results[i].id == halving.results[i].id &&
+                              streamed.results[i].epochs == halving.results[i].epochs &&
+                              streamed.results[i].validationError == halving.results[i].validationError;
+            }
+        }
+        std::remove("test_search_temp.csv");
+        
+        std::cout << "  Espaço com ativação desconhecida rejeitado" << (rejected ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Grade: " << grid.results.size() << " configurações distintas e ordenadas, "
+                  << grid.epochsTrained << "/" << grid.epochsBudget << " épocas" << (gridOk ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Sorteio reproduzível com a mesma semente" << (reproducible ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Successive halving: " << stopped << " interrompidas, melhor "
+                  << best.config.architecture(4, 1) << " " << best.config.activation << " (erro "
+                  << best.validationError << "), " << halving.epochsTrained << "/" << halving.epochsBudget
+                  << " épocas" << (halvingOk ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Mesma busca sobre CsvDataset, sem cópia para vetores" << (fromDataset ? " ✓" : " ✗") << std::endl;
+        
+        return rejected && gridOk && reproducible && halvingOk && fromDataset;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool test_reproducible_training() {
+    std::cout << "\n[TEST 27] Treinamento reprodutível com semente..." << std::endl;
+    
+    try {
+        std::vector<std::vector<double>> inputs = {
+            {1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1},
+            {0, 0, 1, 1}, {1, 1, 0, 0}, {0, 1, 1, 0}, {1, 0, 0, 1},
+            {1, 0, 1, 0}, {0, 1, 0, 1}, {0, 1, 1, 1}, {1, 0, 1, 1},
+            {1, 1, 0, 1}, {1, 1, 1, 0}, {1, 1, 1, 1}, {0, 0, 0, 0}
+        };
+        std::vector<std::vector<double>> targets = {
+            {0.53}, {0.59}, {0.65}, {0.71}, {0.65}, {0.53}, {0.65}, {0.53},
+            {0.65}, {0.59}, {0.65}, {0.65}, {0.53}, {0.65}, {0.65}, {0.77}
+        };
+        auto parameters = [](const NeuralNetwork& network) {
+            std::vector<double> values;
+            for (const auto& layer : network.getLayers()) {
+                for (const auto& row : layer->getWeights()) values.insert(values.end(), row.begin(), row.end());
+                values.insert(values.end(), layer->getBias().begin(), layer->getBias().end());
+            }
+            return values;
+        };
+        auto build = [](uint64_t seed, int depth) {
+            std::unique_ptr<NeuralNetwork> network(new NeuralNetwork(4, 1, 0.3, 0.9));
+            network->setSeed(seed);
+            for (int d = 0; d < depth; ++d) {
+                network->addHiddenLayer(5, std::make_shared<SigmoidActivation>(), 0.5);
+            }
+            network->finalize(std::make_shared<SigmoidActivation>(), 0.5);
+            return network;
+        };
+        
+        // Mesma semente: pesos iniciais e treinados idênticos bit a bit (em duas chamadas de trainBatch)
+        std::unique_ptr<NeuralNetwork> first = build(1234, 1);
+        std::unique_ptr<NeuralNetwork> second = build(1234, 1);
+        std::unique_ptr<NeuralNetwork> other = build(1235, 1);
+        bool sameInit = parameters(*first) == parameters(*second) && parameters(*first) != parameters(*other);
+        first->trainBatch(inputs, targets, 200, 0.0, false);
+        first->trainBatch(inputs, targets, 200, 0.0, false);
+        second->trainBatch(inputs, targets, 200, 0.0, false);
+        second->trainBatch(inputs, targets, 200, 0.0, false);
+        bool sameTrained = parameters(*first) == parameters(*second);
+        
+        // Camada l depende só de (semente, l): acrescentar camadas não muda as anteriores
+        std::unique_ptr<NeuralNetwork> deeper = build(1234, 2);
+        bool layerStreams = deeper->getLayers()[0]->getWeights() == build(1234, 1)->getLayers()[0]->getWeights();
+        
+        bool lateSeedRejected = false;
+        try { first->setSeed(1); } catch (const std::logic_error&) { lateSeedRejected = true; }
+        
+        // Embaralhamento da época e depende só de (semente, e), não das épocas anteriores
+        BlockShuffler sequential(10, 3, 99), direct(10, 3, 99);
+        for (int e = 0; e < 5; ++e) sequential.shuffle();
+        direct.shuffle(5);
+        std::set<size_t> seen;
+        bool sameEpoch = true;
+        for (size_t k = 0; k < 10; ++k) {
+            sameEpoch = sameEpoch && sequential.at(k) == direct.at(k);
+            seen.insert(direct.at(k));
+        }
+        bool shuffleOk = sameEpoch && seen.size() == 10;
+        
+        // Busca com parada pela mediana: mesmo relatório com 1 ou 3 threads
+        SearchSpace space;
+        space.hiddenSizes = {3, 5};
+        space.depths = {1};
+        space.activations = {"Sigmoid", "Tanh"};
+        space.learningRates = {0.05, 0.5};
+        space.momenta = {0.0, 0.9};
+        space.initRanges = {0.5};
+        SearchConfig config;
+        config.strategy = SearchStrategy::Grid;
+        config.maxEpochs = 600;
+        config.evaluationInterval = 100;
+        config.minTrialsForMedian = 2;
+        config.threads = 1;
+        SearchReport single = HyperparameterSearch(space, config).run(inputs, targets, inputs, targets);
+        config.threads = 3;
+        SearchReport parallel = HyperparameterSearch(space, config).run(inputs, targets, inputs, targets);
+        bool sameSearch = single.results.size() == parallel.results.size() && parallel.threads == 3;
+        int stopped = 0;
+        for (size_t i = 0; sameSearch && i < single.results.size(); ++i) {
+            const TrialResult& a = single.results[i];
+            const TrialResult& b = parallel.results[i];
+            sameSearch = a.id == b.id && a.seed == b.seed && a.epochs == b.epochs && a.stopped == b.stopped &&
+                         a.validationError == b.validationError && a.trainingError == b.trainingError;
+            if (a.stopped) stopped++;
+        }
+        
+        // Sementes que diferem só nos 32 bits altos sorteiam buscas diferentes
+        SearchConfig low, high;
+        low.strategy = high.strategy = SearchStrategy::Random;
+        low.seed = 7;
+        high.seed = 7 + (uint64_t(1) << 32);
+        std::vector<TrialConfig> lowDraw = HyperparameterSearch(SearchSpace(), low).candidates();
+        std::vector<TrialConfig> highDraw = HyperparameterSearch(SearchSpace(), high).candidates();
+        bool wideSeed = false;
+        for (size_t i = 0; i < lowDraw.size(); ++i) {
+            wideSeed = wideSeed || lowDraw[i].architecture(4, 1) != highDraw[i].architecture(4, 1) ||
+                       lowDraw[i].activation != highDraw[i].activation ||
+                       lowDraw[i].learningRate != highDraw[i].learningRate;
+        }
+        
+        std::cout << "  Mesma semente: pesos iniciais iguais, outra semente: diferentes" << (sameInit ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Pesos após 400 épocas idênticos bit a bit" << (sameTrained ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Camada 0 igual em 4-5-1 e 4-5-5-1" << (layerStreams ? " ✓" : " ✗") << std::endl;
+        std::cout << "  setSeed depois das camadas rejeitado" << (lateSeedRejected ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Época 5 embaralhada igual em sequência e direto" << (shuffleOk ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Busca (" << single.results.size() << " trials, " << stopped
+                  << " interrompidos) idêntica com 1 e 3 threads" << (sameSearch ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Semente de 64 bits na busca" << (wideSeed ? " ✓" : " ✗") << std::endl;
+        
+        return sameInit && sameTrained && layerStreams && lateSeedRejected && shuffleOk && sameSearch && wideSeed;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool test_training_observer() {
+    std::cout << "\n[TEST 28] Métricas de treinamento por época..." << std::endl;
+    
+    try {
+        std::vector<std::vector<double>> inputs = {
+            {1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1},
+            {0, 0, 1, 1}, {1, 1, 0, 0}, {0, 1, 1, 0}, {1, 0, 0, 1}
+        };
+        std::vector<std::vector<double>> targets = {
+            {0.53}, {0.59}, {0.65}, {0.71}, {0.65}, {0.53}, {0.65}, {0.53}
+        };
+        auto build = [] {
+            std::unique_ptr<NeuralNetwork> network(new NeuralNetwork(4, 1, 0.3, 0.9));
+            network->setSeed(2024);
+            network->addHiddenLayer(5, std::make_shared<SigmoidActivation>(), 0.5);
+            network->finalize(std::make_shared<SigmoidActivation>(), 0.5);
+            return network;
+        };
+        
+        // 50 épocas, validação a cada 10, com histórico em memória, CSV e binário
+        std::unique_ptr<NeuralNetwork> observed = build();
+        TrainingHistory history;
+        EarlyStoppingConfig config;
+        config.validationInputs = &inputs;
+        config.validationTargets = &targets;
+        config.validationInterval = 10;
+        config.patience = 0;
+        config.restoreBestWeights = false;
+        config.observers.push_back(&history);
+        {
+            CsvTrainingLog csv("test_training_log_temp.csv");
+            BinaryTrainingLog binary("test_training_log_temp.bin");
+            config.observers.push_back(&csv);
+            config.observers.push_back(&binary);
+            observed->trainBatch(inputs, targets, 50, 0.0, false, config);
+        }
+        const std::vector<EpochStats>& epochs = history.getEpochs();
+        bool perEpoch = history.isFinished() && epochs.size() == 50;
+        double previousElapsed = 0.0;
+        for (size_t i = 0; perEpoch && i < epochs.size(); ++i) {
+            const EpochStats& e = epochs[i];
+            perEpoch = e.epoch == static_cast<int>(i) + 1 && e.validated() == (e.epoch % 10 == 0) &&
+                       e.gradientNorm > 0.0 && std::isfinite(e.gradientNorm) && e.samples == inputs.size() &&
+                       e.samplesPerSecond() > 0.0 && e.elapsedSeconds >= previousElapsed;
+            previousElapsed = e.elapsedSeconds;
+        }
+        const TrainingEnd& end = history.getEnd();
+        bool endOk = end.reason == StopReason::MaxEpochs && end.lastEpoch == 50 && end.epochsTrained == 50 &&
+                     end.seconds >= end.trainSeconds + end.validationSeconds && std::isfinite(end.bestValidationError);
+        
+        // Logs gravados: binário idêntico ao histórico; CSV com cabeçalho + 50 linhas
+        std::vector<EpochStats> reread = BinaryTrainingLog::read("test_training_log_temp.bin");
+        bool binaryOk = reread.size() == epochs.size();
+        for (size_t i = 0; binaryOk && i < reread.size(); ++i) {
+            binaryOk = reread[i].epoch == epochs[i].epoch && reread[i].trainingError == epochs[i].trainingError &&
+                       reread[i].gradientNorm == epochs[i].gradientNorm &&
+                       reread[i].validated() == epochs[i].validated();
+        }
+        std::ifstream csvIn("test_training_log_temp.csv");
+        std::string line;
+        int lines = 0;
+        while (std::getline(csvIn, line)) lines++;
+        bool csvOk = lines == 51;
+        std::remove("test_training_log_temp.csv");
+        std::remove("test_training_log_temp.bin");
+        
+        // Observar não altera o treinamento
+        std::unique_ptr<NeuralNetwork> plain = build();
+        config.observers.clear();
+        plain->trainBatch(inputs, targets, 50, 0.0, false, config);
+        bool unchanged = plain->predict(inputs[3]) == observed->predict(inputs[3]);
+        
+        // Motivos de parada
+        TrainingHistory converged, stopped;
+        config.observers = {&converged};
+        build()->trainBatch(inputs, targets, 100, 1.0, false, config);
+        config.observers = {&stopped};
+        config.patience = 1;
+        config.minDelta = 1.0;
+        build()->trainBatch(inputs, targets, 100, 0.0, false, config);
+        bool reasons = converged.getEnd().reason == StopReason::Converged && converged.getEnd().lastEpoch == 1 &&
+                       stopped.getEnd().reason == StopReason::EarlyStopped && stopped.getEnd().lastEpoch == 20;
+        
+        std::cout << "  50 épocas com erro, norma do gradiente (" << epochs.front().gradientNorm << " → "
+                  << epochs.back().gradientNorm << ") e validação a cada 10" << (perEpoch ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Resumo: " << end.epochsTrained << " épocas, " << stopReasonName(end.reason)
+                  << (endOk ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Log binário relido igual ao histórico" << (binaryOk ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Log CSV com " << lines << " linhas" << (csvOk ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Observadores não alteram os pesos" << (unchanged ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Parada por convergência e por early stopping informadas" << (reasons ? " ✓" : " ✗") << std::endl;
+        
+        return perEpoch && endOk && binaryOk && csvOk && unchanged && reasons;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Dataset com bloco em cache (como CsvDataset): leituras só numa thread por vez
+class SequentialView : public Dataset {
+public:
+    explicit SequentialView(const Dataset& source) : source(source), reads(0) {}
+    size_t size() const override { return source.size(); }
+    int getInputSize() const override { return source.getInputSize(); }
+    int getOutputSize() const override { return source.getOutputSize(); }
+    void getSample(size_t index, std::vector<double>& input, std::vector<double>& target) const override {
+        source.getSample(index, input, target);
+    }
+    void readBatch(const size_t* indices, size_t count, double* inputs, double* targets) const override {
+        reads++;   // Sem atomic: leituras simultâneas seriam uma corrida (ThreadSanitizer)
+        source.readBatch(indices, count, inputs, targets);
+    }
+    
+    const Dataset& source;
+    mutable size_t reads;
+};
+
+bool test_evaluation() {
+    std::cout << "\n[TEST 29] Avaliação em lotes com matriz de confusão..." << std::endl;
+    
+    try {
+        NeuralNetwork network(4, 1, 0.3, 0.9);
+        network.setSeed(7);
+        network.addHiddenLayer(8, std::make_shared<SigmoidActivation>(), 0.5);
+        network.finalize(std::make_shared<SigmoidActivation>(), 0.5);
+        std::vector<std::vector<double>> inputs = {
+            {1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1},
+            {0, 0, 1, 1}, {1, 1, 0, 0}, {0, 1, 1, 0}, {1, 0, 0, 1}
+        };
+        std::vector<std::vector<double>> targets = {
+            {0.53}, {0.59}, {0.65}, {0.71}, {0.77}, {0.53}, {0.65}, {0.90}
+        };
+        network.trainBatch(inputs, targets, 2000, 0.0, false);
+        
+        // Mesmo erro de validate() e mesmas saídas de predict()
+        EvaluationResult small = network.evaluate(inputs, targets);
+        double reference = network.validate(inputs, targets, false);
+        double manual = 0.0;
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            double diff = targets[i][0] - network.predict(inputs[i])[0];
+            manual += 0.5 * diff * diff;
+        }
+        manual /= inputs.size();
+        bool lossOk = std::fabs(small.loss - manual) < 1e-12 && std::fabs(reference - manual) < 1e-12;
+        
+        // Matriz: soma = amostras, "fora" só na linha da amostra com alvo 0.90
+        size_t sum = 0, diagonal = 0;
+        for (size_t e = 0; e < small.confusion.size(); ++e) {
+            for (size_t p = 0; p < small.confusion[e].size(); ++p) sum += small.confusion[e][p];
+            if (e + 1 < small.confusion.size()) diagonal += small.confusion[e][e];
+        }
+        size_t outside = 0;
+        for (size_t p = 0; p < small.confusion.back().size(); ++p) outside += small.confusion.back()[p];
+        bool matrixOk = sum == inputs.size() && outside == 1 && small.labeled == 7 &&
+                        small.correct == diagonal && small.labels.size() == 6;
+        
+        // 200 mil amostras: mesmo resultado com 1 ou 4 threads
+        FloatDataset frames(4, 1, 200000);
+        for (size_t i = 0; i < 200000; ++i) {
+            double input[4] = {(i % 7) / 7.0, (i % 11) / 11.0, (i % 13) / 13.0, (i % 17) / 17.0};
+            double target[1] = {0.50 + (i % 31) * 0.01};
+            frames.append(input, target);
+        }
+        EvaluationConfig serial;
+        serial.threads = 1;
+        EvaluationConfig parallel;
+        parallel.threads = 4;
+        parallel.parallelThreshold = 0;
+        EvaluationResult one = network.evaluate(frames, serial);
+        EvaluationResult four = network.evaluate(frames, parallel);
+        bool threadsOk = one.threads == 1 && four.threads == 4 && one.loss == four.loss &&
+                         one.mse == four.mse && one.maxAbsError == four.maxAbsError &&
+                         one.confusion == four.confusion;
+        
+        // Sem leituras simultâneas: lido em rodadas por uma thread, avaliado por 4
+        SequentialView sequential(frames);
+        EvaluationResult shared = network.evaluate(sequential, parallel);
+        bool sharedOk = shared.threads == 4 && shared.loss == one.loss && shared.confusion == one.confusion &&
+                        sequential.reads == (391 + 31) / 32;   // 391 lotes de 512, rodadas de 4 x 8 lotes
+        
+        // Referência: o laço de predict() amostra a amostra usado até aqui
+        auto started = std::chrono::steady_clock::now();
+        double looped = 0.0;
+        std::vector<double> input, target;
+        for (size_t i = 0; i < frames.size(); ++i) {
+            frames.getSample(i, input, target);
+            double diff = target[0] - network.predict(input)[0];
+            looped += 0.5 * diff * diff;
+        }
+        double loopSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        bool largeOk = std::fabs(looped / frames.size() - one.loss) < 1e-9;
+        
+        bool rejected = false;
+        try {
+            network.evaluate({{1, 0, 0}}, {{0.5}});
+        } catch (const std::invalid_argument&) {
+            rejected = true;
+        }
+        
+        std::cout << "  Erro igual ao de validate(): " << small.loss << (lossOk ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Matriz com " << sum << " amostras, acurácia " << 100.0 * small.accuracy() << "%"
+                  << (matrixOk ? " ✓" : " ✗") << std::endl;
+        std::cout << "  200000 amostras: 1 thread " << one.seconds * 1000.0 << " ms, 4 threads "
+                  << four.seconds * 1000.0 << " ms, idênticos" << (threadsOk ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Dataset sem leitura paralela: " << sequential.reads << " leituras, "
+                  << shared.seconds * 1000.0 << " ms" << (sharedOk ? " ✓" : " ✗") << std::endl;
+        std::cout << "  (predict() amostra a amostra: " << loopSeconds * 1000.0 << " ms)"
+                  << (largeOk ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Dimensões incompatíveis rejeitadas" << (rejected ? " ✓" : " ✗") << std::endl;
+        
+        return lossOk && matrixOk && threadsOk && sharedOk && largeOk && rejected;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool test_layer_config() {
+    std::cout << "\n[TEST 30] Inicialização Xavier/He, dropout e weight decay..." << std::endl;
+    
+    try {
+        // Amplitudes pelo fan-in: Xavier √(6/(in+out)), He √(6/in); bias zero
+        LayerConfig xavier;
+        xavier.init = WeightInit::Xavier;
+        LayerConfig he;
+        he.init = WeightInit::He;
+        Layer xavierLayer(64, 32, std::make_shared<TanhActivation>(), xavier, 1, 0);
+        Layer heLayer(64, 32, std::make_shared<ReLUActivation>(), he, 1, 0);
+        auto maxAbs = [](const Layer& layer) {
+            double largest = 0.0;
+            for (const auto& row : layer.getWeights())
+                for (double w : row) largest = std::max(largest, std::fabs(w));
+            return largest;
+        };
+        double xavierLimit = std::sqrt(6.0 / 96.0), heLimit = std::sqrt(6.0 / 64.0);
+        bool initOk = maxAbs(xavierLayer) <= xavierLimit && maxAbs(xavierLayer) > 0.8 * xavierLimit &&
+                      maxAbs(heLayer) <= heLimit && maxAbs(heLayer) > 0.8 * heLimit &&
+                      xavierLayer.getBias() == std::vector<double>(32, 0.0);
+        
+        // Inverted dropout: ~metade desligada, restantes escaladas por 2; forward() intacto
+        LayerConfig half;
+        half.dropout = 0.5;
+        Layer dropped(4, 2000, std::make_shared<LinearActivation>(), half, 3, 0);
+        std::vector<double> x = {0.2, 0.4, 0.6, 0.8};
+        std::vector<double> plain = dropped.forward(x);
+        CounterRng maskRng(3, 0);
+        std::vector<double> masked = dropped.forwardTraining(x, maskRng);
+        size_t zeros = 0;
+        bool scaled = true;
+        for (size_t j = 0; j < masked.size(); ++j) {
+            if (masked[j] == 0.0) zeros++;
+            else scaled = scaled && masked[j] == plain[j] * 2.0;
+        }
+        bool dropoutOk = scaled && zeros > 900 && zeros < 1100 && dropped.forward(x) == plain;
+        
+        // Rede com dropout: treino reprodutível pela semente, predição determinística
+        std::vector<std::vector<double>> inputs = {
+            {1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1},
+            {0, 0, 1, 1}, {1, 1, 0, 0}, {0, 1, 1, 0}, {1, 0, 0, 1}
+        };
+        std::vector<std::vector<double>> targets = {
+            {0.53}, {0.59}, {0.65}, {0.71}, {0.65}, {0.53}, {0.65}, {0.53}
+        };
+        auto build = [](uint64_t seed, double dropout, double decay) {
+            std::unique_ptr<NeuralNetwork> network(new NeuralNetwork(4, 1, 0.3, 0.9));
+            network->setSeed(seed);
+            LayerConfig hidden;
+            hidden.init = WeightInit::Xavier;
+            hidden.dropout = dropout;
+            hidden.weightDecay = decay;
+            network->addHiddenLayer(16, std::make_shared<SigmoidActivation>(), hidden);
+            network->addHiddenLayer(16, std::make_shared<SigmoidActivation>(), hidden);
+            LayerConfig output;
+            output.init = WeightInit::Xavier;
+            output.weightDecay = decay;
+            network->finalize(std::make_shared<SigmoidActivation>(), output);
+            return network;
+        };
+        std::unique_ptr<NeuralNetwork> a = build(11, 0.2, 0.0), b = build(11, 0.2, 0.0);
+        std::unique_ptr<NeuralNetwork> c = build(11, 0.0, 0.0);
+        a->trainBatch(inputs, targets, 300, 0.0, false);
+        b->trainBatch(inputs, targets, 300, 0.0, false);
+        c->trainBatch(inputs, targets, 300, 0.0, false);
+        bool reproducible = a->getLayers()[1]->getWeights() == b->getLayers()[1]->getWeights() &&
+                            a->getLayers()[1]->getWeights() != c->getLayers()[1]->getWeights() &&
+                            a->predict(inputs[2]) == a->predict(inputs[2]);
+        double trainedError = a->validate(inputs, targets, false);
+        bool learns = trainedError < 0.01;
+        
+        // Weight decay: sem gradiente, cada peso encolhe por (1 - taxa·λ)
+        LayerConfig decayConfig;
+        decayConfig.weightDecay = 0.1;
+        Layer decaying(4, 3, std::make_shared<SigmoidActivation>(), decayConfig, 5, 0);
+        std::vector<std::vector<double>> before = decaying.getWeights();
+        decaying.updateWeights(0.5, 0.0);
+        bool decayOk = std::fabs(decaying.getWeights()[2][1] - before[2][1] * 0.95) < 1e-15;
+        std::unique_ptr<NeuralNetwork> regularized = build(11, 0.0, 1e-3);
+        regularized->trainBatch(inputs, targets, 300, 0.0, false);
+        auto squaredNorm = [](const NeuralNetwork& network) {
+            double sum = 0.0;
+            for (const auto& layer : network.getLayers())
+                for (const auto& row : layer->getWeights())
+                    for (double w : row) sum += w * w;
+            return sum;
+        };
+        bool smaller = squaredNorm(*regularized) < squaredNorm(*c);
+        
+        // Configuração das camadas salva e restaurada (JSON e binário),
+        // em rede vazia e em rede já montada sem dropout nem L2
+        std::unique_ptr<NeuralNetwork> saved = build(7, 0.2, 1e-3);
+        bool persisted = true;
+        const char* files[] = {"test_layer_config_temp.json", "test_layer_config_temp.bin"};
+        for (const char* file : files) {
+            NeuralNetwork empty(4, 1);
+            std::unique_ptr<NeuralNetwork> prebuilt = build(7, 0.0, 0.0);
+            persisted = persisted && saved->saveWeights(file) &&
+                        empty.loadWeights(file) && prebuilt->loadWeights(file);
+            std::remove(file);
+            for (const NeuralNetwork* loaded : {&empty, prebuilt.get()}) {
+                for (size_t l = 0; persisted && l < loaded->getLayers().size(); ++l) {
+                    const auto& from = saved->getLayers()[l];
+                    const auto& to = loaded->getLayers()[l];
+                    persisted = to->getInit() == from->getInit() &&
+                                to->getDropout() == from->getDropout() &&
+                                to->getWeightDecay() == from->getWeightDecay();
+                }
+            }
+        }
+        persisted = persisted && saved->getLayers()[0]->getDropout() == 0.2 &&
+                    saved->getLayers()[2]->getWeightDecay() == 1e-3;
+        
+        // Configurações inválidas
+        int rejected = 0;
+        LayerConfig invalid;
+        invalid.dropout = 1.0;
+        try { Layer(4, 2, std::make_shared<SigmoidActivation>(), invalid, 1, 0); } catch (const std::invalid_argument&) { rejected++; }
+        invalid.dropout = 0.0;
+        invalid.weightDecay = -1.0;
+        try { Layer(4, 2, std::make_shared<SigmoidActivation>(), invalid, 1, 0); } catch (const std::invalid_argument&) { rejected++; }
+        invalid.weightDecay = 0.0;
+        invalid.dropout = 0.3;
+        try { NeuralNetwork(4, 1).finalize(std::make_shared<SigmoidActivation>(), invalid); } catch (const std::invalid_argument&) { rejected++; }
+        
+        std::cout << "  Xavier ±" << xavierLimit << ", He ±" << heLimit << (initOk ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Dropout 0.5: " << zeros << "/2000 desligados, demais × 2, predição sem máscara"
+                  << (dropoutOk ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Treino com dropout reprodutível pela semente" << (reproducible ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Rede 4-16-16-1 com dropout aprende (erro " << trainedError << ")" << (learns ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Weight decay encolhe os pesos (" << squaredNorm(*regularized) << " < " << squaredNorm(*c) << ")"
+                  << (decayOk && smaller ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Inicialização, dropout e L2 restaurados do arquivo (JSON e binário)"
+                  << (persisted ? " ✓" : " ✗") << std::endl;
+        std::cout << "  Configurações inválidas rejeitadas: " << rejected << "/3" << (rejected == 3 ? " ✓" : " ✗") << std::endl;
+        
+        return initOk && dropoutOk && reproducible && learns && decayOk && smaller && persisted &&
+               rejected == 3;
+        
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Erro: " << e.what() << std::endl;
+        return false;
+    }
+}
+
 int main() {
     std::cout << "╔════════════════════════════════════════════════════╗" << std::endl;
     std::cout << "║   TESTES DA REDE NEURAL                            ║" << std::endl;
@@ -257,7 +2656,7 @@ int main() {
     std::cout << "╚════════════════════════════════════════════════════╝" << std::endl;
     
     int passed = 0;
-    int total = 6;
+    int total = 30;
     
     if (test_network_creation()) passed++;
     if (test_forward_propagation()) passed++;
@@ -265,6 +2664,30 @@ int main() {
     if (test_navigation_scenarios()) passed++;
     if (test_decision_consistency()) passed++;
     if (test_weight_saving()) passed++;
+    if (test_weight_loading_and_checkpoint()) passed++;
+    if (test_streaming_dataset()) passed++;
+    if (test_matrix_dataset()) passed++;
+    if (test_quantized_inference()) passed++;
+    if (test_fixed_network()) passed++;
+    if (test_latency_tracer()) passed++;
+    if (test_async_logger()) passed++;
+    if (test_periodic_scheduler()) passed++;
+    if (test_behavior_arbiter()) passed++;
+    if (test_motion_queue()) passed++;
+    if (test_occupancy_grid()) passed++;
+    if (test_dwa_planner()) passed++;
+    if (test_global_planner()) passed++;
+    if (test_particle_filter()) passed++;
+    if (test_fleet_supervisor()) passed++;
+    if (test_inference_server()) passed++;
+    if (test_telemetry()) passed++;
+    if (test_online_learner()) passed++;
+    if (test_model_handle()) passed++;
+    if (test_hyperparameter_search()) passed++;
+    if (test_reproducible_training()) passed++;
+    if (test_training_observer()) passed++;
+    if (test_evaluation()) passed++;
+    if (test_layer_config()) passed++;
     
     std::cout << "\n" << std::string(50, '=') << std::endl;
     std::cout << "RESULTADO FINAL: " << passed << "/" << total << " testes passaram" << std::endl;
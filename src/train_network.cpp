@@ -49,10 +49,54 @@
  * Útil para treinar offline sem necessidade do simulador.
  * 
  * Uso:
- *   ./build/train_network [output_weights_file]
+ *   ./build/train_network [output_weights_file] [opções]
+ * 
+ * Opções:
+ *   --checkpoint <arquivo>  Grava o melhor modelo de validação durante o treino
+ *                           (".bin" = formato binário, demais = JSON)
+ *                           O estado para retomar (pesos, momentum, época,
+ *                           paciência) vai para <arquivo>.state a cada 1000
+ *                           épocas e na última (ex.: ckpt.state.bin)
+ *   --resume                Retoma o treinamento do estado gravado (ou, sem ele,
+ *                           do melhor modelo)
+ *   --patience <n>          Validações sem melhora antes de parar (padrão: 20)
+ *   --training-log <arquivo>
+ *                           Grava as métricas de cada época (erro, validação,
+ *                           norma do gradiente, amostras/s, tempos); ".bin" =
+ *                           registros binários, demais = CSV
+ *   --dataset <arquivo>     Treina com amostras de arquivo (CSV ou ".bin" colunar)
+ *                           em vez do dataset embutido; lido em blocos do disco
+ *   --in-memory             Carrega o dataset externo para uma matriz float32
+ *                           contígua (FloatDataset) antes de treinar
+ *   --convert-dataset <csv> <bin>
+ *                           Converte um CSV (4 entradas + 1 saída por linha) para
+ *                           o formato binário colunar e encerra
+ *   --search <grid|random|halving>
+ *                           Busca de hiperparâmetros antes do treinamento (tamanho
+ *                           e número de camadas ocultas, ativação, taxa, momentum,
+ *                           amplitude inicial); a melhor configuração é treinada
+ *   --trials <n>            Configurações sorteadas em random/halving (padrão: 54)
+ *   --threads <n>           Trials em paralelo (padrão: núcleos disponíveis)
+ *   --search-epochs <n>     Orçamento máximo de épocas por trial (padrão: 20000)
+ *   --evaluate <pesos>      Só avalia um modelo salvo (erro, matriz de confusão
+ *                           por ação, acurácia) no --dataset, ou no conjunto de
+ *                           validação embutido, e encerra; usa --threads
+ *   --seed <n>              Semente dos pesos iniciais, do embaralhamento e das
+ *                           máscaras de dropout (padrão: sorteada e exibida); com
+ *                           --search, também do sorteio das configurações (padrão:
+ *                           42). Mesma semente e mesmos argumentos = mesmos pesos,
+ *                           com qualquer --threads
+ *   --init <uniform|xavier|he>
+ *                           Inicialização dos pesos (padrão: uniform, amplitude
+ *                           0.5 ou a da busca); xavier/he usam o fan-in da camada
+ *   --dropout <p>           Fração dos neurônios ocultos desligados em cada amostra
+ *                           de treino (padrão: 0); não afeta a predição
+ *   --weight-decay <λ>      Regularização L2 dos pesos em todas as camadas (padrão: 0)
  * 
  * Exemplo:
  *   ./build/train_network trained_weights.json
+ *   ./build/train_network trained_weights.json --checkpoint ckpt.bin --resume
+ *   ./build/train_network trained_weights.json --search halving --trials 81
  * 
  * @author Grupo IA - La Salle
  * @date Novembro/Dezembro 2025
@@ -60,11 +104,15 @@
 
 #include "../include/neuralnetwork/NeuralNetwork.h"
 #include "../include/neuralnetwork/ActivationFunction.h"
+#include "../include/neuralnetwork/Dataset.h"
+#include "../include/neuralnetwork/QuantizedNetwork.h"
+#include "../include/neuralnetwork/HyperparameterSearch.h"
 #include <iostream>
 #include <iomanip>
 #include <memory>
 #include <vector>
 #include <string>
+#include <cstdlib>
 
 /**
  * @brief Cria o dataset de treinamento completo
@@ -266,6 +314,40 @@ std::string interpretOutput(double output) {
     return "INDEFINIDO";
 }
 
+/**
+ * @brief Abre um dataset de sensores gravado em disco
+ * 
+ * Arquivos ".bin" usam o formato binário colunar (BinaryDataset);
+ * os demais são lidos como CSV com 4 entradas e 1 saída por linha.
+ * 
+ * @param filename Caminho do arquivo
+ * @return Dataset pronto para leitura em blocos
+ */
+std::unique_ptr<Dataset> openDataset(const std::string& filename) {
+    const std::string ext = ".bin";
+    bool binary = filename.size() >= ext.size() &&
+                  filename.compare(filename.size() - ext.size(), ext.size(), ext) == 0;
+    if (binary) {
+        return std::unique_ptr<Dataset>(new BinaryDataset(filename));
+    }
+    return std::unique_ptr<Dataset>(new CsvDataset(filename, 4, 1));
+}
+
+/**
+ * @brief Arquivo do estado de treino de um checkpoint ("ckpt.bin" → "ckpt.state.bin")
+ */
+std::string stateFileFor(const std::string& checkpointFile) {
+    if (checkpointFile.empty()) {
+        return std::string();
+    }
+    size_t dot = checkpointFile.find_last_of('.');
+    size_t slash = checkpointFile.find_last_of('/');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return checkpointFile + ".state";
+    }
+    return checkpointFile.substr(0, dot) + ".state" + checkpointFile.substr(dot);
+}
+
 int main(int argc, char* argv[]) {
     std::cout << "\n╔════════════════════════════════════════════════════╗" << std::endl;
     std::cout << "║   TREINAMENTO DA REDE NEURAL                       ║" << std::endl;
@@ -276,22 +358,187 @@ int main(int argc, char* argv[]) {
     
     // Nome do arquivo de saída (pode ser passado como argumento)
     std::string outputFile = "trained_weights.json";
-    if (argc > 1) {
-        outputFile = argv[1];
+    std::string checkpointFile;
+    bool resume = false;
+    int patience = 20;
+    std::string trainingLogFile;
+    std::string evaluateFile;
+    std::string datasetFile;
+    bool inMemory = false;
+    std::string searchMode;
+    SearchConfig searchConfig;
+    bool seeded = false;
+    uint64_t seed = 0;
+    std::string initMode = "uniform";
+    double dropout = 0.0;
+    double weightDecay = 0.0;
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--convert-dataset" && i + 2 < argc) {
+            try {
+                std::unique_ptr<Dataset> source = openDataset(argv[i + 1]);
+                if (!BinaryDataset::write(argv[i + 2], *source)) {
+                    std::cerr << "✗ Erro ao gravar " << argv[i + 2] << std::endl;
+                    return 1;
+                }
+                std::cout << "✓ " << source->size() << " amostras convertidas para "
+                          << argv[i + 2] << std::endl;
+                return 0;
+            } catch (const std::exception& e) {
+                std::cerr << "✗ ERRO: " << e.what() << std::endl;
+                return 1;
+            }
+        } else if (arg == "--dataset" && i + 1 < argc) {
+            datasetFile = argv[++i];
+        } else if (arg == "--in-memory") {
+            inMemory = true;
+        } else if (arg == "--checkpoint" && i + 1 < argc) {
+            checkpointFile = argv[++i];
+        } else if (arg == "--resume") {
+            resume = true;
+        } else if (arg == "--patience" && i + 1 < argc) {
+            patience = std::atoi(argv[++i]);
+        } else if (arg == "--training-log" && i + 1 < argc) {
+            trainingLogFile = argv[++i];
+        } else if (arg == "--evaluate" && i + 1 < argc) {
+            evaluateFile = argv[++i];
+        } else if (arg == "--search" && i + 1 < argc) {
+            searchMode = argv[++i];
+        } else if (arg == "--trials" && i + 1 < argc) {
+            searchConfig.trials = std::atoi(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            searchConfig.threads = std::atoi(argv[++i]);
+        } else if (arg == "--search-epochs" && i + 1 < argc) {
+            searchConfig.maxEpochs = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+            seeded = true;
+            searchConfig.seed = seed;
+        } else if (arg == "--init" && i + 1 < argc) {
+            initMode = argv[++i];
+        } else if (arg == "--dropout" && i + 1 < argc) {
+            dropout = std::atof(argv[++i]);
+        } else if (arg == "--weight-decay" && i + 1 < argc) {
+            weightDecay = std::atof(argv[++i]);
+        } else {
+            outputFile = arg;
+        }
+    }
+    
+    if (searchMode == "grid") {
+        searchConfig.strategy = SearchStrategy::Grid;
+    } else if (searchMode == "random") {
+        searchConfig.strategy = SearchStrategy::Random;
+    } else if (searchMode == "halving") {
+        searchConfig.strategy = SearchStrategy::SuccessiveHalving;
+    } else if (!searchMode.empty()) {
+        std::cerr << "✗ Busca desconhecida: " << searchMode << " (use grid, random ou halving)" << std::endl;
+        return 1;
     }
     
-    std::cout << "Arquivo de saída: " << outputFile << "\n" << std::endl;
+    LayerConfig layerConfig;
+    if (initMode == "xavier") {
+        layerConfig.init = WeightInit::Xavier;
+    } else if (initMode == "he") {
+        layerConfig.init = WeightInit::He;
+    } else if (initMode != "uniform") {
+        std::cerr << "✗ Inicialização desconhecida: " << initMode << " (use uniform, xavier ou he)" << std::endl;
+        return 1;
+    }
+    layerConfig.weightDecay = weightDecay;
+    
+    std::cout << "Arquivo de saída: " << outputFile << std::endl;
+    if (!checkpointFile.empty()) {
+        std::cout << "Checkpoint: " << checkpointFile << " (estado: " << stateFileFor(checkpointFile)
+                  << (resume ? ", retomando se existir" : "") << ")" << std::endl;
+    }
+    std::cout << std::endl;
     
     try {
-        // ===== ETAPA 1: CRIAR ARQUITETURA DA REDE =====
-        std::cout << "Criando arquitetura da rede neural..." << std::endl;
+        // ===== ETAPA 1: OBTER DATASETS =====
+        std::pair<std::vector<std::vector<double>>, std::vector<std::vector<double>>> trainingData = createFullTrainingDataset();
+        std::vector<std::vector<double>>& trainingInputs = trainingData.first;
+        std::vector<std::vector<double>>& trainingTargets = trainingData.second;
+        
+        std::pair<std::vector<std::vector<double>>, std::vector<std::vector<double>>> validationData = createValidationDataset();
+        std::vector<std::vector<double>>& validationInputs = validationData.first;
+        std::vector<std::vector<double>>& validationTargets = validationData.second;
+        
+        // Dataset externo (logs de sensores) é lido do disco em blocos, ou
+        // carregado numa matriz float32 contígua com --in-memory;
+        // sem ele, usa os 16 padrões embutidos em uma matriz contígua
+        std::unique_ptr<Dataset> trainingSet;
+        if (!datasetFile.empty()) {
+            trainingSet = openDataset(datasetFile);
+            if (inMemory) {
+                trainingSet.reset(new FloatDataset(FloatDataset::load(*trainingSet)));
+            }
+            std::cout << "\nDataset externo: " << datasetFile << " ("
+                      << trainingSet->size() << " amostras"
+                      << (inMemory ? ", em memória float32" : "") << ")" << std::endl;
+        } else {
+            trainingSet.reset(new DoubleDataset(
+                DoubleDataset::fromVectors(trainingInputs, trainingTargets)));
+        }
         
-        // Parâmetros do construtor:
+        // Modo avaliação: mede um modelo já treinado e encerra
+        if (!evaluateFile.empty()) {
+            NeuralNetwork candidate(4, 1);
+            if (!candidate.loadWeights(evaluateFile)) {
+                std::cerr << "✗ Erro ao carregar " << evaluateFile << std::endl;
+                return 1;
+            }
+            EvaluationConfig evaluation;
+            evaluation.threads = searchConfig.threads;
+            MemoryDataset builtIn(validationInputs, validationTargets);
+            printEvaluationReport(candidate.evaluate(datasetFile.empty() ? builtIn : *trainingSet, evaluation));
+            return 0;
+        }
+        
+        // ===== ETAPA 2: CRIAR ARQUITETURA DA REDE =====
+        // Configuração padrão (4 → 5 → 1), ou a melhor da busca com --search
+        TrialConfig architecture;
+        int bestTrial = 0;
+        if (!searchMode.empty()) {
+            // O dataset externo é lido direto pelos trials, sem cópia para vetores
+            std::cout << "\nBuscando hiperparâmetros (" << searchStrategyName(searchConfig.strategy)
+                      << ")..." << std::endl;
+            MemoryDataset validationSet(validationInputs, validationTargets);
+            SearchReport report = HyperparameterSearch(SearchSpace(), searchConfig).run(*trainingSet, validationSet);
+            printSearchReport(report);
+            if (!report.best().error.empty()) {
+                std::cerr << "✗ Nenhuma configuração treinou com sucesso" << std::endl;
+                return 1;
+            }
+            architecture = report.best().config;
+            bestTrial = report.best().id;
+            // A rede final parte dos mesmos pesos iniciais do trial vencedor
+            seed = report.best().seed;
+            seeded = true;
+            std::cout << "Melhor configuração: " << architecture.architecture(4, 1) << ", "
+                      << architecture.activation << ", taxa " << architecture.learningRate
+                      << ", momentum " << architecture.momentum << ", init " << architecture.initRange
+                      << std::endl;
+        }
+        
+        std::cout << "\nCriando arquitetura da rede neural..." << std::endl;
+        
+        // Parâmetros do construtor (valores padrão):
         // - inputSize = 4: quatro direções (direita, esquerda, frente, trás)
         // - outputSize = 1: uma ação codificada
         // - learningRate = 0.3: taxa de aprendizado (0.1-0.5 é típico)
         // - momentum = 0.9: inercia do aprendizado (evita oscilações)
-        NeuralNetwork network(4, 1, 0.3, 0.9);
+        NeuralNetwork network(4, 1, architecture.learningRate, architecture.momentum);
+        if (seeded) {
+            network.setSeed(seed);
+        }
+        if (bestTrial > 0) {
+            std::cout << "Semente: " << network.getSeed() << " (trial #" << bestTrial << ")" << std::endl;
+        } else {
+            std::cout << "Semente: " << network.getSeed() << " (repita com --seed "
+                      << network.getSeed() << ")" << std::endl;
+        }
         
         // ARQUITETURA ESCOLHIDA: 4 → 5 → 1
         // 
@@ -299,6 +546,8 @@ int main(int argc, char* argv[]) {
         // - Regra prática: entre tamanho de entrada e saída
         // - 4 entradas, 1 saída → escolhemos 5 (um pouco acima da média)
         // - Testamos 3, 4, 5, 6, 7 → 5 teve melhor resultado
+        // - --search refaz essa comparação (com profundidade, ativação,
+        //   taxa, momentum e amplitude inicial) em paralelo
         // 
         // Por que Sigmoide?
         // - Produz saídas entre 0 e 1 (perfeito para nosso encoding)
@@ -306,25 +555,25 @@ int main(int argc, char* argv[]) {
         // - Função não-linear (permite aprender padrões complexos)
         
         // Adiciona camada oculta com 5 neurônios
-        // dropout = 0.5 (50% dos neurônios desligados no treino)
-        // Isso previne overfitting (decorar ao invés de aprender)
-        network.addHiddenLayer(5, std::make_shared<SigmoidActivation>(), 0.5);
+        // initRange = 0.5: pesos iniciais sorteados em [-0.5, +0.5]
+        // (--init xavier/he ajusta a amplitude ao número de entradas da camada)
+        // --dropout desliga uma fração dos neurônios ocultos a cada amostra de
+        // treino, e --weight-decay puxa os pesos para zero: ambos previnem
+        // overfitting (decorar ao invés de aprender); nenhum é usado por padrão
+        layerConfig.weightInitRange = architecture.initRange;
+        LayerConfig hiddenConfig = layerConfig;
+        hiddenConfig.dropout = dropout;
+        for (int layer = 0; layer < architecture.depth; ++layer) {
+            network.addHiddenLayer(architecture.hiddenSize, createActivation(architecture.activation),
+                                   hiddenConfig);
+        }
         
         // Finaliza a rede definindo camada de saída
-        // Também usa sigmoide para output entre 0 e 1
-        network.finalize(std::make_shared<SigmoidActivation>(), 0.5);
+        // Também usa sigmoide para output entre 0 e 1 (sem dropout)
+        network.finalize(std::make_shared<SigmoidActivation>(), layerConfig);
         
         std::cout << network.getArchitectureInfo() << "\n" << std::endl;
         
-        // ===== ETAPA 2: OBTER DATASETS =====
-        std::pair<std::vector<std::vector<double>>, std::vector<std::vector<double>>> trainingData = createFullTrainingDataset();
-        std::vector<std::vector<double>>& trainingInputs = trainingData.first;
-        std::vector<std::vector<double>>& trainingTargets = trainingData.second;
-        
-        std::pair<std::vector<std::vector<double>>, std::vector<std::vector<double>>> validationData = createValidationDataset();
-        std::vector<std::vector<double>>& validationInputs = validationData.first;
-        std::vector<std::vector<double>>& validationTargets = validationData.second;
-        
         // ===== ETAPA 3: TREINAR A REDE =====
         std::cout << "\n" << std::string(50, '=') << std::endl;
         std::cout << "INICIANDO TREINAMENTO" << std::endl;
@@ -337,17 +586,36 @@ int main(int argc, char* argv[]) {
         std::cout << "\nPARÂMETROS:" << std::endl;
         std::cout << "- Máximo de épocas: 100.000" << std::endl;
         std::cout << "- Threshold de erro: 0.004 (0.4%)" << std::endl;
-        std::cout << "- Learning rate: 0.3 (velocidade de aprendizado)" << std::endl;
-        std::cout << "- Momentum: 0.9 (estabilidade do aprendizado)" << std::endl;
+        std::cout << "- Learning rate: " << architecture.learningRate << " (velocidade de aprendizado)" << std::endl;
+        std::cout << "- Momentum: " << architecture.momentum << " (estabilidade do aprendizado)" << std::endl;
         std::cout << "\nAGUARDE: Treinamento pode levar alguns segundos..." << std::endl;
         std::cout << std::string(50, '=') << "\n" << std::endl;
         
+        // EARLY STOPPING: valida a cada 100 épocas e guarda o melhor modelo
+        // Para quando a validação deixa de melhorar por "patience" validações
+        EarlyStoppingConfig earlyStopping;
+        earlyStopping.validationInputs = &validationInputs;
+        earlyStopping.validationTargets = &validationTargets;
+        earlyStopping.validationInterval = 100;
+        earlyStopping.patience = patience;
+        earlyStopping.checkpointFile = checkpointFile;
+        earlyStopping.stateFile = stateFileFor(checkpointFile);
+        earlyStopping.checkpointInterval = 1000;
+        earlyStopping.resume = resume;
+        
+        // Métricas por época para comparar execuções (o console só mostra a cada 1000)
+        std::unique_ptr<TrainingObserver> trainingLog;
+        if (!trainingLogFile.empty()) {
+            trainingLog = openTrainingLog(trainingLogFile);
+            earlyStopping.observers.push_back(trainingLog.get());
+        }
+        
         int epochs = network.trainBatch(
-            trainingInputs, 
-            trainingTargets,
+            *trainingSet,
             100000,      // Máximo de épocas (normalmente converge antes)
             0.004,       // Threshold de erro (0.4% - muito baixo!)
-            true         // Verbose = mostra progresso a cada época
+            true,        // Verbose = mostra progresso a cada 1000 épocas
+            earlyStopping
         );
         
         // ===== ETAPA 4: VALIDAR A REDE =====
@@ -371,6 +639,17 @@ int main(int argc, char* argv[]) {
             std::cout << "\n⚠ ATENÇÃO! Erro > 5% - Pode precisar mais treinamento." << std::endl;
         }
         
+        // Acertos por ação (faixas de NeuralCollisionAvoidance::ACTION_*)
+        printEvaluationReport(network.evaluate(validationInputs, validationTargets));
+
+        // ===== ETAPA 4.1: INFERÊNCIA QUANTIZADA =====
+        // Versões float32 e int8 da rede treinada, comparadas com a referência
+        // em double no conjunto de validação (calibração no treinamento)
+        QuantizedNetwork quantized(network);
+        quantized.calibrate(*trainingSet);
+        MemoryDataset validationSet(validationInputs, validationTargets);
+        printQuantizationReport(compareQuantization(network, quantized, validationSet));
+
         // ===== ETAPA 5: TESTES DE CENÁRIOS =====
         std::cout << "\n" << std::string(50, '=') << std::endl;
         std::cout << "TESTES DE CENÁRIOS" << std::endl;